@@ -7,6 +7,14 @@
 
 #define USE_SSE2           0
 #define UNROLL_LOOPS       1
+
+// element-wise Vector<double> operators call explicit
+// SSE2/AVX2/AVX-512 kernels (see SIMD_funcs.h)
+#define USE_SIMD_KERNELS   1
+
+// products of small operators (Dr, LIFT) with many columns
+// use kernels specialized for each order N (see SmallMat_funcs.h)
+#define USE_SMALLMAT_KERNELS 1
 #define RGN_BASE_OFFSET   (1)
 
 // select Cholesky solver
@@ -14,6 +22,46 @@
 #undef NDG_USE_CHOLMOD
 
 
+// per-thread array registries: arrays may be released
+// by any thread (requires C++11)
+#if (__cplusplus >= 201103L)
+#define USE_THREAD_REGISTRY 1
+#else
+#define USE_THREAD_REGISTRY 0
+#endif
+
+#if (USE_THREAD_REGISTRY)
+#define umTHREAD_LOCAL  thread_local
+#else
+#define umTHREAD_LOCAL
+#endif
+
+// byte alignment of registry arrays, and the size from
+// which arrays are backed by transparent huge pages (Linux;
+// 0 disables).  See umAllocPolicy in Registry_Type.h
+#define NDG_ARRAY_ALIGN     64
+#define NDG_HUGEPAGE_BYTES  (4<<20)
+
+// distance (in trace nodes) of software prefetch in the
+// fused trace gathers (see Gather_funcs.h); 0: none
+#define NDG_GATHER_PREFETCH  0
+
+// count array allocations, deep copies and moves
+// (see umArrayStats below, and Vector<T>::stats()).
+// Off by default: build with -DTRACK_ARRAY_STATS=1
+#ifndef TRACK_ARRAY_STATS
+#define TRACK_ARRAY_STATS   0
+#endif
+
+// charge array memory to names and solver phases
+// (see MemProfile.h; switched on by NDG_MEMPROF=1).
+// The hooks test one flag while profiling is off; build
+// with -DTRACK_ARRAY_MEMORY=0 to compile them out
+#ifndef TRACK_ARRAY_MEMORY
+#define TRACK_ARRAY_MEMORY  1
+#endif
+
+
 #ifndef NDEBUG
 #define CHECK_ARRAY_INDEX   1
 #else
@@ -56,6 +104,36 @@ typedef struct {
 } umMATLAB;
 
 
+//
+// STRUCT: array allocation/copy/move counters
+//
+typedef struct umArrayStats_ {
+  long alloc;     // data allocations taken from a registry
+  long index;     // column-pointer tables built (Mat_COL)
+  long copy;      // deep copies of entire arrays on assign/construct
+  long move;      // O(1) transfers of ownership (OBJ_temp or rvalue)
+  long frame;     // data allocations taken from a umFrame arena
+  long temp;      // OBJ_temp arrays (objects on the heap) released
+
+  void reset() { alloc = index = copy = move = frame = temp = 0; }
+
+  umArrayStats_ operator-(const umArrayStats_& B) const {
+    umArrayStats_ d = { alloc-B.alloc, index-B.index, copy-B.copy, move-B.move, frame-B.frame, temp-B.temp };
+    return d;
+  }
+  umArrayStats_& operator+=(const umArrayStats_& B) {
+    alloc += B.alloc; index += B.index; copy += B.copy; move += B.move; frame += B.frame; temp += B.temp;
+    return (*this);
+  }
+} umArrayStats;
+
+#if (TRACK_ARRAY_STATS)
+#define umSTAT_INC(x)   (++(x))
+#else
+#define umSTAT_INC(x)
+#endif
+
+
 //
 // ENUM: object modes
 //
@@ -224,8 +302,8 @@ inline const char* tmp_op_name
 {
 #ifndef NDEBUG
 
-  static char buf[300]={""};
-  static int sID=0;
+  static umTHREAD_LOCAL char buf[300]={""};
+  static umTHREAD_LOCAL int sID=0;
   ++sID;
 
   snprintf(buf, (size_t)298, "%s%s%s", s1,op,s2);
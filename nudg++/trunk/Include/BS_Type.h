@@ -0,0 +1,90 @@
+// BS_Type.h
+// block sparse matrix of dense (b,b) blocks, for DG
+// operators made of element blocks
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__BS_Type_H__INCLUDED
+#define NDG__BS_Type_H__INCLUDED
+
+#include "CS_Type.h"
+
+//---------------------------------------------------------
+// Every nonzero of a DG operator such as the IPDG matrix
+// belongs to a dense (Np,Np) element-pair block, but CS<T>
+// stores a row index for each entry.  BSd is block csc:
+// a square matrix of Nb*Nb blocks of size (b,b), with one
+// row index per block:
+//
+//   P[0..Nb]   start of block column kc in I
+//   I[p]       block row of block p (0-based)
+//   X          the blocks, each column-major, in order:
+//              entry (i,j) of block p is X[p*b*b + i + j*b]
+//
+// Block rows of a block column are ascending.  A shape of
+// (sp_LOWER | sp_SYMMETRIC) means that only the lower
+// triangle of a symmetric matrix is stored (the diagonal
+// blocks keep their lower half, with zero above), as for
+// tril(OP) in the IPDG solvers: products then also apply
+// the mirrored upper triangle.
+//
+// gaxpy applies each block with the order-specialized
+// kernels of SmallMat_funcs.h when one is registered for
+// (b,b), so the inner loops run on dense blocks.  Each
+// row sums its entries in column order, as CS<T>::gaxpy
+// does, so products without sp_SYMMETRIC match those of
+// the csc form.
+//
+// CS_PCG::cholinc(A, droptol, b) keeps a BSd copy of A
+// for the products of the CG iterations.
+//---------------------------------------------------------
+
+//---------------------------------------------------------
+class BSd
+//---------------------------------------------------------
+{
+public:
+  BSd(const char* sz="BS");
+  ~BSd() {}
+
+  void  resize(int Nb, int b, int nnzb);  // (Nb*b,Nb*b), zero blocks
+  void  reset();                          // release all data
+
+  // copy A, padding its entries to (b,b) blocks, and
+  // write this back to A, dropping entries that are 0
+  void  load (const CSd& A, int b);
+  void  to_CS(CSd& A) const;
+
+  // y += A*x;  Y += A*X, with X (n,nrhs) and Y (n,nrhs)
+  void  gaxpy(const DVec& x, DVec& y) const;
+  void  gaxpy(int nrhs, const double* X, int ldx, double* Y, int ldy) const;
+
+  int   num_rows()   const { return m_Nb*m_b; }
+  int   num_cols()   const { return m_Nb*m_b; }
+  int   num_blocks() const { return m_Nb; }     // block rows (cols)
+  int   block_size() const { return m_b; }
+  int   nnzb()       const { return m_Nb>0 ? P[m_Nb] : 0; }
+  int   nnz()        const { return nnzb()*m_b*m_b; }
+  bool  ok()         const { return (m_Nb>0 && m_b>0); }
+  bool  is_sym()     const { return 0 != (m_shape & sp_SYMMETRIC); }
+
+  int   get_shape() const   { return m_shape; }
+  void  set_shape(int flag) { m_shape = flag; }
+  const char* name() const  { return m_name.c_str(); }
+
+public:
+  IVec  P;            // block column pointers (Nb+1)
+  IVec  I;            // block row indices (nnzb)
+  DVec  X;            // blocks (b*b*nnzb)
+
+protected:
+  int   m_Nb, m_b;    // number and size of blocks
+  int   m_shape;      // {sp_NONE, sp_LOWER | sp_SYMMETRIC}
+  std::string m_name; // string identifier
+};
+
+
+// y = A*x, Y = A*X
+DVec& operator*(const BSd& A, const DVec& x);
+DMat& operator*(const BSd& A, const DMat& X);
+
+#endif  // NDG__BS_Type_H__INCLUDED
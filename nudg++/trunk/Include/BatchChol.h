@@ -0,0 +1,63 @@
+// BatchChol.h
+// batched solves with the Cholesky-factored mass matrices
+// of curved elements
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__BatchChol_H__INCLUDED
+#define NDG__BatchChol_H__INCLUDED
+
+#include "Mat_COL.h"
+
+//---------------------------------------------------------
+// Each curved element k has its own (Np,Np) mass matrix,
+// stored as the upper Cholesky factor U_k in column k of
+// cub.mmCHOL.  Solving one element and field at a time
+// (chol_solve, i.e. dpotrs) repeats the call and setup
+// work for every small system.  umBatchChol copies the
+// factors of a set of elements into a packed, interleaved
+// layout: entry (i,j) of U for umBC_LANES consecutive
+// elements is stored contiguously, so the triangular
+// solves run with one element per SIMD lane.  All elements
+// and all fields are solved in one call:
+//
+//   cub.mmBatch.reset(cub.mmCHOL, curved, Np);
+//   cub.mmBatch.solve(rhsQ, 4);  // rhsQ (Np*K,4): 4 fields
+//   cub.mmBatch.solve(dUdx, 1);  // dUdx (Np,K):   1 field
+//
+// The operations are those of the reference dpotrs, in
+// the same order and without fused multiply-add, so the
+// results are unchanged.  The SIMD level follows that of
+// the element-wise kernels (see SIMD_funcs.h).
+//---------------------------------------------------------
+
+enum { umBC_LANES = 8 };    // elements per batch
+
+//---------------------------------------------------------
+class umBatchChol
+//---------------------------------------------------------
+{
+public:
+  umBatchChol() : m_Np(0), m_Nelmt(0), m_Nbatch(0) {}
+
+  // copy the factors of elements elmts(1:n) from the
+  // columns of CHOL (Np*Np,K); an empty set clears
+  void reset(const DMat& CHOL, const IVec& elmts, int Np);
+  void clear() { reset(DMat(), IVec(), 0); }
+
+  // X = inv(M_k)*X in place, for each element k in the
+  // set: X holds nf fields of Np*K values, one after the
+  // other (i.e. X is (Np*K,nf), or (Np,K) when nf=1).
+  // Safe to call from several threads at once.
+  void solve(DMat& X, int nf) const;
+  void solve(double* X, int nf, int ldf) const;
+
+  int  num_elmts() const { return m_Nelmt; }
+  int  Np()        const { return m_Np; }
+
+protected:
+  int  m_Np, m_Nelmt, m_Nbatch;
+  IVec m_elmt;        // element ids (1-based)
+  DVec m_U;           // packed upper factors, by batch
+};
+
+#endif  // NDG__BatchChol_H__INCLUDED
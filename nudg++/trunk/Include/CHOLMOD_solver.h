@@ -9,6 +9,33 @@
 #include "cholmod.h"
 #include "CS_Type.h"
 
+//---------------------------------------------------------
+class CHOLMOD_symbolic
+//---------------------------------------------------------
+{
+  // symbolic factor from cholmod_analyze, with the pattern 
+  // it was built for, shared by reference count between
+  // solvers for matrices with that pattern (cf. CS_Chol).
+  // Ls is allocated and freed in this object's own Common,
+  // so it does not depend on the life of any one solver.
+public:
+  CHOLMOD_symbolic();
+  ~CHOLMOD_symbolic();
+
+  bool analyze(cholmod_sparse* A, const CSd& mat);
+  bool matches(const CSd& mat) const;
+
+  cholmod_factor* Ls; // symbolic factor (no values)
+  IVec  P, I;         // the pattern that was analyzed
+  int   refs;         // number of solvers using this
+  cholmod_common cm;  // owns Ls
+
+private:
+  CHOLMOD_symbolic(const CHOLMOD_symbolic&);
+  CHOLMOD_symbolic& operator=(const CHOLMOD_symbolic&);
+};
+
+
 //---------------------------------------------------------
 class CHOLMOD_solver
 //---------------------------------------------------------
@@ -28,12 +55,27 @@ public:
   void  set_droptol(double d)  { drop_tol = d; }
   void  write_matlab(const char* sz) const;
 
-  // load/factor/solve
+  // load/factor/solve.  chol() only refactors if the 
+  // pattern of mat has been analyzed already.
   bool  load(const CSd& mat);
   void  chol(const CSd &mat, int dummy=1, double droptol=0.0);
   DVec& solve(const DVec &b);
 
+  // split factorization: analyze() the pattern of mat 
+  // once, then factorize_numeric() new values on it
+  bool  analyze(const CSd& mat);
+  bool  factorize_numeric(const CSd& mat);
+  bool  is_analyzed(const CSd& mat) const;
+
+  // use the analysis of B (ignored by chol() if the 
+  // patterns do not match)
+  void  share_symbolic(const CHOLMOD_solver& B);
+
 protected:
+  void  release_symbolic();
+
+  CHOLMOD_symbolic* m_sym;  // shared symbolic analysis
+
   bool    initialized;
   double  drop_tol;
   int     m_status, m_NNZ, m_M, m_N;
@@ -0,0 +1,93 @@
+// CS_BlockPattern.h
+// direct csc assembly of DG operators made of (Np,Np)
+// element blocks
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__CS_BlockPattern_H__INCLUDED
+#define NDG__CS_BlockPattern_H__INCLUDED
+
+#include "CS_Type.h"
+#include "BS_Type.h"
+
+//---------------------------------------------------------
+// A DG operator couples element k to itself and to the
+// neighbor across each coupled face, so its pattern is a
+// set of dense (Np,Np) blocks fixed by the connectivity.
+// umBlockPattern builds the csc column pointers and row
+// indices of these blocks from nbr(k,f), the element
+// coupled to k through face f (0 if none), before any
+// values exist.  alloc() sets up the matrix, either csc
+// (CSd) or block sparse (BSd, see BS_Type.h), and element
+// blocks are then added straight into place, e.g. by an
+// OpenMP loop over elements (block row k is written by
+// element k only).  For CSd, finish() drops the zero
+// entries in place.  This replaces triplet buffers,
+// CS<T>::load and its compress/dupl passes:
+//
+//   umBlockPattern pat;
+//   pat.build(nbr, Np, sp_LT);  pat.alloc(spOP);
+//   ... pat.add_face(k,f, OP12); pat.add_diag(k, OP11);
+//   pat.finish(spOP);
+//
+// The entries of each column keep the order of the
+// triplets of a serial sweep over elements (faces, then
+// the diagonal block), and entries with |x| <= tol are
+// dropped as in CS<T>::load, so the csc arrays are those
+// that load would produce.  A BSd keeps the dense blocks,
+// with the same entries (tril: the diagonal blocks are
+// zero above the diagonal, and the matrix is flagged
+// sp_SYMMETRIC).
+//
+//   part : sp_LT (lower triangle, e.g. for Cholesky) or
+//          sp_All (all blocks)
+//---------------------------------------------------------
+
+//---------------------------------------------------------
+class umBlockPattern
+//---------------------------------------------------------
+{
+public:
+  umBlockPattern()
+    : m_K(0), m_Np(0), m_Nfaces(0), m_part(sp_All), m_nnz(0),
+      m_pX(NULL), m_pP(NULL)
+  {}
+
+  // blocks of the operator coupling elements through
+  // nbr (K,Nfaces); an empty nbr gives the block diagonal
+  void build(const IMat& nbr, int Np, int part);
+  void build(int K, int Np, int part);
+
+  // set A to the (Np*K,Np*K) pattern, with zero values,
+  // and add the blocks to A from now on
+  void alloc(CSd& A);
+  void alloc(BSd& A);
+
+  // is block (k, nbr(k,f)) stored?  (sp_LT: upper blocks
+  // are not, so they need not be formed)
+  bool stored(int k, int f) const { return m_frank[(f-1)*m_K+k-1] >= 0; }
+
+  // A(block k, block nbr(k,f)) += B, and A(k,k) += B;
+  // B is a column-major (Np,Np) block
+  void add_face(int k, int f, const double* B, double tol=1e-15) const;
+  void add_diag(int k,        const double* B, double tol=1e-15) const;
+
+  // drop the entries of A that are still zero; returns nnz
+  int  finish(CSd& A) const;
+
+  int  max_nnz() const { return m_nnz; }   // before finish()
+  int  nnzb()    const { return m_colB.size() ? m_colB[m_K] : 0; }
+
+protected:
+  void add_block(int kr, int kc, int rank, const double* B, double tol) const;
+
+  int  m_K, m_Np, m_Nfaces, m_part, m_nnz;
+  IMat m_nbr;         // (K,Nfaces) coupled elements
+  IVec m_colB;        // (K+1) start of block column kc in m_rowB
+  IVec m_rowB;        // row element of each stored block
+  IVec m_frank;       // (K*Nfaces) rank of face blocks in their column, or -1
+  IVec m_drank;       // (K) rank of the diagonal blocks
+  double*    m_pX;    // values of the target matrix
+  const int* m_pP;    // its column pointers (NULL: BSd)
+};
+
+#endif  // NDG__CS_BlockPattern_H__INCLUDED
@@ -91,7 +91,8 @@ public:
   int   get_sp_count() const { return sp_count; }
 
   const char* name() const  { return m_name.c_str(); }
-  void  set_name(const char* sz) { m_name = sz; }
+  void  set_name(const char* sz) { m_name = sz; name_parts(); }
+  void  name_parts();   // name P,I,X after this matrix (see MemProfile.h)
   int   get_mode() const    { return m_mode; }
   void  set_mode(int mode)  { m_mode = mode; }
   int   get_shape() const   { return m_shape; }
@@ -148,6 +149,7 @@ public:
   int     is_tri() const;
   IMat&   find2D(char op, T val) const;
   int     fkeep(KeepFunc fK, void *other);
+  void    gather(const CS<T>& B, Vector<T>& x) const;    // x = B on pattern of this
   void    gaxpy(const Vector<T>& x, Vector<T>& y) const; // y += Ax
   void    gxapy(const Vector<T>& x, Vector<T>& y) const; // y += xA
 
@@ -254,7 +256,7 @@ CS<T>::CS(const char* sz, int mode)
   : nzmax(0), m(0), n(0), P("P"), I("I"), X("X"), nz(0),
     m_mode(mode), m_values(0), m_shape(sp_NONE), m_name(sz)
 {
-  ++sp_count;
+  ++sp_count;  name_parts();
   //umTRC(2, "+++ CS<T> ctor (1) +++ : name: %s, count: %d\n", name(), sp_count);
 }
 
@@ -266,7 +268,7 @@ CS<T>::CS(int Nr, int Nc, int nzmax, int values, int triplet, int mode, const ch
   : nzmax(0), m(0), n(0), P("P"), I("I"), X("X"), nz(0),
     m_mode(mode), m_values(0), m_shape(sp_NONE), m_name(sz)
 {
-  ++sp_count;
+  ++sp_count;  name_parts();
   resize(Nr, Nc, nzmax, values, triplet);
   //umTRC(2, "+++ CS<T> ctor (2) +++ : name: %s, count: %d\n", name(), sp_count);
 }
@@ -279,7 +281,7 @@ CS<T>::CS(const CS<T>& B) //, int mode, const char* sz, int values)
   : nzmax(0), m(0), n(0), P("P"), I("I"), X("X"), nz(0),
     m_mode(OBJ_real), m_values(B.m_values), m_shape(B.m_shape), m_name("CS")
 {
-  ++sp_count;
+  ++sp_count;  name_parts();
   this->copy(B, B.m_values);
   //umTRC(2, "+++ CS<T> ctor (3) +++ : name: %s, count: %d\n", name(), sp_count);
 }
@@ -292,7 +294,7 @@ CS<T>::CS(const CS<T>& B, int mode, const char* sz, int values)
   : nzmax(0), m(0), n(0), P("P"), I("I"), X("X"), nz(0),
     m_mode(mode), m_values(values), m_shape(sp_NONE), m_name(sz)
 {
-  ++sp_count;
+  ++sp_count;  name_parts();
   this->copy(B, values);
   //umTRC(2, "+++ CS<T> ctor (4) +++ : name: %s, count: %d\n", name(), sp_count);
 }
@@ -389,6 +391,7 @@ CS<T>& CS<T>::operator = (const CS<T>& B)
     // huge, call own_2() to force immediate deallocation
     P.own_2(Bref.P); I.own_2(Bref.I); X.own_2(Bref.X);
     delete (&B);
+    name_parts();
   }
 
   assert(ok());
@@ -427,6 +430,7 @@ void CS<T>::copy(const CS<T>& B, int values)
     P.own_2(Bref.P); I.own_2(Bref.I);   // transfer {P,I}
     if (values) X.own_2(Bref.X);        // transfer {X} ?
     delete (&B);
+    name_parts();
   }
 
   if (m>0 && n>0) { 
@@ -497,6 +501,18 @@ void CS<T>::resize(int Nr, int Nc, int max_nz, int values, int triplet)
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+void CS<T>::name_parts()
+//---------------------------------------------------------
+{
+  // charge the storage of this matrix to its own name
+  P.set_name((m_name+".P").c_str());  umMEM_OWNER(P.data(), P.name());
+  I.set_name((m_name+".I").c_str());  umMEM_OWNER(I.data(), I.name());
+  X.set_name((m_name+".X").c_str());  umMEM_OWNER(X.data(), X.name());
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 bool CS<T>::realloc(int max_nz, bool bCheck)
@@ -548,6 +564,7 @@ CS<T>& CS<T>::own(const CS<T>& B, int values)
   else X.Free();
 
   Bref.reset();    // reset B to empty
+  name_parts();
 
   if (m>0 && n>0) {
     assert(this->ok()); 
@@ -1447,6 +1464,36 @@ int CS<T>::fkeep(KeepFunc fK, void *other)
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+void CS<T>::gather(const CS<T>& B, Vector<T>& x) const
+//---------------------------------------------------------
+{
+  // x(p) = B(I[p],j) for each entry p of this, 0 where
+  // B has no entry, so that, e.g., for C = A+s*B on the 
+  // pattern of C, C.X = a + s*b, with a=C.gather(A), 
+  // b=C.gather(B).  The pattern of B must be a subset of 
+  // the pattern of this.
+
+  if (!is_csc() || !B.is_csc() || !is_compatible(B)) {
+    umERROR("CS<T>::gather()", "Both args must be csc"); 
+  }
+
+  IVec w(m); w.fill(-1);
+  x.resize(P[n]); x.fill(T(0));
+
+  int i=0, p=0, q=0;
+  for (int j=0; j<n; ++j) {
+    for (p=P[j]; p<P[j+1]; ++p) { w[I[p]] = p; }    // rows of this(:,j)
+    for (q=B.P[j]; q<B.P[j+1]; ++q) {
+      i = B.I[q];
+      if (w[i] < P[j]) { umERROR("CS<T>::gather()", "B(%d,%d) is not in the pattern", i+1, j+1); return; }
+      x[w[i]] = B.X[q];
+    }
+  }
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 void CS<T>::gaxpy(const Vector<T>& x, Vector<T>& y) const
@@ -2582,7 +2629,7 @@ template <typename T> inline
 CS<T>& trans2(const CS<T> &A, int values)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; 
+  static umTHREAD_LOCAL char buf[100]={""}; 
   snprintf(buf, (size_t)90, "trans(%s)", A.name()); 
 
   // Copy constructor deletes A (if temp)
@@ -2597,7 +2644,7 @@ template <typename T> inline
 CS<T>& perm(const CS<T> &A, const IVec& pinv, const IVec& q, int values)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "perm(%s)", A.name()); 
 
   // Copy constructor deletes A (if temp)
@@ -2728,6 +2775,27 @@ public:
 };
 
 
+//---------------------------------------------------------
+class CS_CholSymbolic
+//---------------------------------------------------------
+{
+  // The AMD ordering and symbolic analysis of a Cholesky
+  // factorization depend only on the pattern of A, so one
+  // analysis serves every matrix with that pattern.  It is
+  // shared by reference count (see CS_Chol::share_symbolic).
+public:
+  CS_CholSymbolic() : S(NULL), order(-1), refs(1) {}
+  ~CS_CholSymbolic() { if (S) { delete S; S=NULL; } }
+
+  bool matches(const CSd& A, int ord) const;
+
+  CSS*  S;        // symbolic info
+  int   order;    // AMD re-ordering mode
+  IVec  P, I;     // the pattern that was analyzed
+  int   refs;     // number of solvers using this
+};
+
+
 //---------------------------------------------------------
 class CS_Chol
 //---------------------------------------------------------
@@ -2738,9 +2806,23 @@ public:
   ~CS_Chol();
 
   // Perform Cholesky factorization using 
-  // selected AMD re-ordering mode:
+  // selected AMD re-ordering mode.  If the
+  // pattern of A has been analyzed already,
+  // only the numeric factorization is done.
   int chol(CSd& A, int order=1, double dummy=0.0);
 
+  // split factorization: analyze() the pattern of A 
+  // once, then factorize_numeric() new values on that
+  // pattern (Note: takes ownership of A's data)
+  int  analyze(const CSd& A, int order=1);
+  int  factorize_numeric(CSd& A);
+  bool is_analyzed(const CSd& A, int order) const;
+
+  // use the analysis of B, e.g. for a second operator
+  // with the same pattern.  Ignored by chol() if the 
+  // patterns do not match.
+  void share_symbolic(const CS_Chol& B);
+
   // use factored form to solve for rhs, return x=A\rhs
   DVec& solve(const DVec& rhs);
 
@@ -2748,7 +2830,10 @@ public:
   DVec& chol_solve(int order, CSd& A, DVec& rhs);
 
 protected:
-  CSS  *S;        // symbolic info
+  void release_symbolic();
+
+  CS_CholSymbolic *m_sym; // shared symbolic analysis
+  CSS  *S;        // symbolic info (m_sym->S)
   CSN  *N;        // numeric data
   DVec b, x;      // rhs, solution
 };
@@ -2818,6 +2903,8 @@ protected:
 */
 
 
+class BSd;   // BS_Type.h
+
 //---------------------------------------------------------
 class CS_PCG
 //---------------------------------------------------------
@@ -2825,13 +2912,15 @@ class CS_PCG
 public:
   
   CS_PCG() 
-    : m_droptol(1e-3), m_tol(1e-6), m_maxit(20), 
+    : m_pAb(NULL), m_droptol(1e-3), m_tol(1e-6), m_maxit(20), 
       m_verbose(true), m_factor(false), m_oldsol(false) {}
 
-  ~CS_PCG() {}
+  ~CS_PCG();
 
-  // create incomplete Cholesky preconditioner
-  int cholinc(CSd& A, double droptol=1e-3);
+  // create incomplete Cholesky preconditioner.  With b>0,
+  // also keep A as (b,b) blocks (BSd) for the products A*x
+  // of the iterations, e.g. b=Np for DG operators
+  int cholinc(CSd& A, double droptol=1e-3, int b=0);
 
   // Use a preconditioned Conjugate Gradient method 
   // to return an iterative solution to: x = A\rhs.
@@ -2854,8 +2943,11 @@ public:
   DVec&   get_resvec()        { return m_resvec; }
 
 protected:
+  DVec& mult_A(const DVec& x) const;  // A*x
+
   // the system -------------------------
   CSd  A;             // symmetric pos.def system to solve
+  BSd* m_pAb;         // A as dense blocks, or NULL
   CSd  L;             // cholinc() preconditioner
   DVec pb, px, x;     // permuted rhs, permuted sol, sol.
   DVec prec_x;        // solution from preconditioner 
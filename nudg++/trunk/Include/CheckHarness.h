@@ -0,0 +1,158 @@
+// CheckHarness.h
+// common parts of the check programs in Src/Benchmarks
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__CheckHarness_H__INCLUDED
+#define NDG__CheckHarness_H__INCLUDED
+
+#include <cstdio>
+#include <cstdarg>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+class NDG2D;
+class NDG3D;
+
+//---------------------------------------------------------
+// Each check program sets a solver up on a mesh (without
+// running its Driver), evaluates a reference path and a
+// new one, and prints a table of timings and differences.
+// The parts they share:
+//
+//   umCheckFixture<S>  solver S, set up from a mesh at
+//                      order N by Setup(mesh, N)
+//   umCheckLoad()      Setup, or a warning and NULL
+//   umCheckDiff        largest difference of two results
+//   umCheckTable       rows of the report
+//   umCheckBanner()    the NuDG++ banner of the mains
+//
+//   umCheckBanner("FluxCheck2D");
+//   umCheckTable tab;
+//   for (each mesh) {
+//     FluxCheck2D* p = umCheckLoad("FluxCheck2D", new FluxCheck2D(sim), mesh, N);
+//     if (!p) { continue; }
+//     ...
+//     tab.row("%-28s %5d ...\n", mesh, p->num_elmts(), ...);
+//     delete p;
+//   }
+//   printf(heading);  tab.print();
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+template <class S>
+class umCheckFixture : public S
+//---------------------------------------------------------
+{
+public:
+  virtual void Driver() {}    // the check drives the solver
+
+  // read the mesh, set the order and final time.  InitRun
+  // is left to Setup: some solvers must choose their
+  // initial and boundary data first.
+  bool Load(const char* mesh, int Nord, double Tfinal=0.1) {
+    this->N = Nord;  this->FileName = mesh;  this->FinalTime = Tfinal;
+    return read_mesh(this);
+  }
+
+  // default set up: mesh and order, then InitRun
+  virtual bool Setup(const char* mesh, int Nord) {
+    if (!Load(mesh, Nord)) { return false; }
+    this->InitRun();
+    return true;
+  }
+
+  int    num_elmts() const { return this->K; }
+  int    num_nodes() const { return this->Np; }
+  double now()             { return this->timer.read(); }
+
+protected:
+  bool read_mesh(NDG2D*) { return this->MeshReaderGambit2D(this->FileName); }
+  bool read_mesh(NDG3D*) { return this->MeshReaderGambit3D(this->FileName); }
+};
+
+
+//---------------------------------------------------------
+template <class T>
+T* umCheckLoad(const char* prog, T* p, const char* mesh, int Nord)
+//---------------------------------------------------------
+{
+  // p, set up from mesh at order Nord, or NULL (p deleted)
+  // if the mesh could not be loaded
+  if (p && p->Setup(mesh, Nord)) { return p; }
+  umWARNING(prog, "could not load mesh %s", mesh);
+  delete p;
+  return NULL;
+}
+
+
+//---------------------------------------------------------
+class umCheckDiff
+//---------------------------------------------------------
+{
+  // largest |A-R| over one or more pairs of results, and
+  // largest |R|, for differences relative to the reference
+public:
+  umCheckDiff() : m_d(0.0), m_rmax(0.0) {}
+
+  void add(const double* a, const double* r, int n) {
+    for (int i=0; i<n; ++i) {
+      m_d    = std::max(m_d, fabs(a[i]-r[i]));
+      m_rmax = std::max(m_rmax, fabs(r[i]));
+    }
+  }
+  void add(const DMat& A, const DMat& R) {
+    assert(A.size() == R.size());
+    add(A.data(), R.data(), R.size());
+  }
+
+  double abs() const { return m_d; }
+  double rel() const { return (m_rmax>0.0) ? m_d/m_rmax : m_d; }
+
+protected:
+  double m_d, m_rmax;
+};
+
+
+//---------------------------------------------------------
+class umCheckTable
+//---------------------------------------------------------
+{
+  // rows are collected while the fixtures run (their set
+  // up writes to the log), then printed together
+public:
+  void row(const char* fmt, ...) {
+    char buf[400];  va_list ap;
+    va_start(ap, fmt);  vsnprintf(buf, sizeof(buf), fmt, ap);  va_end(ap);
+    m_rows.push_back(buf);
+  }
+  void print() const {
+    for (size_t i=0; i<m_rows.size(); ++i) { printf("%s", m_rows[i].c_str()); }
+  }
+  int  size() const { return (int)m_rows.size(); }
+
+protected:
+  std::vector<std::string> m_rows;
+};
+
+
+//---------------------------------------------------------
+inline void umCheckBanner(const char* prog)
+//---------------------------------------------------------
+{
+  umLOG(1, "\n");
+  umLOG(1, "--------------------------------\n");
+  umLOG(1, "              NuDG++            \n");
+  umLOG(1, "  Nodal Discontinuous Galerkin  \n");
+  umLOG(1, "         check programs         \n");
+  umLOG(1, "                                \n");
+  umLOG(1, "   o  %-26s\n", prog);
+  umLOG(1, "   o  version 3.0.0             \n");
+  umLOG(1, "   o  June 6, 2007              \n");
+  umLOG(1, "   o  Dr Tim Warburton          \n");
+  umLOG(1, "   o  tim.warburton@gmail.com   \n");
+  umLOG(1, "--------------------------------\n\n");
+}
+
+#endif  // NDG__CheckHarness_H__INCLUDED
@@ -6,6 +6,7 @@
 #define NDG__Cub2D_H__INCLUDED
 
 #include "Mat_COL.h"
+#include "BatchChol.h"
 
 //---------------------------------------------------------
 class Cub2D
@@ -19,6 +20,7 @@ public:
   DMat V, Dr, Ds,  VT, DrT, DsT;
   DMat x,y, rx, sx, ry, sy, J;
   DMat mm, mmCHOL;
+  umBatchChol mmBatch;   // mmCHOL of the curved elements, batched
 };
 
 
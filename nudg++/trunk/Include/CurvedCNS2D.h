@@ -76,6 +76,7 @@ protected:
 
   double gamma, gm1, mu, pbar, pref;
   DMat Q, rhsQ, resQ;
+  DMat cQ, gQ, dQ, cdQ, gdQ;  // stacked fields, derivatives for RHS()
   
   // store pre-calculated constant boundary data
   IVec gmapB;       // concatenated boundary maps
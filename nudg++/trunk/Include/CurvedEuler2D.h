@@ -55,6 +55,10 @@ protected:
   void MapGaussFaceData();
   void PreCalcBdryData();
   void RHS(DMat& Qin, double ti, fp_BC SolutionBC);
+  void InvMass(DMat& R);        // R = inv(M)*R, per element
+  void InitBatchMass();
+  void SurfaceFlux(DMat& QM, DMat& QP, DMat& flux);
+  void InitUniqueFlux();
 
   void Fluxes(DMat& Qin, DMat& F, DMat& G);
   void Fluxes(DMat& Qin, double gamma, DMat& F, DMat& G, DVec& rho, DVec& u, DVec& v, DVec& p);
@@ -62,6 +66,8 @@ protected:
   void LF2D (const DMat& lnx, const DMat& lny, DMat& QM, DMat& QP, double gamma, DMat& flux);
   void Roe2D(const DMat& lnx, const DMat& lny, DMat& QM, DMat& QP, double gamma, DMat& flux);
   void HLL2D(const DMat& lnx, const DMat& lny, DMat& QM, DMat& QP, double gamma, DMat& flux);
+  void HLLC2D(const DMat& lnx, const DMat& lny, DMat& QM, DMat& QP, double gamma, DMat& flux);
+  void NodeFlux2D(int ftype, const DMat& lnx, const DMat& lny, const DMat& QM, const DMat& QP, double gamma, DMat& flux);
 
 
 protected:
@@ -85,8 +91,24 @@ protected:
   DMat Q, Q1, Q2, Qbc, rhsQ, resQ;
   DMat QM, QP, flux; // nflux, 
   DMat cQ, cF, cG, gQ, gQM, gQP;
+  DMat cWr, cWs, gWf, dQs;  // stacked operands for RHS()
+
+  // straight-sided elements: runs of consecutive ids and
+  // a tile of work for the batched inverse mass (InvMass)
+  bool m_bBatchMass;
+  IVec m_sRuns;
+  int  m_sTileK;
+  DMat m_sW;
   DVec resid;
 
+  // unique-face fluxes (NDG_FLUX=unique): Gauss points on
+  // the owner side of each face (interior faces first),
+  // the partners of the interior points, packed normals
+  // and LF wave speeds
+  bool m_bUniqueFlux;
+  IVec m_uIdx, m_uPart;
+  DVec m_unx, m_uny, m_ulam;
+
   // store pre-calculated constant boundary data
   IVec gmapB;       // concatenated boundary maps
   DVec gxB, gyB;    // {x,y} coords of boundary nodes
@@ -112,6 +112,7 @@ protected:
 
   void CurvedINSPressureSetUp2D();
   void CurvedINSViscousSetUp2D();
+  void CurvedINSViscousUpdate2D();  // refactor VEL for new {g0,dt,nu}
 
   void INSAdvection2D();
   void INSPressure2D();
@@ -156,6 +157,17 @@ protected:
   DVec Uxrhs,Uyrhs, rhsbcUx, rhsbcUy, rhsbcPR;
   DVec refrhsbcUx, refrhsbcUy, refrhsbcPR;
   DVec    refbcUx,    refbcUy,    refbcPR, refbcdUndt;
+
+  // velocity system VEL = OP + (g0/(dt*nu))*MM: OP is kept 
+  // on the (frozen) pattern of VEL.  MM is block diagonal,
+  // so only its entries are kept, with their positions in 
+  // VELop.X (0-based).  Both live for the whole run: about
+  // 12 bytes per entry of VEL plus 12 per entry of MM, 
+  // against the 12 per entry of L held by the Cholesky 
+  // factor (e.g. 24 + 9 MB, against 58 MB for L, N=8, K=374)
+  CSd  VELop;
+  DVec VELmm;
+  IVec VELmmIdx;
   // 
   IVec nbcmapD, vbcmapD;
 
@@ -65,6 +65,7 @@ protected:
 
 
   void RHS(DMat& Qin, double ti, fp_BC SolutionBC);
+  void InitUniqueFlux();
 
   void Fluxes(DMat& Qin, DMat& F, DMat& G, DMat& H);
   void Fluxes(DMat& Qin, DMat& F, DMat& G, DMat& H, DVec& rho, DVec& u, DVec& v, DVec& w, DVec& p);
@@ -90,8 +91,16 @@ protected:
 
   DMat  Q, rhsQ, resQ;      // state data and residual
   DMat  cF,cG,cH;           // storage for flux data
-  DMat  QM, QP, flux;       // 
-  DMat  fM,gM,hM,fP,gP,hP;  //
+  DMat  QM, QP, flux;       // face traces and LF flux
+  DVec  lambda;             // LF wave speed per node
+
+  // unique-face fluxes (NDG_FLUX=unique): face nodes on the
+  // owner side of each face (interior faces first), the
+  // partners of the interior nodes, packed normals and
+  // LF wave speeds
+  bool  m_bUniqueFlux;
+  IVec  m_uIdx, m_uPart;
+  DVec  m_unx, m_uny, m_unz, m_ulam;
 
   // store pre-calculated constant boundary data
   IVec gmapB;           // concatenated boundary maps
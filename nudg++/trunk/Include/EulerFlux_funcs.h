@@ -0,0 +1,74 @@
+// EulerFlux_funcs.h
+// pointwise numerical fluxes for the Euler equations,
+// evaluated in vectorized loops over face nodes
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__EulerFlux_funcs_H__INCLUDED
+#define NDG__EulerFlux_funcs_H__INCLUDED
+
+#include "SIMD_funcs.h"
+
+//---------------------------------------------------------
+// Each numerical flux is a functor that takes one face
+// node (normal n, traces qM and qP) and returns the flux
+// F*.n at that node (see EulerFlux_kernels.h).  The same
+// functors, templated on the dimension, serve CurvedEuler2D
+// and Euler3D.  Roe, HLL and HLLC rotate the traces to the
+// face normal frame; LF works with Cartesian fluxes and the
+// wave speed lam, the largest |u|+c on each face, formed
+// first by umEulerSpeed.
+//
+// A state q has Dim+2 fields {rho, rho*u[Dim], Ener}.  The
+// traces and fluxes are column-major (Nr,Dim+2) arrays with
+// leading dimension ldq (ldf): field f of node i is
+// QM[f*ldq+i].
+// The normal of node i is {nx,ny,nz}[i*ninc], with ninc = 0
+// for one normal per call (e.g. a straight face); nz is
+// ignored for Dim=2.
+//
+// Node loops are vectorized for the SIMD level of the
+// element-wise kernels (see SIMD_funcs.h).  For Dim=2, LF,
+// Roe and HLL perform the operations of the whole-array
+// versions they replace, in the same order and without
+// fused multiply-add, so results are unchanged.
+//
+//   ftype : FT_LaxF, FT_Roe, FT_HLL or FT_HLLC
+//---------------------------------------------------------
+
+// F(i,:) = F*(QM(i,:), QP(i,:), n(i)).n(i),  i = 0:Nr-1
+void umEulerFlux
+(
+  int ftype, int Dim, double gamma, int Nr,
+  const double* nx, const double* ny, const double* nz, int ninc,
+  const double* QM, const double* QP, int ldq,
+  const double* lam,        // LF only (else NULL)
+  double* F, int ldf
+);
+
+// lam[i] = max(|u|+c) over both traces of the Nfp nodes of
+// the face holding node i; faces are Nfp consecutive nodes
+void umEulerSpeed
+(
+  int Dim, double gamma, int Nr, int Nfp,
+  const double* QM, const double* QP, int ldq,
+  double* lam
+);
+
+// umEulerFlux at the Nu owner-side nodes u[i] (1-based) of
+// the unique faces (BuildFaceList2D/3D), interior faces
+// first, with normals n[i]: F(u[i],:) = F*, and for the
+// NuI nodes of interior faces F(p[i],:) = -F* at their
+// partner nodes, as F*(qP,qM,-n) = -F*(qM,qP,n).  One pass
+// reads the traces in place and writes both sides.  LF
+// forms the wave speeds of each face in lam (scratch, Nu).
+void umEulerFluxUnique
+(
+  int ftype, int Dim, double gamma, int Nu, int NuI, int Nfp,
+  const int* u, const int* p,
+  const double* nx, const double* ny, const double* nz,
+  const double* QM, const double* QP, int ldq,
+  double* lam,
+  double* F, int ldf
+);
+
+#endif  // NDG__EulerFlux_funcs_H__INCLUDED
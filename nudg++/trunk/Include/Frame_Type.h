@@ -0,0 +1,317 @@
+// Frame_Type.h
+// per-thread "frame" arena for array temporaries
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__Frame_Type_H__INCLUDED
+#define NDG__Frame_Type_H__INCLUDED
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include "ArrayMacros.h"
+
+#if defined(__linux__) && (USE_THREAD_REGISTRY)
+#include <pthread.h>
+#define umFRAME_STACK_CHECK 1
+#else
+#define umFRAME_STACK_CHECK 0
+#endif
+
+// x86 stacks grow down, and the frame address of a
+// function lies above all of its locals (see birth)
+#if (umFRAME_STACK_CHECK) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define umFRAME_BASE_CHECK 1
+#define umFRAME_BASE()  ((const char*)__builtin_frame_address(0))
+#define umFRAME_INLINE  inline __attribute__((always_inline))
+#else
+#define umFRAME_BASE_CHECK 0
+#define umFRAME_BASE()  ((const char*)NULL)
+#define umFRAME_INLINE  inline
+#endif
+
+#if (USE_THREAD_REGISTRY)
+#include <atomic>
+extern std::atomic<int> g_umFrames_open;  // frames open on any thread
+#else
+extern int              g_umFrames_open;
+#endif
+
+//---------------------------------------------------------
+// Usage:
+//
+//   void CurvedCNS2D::RHS(...)
+//   {
+//     umFrame frame;       // open a frame on this thread
+//     DMat a, b, c;        // locals born inside the frame
+//     a = b + c;           // temporaries: bump-allocated
+//     ...
+//   }                      // frame closes: arena rewound
+//
+// While a umFrame is open, array data for objects "born"
+// inside it is bump-allocated from a per-thread arena,
+// rather than taken from the registries.  Releasing such
+// data costs nothing; the whole arena is rewound in O(1)
+// when the frame closes.  An object is born in a frame if
+// it is created while the frame is open, and it is either
+// an OBJ_temp or a local (i.e. on this thread's stack).
+// Such locals are always destroyed before the frame is.
+//
+// Objects that outlive the frame (members, statics, heap
+// objects, arguments) keep using the registries.  When
+// one of these is assigned a frame temporary, the data is
+// copied into its own storage instead of being transferred
+// (see Vector<T>::steal).  Frames may be nested.
+//
+// Rule: only open a frame in a function that returns no
+// arrays, and do not let OBJ_temp results escape it.  An
+// array returned by value may be constructed directly in
+// the caller (NRVO), i.e. on the stack while the frame is
+// open, and would be born in it.  Where the check is
+// available (umFRAME_BASE_CHECK), birth() asserts against
+// this, and gives such an array registry storage.
+//
+// Scope: a frame only removes registry traffic for arrays
+// born in it.  The RK stage loops of Maxwell2D/3D, Euler
+// and the INS solvers open no frame, since their results
+// and stage arrays are members: frame temporaries would be
+// copied into them, which cost more than the lookups saved
+// (Maxwell2D::RHS, 0.93s -> 1.08s).  Their registry 
+// allocations are unchanged.  CurvedCNS2D::RHS, with its
+// local arrays, opens one.
+//
+// Cost: array constructors call birth(), which reads one
+// process-wide counter of open frames.  Only while some
+// thread has a frame open does it look up the per-thread
+// arena, so code that never opens a frame pays no more.
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+class umFrameArena
+//---------------------------------------------------------
+{
+public:
+  enum { MAX_DEPTH = 32, MAX_BLOCKS = 32 };
+
+protected:
+
+  char*   m_blk[MAX_BLOCKS];  // blocks of storage
+  size_t  m_len[MAX_BLOCKS];  // size of each block
+  int     m_nblk;             // number of blocks
+
+  int     m_cur;              // current block
+  size_t  m_off;              // offset into current block
+  size_t  m_used, m_hwm;      // bytes in use, high-water mark
+
+  int         m_depth;                // number of open frames
+  const char* m_stack_lo;             // extent of this thread's stack
+  const char* m_stack_hi;
+  const char* m_base[MAX_DEPTH];      // frame address of each opener
+
+public:
+
+  umFrameArena();
+  ~umFrameArena();
+
+  // arena belonging to the calling thread
+  static umFrameArena& local();
+
+  // frame depth at which an object, at address p, is 
+  // born (0: not inside any frame)
+  static int  birth(const void* p, bool bTemp);
+
+  int     depth()     const { return m_depth; }
+  size_t  in_use()    const { return m_used; }
+  size_t  high_water()const { return m_hwm; }
+
+  void*   alloc(size_t nbytes);
+  void    open (int& blk, size_t& off, size_t& used, const char* base);
+  void    close(int blk, size_t off, size_t used);
+  void    release();
+
+protected:
+  bool    on_stack(const char* p) const { return (p>=m_stack_lo && p<m_stack_hi); }
+};
+
+
+//---------------------------------------------------------
+class umFrame
+//---------------------------------------------------------
+{
+  // scoped guard: opens a frame on construction, and
+  // rewinds the arena to its starting point on exit.
+public:
+  // (always inlined: the base is the caller's frame address)
+  umFRAME_INLINE umFrame() { umFrameArena::local().open(m_blk, m_off, m_used, umFRAME_BASE()); }
+  ~umFrame() { umFrameArena::local().close(m_blk, m_off, m_used); }
+
+protected:
+  int     m_blk;
+  size_t  m_off, m_used;
+
+private:
+  umFrame(const umFrame&);              // not copyable
+  umFrame& operator=(const umFrame&);
+};
+
+
+
+///////////////////////////////////////////////////////////
+//
+// umFrameArena: implementation
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+inline umFrameArena::umFrameArena()
+//---------------------------------------------------------
+: m_nblk(0), m_cur(0), m_off(0), m_used(0), m_hwm(0),
+  m_depth(0), m_stack_lo(NULL), m_stack_hi(NULL)
+{
+  for (int i=0; i<MAX_BLOCKS; ++i) { m_blk[i]=NULL; m_len[i]=0; }
+  for (int i=0; i<MAX_DEPTH;  ++i) { m_base[i]=NULL; }
+
+#if (umFRAME_STACK_CHECK)
+  // find the extent of this thread's stack
+  pthread_attr_t attr; void* lo=NULL; size_t len=0;
+  if (0 == pthread_getattr_np(pthread_self(), &attr)) {
+    if (0 == pthread_attr_getstack(&attr, &lo, &len)) {
+      m_stack_lo = (const char*) lo;
+      m_stack_hi = m_stack_lo + len;
+    }
+    pthread_attr_destroy(&attr);
+  }
+#endif
+}
+
+
+//---------------------------------------------------------
+inline umFrameArena::~umFrameArena()
+//---------------------------------------------------------
+{
+  release();
+}
+
+
+//---------------------------------------------------------
+inline umFrameArena& umFrameArena::local()
+//---------------------------------------------------------
+{
+  static umTHREAD_LOCAL umFrameArena s_arena;
+  return s_arena;
+}
+
+
+//---------------------------------------------------------
+inline int umFrameArena::birth(const void* p, bool bTemp)
+//---------------------------------------------------------
+{
+  // A local created while a frame is open is destroyed 
+  // before that frame closes, so it may use the arena.
+  // Statics and heap objects (e.g. members) may not.
+#if (USE_THREAD_REGISTRY)
+  if (g_umFrames_open.load(std::memory_order_relaxed) < 1) { return 0; }
+#else
+  if (g_umFrames_open < 1) { return 0; }
+#endif
+  umFrameArena& A = local();
+  if (A.m_depth < 1) { return 0; }    // no open frame
+  if (bTemp) { return A.m_depth; }
+  const char* q = (const char*)p;
+  if (!A.on_stack(q)) { return 0; }
+
+#if (umFRAME_BASE_CHECK)
+  // Locals of the function that opened the frame, and of
+  // its callees, lie below its frame address.  Above it 
+  // lies the caller, e.g. the NRVO'd return value of the 
+  // function that opened the frame.
+  if (q >= A.m_base[A.m_depth-1]) {
+    assert(!"umFrame: array returned by value from inside a frame");
+    for (int d=A.m_depth-1; d>=1; --d) {
+      if (q < A.m_base[d-1]) { return d; }  // an outer frame
+    }
+    return 0;
+  }
+#endif
+  return A.m_depth;
+}
+
+
+//---------------------------------------------------------
+inline void* umFrameArena::alloc(size_t nbytes)
+//---------------------------------------------------------
+{
+  // bump-allocate nbytes, aligned to a cache line
+  const size_t ALIGN = 64;
+  nbytes = (nbytes + ALIGN-1) & ~(ALIGN-1);
+
+  if (m_nblk>0 && (m_off+nbytes <= m_len[m_cur])) {
+    void* p = m_blk[m_cur] + m_off;
+    m_off += nbytes;  m_used += nbytes;
+    if (m_used > m_hwm) { m_hwm = m_used; }
+    return p;
+  }
+
+  // move on to the next block that is large enough
+  for (int i=m_cur+1; i<m_nblk; ++i) {
+    if (nbytes <= m_len[i]) {
+      m_cur = i;  m_off = nbytes;  m_used += nbytes;
+      if (m_used > m_hwm) { m_hwm = m_used; }
+      return m_blk[i];
+    }
+  }
+
+  // add a new block, at least double the last one
+  if (m_nblk >= MAX_BLOCKS) {
+    umERROR("umFrameArena::alloc", "too many blocks (%d bytes requested)", (int)nbytes);
+  }
+  size_t len = (m_nblk>0) ? 2*m_len[m_nblk-1] : (size_t)(4<<20);
+  while (len < nbytes) { len *= 2; }
+
+  void* pblk = NULL;
+  if (posix_memalign(&pblk, ALIGN, len) || !pblk) {
+    umERROR("umFrameArena::alloc", "failed to allocate %0.2lf MB", double(len)/(1024.*1024.));
+  }
+
+  m_blk[m_nblk] = (char*) pblk;  m_len[m_nblk] = len;
+  m_cur = m_nblk++;  m_off = nbytes;  m_used += nbytes;
+  if (m_used > m_hwm) { m_hwm = m_used; }
+  return pblk;
+}
+
+
+//---------------------------------------------------------
+inline void umFrameArena::open(int& blk, size_t& off, size_t& used, const char* base)
+//---------------------------------------------------------
+{
+  if (m_depth >= MAX_DEPTH) {
+    umERROR("umFrame", "frames nested too deeply (%d)", m_depth);
+  }
+  blk = m_cur;  off = m_off;  used = m_used;  // mark
+  m_base[m_depth] = base;
+  ++m_depth;  ++g_umFrames_open;
+}
+
+
+//---------------------------------------------------------
+inline void umFrameArena::close(int blk, size_t off, size_t used)
+//---------------------------------------------------------
+{
+  // O(1): rewind to the mark taken when the frame opened
+  --m_depth;  --g_umFrames_open;
+  m_cur = blk;  m_off = off;  m_used = used;
+}
+
+
+//---------------------------------------------------------
+inline void umFrameArena::release()
+//---------------------------------------------------------
+{
+  // free all blocks (only valid when no frames are open)
+  if (m_depth > 0) { return; }
+  for (int i=0; i<m_nblk; ++i) { ::free(m_blk[i]); m_blk[i]=NULL; m_len[i]=0; }
+  m_nblk = m_cur = 0;  m_off = m_used = 0;
+}
+
+#endif  // NDG__Frame_Type_H__INCLUDED
@@ -0,0 +1,277 @@
+// Gather_funcs.h
+// fused gathers of face traces through vmapM/vmapP
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__Gather_funcs_H__INCLUDED
+#define NDG__Gather_funcs_H__INCLUDED
+
+//---------------------------------------------------------
+// Surface terms begin by extracting traces of the fields:
+//
+//   dHx = Hx(vmapM)-Hx(vmapP);       // jump
+//   QM(All,n) = Qn(vmapM);           // gather
+//
+// Each mapped region above is copied to a temporary, and
+// for several fields the index arrays are read once per
+// field.  The functions below make one pass over the
+// (1-based) index arrays, and write each result straight
+// into a preallocated trace buffer:
+//
+//   trace_jump  (U, vmapM,vmapP, dU)   dU = U(vmapM)-U(vmapP)
+//   trace_avg   (U, vmapM,vmapP, aU)   aU = (U(vmapM)+U(vmapP))/2
+//   trace_gather(U, vmapM, UM)         UM = U(vmapM)
+//
+// Multi-field versions take Nf fields at once, either as
+// arrays of pointers to separate fields:
+//
+//   const DVec* U[3] = {&Hx, &Hy, &Ez};
+//   DVec*      dU[3] = {&dHx,&dHy,&dEz};
+//   trace_jump(3, U, vmapM,vmapP, dU);
+//   trace_gather(3, U, vmapM,vmapP, UM,UP);
+//
+// or as the columns of a matrix (all Nfields columns):
+//
+//   trace_gather(Q, vmapM,vmapP, QM,QP);  // QM(All,n) = Q(vmapM,n)
+//
+// Trace buffers must already have the size of the index
+// arrays (the matrix version resizes QM,QP if needed).
+// NDG_GATHER_PREFETCH (see ArrayMacros.h) sets the
+// distance of software prefetch (0: none).
+//---------------------------------------------------------
+
+#if (NDG_GATHER_PREFETCH>0) && defined(__GNUC__)
+#define umGATHER_PREFETCH(p)  __builtin_prefetch((p), 0, 1)
+#else
+#define umGATHER_PREFETCH(p)
+#endif
+
+enum { umTRACE_MAX_FIELDS = 16 };
+
+
+///////////////////////////////////////////////////////////
+//
+// kernels on raw data (0-based pointers, 1-based maps)
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+inline void umTraceJump
+(
+  int N, int Nf,
+  const double* const* u,   // [Nf] source fields
+  const int* mA,
+  const int* mB,
+  double* const* d          // [Nf] d[f][i] = u[f][mA[i]] - u[f][mB[i]]
+)
+//---------------------------------------------------------
+{
+  for (int i=0; i<N; ++i) {
+#if (NDG_GATHER_PREFETCH>0)
+    if (i+NDG_GATHER_PREFETCH < N) {
+      int pa=mA[i+NDG_GATHER_PREFETCH]-1, pb=mB[i+NDG_GATHER_PREFETCH]-1;
+      for (int f=0; f<Nf; ++f) { umGATHER_PREFETCH(u[f]+pa); umGATHER_PREFETCH(u[f]+pb); }
+    }
+#endif
+    int a=mA[i]-1, b=mB[i]-1;
+    for (int f=0; f<Nf; ++f) {
+      d[f][i] = u[f][a] - u[f][b];
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+inline void umTraceAvg
+(
+  int N, int Nf,
+  const double* const* u,   // [Nf] source fields
+  const int* mA,
+  const int* mB,
+  double* const* d          // [Nf] d[f][i] = (u[f][mA[i]] + u[f][mB[i]])/2
+)
+//---------------------------------------------------------
+{
+  for (int i=0; i<N; ++i) {
+#if (NDG_GATHER_PREFETCH>0)
+    if (i+NDG_GATHER_PREFETCH < N) {
+      int pa=mA[i+NDG_GATHER_PREFETCH]-1, pb=mB[i+NDG_GATHER_PREFETCH]-1;
+      for (int f=0; f<Nf; ++f) { umGATHER_PREFETCH(u[f]+pa); umGATHER_PREFETCH(u[f]+pb); }
+    }
+#endif
+    int a=mA[i]-1, b=mB[i]-1;
+    for (int f=0; f<Nf; ++f) {
+      d[f][i] = (u[f][a] + u[f][b]) / 2.0;
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+inline void umTraceGather
+(
+  int N, int Nf,
+  const double* const* u,   // [Nf] source fields
+  const int* mA,
+  const int* mB,            // may be NULL
+  double* const* dA,        // [Nf] dA[f][i] = u[f][mA[i]]
+  double* const* dB         // [Nf] dB[f][i] = u[f][mB[i]]
+)
+//---------------------------------------------------------
+{
+  for (int i=0; i<N; ++i) {
+#if (NDG_GATHER_PREFETCH>0)
+    if (i+NDG_GATHER_PREFETCH < N) {
+      int pa=mA[i+NDG_GATHER_PREFETCH]-1;
+      for (int f=0; f<Nf; ++f) { umGATHER_PREFETCH(u[f]+pa); }
+      if (mB) {
+        int pb=mB[i+NDG_GATHER_PREFETCH]-1;
+        for (int f=0; f<Nf; ++f) { umGATHER_PREFETCH(u[f]+pb); }
+      }
+    }
+#endif
+    int a=mA[i]-1;
+    for (int f=0; f<Nf; ++f) { dA[f][i] = u[f][a]; }
+    if (mB) {
+      int b=mB[i]-1;
+      for (int f=0; f<Nf; ++f) { dB[f][i] = u[f][b]; }
+    }
+  }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// array versions
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+inline void umTraceCheck
+(
+  const char* fn, int Nf,
+  const DVec* const* U,
+  const IVec& mA,
+  DVec* const* D,
+  const double** u,
+  double** d
+)
+//---------------------------------------------------------
+{
+  // collect data pointers, checking sizes
+  if (Nf<1 || Nf>umTRACE_MAX_FIELDS) {
+    umERROR(fn, "expected 1 to %d fields, got %d", (int)umTRACE_MAX_FIELDS, Nf);
+  }
+  int N=mA.size();
+  for (int f=0; f<Nf; ++f) {
+    if (D[f]->size() != N) {
+      umERROR(fn, "trace buffer %d has size %d (expected %d)", f+1, D[f]->size(), N);
+    }
+    assert(mA.max_val() <= U[f]->size());
+    u[f] = U[f]->data();  d[f] = D[f]->data();
+  }
+}
+
+
+//---------------------------------------------------------
+inline void trace_jump(int Nf, const DVec* const* U, const IVec& mA, const IVec& mB, DVec* const* D)
+//---------------------------------------------------------
+{
+  // for each field: D[f] = U[f](mA) - U[f](mB)
+  const double* u[umTRACE_MAX_FIELDS];  double* d[umTRACE_MAX_FIELDS];
+  umTraceCheck("trace_jump", Nf, U, mA, D, u, d);
+  assert(mB.size() == mA.size());
+  umTraceJump(mA.size(), Nf, u, mA.data(), mB.data(), d);
+}
+
+
+//---------------------------------------------------------
+inline void trace_avg(int Nf, const DVec* const* U, const IVec& mA, const IVec& mB, DVec* const* D)
+//---------------------------------------------------------
+{
+  // for each field: D[f] = (U[f](mA) + U[f](mB))/2
+  const double* u[umTRACE_MAX_FIELDS];  double* d[umTRACE_MAX_FIELDS];
+  umTraceCheck("trace_avg", Nf, U, mA, D, u, d);
+  assert(mB.size() == mA.size());
+  umTraceAvg(mA.size(), Nf, u, mA.data(), mB.data(), d);
+}
+
+
+//---------------------------------------------------------
+inline void trace_gather(int Nf, const DVec* const* U, const IVec& mA, DVec* const* DA)
+//---------------------------------------------------------
+{
+  // for each field: DA[f] = U[f](mA)
+  const double* u[umTRACE_MAX_FIELDS];  double* d[umTRACE_MAX_FIELDS];
+  umTraceCheck("trace_gather", Nf, U, mA, DA, u, d);
+  umTraceGather(mA.size(), Nf, u, mA.data(), NULL, d, NULL);
+}
+
+
+//---------------------------------------------------------
+inline void trace_gather
+(
+  int Nf, const DVec* const* U, 
+  const IVec& mA, const IVec& mB,
+  DVec* const* DA, DVec* const* DB
+)
+//---------------------------------------------------------
+{
+  // for each field: DA[f] = U[f](mA), DB[f] = U[f](mB)
+  const double* u[umTRACE_MAX_FIELDS];  double *da[umTRACE_MAX_FIELDS], *db[umTRACE_MAX_FIELDS];
+  umTraceCheck("trace_gather", Nf, U, mA, DA, u, da);
+  umTraceCheck("trace_gather", Nf, U, mB, DB, u, db);
+  umTraceGather(mA.size(), Nf, u, mA.data(), mB.data(), da, db);
+}
+
+
+//---------------------------------------------------------
+inline void trace_jump(const DVec& U, const IVec& mA, const IVec& mB, DVec& dU)
+//---------------------------------------------------------
+{
+  const DVec* pU[1] = {&U};  DVec* pD[1] = {&dU};
+  trace_jump(1, pU, mA, mB, pD);
+}
+
+
+//---------------------------------------------------------
+inline void trace_avg(const DVec& U, const IVec& mA, const IVec& mB, DVec& aU)
+//---------------------------------------------------------
+{
+  const DVec* pU[1] = {&U};  DVec* pD[1] = {&aU};
+  trace_avg(1, pU, mA, mB, pD);
+}
+
+
+//---------------------------------------------------------
+inline void trace_gather(const DVec& U, const IVec& mA, DVec& UA)
+//---------------------------------------------------------
+{
+  const DVec* pU[1] = {&U};  DVec* pD[1] = {&UA};
+  trace_gather(1, pU, mA, pD);
+}
+
+
+//---------------------------------------------------------
+inline void trace_gather(const DMat& Q, const IVec& mA, const IVec& mB, DMat& QA, DMat& QB)
+//---------------------------------------------------------
+{
+  // all columns at once: QA(All,n) = Q(mA,n), QB(All,n) = Q(mB,n)
+  int N=mA.size(), Nf=Q.num_cols();
+  assert(mB.size() == N);
+  if (Nf<1 || Nf>umTRACE_MAX_FIELDS) {
+    umERROR("trace_gather", "expected 1 to %d fields, got %d", (int)umTRACE_MAX_FIELDS, Nf);
+  }
+  if (QA.num_rows()!=N || QA.num_cols()!=Nf) { QA.resize(N, Nf, false); }
+  if (QB.num_rows()!=N || QB.num_cols()!=Nf) { QB.resize(N, Nf, false); }
+  assert(mA.max_val() <= Q.num_rows() && mB.max_val() <= Q.num_rows());
+
+  const double* u[umTRACE_MAX_FIELDS];  double *da[umTRACE_MAX_FIELDS], *db[umTRACE_MAX_FIELDS];
+  for (int f=0; f<Nf; ++f) {
+    u[f] = Q.pCol(f+1);  da[f] = QA.pCol(f+1);  db[f] = QB.pCol(f+1);
+  }
+  umTraceGather(N, Nf, u, mA.data(), mB.data(), da, db);
+}
+
+#endif  // NDG__Gather_funcs_H__INCLUDED
@@ -60,6 +60,43 @@ public:
   VecObj<CInfo2D> m_cinfo;  // 2D curved face data
 
 
+  //-------------------------------------
+  // compressed geometric factors (NDG_GEOM=affine)
+  //-------------------------------------
+  // A second, compact copy of the factors read by Grad2D, Div2D, Curl2D:
+  // it cuts their memory traffic, not the memory used.
+  // The nodal rx,sx,..,J stay allocated, since the flux,
+  // cubature and solver code index them directly.
+
+  bool    m_bAffineGeo;     // Grad2D, Div2D, Curl2D read geoK, geoC
+  IVec    geoIdx;           // (K): 0 if affine, else column of geoC
+  DMat    geoK;             // (5,K): {rx,sx,ry,sy,J} of affine elements
+  DMat    geoC;             // (5*Np,Nc): nodal {rx,sx,ry,sy,J} of the rest
+  int     Naffine;          // number of affine elements
+
+  IVec    faceIdx;          // (Nfaces*K): 0 if straight, else column of faceC
+  DMat    faceK;            // (4,Nfaces*K): {nx,ny,sJ,Fscale} of straight faces
+  DMat    faceC;            // (4*Nfp,Ncf): nodal {nx,ny,sJ,Fscale} of the rest
+  int     Nflat;            // number of straight faces
+
+  // compressed factors of face fc = (k-1)*Nfaces+f: factor
+  // n at face node i is g[n*fs + i*inc] (inc=0 if straight)
+  const double* face_geo(int fc, int& fs, int& inc) const {
+    int c = faceIdx(fc);
+    if (c) { fs = Nfp; inc = 1; return faceC.pCol(c); }
+    fs = 1;  inc = 0;  return faceK.pCol(fc);
+  }
+
+
+  //-------------------------------------
+  // unique faces (BuildFaceList2D): face fc = (k-1)*Nfaces+f
+  //-------------------------------------
+
+  IVec    uFaceM;           // (Nuf): interior faces once, then boundary faces
+  IVec    uFaceP;           // (Nuf): neighbor of uFaceM (itself on a boundary)
+  int     NufI;             // number of interior faces (listed first)
+
+
   //-------------------------------------
   // +NBN: added
   //-------------------------------------
@@ -0,0 +1,63 @@
+// Globals2D_P.h
+// 2D operators, metric and face data in precision TS
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__Globals2D_P_H__INCLUDED
+#define NDG__Globals2D_P_H__INCLUDED
+
+#include "Globals2D.h"
+#include "Precision.h"
+
+
+//---------------------------------------------------------
+template <typename TS>
+class Globals2D_P
+//---------------------------------------------------------
+{
+  // The subset of Globals2D read by nodal (collocation) RHS
+  // kernels such as Maxwell2D::RHS: nodal metric and face
+  // data, rounded once into TS after StartUp2D().  The
+  // small operators stay in cache, so kernels hold them in
+  // their accumulation type (see Maxwell2D_P.h).
+  // Globals2D itself stays double; this is its view in TS.
+  // Index maps are not copied: kernels use those of the
+  // Globals2D object, which must outlive this.
+  //
+  // Cubature and Gauss face data of curved elements (m_cub,
+  // m_gauss) are not rounded, so solvers that integrate
+  // curved elements with them (e.g. MaxwellCurved2D) have
+  // no TS view and step in double.
+
+public:
+  Globals2D_P()
+  : rx("rx_p"), ry("ry_p"), sx("sx_p"), sy("sy_p"),
+    nx("nx_p"), ny("ny_p"), Fscale("Fscale_p"), pG(NULL)
+  {}
+
+  void load(const Globals2D& G);
+
+  int Np, Nfp, Nfaces, K;
+  int Nfq;                          // Nfp*Nfaces
+  Vector<TS>  rx, ry, sx, sy;       // metric,    (Np,K)
+  Vector<TS>  nx, ny, Fscale;       // face data, (Nfq,K)
+  const Globals2D* pG;              // source of maps
+};
+
+
+//---------------------------------------------------------
+template <typename TS> inline
+void Globals2D_P<TS>::load(const Globals2D& G)
+//---------------------------------------------------------
+{
+  Np = G.Np;  Nfp = G.Nfp;  Nfaces = G.Nfaces;  K = G.K;
+  Nfq = Nfp*Nfaces;  pG = &G;
+
+  assert(G.Dr.num_rows()==Np && G.LIFT.num_cols()==Nfq);
+  assert(G.rx.size()==Np*K && G.Fscale.size()==Nfq*K);
+
+  to_prec(G.rx, rx);  to_prec(G.ry, ry);
+  to_prec(G.sx, sx);  to_prec(G.sy, sy);
+  to_prec(G.nx, nx);  to_prec(G.ny, ny);  to_prec(G.Fscale, Fscale);
+}
+
+#endif  // NDG__Globals2D_P_H__INCLUDED
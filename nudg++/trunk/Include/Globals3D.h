@@ -60,6 +60,43 @@ public:
   VecObj<CInfo3D> m_cinfo;  // 3D curved face data
 
 
+  //-------------------------------------
+  // compressed geometric factors (NDG_GEOM=affine)
+  //-------------------------------------
+  // A second, compact copy of the factors read by Grad3D, Div3D, Curl3D:
+  // it cuts their memory traffic, not the memory used.
+  // The nodal rx,sx,..,J stay allocated, since the flux,
+  // cubature and solver code index them directly.
+
+  bool    m_bAffineGeo;     // Grad3D, Div3D, Curl3D read geoK, geoC
+  IVec    geoIdx;           // (K): 0 if affine, else column of geoC
+  DMat    geoK;             // (10,K): {rx,sx,tx,ry,sy,ty,rz,sz,tz,J} of affine elements
+  DMat    geoC;             // (10*Np,Nc): nodal factors of the rest, same order
+  int     Naffine;          // number of affine elements
+
+  IVec    faceIdx;          // (Nfaces*K): 0 if planar, else column of faceC
+  DMat    faceK;            // (5,Nfaces*K): {nx,ny,nz,sJ,Fscale} of planar faces
+  DMat    faceC;            // (5*Nfp,Ncf): nodal {nx,ny,nz,sJ,Fscale} of the rest
+  int     Nflat;            // number of planar faces
+
+  // compressed factors of face fc = (k-1)*Nfaces+f: factor
+  // n at face node i is g[n*fs + i*inc] (inc=0 if planar)
+  const double* face_geo(int fc, int& fs, int& inc) const {
+    int c = faceIdx(fc);
+    if (c) { fs = Nfp; inc = 1; return faceC.pCol(c); }
+    fs = 1;  inc = 0;  return faceK.pCol(fc);
+  }
+
+
+  //-------------------------------------
+  // unique faces (BuildFaceList3D): face fc = (k-1)*Nfaces+f
+  //-------------------------------------
+
+  IVec    uFaceM;           // (Nuf): interior faces once, then boundary faces
+  IVec    uFaceP;           // (Nuf): neighbor of uFaceM (itself on a boundary)
+  int     NufI;             // number of interior faces (listed first)
+
+
   //-------------------------------------
   // +NBN: added
   //-------------------------------------
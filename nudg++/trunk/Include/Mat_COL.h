@@ -14,6 +14,7 @@
 template <typename T> class Mat_COL;
 
 typedef Mat_COL<double>  DMat;
+typedef Mat_COL<float>   FMat;
 typedef Mat_COL<dcmplx>  ZMat;
 typedef Mat_COL<int>     IMat;
 typedef Mat_COL<long>    LMat;
@@ -43,6 +44,7 @@ protected:
   int   m_M;    // num rows
   int   m_N;    // num cols
   int   m_MN;   // num elements = (m*n)
+  int   m_ld;   // column stride (leading dimension), >= m_M
 
   T**   col_;   // 1-based data pointers, adjusted 
                 // to enable 1-based (i,j) indexing
@@ -68,6 +70,9 @@ public:
   // constructors
   explicit Mat_COL(const char* sz="mat", OBJ_mode md=OBJ_real);
            Mat_COL(const Mat_COL<T> &B, OBJ_mode md=OBJ_real, const char* sz="mat");
+#if (__cplusplus >= 201103L)
+           Mat_COL(Mat_COL<T> &&B);   // C++11 move: O(1) transfer
+#endif
   explicit Mat_COL(int M, int N, const char* sz, OBJ_mode md=OBJ_real);
   explicit Mat_COL(int M, int N, const T x=T(0), OBJ_mode md=OBJ_real, const char* sz="mat");
   explicit Mat_COL(int M, int N, const T *data, OBJ_mode md=OBJ_real, const char* sz="mat");
@@ -81,12 +86,16 @@ public:
   // manage allocation
   Mat_COL<T>& borrow(int M, int N, T* p);
   void lend_col(int N, Vector<T> &col);
-  void set_pointers(int M, int N);
+  void set_pointers(int M, int N, int ld=0);
+  Mat_COL<T>& steal(Mat_COL<T>& B); // O(1) transfer, leaves B empty
   bool resize(int M, int N, bool bInit=true, T x=T(0));         // reinit to zeros(M,N)
+  bool resize_padded(int M, int N, bool bInit=true, T x=T(0));  // aligned columns, see below
+  void unpad();                                                 // back to ld == M
   bool resize(const Mat_COL<T>& B, bool bInit=true, T x=T(0));  // reinit to zeros(M,N)
   bool realloc(int newM, int newN, bool bInit=true, T x=T(0));  // map col-data onto new shape
   bool reshape(int newM, int newN, bool bInit=true, T x=T(0));  // wrap data into new shape
   bool compatible(const Mat_COL<T>& B) const;
+  Mat_COL<T>* new_temp(const T* pdata, T x, const char* sz) const;  // OBJ_temp, same layout
 
   void append_col(const Vector<T>& V);
   void append_row(const Vector<T>& V);
@@ -109,6 +118,13 @@ public:
   Mat_COL<T>& operator=(const T &val);
   Mat_COL<T>& operator=(const Mat_COL<T> &B);
   Mat_COL<T>& operator=(const Vector<T> &V);
+#if (__cplusplus >= 201103L)
+  Mat_COL<T>& operator=(Mat_COL<T> &&B);
+#endif
+  // evaluate element-wise expression (see VecExpr_Type.h)
+  template <class E> Mat_COL<T>& operator= (const VecExpr<T,E>& X);
+  template <class E> Mat_COL<T>& operator+=(const VecExpr<T,E>& X);
+  template <class E> Mat_COL<T>& operator-=(const VecExpr<T,E>& X);
   // allow assignment of IMat to DMat
   Mat_COL<T>& assign(const IMat &B);
 
@@ -122,6 +138,8 @@ public:
   int   dim(int d) const { return (d==1)?m_M:((d==2)?m_N:0); }
   int   num_rows() const { return m_M; }
   int   num_cols() const { return m_N; }
+  int   ld()       const { return m_ld; }
+  bool  is_padded() const { return (m_ld != m_M); }
   int     max_mn() const { return (m_M > m_N) ? m_M : m_N; }
   int     min_mn() const { return (m_M < m_N) ? m_M : m_N; }
 
@@ -196,9 +214,12 @@ public:
   Mat_COL<T>&  div_element (const Vector<T>& b);
 
   // The following variations do not change (*this)
-  Mat_COL<T>&  dd(const Mat_COL<T> &B) const;
-  Mat_COL<T>&  dm(const Mat_COL<T> &B) const;
-  Mat_COL<T>&  dm(const Vector<T> &V) const;
+  // C = A ./ B,  C = A .* B  (see VecExpr_Type.h)
+  VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,VecExprLeaf<T,1>,umOpDiv> > dd(const Mat_COL<T> &B) const;
+  VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,VecExprLeaf<T,1>,umOpMul> > dm(const Mat_COL<T> &B) const;
+  VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,VecExprLeaf<T,0>,umOpMul> > dm(const Vector<T> &V) const;
+  template <class E> VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,E,umOpDiv> > dd(const VecExpr<T,E> &B) const;
+  template <class E> VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,E,umOpMul> > dm(const VecExpr<T,E> &B) const;
   Mat_COL<T>&  dm(const T* data) const;
 
 
@@ -224,13 +245,16 @@ public:
 
 
   // element-by-element operations (A.+B) all call 
-  // unrolled vector version (deleting arg if temp)
+  // unrolled vector version (deleting arg if temp);
+  // matrices with different column strides (see 
+  // resize_padded) are combined column by column.
   //
   // A.+B, A.+V, A.-B, A.-V
-  Mat_COL<T>& operator+=(const Mat_COL<T> &B) {Vector<T>::operator+=((const Vector<T>&)B);return(*this);}
+  Mat_COL<T>& operator+=(const Mat_COL<T> &B) {if (B.m_ld!=m_ld) {return by_cols(B,'+');} Vector<T>::operator+=((const Vector<T>&)B);return(*this);}
   Mat_COL<T>& operator+=(const Vector <T> &V) {Vector<T>::operator+=(V);return(*this);}
-  Mat_COL<T>& operator-=(const Mat_COL<T> &B) {Vector<T>::operator-=((const Vector<T>&)B);return(*this);}
+  Mat_COL<T>& operator-=(const Mat_COL<T> &B) {if (B.m_ld!=m_ld) {return by_cols(B,'-');} Vector<T>::operator-=((const Vector<T>&)B);return(*this);}
   Mat_COL<T>& operator-=(const Vector <T> &V) {Vector<T>::operator-=(V);return(*this);}
+  Mat_COL<T>& by_cols(const Mat_COL<T> &B, char op);  // (*this) op= B, column by column
 
   Mat_COL<T>& operator*=(const Mat_COL<T> &A);  // matrix multiplication
   Mat_COL<T>& operator/=(const Mat_COL<T> &A);  // mrdivide(B,A): B/A => B*inv(A)
@@ -528,7 +552,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const char* sz, OBJ_mode md)
 //---------------------------------------------------------
 : Vector<T>(sz, md), 
-  m_M(0), m_N(0), m_MN(0), col_(0),
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0),
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {}
 
@@ -539,28 +563,50 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const Mat_COL<T> &B, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : Vector<T>(sz, md), 
-  m_M(0), m_N(0), m_MN(0), col_(0),
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0),
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
-  int Nr = B.m_M, Nc = B.m_N;
+  int Nr = B.m_M, Nc = B.m_N, ld = B.m_ld;
   this->m_mode = md;
 
+  if ((OBJ_temp == B.get_mode()) && B.ok() && !B.is_borrowed()) {
+    // take B's data and column pointers, then delete B
+    steal(const_cast<Mat_COL<T>& >(B));
+    delete &B;
+    return;
+  }
+
   // manage copy of real/temp objects
   // deletes B, if temporary.
   Vector<T>::operator= ((const Vector<T>&) B);
 
   if (Nr>0 && Nc>0) {
-    set_pointers(Nr,Nc);
+    set_pointers(Nr,Nc,ld);
   }
 }
 
 
+#if (__cplusplus >= 201103L)
+//---------------------------------------------------------
+template <typename T> inline
+Mat_COL<T>::Mat_COL(Mat_COL<T> &&B)
+//---------------------------------------------------------
+: Vector<T>(B.name(), OBJ_real), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0),
+  m_fact_mode(FACT_NONE), m_ipiv(NULL)
+{
+  if (B.is_borrowed()) { operator=((const Mat_COL<T>&)B); }
+  else if (B.ok())     { steal(B); }
+}
+#endif
+
+
 //---------------------------------------------------------
 template <typename T> inline
 Mat_COL<T>::Mat_COL(int M, int N, const char* sz, OBJ_mode md)
 //---------------------------------------------------------
 : Vector<T>(M*N, sz, md),
-  m_M(0), m_N(0), m_MN(0), col_(0),
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0),
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   set_pointers(M,N);
@@ -572,7 +618,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(int M, int N, const T x, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : Vector<T>(M*N, x, md, sz),
-  m_M(0), m_N(0), m_MN(0), col_(0),
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0),
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   set_pointers(M,N);
@@ -584,7 +630,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(int M, int N, const T *data, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : Vector<T>(M*N, data, md, sz), 
-  m_M(0), m_N(0), m_MN(0), col_(0), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0), 
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   set_pointers(M,N);
@@ -596,7 +642,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const ArrayData& rAD, int M, int N, const char *sdata, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : Vector<T>(M*N, T(0), md, sz),
-  m_M(0), m_N(0), m_MN(0), col_(0), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0), 
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   set_pointers(M,N);
@@ -652,7 +698,7 @@ void Mat_COL<T>::destroy()
   // Note: restore "col_" to 0-offset
   if (col_) {col_ ++; ::free(col_); col_=NULL;}
 
-  m_M = m_N = m_MN = 0;
+  m_M = m_N = m_MN = m_ld = 0;
   m_fact_mode = FACT_NONE;
 
   if (m_ipiv) { umIVectorFree(m_ipiv); }
@@ -711,45 +757,89 @@ void Mat_COL<T>::lend_col(int N, Vector<T> &col)
 }
 
 
-// The internal contiguous (0-offset) array v_[M*N] is 
+// The internal contiguous (0-offset) array v_[ld*N] is 
 // allocated in base class Vector.  Here we create an 
 // internal array of column pointers to enable 1-based, 
-// column-major indexing into an (M,N) matrix.
+// column-major indexing into an (M,N) matrix whose 
+// columns are ld apart (ld=0: ld=M, no padding).
 //---------------------------------------------------------
 template <typename T> inline
-void Mat_COL<T>::set_pointers(int M, int N)
+void Mat_COL<T>::set_pointers(int M, int N, int ld)
 //---------------------------------------------------------
 {
   m_fact_mode = FACT_NONE;
 
+  if (ld < 1) { ld = M; }
   assert( this->v_ );  // data allocated in Vector::initialize()
   assert( M >= 1);
   assert( N >= 1);
+  assert( ld >= M && ld*N <= this->m_Len );
 
-  // clear the old set of column pointers
+  // Re-use the old set of column pointers if the 
+  // number of columns is unchanged, else clear it.
   // Note: restore "col_" to 0-offset
-  if (col_) {col_ ++; ::free(col_); col_=NULL;}
+  if (col_) {
+    col_ ++; 
+    if (N != m_N) { ::free(col_); col_=NULL; }
+  }
 
-  // allocate a New set of col pointers
-  col_ = (T **) calloc((size_t)N, sizeof(T*) );
-  assert(col_);
+  if (!col_) {
+    // allocate a New set of col pointers
+    col_ = (T **) calloc((size_t)N, sizeof(T*) );
+    assert(col_);
+    umSTAT_INC(Vector<T>::s_stats.index);
+  }
 
   m_M  = M;     // num rows
   m_N  = N;     // num cols
   m_MN = M*N;   // total elements
+  m_ld = ld;    // column stride
 
   // adjust pointers for 1-based indexing
   T* p = this->v_ - 1;
   for (int i=0; i<N; ++i)
   {
     col_[i] = p;
-    p += M;
+    p += ld;
   }
 
   col_ -- ;   // adjust for 1-based indexing
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+Mat_COL<T>& Mat_COL<T>::steal(Mat_COL<T>& B)
+//---------------------------------------------------------
+{
+  // Transfer B's data in O(1) (see Vector<T>::steal).
+  // B's column pointers already index that data, so 
+  // swap tables rather than building a new one; our
+  // old table (if any) is released along with B.
+  // Any factorization (mode, pivots) moves with B.
+  // (If B's data lives in a umFrame that this matrix
+  // outlives, Vector<T>::steal copies it instead.)
+
+  int M=B.m_M, N=B.m_N, ld=B.m_ld;
+  const T* pB = B.v_;
+  Vector<T>::steal(B);
+
+  if (B.col_ && (ld*N == this->m_Len) && (this->v_ == pB)) {
+    std::swap(col_, B.col_);
+    m_M = M;  m_N = N;  m_MN = M*N;  m_ld = ld;
+  } else if (M>0 && N>0) {
+    set_pointers(M, N, ld);
+  }
+
+  m_fact_mode = B.m_fact_mode;
+  std::swap(m_ipiv, B.m_ipiv);
+
+  B.m_M = B.m_N = B.m_MN = B.m_ld = 0;
+  B.m_fact_mode = FACT_NONE;
+  return (*this);
+}
+
+
 
 // The internal contiguous (0-offset) array v_[M*N] is 
 // allocated by base class Vector. Here we just call
@@ -763,6 +853,8 @@ bool Mat_COL<T>::resize(int M, int N, bool bInit, T x)
   // Resize existing object, optionally setting 
   // the entire array to some given inital value.
   // Return value indicates whether size has changed.
+  // A new shape has unpadded columns; if the shape is
+  // unchanged, so is the layout (see resize_padded).
 
   assert(!this->m_borrowed);  // "borrowed" allocations must not be changed
   assert(M >= 0);             // must be non-negative
@@ -811,6 +903,65 @@ bool Mat_COL<T>::resize(const Mat_COL<T>& B, bool bInit, T x)
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+bool Mat_COL<T>::resize_padded(int M, int N, bool bInit, T x)
+//---------------------------------------------------------
+{
+  // As resize(M,N), but each column is padded so that 
+  // it starts on the alignment of the allocation policy
+  // (umAllocPolicy::align, 64 bytes by default): every
+  // column of an (Np,K) array is then aligned.
+  //
+  // The padding rows are part of the base Vector: they 
+  // are allocated, filled by bInit, and carried along by
+  // element-wise operations on the whole array, but they
+  // are never read by (i,j) or column access, by copies,
+  // or by the BLAS/LAPACK routines, which are given ld().
+  // Whole-array reductions of Vector<T> (sum, max_val,
+  // norms, ...) also see the padding, and single-index
+  // access A(i) addresses the padded array.  Operations
+  // that reshape the data (reshape, append_*, load, ...)
+  // first call unpad().
+
+  assert(!this->m_borrowed);  // "borrowed" allocations must not be changed
+  assert(M >= 0 && N >= 0);
+
+  int a = (int) std::max(umAllocPolicy::get().align/sizeof(T), (size_t)1);
+  int ld = ((M+a-1)/a)*a;
+  if (M==m_M && N==m_N && ld==m_ld) {
+    if (bInit && this->m_Len>0) { m_fact_mode = FACT_NONE;  fill(x); }
+    return false;
+  }
+
+  this->destroy();
+  if (M>0 && N>0) {
+    initialize(ld*N, bInit, x);
+    set_pointers(M, N, ld);
+  }
+  return true;
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+void Mat_COL<T>::unpad()
+//---------------------------------------------------------
+{
+  // Compact a padded matrix in place to ld == M, for
+  // routines that treat the data as one (M*N) array.
+
+  if (!is_padded() || !ok()) { return; }
+  int M=m_M, N=m_N, ld=m_ld;
+  T* p = this->v_;
+  for (int j=1; j<N; ++j) {
+    memmove(p + j*M, p + j*ld, M*sizeof(T));
+  }
+  this->extend(M*N);
+  set_pointers(M, N);
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 bool Mat_COL<T>::realloc(int newM, int newN, bool bInit, T x)
@@ -861,6 +1012,7 @@ bool Mat_COL<T>::reshape(int newM, int newN, bool bInit, T x)
   if (newM==m_M && newN==m_N) {
     return false;               // no change
   }
+  unpad();                      // data as one (M*N) array
   if (newM*newN != m_M*m_N) {
     extend(newM*newN,bInit,x);  // expand or contract
   }
@@ -869,6 +1021,20 @@ bool Mat_COL<T>::reshape(int newM, int newN, bool bInit, T x)
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+Mat_COL<T>* Mat_COL<T>::new_temp(const T* pdata, T x, const char* sz) const
+//---------------------------------------------------------
+{
+  // An OBJ_temp (M,N) matrix with the layout of this one,
+  // holding a copy of the (padded) array pdata, or x.
+  Mat_COL<T>* tmp = pdata ? new Mat_COL<T>(m_ld, m_N, pdata, OBJ_temp, sz)
+                          : new Mat_COL<T>(m_ld, m_N, x,     OBJ_temp, sz);
+  if (is_padded()) { tmp->set_pointers(m_M, m_N, m_ld); }
+  return tmp;
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 bool Mat_COL<T>::compatible(const Mat_COL<T>& B) const
@@ -904,6 +1070,7 @@ void Mat_COL<T>::append_col(const Vector<T>& V)
     resize(V.length(), 1);      // appending "1st" col to empty mat
     this->set_col(1, V);        // load data into new column 
   } else {
+    unpad();                    // columns must be contiguous
     int old_len = size();       // store current length
     int new_len = size()+m_M;   // calculate required length
     this->extend(new_len);      // add space for new column
@@ -944,7 +1111,13 @@ void Mat_COL<T>::append_cols(const Mat_COL<T>& B)
     }
 
     int newNc = this->num_cols()+B.num_cols();
-    Vector<T>::append(B);       // append col-major data to tail
+    unpad();                    // columns must be contiguous
+    if (B.is_padded()) {
+      Mat_COL<T> Bc(B);  Bc.unpad();
+      Vector<T>::append(Bc);    // append col-major data to tail
+    } else {
+      Vector<T>::append(B);     // append col-major data to tail
+    }
     set_pointers(m_M, newNc);   // adjust logical indexing
   }
 }
@@ -1158,6 +1331,10 @@ Mat_COL<T>& Mat_COL<T>::copy(const T *vec)
 //---------------------------------------------------------
 {
   // assumes sufficient elements, col-major sequence
+  if (is_padded()) {
+    for (int j=1; j<=m_N; ++j) { load_col(j, m_M, vec + (j-1)*m_M); }
+    return (*this);
+  }
   Vector<T>::copy(vec);
   return (*this);
 }
@@ -1179,6 +1356,7 @@ void Mat_COL<T>::load(int M, int N, const T *vdata)
 //---------------------------------------------------------
 {
   // load (col-major) data into matrix COLUMNS
+  if (is_padded()) { this->destroy(); }
   resize(M,N, false);
   copy(vdata);
 }
@@ -1191,6 +1369,7 @@ void Mat_COL<T>::load(int M, int N, const Vector<T>& V)
 {
   // load (col-major) data into matrix COLUMNS
   
+  if (is_padded()) { this->destroy(); }
   resize(M,N);    // initialize to zeros(M,N)
 
   int len = V.size();
@@ -1289,6 +1468,13 @@ Mat_COL<T>& Mat_COL<T>::assign(const IMat &B)
   if (this->m_name=="mat" || this->m_name.empty()) 
     this->m_name=B.name();
 
+  if (is_padded() || B.is_padded()) {
+    this->resize(M,N);        // load (i,j) by (i,j)
+    for (int j=1; j<=N; ++j) for (int i=1; i<=M; ++i) { col_[j][i] = T(B(i,j)); }
+    if (B.get_mode() == OBJ_temp) { delete (&B); }
+    return (*this);
+  }
+
   this->resize(M,N);          // resize array of T
   const int* p = B.data();    // load int data as T
 
@@ -1320,21 +1506,62 @@ Mat_COL<T>& Mat_COL<T>::operator=(const Mat_COL<T> &B)
     }
   }
 
-  int M=B.m_M, N=B.m_N;
+  int M=B.m_M, N=B.m_N, ld=B.m_ld;
   m_fact_mode = B.get_factmode();
   if (this->m_name=="mat" || this->m_name.empty()) 
     this->m_name=B.name();
 
+  if ((OBJ_temp == B.get_mode()) && B.ok() && 
+      !B.is_borrowed() && !this->m_borrowed) 
+  {
+    // take B's data and column pointers, then delete B
+    steal(const_cast<Mat_COL<T>& >(B));
+    delete &B;
+    return (*this);
+  }
+
+  if (this->m_borrowed && (ld != m_ld) && (M == m_M) && (N == m_N)) {
+    // copy a padded matrix into a borrowed one, by columns
+    for (int j=1; j<=N; ++j) { load_col(j, M, B.pCol(j)); }
+    if (OBJ_temp == B.get_mode()) { delete &B; }
+    return (*this);
+  }
+
   // base class manages the actual allocation
   Vector<T>::operator= ((const Vector<T>&) B);
 
   if (this->m_Len > 0) {
     // adjust (column) pointers for (M,N) indexing
-    set_pointers(M, N);
+    set_pointers(M, N, ld);
+  }
+
+  return (*this);
+}
+
+
+#if (__cplusplus >= 201103L)
+//---------------------------------------------------------
+template <typename T> inline
+Mat_COL<T>& Mat_COL<T>::operator=(Mat_COL<T> &&B)
+//---------------------------------------------------------
+{
+  // C++11 move assignment: take B's data and column 
+  // pointers in O(1). Borrowed arrays need a copy.
+
+  if (this == &B) { return (*this); }
+
+  if (this->m_borrowed || B.is_borrowed()) {
+    return operator=((const Mat_COL<T>&)B);
   }
 
+  if (this->m_name=="mat" || this->m_name.empty()) 
+    this->m_name=B.name();
+
+  if (B.ok()) { steal(B); }
+  else        { destroy(); }
   return (*this);
 }
+#endif
 
 
 //---------------------------------------------------------
@@ -1393,7 +1620,7 @@ Mat_COL<T>& Mat_COL<T>::operator!() const
   // this are "toggled" to zero, and vice-versa.
 
   // initialize result to ZERO, then toggle...
-  Mat_COL<T>* tmp = new Mat_COL(m_M, m_N, this->ZERO, OBJ_temp, "!TMP");
+  Mat_COL<T>* tmp = new_temp(NULL, this->ZERO, "!TMP");
   for (int i=0; i<this->m_Len; ++i){
     if (this->ZERO == this->v_[i]) { 
       tmp->v_[i] = this->ONE; 
@@ -1558,6 +1785,17 @@ bool Mat_COL<T>::operator==(const Mat_COL<T> &B) const
   if (B.num_rows() != m_M) return false;  // diff. shape?
   if (B.num_cols() != m_N) return false;  // diff. shape?
 
+  if (is_padded() || B.is_padded()) {
+    // compare columns, not padding
+    for (int j=1; j<=m_N; ++j) {
+      const T *a=this->pCol(j), *b=B.pCol(j);
+      for (int i=0; i<m_M; ++i) {
+        if (std::abs(a[i]-b[i]) > this->m_EqTol) { return false; }
+      }
+    }
+    return true;
+  }
+
   // compare data in base arrays
   return Vector<T>::operator==((const Vector<T>&)B);
 }
@@ -1579,7 +1817,7 @@ Mat_COL<T>& Mat_COL<T>::eq(T val) const
   //   r(i) = (v(i) == val) ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(x==val)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(x==val)");
   for (int i=1; i<=this->m_Len; ++i) { if (this->vm1_[i] == val) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
 }
@@ -1594,10 +1832,12 @@ Mat_COL<T>& Mat_COL<T>::eq(Mat_COL<T>& B) const
   if (! this->compatible(B)) { umERROR("Mat_COL<T>::eq(B)", "matrix dimensions not compatible"); }
  
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(A==B)");
-  const T* pA=this->data(), *pB=B.data(); T* pT=tmp->data();
-  for (int i=0; i<this->m_Len; ++i) {
-    if (pA[i] == pB[i]) { pT[i] = T(1); } 
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(A==B)");
+  for (int j=1; j<=m_N; ++j) {
+    const T* pA=this->pCol(j), *pB=B.pCol(j); T* pT=tmp->pCol(j);
+    for (int i=0; i<m_M; ++i) {
+      if (pA[i] == pB[i]) { pT[i] = T(1); } 
+    }
   }
 
   if (B.get_mode() == OBJ_temp) { delete (&B); } // delete temps
@@ -1612,7 +1852,7 @@ Mat_COL<T>& Mat_COL<T>::le(T val) const
   //   r(i) = (v(i) <= val) ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(x<=val)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(x<=val)");
   for (int i=1; i<=this->m_Len; ++i) { if (this->vm1_[i] <= val) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
 }
@@ -1625,7 +1865,7 @@ Mat_COL<T>& Mat_COL<T>::lt(T val) const
   //   r(i) = (v(i) < val) ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(x<val)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(x<val)");
   for (int i=1; i<=this->m_Len; ++i) { if (this->vm1_[i] < val) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
 }
@@ -1638,7 +1878,7 @@ Mat_COL<T>& Mat_COL<T>::lt_abs(T val) const
   //   r(i) = |v(i)| < val ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(|x|<tol)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(|x|<tol)");
   T fval = std::abs(val);
   for (int i=1; i<=this->m_Len; ++i) { if (std::abs(this->vm1_[i]) < fval) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
@@ -1652,7 +1892,7 @@ Mat_COL<T>& Mat_COL<T>::ge(T val) const
   //   r(i) = (v(i) >= val) ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(x>=val)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(x>=val)");
   for (int i=1; i<=this->m_Len; ++i) { if (this->vm1_[i] >= val) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
 }
@@ -1665,7 +1905,7 @@ Mat_COL<T>& Mat_COL<T>::gt(T val) const
   //   r(i) = (v(i) > val) ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(x>val)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(x>val)");
   for (int i=1; i<=this->m_Len; ++i) { if (this->vm1_[i] > val) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
 }
@@ -1678,7 +1918,7 @@ Mat_COL<T>& Mat_COL<T>::gt_abs(T val) const
   //   r(i) = |v(i)| > val ? 1:0
 
   // initialize with zeros.
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->ZERO, OBJ_temp, "(|x|>tol)");
+  Mat_COL<T> *tmp=new_temp(NULL, this->ZERO, "(|x|>tol)");
   T fval = std::abs(val);
   for (int i=1; i<=this->m_Len; ++i) { if (std::abs(this->vm1_[i]) > fval) { tmp->vm1_[i] = this->ONE; } }
   return (*tmp);
@@ -1819,10 +2059,31 @@ double Mat_COL<T>::norm_frob() const
 // The first set update (*this) in place
 //---------------------------------------------------------
 
+template <typename T> inline
+Mat_COL<T>& Mat_COL<T>::by_cols(const Mat_COL<T> &B, char op)
+{
+  // A = A op B, op in {+,-,*,/}, for matrices of the
+  // same shape whose column strides differ
+  if (! this->compatible(B)) { umERROR("Mat_COL<T>::by_cols(B)", "matrix dimensions not compatible"); }
+  for (int j=1; j<=m_N; ++j) {
+    T* a = this->pCol(j);  const T* b = B.pCol(j);
+    switch (op) {
+    case '+': for (int i=0; i<m_M; ++i) { a[i] += b[i]; }  break;
+    case '-': for (int i=0; i<m_M; ++i) { a[i] -= b[i]; }  break;
+    case '*': for (int i=0; i<m_M; ++i) { a[i] *= b[i]; }  break;
+    case '/': for (int i=0; i<m_M; ++i) { a[i] /= b[i]; }  break;
+    default:  assert(false);
+    }
+  }
+  if (OBJ_temp == B.get_mode()) { delete (&B); }
+  return (*this);
+}
+
 template <typename T> inline
 Mat_COL<T>& Mat_COL<T>::mult_element(const Mat_COL<T> &B)
 {
   // A = A .* B
+  if (B.m_ld != m_ld) { return by_cols(B, '*'); }
   Vector<T>::operator *= ((const Vector<T>&)B);
   return (*this);
 }
@@ -1847,6 +2108,7 @@ template <typename T> inline
 Mat_COL<T>& Mat_COL<T>::div_element (const Mat_COL<T> &B)
 {
   // A = A ./ B
+  if (B.m_ld != m_ld) { return by_cols(B, '/'); }
   Vector<T>::operator /= ((const Vector<T>&)B);
   return (*this);
 }
@@ -1864,51 +2126,6 @@ Mat_COL<T>& Mat_COL<T>::div_element (const Vector<T>& b)
 // The following variations do not change (*this)
 //---------------------------------------------------------
 
-template <typename T> inline
-Mat_COL<T>& Mat_COL<T>::dd(const Mat_COL<T> &B) const
-{
-  // (*this) is not changed: C = A ./ B
-
-  std::string sz; tmp_op_name(this->name(), "./", B.name(), sz);
-  // NOT USING COPY CONSTRUCTOR: side-effects if (*this)==OBJ_temp
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->data(), OBJ_temp, sz.c_str());
-  (*tmp).div_element(B);
-  if (OBJ_temp == this->m_mode) {
-    delete (this);
-  }
-  return (*tmp);
-}
-  
-template <typename T> inline
-Mat_COL<T>& Mat_COL<T>::dm(const Mat_COL<T> &B) const
-{
-  // (*this) is not changed: C = A .* B
-
-  std::string sz; tmp_op_name(this->name(), ".*", B.name(), sz);
-  // NOT USING COPY CONSTRUCTOR: side-effects if (*this)==OBJ_temp
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->data(), OBJ_temp, sz.c_str());
-  (*tmp).mult_element(B);
-  if (OBJ_temp == this->m_mode) {
-    delete (this);
-  }
-  return (*tmp);
-}
-
-template <typename T> inline
-Mat_COL<T>& Mat_COL<T>::dm(const Vector<T> &V) const
-{
-  // (*this) is not changed: C = A .* V
-
-  std::string sz; tmp_op_name(this->name(), ".*", V.name(), sz);
-  // NOT USING COPY CONSTRUCTOR: side-effects if (*this)==OBJ_temp
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->data(), OBJ_temp, sz.c_str());
-  (*tmp).mult_element(V);
-  if (OBJ_temp == this->m_mode) {
-    delete (this);
-  }
-  return (*tmp);
-}
-
 template <typename T> inline
 Mat_COL<T>& Mat_COL<T>::dm(const T* data) const
 {
@@ -1918,7 +2135,7 @@ Mat_COL<T>& Mat_COL<T>::dm(const T* data) const
   std::string sz; tmp_op_name(this->name(), ".*", "v", sz);
 
   // NOT USING COPY CONSTRUCTOR: side-effects if (*this)==OBJ_temp
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->data(), OBJ_temp, sz.c_str());
+  Mat_COL<T> *tmp=new_temp(this->data(), this->ZERO, sz.c_str());
   (*tmp).mult_element(data);
   if (OBJ_temp == this->m_mode) {
     delete (this);
@@ -2053,6 +2270,7 @@ Mat_COL<T>& Mat_COL<T>::invert()
 {
   assert(sizeof(T) == sizeof(double));
   assert(this->is_square());
+  unpad();
 
   if (1 == m_MN) {
     if (fabs(this->v_[0]) <= DBL_MIN) {umERROR("Mat_COL::invert()", "matrix has 1 (zero) element.");}
@@ -2181,11 +2399,12 @@ double Mat_COL<T>::solve_LU
   assert (FACT_LUP == m_fact_mode);
   assert (m_ipiv);
 
-  int rows=m_M, LDA=m_M, NRHS=B.num_cols(), LDB=B.num_rows(), info=0;
-  int ldwork=4*rows; double rcond=0.0;  assert(LDB==rows);
+  int rows=m_M, LDA=m_ld, NRHS=B.num_cols(), LDB=0, info=0;
+  int ldwork=4*rows; double rcond=0.0;  assert(B.num_rows()==rows);
   char NT = bTrans ? 'T' : 'N';
 
   X = B;    // initialize solution with RHS
+  LDB = X.ld();
 
   GETRS (NT, rows, NRHS, this->data(), LDA, m_ipiv, X.data(), LDB, info);
 
@@ -2223,7 +2442,7 @@ double Mat_COL<T>::solve_LU
   assert (FACT_LUP == m_fact_mode);
   assert (m_ipiv);
 
-  int rows=m_M, LDA=m_M, NRHS=1, LDB=b.size(), info=0;
+  int rows=m_M, LDA=m_ld, NRHS=1, LDB=b.size(), info=0;
   int ldwork=4*rows; double rcond=0.0; assert(LDB==rows);
   char NT = bTrans ? 'T' : 'N';
 
@@ -2362,6 +2581,7 @@ void Mat_COL<T>::extend_col(const int ncol)
   // This will extend (or contract) the matrix to 
   // have ncol columns, keeping exisitng data.
   assert(ncol>0);
+  unpad();
   this->extend(m_M*ncol);
   this->set_pointers(m_M, ncol);
 }
@@ -2844,7 +3064,7 @@ void Mat_COL<T>::print
 ) const
 //---------------------------------------------------------
 {
-  static char buf[20] = {""};
+  static umTHREAD_LOCAL char buf[20] = {""};
 
   // handle integer data types
   if (sizeof(T) == sizeof(double))
@@ -3059,6 +3279,7 @@ void Mat_COL<T>::m_load(FILE *fp, std::string& name)
   name = buf;
 
   int M=mat.m, N=mat.n;
+  if (is_padded()) { this->destroy(); }
   this->resize(M,N);
 
   float  f_temp=0.0f;
@@ -3094,7 +3315,7 @@ void Mat_COL<T>::m_load(FILE *fp, std::string& name)
       }
       else if ( o_flag == COL_ORDER ) 
       {
-        this->v_[i] = (T)(d_temp);        // cast double to <T>
+        this->v_[i] = (T)(d_temp);        // cast double to <T> (not padded)
       } 
       else 
       {
@@ -3156,7 +3377,7 @@ void Mat_COL<T>::m_load(FILE *fp, std::string& name)
 inline DMat& inv(const DMat& A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "inv(%s)", A.name()); 
 
   DMat *tmp=new DMat(A, OBJ_temp, buf);
@@ -3170,7 +3391,7 @@ template <typename T> inline
 Mat_COL<T>& trans(const Mat_COL<T> &A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "trans(%s)", A.name()); 
 
   // constructor deletes A (if temporary)
@@ -3185,7 +3406,7 @@ template <typename T> inline
 Mat_COL<T>& abs(const Mat_COL<T> &A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "abs(%s)", A.name()); 
 
   Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, buf);
@@ -3199,7 +3420,7 @@ template <typename T> inline
 Vector<T>& abs(const Vector<T>& V)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "abs(%s)", V.name()); 
 
   Vector<T> *tmp=new Vector<T>(V, OBJ_temp, buf);
@@ -3213,7 +3434,7 @@ template <typename T> inline
 Vector<T>& abs(const MappedRegion1D< Vector<T> >& R)
 //---------------------------------------------------------
 {
-  static char buf[20]={""};
+  static umTHREAD_LOCAL char buf[20]={""};
   snprintf(buf, (size_t)19, "abs(map)"); 
 
   Vector<T> *tmp=new Vector<T>(R, OBJ_temp, buf);
@@ -3227,7 +3448,7 @@ template <typename T> inline
 Mat_COL<T>& abs(const MappedRegion2D< Mat_COL<T> >& R)
 //---------------------------------------------------------
 {
-  static char buf[20]={""};
+  static umTHREAD_LOCAL char buf[20]={""};
   snprintf(buf, (size_t)19, "abs(map)"); 
 
   Mat_COL<T> *tmp=new Mat_COL<T>(R, OBJ_temp, buf);
@@ -3241,7 +3462,7 @@ Mat_COL<T>& abs(const MappedRegion2D< Mat_COL<T> >& R)
 inline DMat& sqrt(const DMat& A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "sqrt(%s)", A.name()); 
 
   DMat *tmp=new DMat(A, OBJ_temp, buf);
@@ -3254,7 +3475,7 @@ inline DMat& sqrt(const DMat& A)
 inline DVec& sqrt(const DVec& V)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "sqrt(%s)", V.name()); 
 
   DVec *tmp=new DVec(V, OBJ_temp, buf);
@@ -3268,7 +3489,7 @@ template <typename T> inline
 Mat_COL<T>& sqr(const Mat_COL<T>& A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "(%s)^2", A.name()); 
 
   Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, buf);
@@ -3282,7 +3503,7 @@ template <typename T> inline
 Vector<T>& sqr(const Vector<T>& V)
 //---------------------------------------------------------
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "(%s)^2", V.name()); 
 
   Vector<T> *tmp=new Vector<T>(V, OBJ_temp, buf);
@@ -3295,7 +3516,7 @@ Vector<T>& sqr(const Vector<T>& V)
 inline DMat& exp(const DMat& A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; snprintf(buf, (size_t)90, "exp(%s)", A.name()); 
+  static umTHREAD_LOCAL char buf[100]={""}; snprintf(buf, (size_t)90, "exp(%s)", A.name()); 
   DMat *tmp=new DMat(A, OBJ_temp, buf);
   tmp->exp_val();
   return (*tmp);
@@ -3306,7 +3527,7 @@ inline DMat& exp(const DMat& A)
 inline DVec& exp(const DVec& V)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; snprintf(buf, (size_t)90, "exp(%s)", V.name()); 
+  static umTHREAD_LOCAL char buf[100]={""}; snprintf(buf, (size_t)90, "exp(%s)", V.name()); 
   DVec *tmp=new DVec(V, OBJ_temp, buf);
   tmp->exp_val();
   return (*tmp);
@@ -3317,7 +3538,7 @@ inline DVec& exp(const DVec& V)
 inline DMat& log(const DMat& A)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; snprintf(buf, (size_t)90, "log(%s)", A.name()); 
+  static umTHREAD_LOCAL char buf[100]={""}; snprintf(buf, (size_t)90, "log(%s)", A.name()); 
   DMat *tmp=new DMat(A, OBJ_temp, buf);
   tmp->log();
   return (*tmp);
@@ -3328,7 +3549,7 @@ inline DMat& log(const DMat& A)
 inline DVec& log(const DVec& V)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; snprintf(buf, (size_t)90, "log(%s)", V.name()); 
+  static umTHREAD_LOCAL char buf[100]={""}; snprintf(buf, (size_t)90, "log(%s)", V.name()); 
   DVec *tmp=new DVec(V, OBJ_temp, buf);
   tmp->log();
   return (*tmp);
@@ -3339,7 +3560,7 @@ inline DVec& log(const DVec& V)
 inline DMat& pow(const DMat& A, double x)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; snprintf(buf, (size_t)90, "(%s)^%g", A.name(), x); 
+  static umTHREAD_LOCAL char buf[100]={""}; snprintf(buf, (size_t)90, "(%s)^%g", A.name(), x); 
   DMat *tmp=new DMat(A, OBJ_temp, buf);
   tmp->pow_val(x);
   return (*tmp);
@@ -3350,7 +3571,7 @@ inline DMat& pow(const DMat& A, double x)
 inline DVec& pow(const DVec& V, double x)
 //---------------------------------------------------------
 {
-  static char buf[100]={""}; snprintf(buf, (size_t)90, "(%s)^%g", V.name(), x); 
+  static umTHREAD_LOCAL char buf[100]={""}; snprintf(buf, (size_t)90, "(%s)^%g", V.name(), x); 
   DVec *tmp=new DVec(V, OBJ_temp, buf);
   tmp->pow_val(x);
   return (*tmp);
@@ -3368,10 +3589,12 @@ inline DMat& max(const DMat& A, const DMat& B)
 
   // constructor deletes A if OBJ_temp
   DMat *tmp=new DMat(A, OBJ_temp, "MAX(A,B)");
-  double *a=tmp->data(); const double *b=B.data();
-  // operate over vector data
-  for (int i=0; i<len; ++i) { 
-    a[i] = std::max(a[i],b[i]);
+  if (tmp->ld() != B.ld()) {
+    // different column strides: by columns
+    for (int j=1; j<=N; ++j) { umV_max(M, tmp->pCol(j), B.pCol(j)); }
+  } else {
+    // operate over vector data
+    umV_max(len, tmp->data(), B.data());
   }
 
   if (B.get_mode() == OBJ_temp) { delete (&B); }
@@ -3386,11 +3609,12 @@ inline DMat& min(const DMat& A, const DMat& B)
 
   // constructor deletes A if OBJ_temp
   DMat *tmp=new DMat(A, OBJ_temp, "MIN(A,B)");
-
-  double *a=tmp->data(); const double *b=B.data();
-  // operate over vector data
-  for (int i=0; i<len; ++i) {
-    a[i] = std::min(a[i],b[i]);
+  if (tmp->ld() != B.ld()) {
+    // different column strides: by columns
+    for (int j=1; j<=N; ++j) { umV_min(M, tmp->pCol(j), B.pCol(j)); }
+  } else {
+    // operate over vector data
+    umV_min(len, tmp->data(), B.data());
   }
 
   if (B.get_mode() == OBJ_temp) { delete (&B); }
@@ -3408,9 +3632,7 @@ inline DVec& max(const DVec& A, const DVec& B)
   DVec *tmp=new DVec(A, OBJ_temp, "MAX(A,B)");
   assert(B.size()==len);  // assume matching dimension
   double *a=tmp->data(); const double *b=B.data();
-  for (int i=0; i<len; ++i) {
-    a[i] = std::max(a[i],b[i]);
-  }
+  umV_max(len, a, b);
 
   if (B.get_mode() == OBJ_temp) { delete (&B); }
   return (*tmp);
@@ -3423,9 +3645,7 @@ inline DVec& min(const DVec& A, const DVec& B)
   DVec *tmp=new DVec(A, OBJ_temp, "MIN(A,B)");
   assert(B.size()==len);  // assume matching dimension
   double *a=tmp->data(); const double *b=B.data();
-  for (int i=0; i<len; ++i) {
-    a[i] = std::min(a[i],b[i]);
-  }
+  umV_min(len, a, b);
 
   if (B.get_mode() == OBJ_temp) { delete (&B); }
   return (*tmp);
@@ -3473,9 +3693,7 @@ inline DVec& max(double x, const DVec& A)
   int len=A.size();
   DVec *tmp=new DVec(A, OBJ_temp, "MAX(x,A)");
   double *a=tmp->data();
-  for (int i=0; i<len; ++i) {
-    a[i] = std::max(a[i],x);
-  }
+  umV_max(len, a, x);
   return (*tmp);
 }
 //---------------------------------------------------------
@@ -3485,9 +3703,7 @@ inline DVec& min(double x, const DVec& A)
   int len=A.size();
   DVec *tmp=new DVec(A, OBJ_temp, "MIN(x,A)");
   double *a=tmp->data();
-  for (int i=0; i<len; ++i) {
-    a[i] = std::min(a[i],x);
-  }
+  umV_min(len, a, x);
   return (*tmp);
 }
 
@@ -3591,68 +3807,7 @@ inline DVec& atan2(const DVec& Y, const DVec& X)
 
 
 
-// matrix + matrix
-template <typename T> inline
-Mat_COL<T>& operator+(const Mat_COL<T> &A, const Mat_COL<T> &B)
-{
-#if (USE_ARRAY_NAMES)
-  //
-  // NBN: eventually we may want to avoid using names.
-  //      Use simple stubs during transition?
-  //
-  std::string sz; tmp_op_name(A.name(),"+",B.name(), sz);
-#else
-  static std::string sz("mat");
-#endif
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += B;
-  return (*tmp);
-}
-
-// matrix + vector
-template <typename T> inline 
-Mat_COL<T>& operator+(const Mat_COL<T> &A, const Vector<T> &V)
-{
-  std::string sz; tmp_op_name(A.name(),"+",V.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += V;
-  return (*tmp);
-}
-
-// vector + matrix
-template <typename T> inline 
-Mat_COL<T>& operator+(const Vector<T> &V, const Mat_COL<T> &A)
-{
-  std::string sz; tmp_op_name(V.name(),"+",A.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += V;
-  return (*tmp);
-}
-
-// matrix + scalar
-template <typename T> inline 
-Mat_COL<T>& operator+(const Mat_COL<T> &A, const T &x)
-{
-  std::string sz; tmp_op_name(A.name(),"+","x", sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += x;
-  return (*tmp);
-}
-
-// scalar + matrix
-template <typename T> inline 
-Mat_COL<T>& operator+(const T &x, const Mat_COL<T> &A)
-{
-  std::string sz; tmp_op_name("x","+",A.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += x;
-  return (*tmp);
-}
+// matrix, vector and scalar operands:  see VecExpr_Type.h
 
 
 //---------------------------------------------------------
@@ -3677,64 +3832,7 @@ Mat_COL<T>& operator+(const T &x, const Mat_COL<T> &A)
 //---------------------------------------------------------
 
 
-// matrix - matrix
-template <typename T> inline 
-Mat_COL<T>& operator-(const Mat_COL<T> &A, const Mat_COL<T> &B)
-{
-  std::string sz; tmp_op_name(A.name(),"-",B.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) -= B;
-  return (*tmp);
-}
-
-// matrix - vector
-template <typename T> inline 
-Mat_COL<T>& operator-(const Mat_COL<T> &A, const Vector<T> &V)
-{
-  std::string sz; tmp_op_name(A.name(),"-",V.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) -= V;
-  return (*tmp);
-}
-
-// vector - matrix
-template <typename T> inline 
-Vector<T>& operator-(const Vector<T> &V, const Mat_COL<T> &A)
-{
-  std::string sz; tmp_op_name(V.name(),"-",A.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(V, OBJ_temp, sz.c_str());
-  (*tmp) -= (const Vector<T>&)(A);
-  return (*tmp);
-}
-
-// matrix - scalar
-template <typename T> inline 
-Mat_COL<T>& operator-(const Mat_COL<T> &A, const T &x)
-{
-  std::string sz; tmp_op_name(A.name(),"-","x", sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) -= x;
-  return (*tmp);
-}
-
-// scalar - matrix
-template <typename T> inline 
-Mat_COL<T>& operator-(const T &x, const Mat_COL<T> &A) 
-{ 
-  //
-  // create a matrix filled with scalar x; subtract A
-  //
-  std::string sz; tmp_op_name("x","-",A.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A.num_rows(), A.num_cols(), x, OBJ_temp, sz.c_str());
-  (*tmp) -= A;
-  return (*tmp);
-}
-
+// matrix, vector and scalar operands:  see VecExpr_Type.h
 
 
 //---------------------------------------------------------
@@ -3758,31 +3856,31 @@ Mat_COL<T>& operator-(const T &x, const Mat_COL<T> &A)
 
 // 1a :  matrix | matrix
 template <typename T> inline
-Mat_COL<T>& operator| (const Mat_COL<T> &A, const Mat_COL<T> &B)
+Mat_COL<T> operator| (const Mat_COL<T> &A, const Mat_COL<T> &B)
 {
   std::string sz; tmp_op_name(A.name(),"|",B.name(), sz);
 
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) |= B;
-  return (*tmp);
+  Mat_COL<T> X(A, OBJ_real, sz.c_str());
+  X |= B;
+  return X;
 }
 
 
 // 1b :  matrix | Vector
 template <typename T> inline
-Vector<T>& operator| (const Mat_COL<T> &A, const Vector<T> &b)
+Vector<T> operator| (const Mat_COL<T> &A, const Vector<T> &b)
 {
   std::string sz; tmp_op_name(A.name(),"|",b.name(), sz);
 
-  Vector<T> *x=new Vector<T>(sz.c_str(), OBJ_temp);
-  umSOLVE(A, b, (*x));
-  return (*x);
+  Vector<T> x(sz.c_str());
+  umSOLVE(A, b, x);
+  return x;
 }
 
 
 // 2a :  matrix / matrix
 template <typename T> inline 
-Mat_COL<T>& operator/ (const Mat_COL<T> &A, const Mat_COL<T> &B)
+Mat_COL<T> operator/ (const Mat_COL<T> &A, const Mat_COL<T> &B)
 {
   std::string sz; tmp_op_name(A.name(),"/",B.name(), sz);
 
@@ -3793,16 +3891,16 @@ Mat_COL<T>& operator/ (const Mat_COL<T> &A, const Mat_COL<T> &B)
   //   X                          = tr( tr(A) | tr(B) );
   //-------------------------------------------------------
 
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) /= B;
-  return (*tmp);
+  Mat_COL<T> X(A, OBJ_real, sz.c_str());
+  X /= B;
+  return X;
 }
 
 
 // 2b :  vector / matrix : "right division" b/A ==> b*inv(A)
 
 inline  // specialization for <T>=<double>
-DVec& operator/ (const DVec &b, const DMat &A)
+DVec operator/ (const DVec &b, const DMat &A)
 {
   // Matlab's A\B and B/A
   //-------------------------------------------------------
@@ -3812,39 +3910,14 @@ DVec& operator/ (const DVec &b, const DMat &A)
   //-------------------------------------------------------
 
   std::string sz; tmp_op_name(b.name(),"/",A.name(), sz);
-  DVec *tmp=new DVec(sz.c_str(), OBJ_temp);
-  (*tmp) = trans(A)|b;
-  return (*tmp);
-}
-
-
-
-// 3a :  matrix / scalar
-template <typename T> inline
-Mat_COL<T>& operator/ (const Mat_COL<T> &A, const T &x) 
-{
-  assert(fabs(x)>0.0); 
-
-  std::string sz; tmp_op_name(A.name(),"/","x", sz);
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) /= x;
-  return (*tmp);
+  DVec x(sz.c_str());
+  x = trans(A)|b;
+  return x;
 }
 
 
-// 3b :  scalar / matrix
-template <typename T> inline 
-Mat_COL<T>& operator/ (const T &x, const Mat_COL<T> &A) 
-{ 
-  //
-  // create a matrix filled with scalar x; div_element(A)
-  //
-  std::string sz; tmp_op_name("x","/",A.name(), sz);
 
-  Mat_COL<T> *tmp=new Mat_COL<T>(A.num_rows(), A.num_cols(), x, OBJ_temp, sz.c_str());
-  tmp->div_element(A);
-  return (*tmp);
-}
+// 3a, 3b :  see VecExpr_Type.h
 
 
 //---------------------------------------------------------
@@ -3876,58 +3949,37 @@ Mat_COL<T>& operator/ (const T &x, const Mat_COL<T> &A)
 
 // 1a :  DMat * DMat
 inline 
-DMat& operator*(const DMat& A, const DMat& B)
+DMat operator*(const DMat& A, const DMat& B)
 {
   std::string sz; tmp_op_name(A.name(),"*",B.name(), sz);
-  DMat* C = new DMat(sz.c_str(), OBJ_temp);
-  umAxB (A, B, (*C));  // calls BLAS DGEMM
+  DMat C(sz.c_str());
+  umAxB (A, B, C);  // calls BLAS DGEMM
 
   if (A.get_mode() == OBJ_temp) { delete (&A);  }
   if (B.get_mode() == OBJ_temp) { delete (&B);  }
-  return (*C);
+  return C;
 }
 
 
 // 1b :  mat<T> * mat<T>
 template <typename T> inline 
-Mat_COL<T>& operator*(const Mat_COL<T> &A, const Mat_COL<T> &B)
+Mat_COL<T> operator*(const Mat_COL<T> &A, const Mat_COL<T> &B)
 {
   std::string sz; tmp_op_name(A.name(),"*",B.name(), sz);
 
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= B;
-  return (*tmp);
+  Mat_COL<T> X(A, OBJ_real, sz.c_str());
+  X *= B;
+  return X;
 }
 
 
-// 2 :  matrix * scalar
-template <typename T> inline 
-Mat_COL<T>& operator*(const Mat_COL<T> &A, const T &x)
-{
-  std::string sz; tmp_op_name(A.name(),"*","x", sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= x;
-  return (*tmp);
-}
-
-
-// 3 :  scalar * matrix
-template <typename T> inline 
-Mat_COL<T>& operator*(const T &x, const Mat_COL<T> &A) 
-{
-  std::string sz; tmp_op_name("x","*",A.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= x;
-  return (*tmp);
-}
+// 2, 3 :  see VecExpr_Type.h
 
 
 // 4a:  matrix * vector : C = A  * v  ... if (rows,cols) match, 
 // 4b:  matrix * vector : C = A .* v  ... else if size() match.
 template <typename T> inline
-Vector<T>& operator* (const Mat_COL<T> &A, const Vector<T> &V) 
+Vector<T> operator* (const Mat_COL<T> &A, const Vector<T> &V) 
 {
   int M=A.num_rows(), K=A.num_cols(), N=V.size();
 
@@ -3937,14 +3989,14 @@ Vector<T>& operator* (const Mat_COL<T> &A, const Vector<T> &V)
   } 
   else if ( M*K == N ) 
   {
-    return ((const Vector<T> &)A) * V;  // Matlab A .* v
-  //return (Vector<T>&) (A.dm(V)); // Matlab A .* v
+    Vector<T> X("A.*v");
+    X = ((const Vector<T> &)A) * V;     // Matlab A .* v
+    return X;
   }
   else
   { 
     umERROR("matrix * vector", "incompatible dimensions"); 
-    Vector<T>* dum = new Vector<T>(1);
-    return (*dum);
+    return Vector<T>(1);
   }
 }
 
@@ -3952,7 +4004,7 @@ Vector<T>& operator* (const Mat_COL<T> &A, const Vector<T> &V)
 // 5a:  vector * matrix : c = v  * A  ... if (rows,cols) match, 
 // 5b:  vector * matrix : c = v .* A  ... else if size() match.
 template <typename T> inline
-Vector<T>& operator* (const Vector<T> &V, const Mat_COL<T> &A) 
+Vector<T> operator* (const Vector<T> &V, const Mat_COL<T> &A) 
 { 
   int M=A.num_rows(), K=A.num_cols(), N=V.size();
 
@@ -3962,14 +4014,14 @@ Vector<T>& operator* (const Vector<T> &V, const Mat_COL<T> &A)
   } 
   else if ( N == M*K ) 
   {
-    return (V * ((const Vector<T> &)A));  // Matlab v .* A
-  //return (Vector<T>&)  (A.dm(V));  // Matlab v .* A
+    Vector<T> X("v.*A");
+    X = (V * ((const Vector<T> &)A));   // Matlab v .* A
+    return X;
   }
   else
   { 
     umERROR("vector * matrix", "incompatible dimensions"); 
-    Vector<T>* dum = new Vector<T>(1);
-    return (*dum);
+    return Vector<T>(1);
   }
 }
 
@@ -4026,19 +4078,6 @@ Mat_COL<T>& outer(const Vector<T> &A, const Vector<T> &B)
 }
 
 
-// negation (unary operator)
-template <typename T> inline 
-Mat_COL<T>& operator- (const Mat_COL<T> &A) 
-{
-  std::string sz; tmp_op_name(" ","-",A.name(), sz);
-
-  Mat_COL<T> *tmp=new Mat_COL<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= T(-1);
-  return (*tmp);
-}
-
-
-
 ///////////////////////////////////////////////////////////
 //
 // Matlab "element-wise" operations:  C = A .* B
@@ -4316,44 +4355,44 @@ void matmult
 // matrix-vector product: BLAS 2
 //---------------------------------------------------------
 inline  // specialization for <T>=<double>
-DVec& matmult(const DMat &A, const DVec &V)
+DVec matmult(const DMat &A, const DVec &V)
 //---------------------------------------------------------
 {
   // Returns "col" vector: x = A*v
 
   int rows=A.num_rows(), cols=A.num_cols();
   if (V.size() != cols) { umERROR("Mat*Vec", "wrong dimensions"); }
-  DVec* X = new DVec(rows, 0.0, OBJ_temp, "A*v");
+  DVec X(rows, "A*v");
   double alpha=1.0, beta=0.0; int inc = 1;
   
   GEMV ('N', rows, cols, alpha, 
-        A.data(),  rows, 
+        A.data(),  A.ld(), 
         V.data(),  inc, beta, 
-        X->data(), inc);
+        X.data(),  inc);
 
   // delete temporary objects
   if (A.get_mode() == OBJ_temp) { delete (&A); }
   if (V.get_mode() == OBJ_temp) { delete (&V); }
 
-  return (*X);
+  return X;
 }
 
 
 // matrix-vector product: general
 //---------------------------------------------------------
 template <typename T> inline 
-Vector<T>& matmult(const Mat_COL<T> &A, const Vector<T> &V)
+Vector<T> matmult(const Mat_COL<T> &A, const Vector<T> &V)
 //---------------------------------------------------------
 {
   // Returns "col" vector: x = A*v
 
   int rows=A.num_rows(), cols=A.num_cols(); T ZERO=T(0);
   if (V.size() != cols) { umERROR("Mat*Vec", "wrong dimensions"); }
-  Vector<T>* X = new Vector<T>(rows, ZERO, OBJ_temp, "A*v");
+  Vector<T> X(rows, ZERO, OBJ_real, "A*v");
 
   // Col major: X=Sum(v(j)*A(j)). X is 
   // a vector sum, updated by saxpy ops
-  double* px = X->d_m1();
+  double* px = X.d_m1();
   T sc = ZERO;
   for (int j=1; j<=cols; ++j) {
     sc = V(j);
@@ -4369,50 +4408,50 @@ Vector<T>& matmult(const Mat_COL<T> &A, const Vector<T> &V)
   if (A.get_mode() == OBJ_temp) { delete (&A); }
   if (V.get_mode() == OBJ_temp) { delete (&V); }
 
-  return (*X);
+  return X;
 }
 
 
 // vector-matrix product: BLAS 2
 //---------------------------------------------------------
 inline  // specialization for <T>=<double>
-DVec& matmult(const DVec &V, const DMat &A)
+DVec matmult(const DVec &V, const DMat &A)
 //---------------------------------------------------------
 {
   // Returns "row" vector: x =  v*A  =  A' * v
 
   int rows=A.num_rows(), cols=A.num_cols();
   if (V.size() != rows) { umERROR("umVec * umMat", "wrong dimensions"); }
-  DVec* X = new DVec(cols, 0.0, OBJ_temp, "v*A");
+  DVec X(cols, "v*A");
   double alpha=1.0, beta=0.0; int inc = 1;
 
   GEMV ('T', rows, cols, alpha, 
-        A.data(),  rows, 
+        A.data(),  A.ld(), 
         V.data(),  inc, beta, 
-        X->data(), inc);
+        X.data(),  inc);
 
   // delete temporary objects
   if (A.get_mode() == OBJ_temp) { delete (&A); }
   if (V.get_mode() == OBJ_temp) { delete (&V); }
 
-  return (*X);
+  return X;
 }
 
 
 // vector-matrix product: general
 //---------------------------------------------------------
 template <typename T> inline 
-Vector<T>& matmult (const Vector<T> &V, const Mat_COL<T> &A)
+Vector<T> matmult (const Vector<T> &V, const Mat_COL<T> &A)
 //---------------------------------------------------------
 {
   // Returns "row" vector: x =  v*A  =  A' * v
 
   int rows=A.num_rows(), cols=A.num_cols(); T ZERO = T(0);
   if (V.size() != rows) { umERROR("umVec * umMat", "wrong dimensions"); }
-  Vector<T>* X = new Vector<T>(cols, ZERO, OBJ_temp, "v*A");
+  Vector<T> X(cols, ZERO, OBJ_real, "v*A");
 
   // Col major: X(i) = dot product
-  T* px = X->d_m1();
+  T* px = X.d_m1();
   for (int j=1; j<=cols; ++j) {
     const T* Aj = A[j]+1; // shift to 0-based data
     px[j] = V.inner(rows, Aj); 
@@ -4422,7 +4461,7 @@ Vector<T>& matmult (const Vector<T> &V, const Mat_COL<T> &A)
   if (A.get_mode() == OBJ_temp) { delete (&A); }
   if (V.get_mode() == OBJ_temp) { delete (&V); }
 
-  return (*X);
+  return X;
 }
 
 
@@ -4560,7 +4599,7 @@ Vector<T>& Mat_COL<T>::get_map(const IVec& map, int j) const
 {
   // Return a vector of values mapped from column j
 
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "vmap(%s,%d)", this->name(),j);
   CheckIdx_Col_1(j);
   int idx=0, len=map.size();
@@ -4585,7 +4624,7 @@ Vector<T>& Mat_COL<T>::get_map(int i, const IVec& map) const
 {
   // Return a vector of values mapped from row i
 
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "vmap(%d,%s)", i,this->name());
   CheckIdx_Row_1(i);
   int idx=0, len=map.size();
@@ -4756,7 +4795,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const Region2D< Mat_COL<T> > &R, OBJ_mode md, const char *sz)
 //---------------------------------------------------------
 : Vector<T>(sz, md),
-  m_M(0), m_N(0), m_MN(0), col_(0), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0), 
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   (*this)=R;  // matrix = region
@@ -4767,7 +4806,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const const_Region2D< Mat_COL<T> > &R, OBJ_mode md, const char *sz)
 //---------------------------------------------------------
 : Vector<T>(sz, md),
-  m_M(0), m_N(0), m_MN(0), col_(0), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0), 
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   (*this)=R;  // matrix = region
@@ -5191,7 +5230,7 @@ Vector<T>& dm(const Region1D< Vector<T> > &A,
 
 // 6c:  matrix * Region1D
 template <typename T> inline 
-Vector<T>& operator*(const Mat_COL<T> &A, const Region1D< Vector<T> > &R)
+Vector<T> operator*(const Mat_COL<T> &A, const Region1D< Vector<T> > &R)
 {
   int M=A.num_rows(), K=A.num_cols(), N=R.size();
   assert(K==N);
@@ -5202,8 +5241,8 @@ Vector<T>& operator*(const Mat_COL<T> &A, const Region1D< Vector<T> > &R)
 
 // 6d:  matrix * MappedRegion1D
 template <typename T> inline 
-Vector<T>& operator*(const Mat_COL<T> &A, 
-                     const MappedRegion1D< Vector<T> > &R)
+Vector<T> operator*(const Mat_COL<T> &A, 
+                    const MappedRegion1D< Vector<T> > &R)
 {
   int M=A.num_rows(), K=A.num_cols(), N=R.size();
   assert(K==N);
@@ -5313,7 +5352,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const MappedRegion2D< Mat_COL<T> > &R, OBJ_mode md, const char *sz)
 //---------------------------------------------------------
 : Vector<T>(sz, md),
-  m_M(0), m_N(0), m_MN(0), col_(0), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0), 
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   (*this)=R;  // matrix = mapped region
@@ -5324,7 +5363,7 @@ template <typename T> inline
 Mat_COL<T>::Mat_COL(const const_MappedRegion2D< Mat_COL<T> > &R, OBJ_mode md, const char *sz)
 //---------------------------------------------------------
 : Vector<T>(sz, md),
-  m_M(0), m_N(0), m_MN(0), col_(0), 
+  m_M(0), m_N(0), m_MN(0), m_ld(0), col_(0), 
   m_fact_mode(FACT_NONE), m_ipiv(NULL)
 {
   (*this)=R;  // matrix = mapped region
@@ -5674,7 +5713,7 @@ Mat_COL<T>& Mat_COL<T>::dm(const MappedRegion2D< Mat_COL<T> > &R) const
 
   std::string sz; tmp_op_name(this->name(), ".*", "R(map)", sz);
   // NOT USING COPY CONSTRUCTOR: side-effects if (*this)==OBJ_temp
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->data(), OBJ_temp, sz.c_str());
+  Mat_COL<T> *tmp=new_temp(this->data(), this->ZERO, sz.c_str());
 
   for (int j=1; j<=m_N; ++j) {
     for (int i=1; i<=m_M; ++i) {
@@ -5700,7 +5739,7 @@ Mat_COL<T>& Mat_COL<T>::dd(const MappedRegion2D< Mat_COL<T> > &R) const
 
   std::string sz; tmp_op_name(this->name(), "./", "R(map)", sz);
   // NOT USING COPY CONSTRUCTOR: side-effects if (*this)==OBJ_temp
-  Mat_COL<T> *tmp=new Mat_COL<T>(m_M, m_N, this->data(), OBJ_temp, sz.c_str());
+  Mat_COL<T> *tmp=new_temp(this->data(), this->ZERO, sz.c_str());
 
   for (int j=1; j<=m_N; ++j) {
     for (int i=1; i<=m_M; ++i) {
@@ -6272,4 +6311,99 @@ Mat_COL<T>& max
 }
 
 
+//---------------------------------------------------------
+// element-wise expressions (see VecExpr_Type.h)
+//---------------------------------------------------------
+
+template <typename T> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,VecExprLeaf<T,1>,umOpDiv> >
+Mat_COL<T>::dd(const Mat_COL<T>& B) const
+{ return umExprBinary< T, Mat_COL<T>, Mat_COL<T>, umOpDiv >::apply(*this, B); }
+
+template <typename T> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,VecExprLeaf<T,1>,umOpMul> >
+Mat_COL<T>::dm(const Mat_COL<T>& B) const
+{ return umExprBinary< T, Mat_COL<T>, Mat_COL<T>, umOpMul >::apply(*this, B); }
+
+template <typename T> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,VecExprLeaf<T,0>,umOpMul> >
+Mat_COL<T>::dm(const Vector<T>& V) const
+{ return umExprBinary< T, Mat_COL<T>, Vector<T>, umOpMul >::apply(*this, V); }
+
+template <typename T> template <class E> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,E,umOpDiv> >
+Mat_COL<T>::dd(const VecExpr<T,E>& B) const
+{ return umExprBinary< T, Mat_COL<T>, VecExpr<T,E>, umOpDiv >::apply(*this, B); }
+
+template <typename T> template <class E> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,1>,E,umOpMul> >
+Mat_COL<T>::dm(const VecExpr<T,E>& B) const
+{ return umExprBinary< T, Mat_COL<T>, VecExpr<T,E>, umOpMul >::apply(*this, B); }
+
+
+//---------------------------------------------------------
+template <typename T> template <class E> inline
+Mat_COL<T>& Mat_COL<T>::operator=(const VecExpr<T,E>& X)
+//---------------------------------------------------------
+{
+  // A matrix expression gives its shape to (*this); for
+  // a vector expression, keep the current shape if the
+  // length matches, as operator=(const Vector<T>&).
+  int N = X.size(), M = X.num_rows(), Nc = X.num_cols();
+  bool bPad = (X.ld() != M);
+  if (!VecExpr<T,E>::MAT) { 
+    if (N == this->m_Len && !this->is_padded()) { M = m_M; Nc = m_N; }
+    else { M = N; Nc = 1; }
+  }
+
+  if (M != m_M || Nc != m_N || bPad != this->is_padded()) {
+    // resize destroys the data: if (*this) appears in X,
+    // evaluate into a new array first
+    if (X.reads(this->v_, this->m_Len)) { 
+      return operator=(X.eval()); 
+    }
+    if (bPad) { this->resize_padded(M, Nc, false); }
+    else      { this->resize       (M, Nc, false); }
+  }
+  m_fact_mode = FACT_NONE;
+
+  T* p = this->v_;
+  for (int i=0; i<N; ++i) { p[i] = X[i]; }
+  X.release();    // delete any OBJ_temp operands
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> template <class E> inline
+Mat_COL<T>& Mat_COL<T>::operator+=(const VecExpr<T,E>& X)
+//---------------------------------------------------------
+{
+  Vector<T>::operator+=(X);
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> template <class E> inline
+Mat_COL<T>& Mat_COL<T>::operator-=(const VecExpr<T,E>& X)
+//---------------------------------------------------------
+{
+  Vector<T>::operator-=(X);
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+// fused trace gathers (vmapM/vmapP)
+//---------------------------------------------------------
+#include "Gather_funcs.h"
+
+
+//---------------------------------------------------------
+// non-owning strided views (columns, rows, blocks)
+//---------------------------------------------------------
+#include "View2D.h"
+
+
 #endif  // NDG__Matrix_COL_H__INCLUDED
@@ -1003,7 +1003,7 @@ void Mat_DIAG<T>::print
 ) const
 //---------------------------------------------------------
 {
-  static char buf[20] = {""};
+  static umTHREAD_LOCAL char buf[20] = {""};
   sprintf(buf, "%c%d.%d%s ", '%',wdth, prec,fmt);
 
   int M = this->num_rows();
@@ -1099,7 +1099,7 @@ void Mat_DIAG<T>::print_STREAM
 
 inline DMat_Diag& inv (const DMat_Diag& A)
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "inv(%s)", A.name()); 
 
   DMat_Diag *tmp=new DMat_Diag(A, OBJ_temp, buf);
@@ -1111,7 +1111,7 @@ inline DMat_Diag& inv (const DMat_Diag& A)
 template <typename T>
 inline Mat_DIAG<T>& trans(const Mat_DIAG<T>& A)
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "tr(%s)", A.name()); 
 
   DMat_Diag *tmp=new DMat_Diag(A, OBJ_temp, buf);
@@ -1123,7 +1123,7 @@ inline Mat_DIAG<T>& trans(const Mat_DIAG<T>& A)
 template <typename T>
 inline Mat_DIAG<T>& abs (const Mat_DIAG<T>& A)
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "abs(%s)", A.name()); 
 
   DMat_Diag *tmp=new DMat_Diag(A, OBJ_temp, buf);
@@ -1134,7 +1134,7 @@ inline Mat_DIAG<T>& abs (const Mat_DIAG<T>& A)
 
 inline DMat_Diag& sqrt(const DMat_Diag& A)
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "sqrt(%s)", A.name()); 
 
   DMat_Diag *tmp=new DMat_Diag(A, OBJ_temp, buf);
@@ -1146,7 +1146,7 @@ inline DMat_Diag& sqrt(const DMat_Diag& A)
 template <typename T>
 inline Mat_DIAG<T>& sqr(const Mat_DIAG<T>& A)
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "(%s)^2", A.name()); 
 
   DMat_Diag *tmp=new DMat_Diag(A, OBJ_temp, buf);
@@ -1157,7 +1157,7 @@ inline Mat_DIAG<T>& sqr(const Mat_DIAG<T>& A)
 
 inline DMat_Diag& exp(const DMat_Diag& A)
 {
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "exp(%s)", A.name()); 
 
   DMat_Diag *tmp=new DMat_Diag(A, OBJ_temp, buf);
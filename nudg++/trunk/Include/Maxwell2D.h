@@ -6,6 +6,9 @@
 #define NDG__Maxwell2D_H__INCLUDED
 
 #include "NDG2D.h"
+#include "Precision.h"
+
+class Maxwell2D_Pbase;
 
 
 //---------------------------------------------------------
@@ -21,6 +24,8 @@ protected:
 
   virtual void Run();
   virtual void RHS();
+  virtual void RHS_fused();
+  void InitFusedRHS();
 
   virtual void Resize();
   virtual void SetIC();
@@ -41,7 +46,7 @@ protected:
   DMat   dHx,   dHy,   dEz;
   DMat rhsHx, rhsHy, rhsEz;
   DMat resHx, resHy, resEz;
-  DMat ndotdH, fluxHx, fluxHy, fluxEz;
+  DMat fluxHx, fluxHy, fluxEz;
   // local derivatives of fields
   DMat Ezx, Ezy, CuHz;
 
@@ -49,6 +54,22 @@ protected:
 
   // stepsize calculation
   DVec rLGL, w;
+
+  // array allocations/copies/moves inside RHS()
+  umArrayStats  stats_rhs;
+  int           Ncalls_rhs;
+
+  // precision of time stepping (NDG_PRECISION): single 
+  // and mixed use a float stepper (see Maxwell2D_P.h)
+  umPrecision       m_precision;
+  Maxwell2D_Pbase*  m_pPrec;
+
+  // element-local RHS (NDG_RHS=fused): face node boundary
+  // flags, elements per tile, and tile scratch
+  bool  m_bFusedRHS;
+  IVec  m_bdry;
+  int   m_tileK;
+  DVec  m_tile;
 };
 
 #endif  // NDG__Maxwell2D_H__INCLUDED
@@ -0,0 +1,176 @@
+// Maxwell2D_P.h
+// Maxwell2D (TM) time stepping in single/mixed precision
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__Maxwell2D_P_H__INCLUDED
+#define NDG__Maxwell2D_P_H__INCLUDED
+
+#include "Globals2D_P.h"
+#include "Maxwell2D_fused.h"
+
+//---------------------------------------------------------
+// Maxwell2D_P<TS,TA> advances (Hx,Hy,Ez) with the same
+// upwind flux and 5-stage LSERK scheme as Maxwell2D, but
+// holds fields, metric and face data in TS, and forms the
+// derivative and LIFT products in TA (see Precision.h).
+// The small operators Dr, Ds and LIFT stay in cache, so
+// they are held in TA.  The RHS is the fused kernel of
+// Maxwell2D::RHS_fused (Maxwell2D_fused.h).
+//
+// Only this explicit Maxwell2D path is templated on
+// precision.  Mesh setup, Globals2D, Globals3D, the array
+// operators and the Euler, INS and CNS solvers stay in
+// double (see Precision.h).  A solver derived from
+// Maxwell2D with its own RHS (MaxwellCurved2D) steps in
+// double.
+//
+// Maxwell2D selects a stepper with NDG_PRECISION:
+//
+//   Maxwell2D_Pbase* p = NewMaxwell2D_P(umPREC_MIXED, *this);
+//   p->SetFields(Hx,Hy,Ez);
+//   p->Step(dt);  p->GetFields(Hx,Hy,Ez);
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+class Maxwell2D_Pbase
+//---------------------------------------------------------
+{
+public:
+  virtual ~Maxwell2D_Pbase() {}
+
+  virtual void SetFields(const DMat& Hx, const DMat& Hy, const DMat& Ez) = 0;
+  virtual void GetFields(DMat& Hx, DMat& Hy, DMat& Ez) const = 0;
+  virtual void RHS() = 0;
+  virtual void Step(double dt) = 0;
+  virtual umPrecision precision() const = 0;
+};
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA>
+class Maxwell2D_P : public Maxwell2D_Pbase
+//---------------------------------------------------------
+{
+public:
+  explicit Maxwell2D_P(const Globals2D& G);
+
+  virtual void SetFields(const DMat& Hx, const DMat& Hy, const DMat& Ez);
+  virtual void GetFields(DMat& Hx, DMat& Hy, DMat& Ez) const;
+  virtual void RHS();
+  virtual void Step(double dt);
+  virtual umPrecision precision() const {
+    return (sizeof(TS)==sizeof(double)) ? umPREC_DOUBLE :
+           ((sizeof(TA)==sizeof(double)) ? umPREC_MIXED : umPREC_SINGLE);
+  }
+
+  const Vector<TS>& get_Ez() const { return Ez; }
+
+protected:
+  Globals2D_P<TS> P;
+  IVec        bdry;                 // 1 at boundary face nodes (mapB)
+  Vector<TS>  Hx, Hy, Ez;           // fields
+  Vector<TS>  rhsHx, rhsHy, rhsEz;  // right hand sides
+  Vector<TS>  resHx, resHy, resEz;  // Runge-Kutta residuals
+  Vector<TA>  Dr, Ds, LIFT;         // operators, in TA
+  umMaxwell2D_Data<TS,TA> kd;       // arguments of the fused kernel
+  int         tileK;                // elements per tile
+  Vector<TA>  work;                 // tile scratch
+  double      rk4a[5], rk4b[5];
+};
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA> inline
+Maxwell2D_P<TS,TA>::Maxwell2D_P(const Globals2D& G)
+//---------------------------------------------------------
+: bdry("bdry"), Hx("Hx_p"), Hy("Hy_p"), Ez("Ez_p"),
+  rhsHx("rhsHx_p"), rhsHy("rhsHy_p"), rhsEz("rhsEz_p"),
+  resHx("resHx_p"), resHy("resHy_p"), resEz("resEz_p"),
+  Dr("Dr_a"), Ds("Ds_a"), LIFT("LIFT_a"), work("work_p")
+{
+  P.load(G);
+  int Npk = P.Np*P.K;
+
+  umMaxwell2D_Bdry(G, bdry);
+  Hx.resize(Npk);     Hy.resize(Npk);     Ez.resize(Npk);
+  rhsHx.resize(Npk);  rhsHy.resize(Npk);  rhsEz.resize(Npk);
+  resHx.resize(Npk);  resHy.resize(Npk);  resEz.resize(Npk);
+  to_prec(G.Dr, Dr);  to_prec(G.Ds, Ds);  to_prec(G.LIFT, LIFT);
+  work.resize(umMaxwell2D_Tile(P.Np, P.Nfq, P.K, tileK));
+
+  // nodal metric and face data of P (no compressed faces)
+  kd.load(G, bdry);
+  kd.Dr = Dr.data();    kd.Ds = Ds.data();    kd.LIFT = LIFT.data();
+  kd.rx = P.rx.data();  kd.ry = P.ry.data();  kd.sx = P.sx.data();  kd.sy = P.sy.data();
+  kd.nx = P.nx.data();  kd.ny = P.ny.data();  kd.Fscale = P.Fscale.data();
+
+  for (int i=0; i<5; ++i) { rk4a[i] = G.rk4a[i];  rk4b[i] = G.rk4b[i]; }
+}
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA> inline
+void Maxwell2D_P<TS,TA>::SetFields(const DMat& hx, const DMat& hy, const DMat& ez)
+//---------------------------------------------------------
+{
+  to_prec(hx, Hx);  to_prec(hy, Hy);  to_prec(ez, Ez);
+  resHx.fill(TS(0));  resHy.fill(TS(0));  resEz.fill(TS(0));
+}
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA> inline
+void Maxwell2D_P<TS,TA>::GetFields(DMat& hx, DMat& hy, DMat& ez) const
+//---------------------------------------------------------
+{
+  // fields keep their shape (Np,K)
+  assert(hx.size()==Hx.size() && hy.size()==Hy.size() && ez.size()==Ez.size());
+  umPrecCopy(Hx.size(), Hx.data(), hx.data());
+  umPrecCopy(Hy.size(), Hy.data(), hy.data());
+  umPrecCopy(Ez.size(), Ez.data(), ez.data());
+}
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA> inline
+void Maxwell2D_P<TS,TA>::RHS()
+//---------------------------------------------------------
+{
+  // upwind fluxes (alpha = 1), as Maxwell2D::RHS
+  umMaxwell2D_FusedRHS(kd, 1.0, Hx.data(), Hy.data(), Ez.data(),
+                       rhsHx.data(), rhsHy.data(), rhsEz.data(), tileK, work.data());
+}
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA> inline
+void Maxwell2D_P<TS,TA>::Step(double dt)
+//---------------------------------------------------------
+{
+  // one step of low storage Runge-Kutta (see Maxwell2D::Run)
+  const int Npk = Hx.size();
+  TS *h[3] = {Hx.data(), Hy.data(), Ez.data()};
+  TS *r[3] = {resHx.data(), resHy.data(), resEz.data()};
+  const TS *f[3] = {rhsHx.data(), rhsHy.data(), rhsEz.data()};
+  const TA tdt = TA(dt);
+
+  for (int s=0; s<5; ++s) {
+    RHS();
+    const TA a=TA(rk4a[s]), b=TA(rk4b[s]);
+    for (int m=0; m<3; ++m) {
+      TS *hm=h[m], *rm=r[m];  const TS *fm=f[m];
+      for (int i=0; i<Npk; ++i) {
+        TA res = a*TA(rm[i]) + tdt*TA(fm[i]);
+        rm[i] = TS(res);
+        hm[i] = TS(TA(hm[i]) + b*res);
+      }
+    }
+  }
+}
+
+
+// Maxwell2D_P.cpp: umPREC_DOUBLE gives the <double,double> stepper
+Maxwell2D_Pbase* NewMaxwell2D_P(umPrecision prec, const Globals2D& G);
+
+#endif  // NDG__Maxwell2D_P_H__INCLUDED
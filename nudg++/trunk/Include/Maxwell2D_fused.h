@@ -0,0 +1,230 @@
+// Maxwell2D_fused.h
+// element-local Maxwell2D (TM) RHS kernel, templated on
+// storage and accumulation precision
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__Maxwell2D_fused_H__INCLUDED
+#define NDG__Maxwell2D_fused_H__INCLUDED
+
+#include "Globals2D.h"
+#include "Precision.h"
+#include "SmallMat_funcs.h"
+#include "MaxwellFlux_funcs.h"
+
+//---------------------------------------------------------
+// One pass over the mesh in tiles of elements: each tile
+// gathers its face traces, forms the upwind fluxes (with
+// the reflective wall of Maxwell2D::RHS, Ez+ = -Ez-),
+// applies Dr, Ds and LIFT, and writes the right hand sides
+// while its data is in cache.  Maxwell2D::RHS_fused and
+// the float steppers of Maxwell2D_P.h both call it:
+//
+//   <double,double>  operation by operation as RHS(), so
+//                    results are identical to it
+//   <float, TA>      fields, metric and face data in float,
+//                    fluxes and products accumulated in TA
+//
+// The products use the order-specialized kernels of
+// SmallMat_funcs.h for each pair of types, so float fields
+// are read as they are, without widening a copy.
+//
+// The kernel reads the nodal metric and face data, as
+// RHS() does.  With compressed face data (CompressFace2D,
+// double storage only) it reads one {nx,ny,Fscale} per
+// straight face instead, again as RHS() does.
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA>
+struct umMaxwell2D_Data
+//---------------------------------------------------------
+{
+  int Np, Nfp, Nfaces, K;
+  const int *vmapM, *vmapP;         // (Nfp*Nfaces,K), 1-based
+  const int *bdry;                  // 1 at boundary face nodes
+  const TA  *Dr, *Ds, *LIFT;        // operators (column-major)
+  const TS  *rx, *ry, *sx, *sy;     // metric,    (Np,K)
+  const TS  *nx, *ny, *Fscale;      // face data, (Nfp*Nfaces,K)
+  const Globals2D* pFace;           // compressed face data, or NULL
+
+  // maps and operators of G; caller sets the TS arrays
+  void load(const Globals2D& G, const IVec& bc) {
+    Np = G.Np;  Nfp = G.Nfp;  Nfaces = G.Nfaces;  K = G.K;
+    vmapM = G.vmapM.data();  vmapP = G.vmapP.data();  bdry = bc.data();
+    pFace = NULL;
+  }
+};
+
+
+//---------------------------------------------------------
+inline void umMaxwell2D_Bdry(const Globals2D& G, IVec& bdry)
+//---------------------------------------------------------
+{
+  // flag the boundary face nodes (mapB)
+  bdry.resize(G.Nfp*G.Nfaces*G.K, true, 0);
+  for (int i=1; i<=G.mapB.size(); ++i) { bdry(G.mapB(i)) = 1; }
+}
+
+
+//---------------------------------------------------------
+inline int umMaxwell2D_Tile(int Np, int Nfq, int K, int& tileK)
+//---------------------------------------------------------
+{
+  // per element: 9 products and 3 fluxes; tiles keep about
+  // 64 KB of double scratch in cache.  Returns the scratch
+  // length of one tile.
+  int per_elmt = 9*Np + 3*Nfq;
+  tileK = std::max(1, std::min(K, 8192/per_elmt));
+  return tileK*per_elmt;
+}
+
+
+//---------------------------------------------------------
+template <typename TA, typename TB> inline
+void umTile_AxB_loop(int M, int Kc, const TA* A, int nt,
+                     const TB* const* B, TA* const* C)
+//---------------------------------------------------------
+{
+  // no kernel for this shape: element by element, each
+  // column of A is loaded once for the three fields
+  for (int e=0; e<nt; ++e) {
+    TA* y[3] = { C[0]+e*M, C[1]+e*M, C[2]+e*M };
+    for (int v=0; v<3; ++v) { for (int i=0; i<M; ++i) { y[v][i] = TA(0); } }
+    for (int j=0; j<Kc; ++j) {
+      const TA* a = A + j*M;
+      for (int v=0; v<3; ++v) {
+        const TA xj = TA(B[v][e*Kc+j]);  TA* yv = y[v];
+        for (int i=0; i<M; ++i) { yv[i] += a[i]*xj; }
+      }
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+// C[v] = A*B[v], v=0:2, for nt element columns, with the
+// order-specialized kernel for the types of A and B if one
+// is registered (SmallMat_funcs.h)
+//---------------------------------------------------------
+inline void umTile_AxB(int M, int Kc, const double* A, int nt,
+                       const double* const* B, double* const* C)
+{
+  umSmallMat_fn fn = umSmallMat_find(M,Kc);
+  for (int v=0; v<3; ++v) {
+    if (fn) { fn(nt, 1.0,A, B[v],Kc, 0.0,C[v],M); }
+    else    { GEMM('N','N',M,nt,Kc, 1.0,A,M, B[v],Kc, 0.0,C[v],M); }
+  }
+}
+
+inline void umTile_AxB(int M, int Kc, const float* A, int nt,
+                       const float* const* B, float* const* C)
+{
+  umSmallMat_fnf fn = umSmallMat_find_f(M,Kc);
+  if (!fn) { umTile_AxB_loop(M,Kc,A,nt,B,C); return; }
+  for (int v=0; v<3; ++v) { fn(nt, 1.0f,A, B[v],Kc, 0.0f,C[v],M); }
+}
+
+inline void umTile_AxB(int M, int Kc, const double* A, int nt,
+                       const float* const* B, double* const* C)
+{
+  umSmallMat_fnm fn = umSmallMat_find_m(M,Kc);
+  if (!fn) { umTile_AxB_loop(M,Kc,A,nt,B,C); return; }
+  for (int v=0; v<3; ++v) { fn(nt, 1.0,A, B[v],Kc, 0.0,C[v],M); }
+}
+
+
+//---------------------------------------------------------
+inline bool umFaceGeo2D(const Globals2D* G, int fc, const double*& gnx,
+                        const double*& gny, const double*& gfs, int& inc)
+//---------------------------------------------------------
+{
+  // {nx,ny,Fscale} of face fc from compressed data
+  if (!G || !G->m_bAffineGeo) { return false; }
+  int fs = 0;  const double* g = G->face_geo(fc, fs, inc);
+  gnx = g;  gny = g+fs;  gfs = g+3*fs;
+  return true;
+}
+
+template <typename TS> inline
+bool umFaceGeo2D(const Globals2D*, int, const TS*&, const TS*&, const TS*&, int&) { return false; }
+
+
+//---------------------------------------------------------
+template <typename TS, typename TA>
+void umMaxwell2D_FusedRHS
+(
+  const umMaxwell2D_Data<TS,TA>& d,
+  double alpha,                     // 1: upwind, 0: central
+  const TS* hx, const TS* hy, const TS* ez,
+  TS* rHx, TS* rHy, TS* rEz,        // (Np,K)
+  int tileK, TA* w                  // see umMaxwell2D_Tile
+)
+//---------------------------------------------------------
+{
+  const int Np=d.Np, Nfp=d.Nfp, Nfq=d.Nfp*d.Nfaces, K=d.K, nt0=tileK;
+  const int *mM=d.vmapM, *mP=d.vmapP, *bc=d.bdry;
+  const TA a1 = TA(alpha), two = TA(2);
+
+  // scratch: derivatives and lifts (Np,nt), fluxes (Nfq,nt)
+  TA *wn = w;
+  TA *Ezr=wn; wn+=Np*nt0;  TA *Ezs=wn; wn+=Np*nt0;
+  TA *Hxr=wn; wn+=Np*nt0;  TA *Hxs=wn; wn+=Np*nt0;
+  TA *Hyr=wn; wn+=Np*nt0;  TA *Hys=wn; wn+=Np*nt0;
+  TA *LHx=wn; wn+=Np*nt0;  TA *LHy=wn; wn+=Np*nt0;
+  TA *LEz=wn; wn+=Np*nt0;
+  TA *fHx=wn; wn+=Nfq*nt0; TA *fHy=wn; wn+=Nfq*nt0;
+  TA *fEz=wn;
+
+  for (int k0=0; k0<K; k0+=nt0) {
+    const int nt = std::min(nt0, K-k0);
+    const int o=k0*Np, of=k0*Nfq;
+
+    //-------------------------------------
+    // traces and upwind fluxes, scaled by Fscale
+    //-------------------------------------
+    for (int fi=0; fi<nt*d.Nfaces; ++fi) {
+      const int n0=of+fi*Nfp;  int inc=1;
+      const TS *gnx=d.nx+n0, *gny=d.ny+n0, *gfs=d.Fscale+n0;
+      umFaceGeo2D(d.pFace, n0/Nfp + 1, gnx, gny, gfs, inc);
+      for (int j=0; j<Nfp; ++j) {
+        const int i=fi*Nfp+j, n=n0+j, a=mM[n]-1, b=mP[n]-1;
+        TA dHx, dHy, dEz;
+        if (bc[n]) {
+          // reflective boundary: Ez+ = -Ez-
+          dHx = TA(0);  dHy = TA(0);  dEz = two*TA(ez[a]);
+        } else {
+          dHx = TA(hx[a])-TA(hx[b]);  dHy = TA(hy[a])-TA(hy[b]);  dEz = TA(ez[a])-TA(ez[b]);
+        }
+        umMaxwell2D_Flux(TA(gnx[j*inc]), TA(gny[j*inc]), TA(gfs[j*inc]), a1,
+                         dHx, dHy, dEz, fHx[i], fHy[i], fEz[i]);
+      }
+    }
+
+    //-------------------------------------
+    // local derivatives and lifts of the tile
+    //-------------------------------------
+    const TS *u[3] = { ez+o, hx+o, hy+o };
+    const TA *f[3] = { fHx, fHy, fEz };
+    TA *ur[3] = {Ezr,Hxr,Hyr}, *us[3] = {Ezs,Hxs,Hys}, *fl[3] = {LHx,LHy,LEz};
+    umTile_AxB(Np,Np,  d.Dr,   nt, u, ur);
+    umTile_AxB(Np,Np,  d.Ds,   nt, u, us);
+    umTile_AxB(Np,Nfq, d.LIFT, nt, f, fl);
+
+    //-------------------------------------
+    // right hand sides
+    //-------------------------------------
+    for (int i=0; i<nt*Np; ++i) {
+      const int n=o+i;
+      const TA rxn=TA(d.rx[n]), ryn=TA(d.ry[n]), sxn=TA(d.sx[n]), syn=TA(d.sy[n]);
+      const TA Ezx  = rxn*Ezr[i] + sxn*Ezs[i];
+      const TA Ezy  = ryn*Ezr[i] + syn*Ezs[i];
+      const TA CuHz = rxn*Hyr[i] + sxn*Hys[i] - ryn*Hxr[i] - syn*Hxs[i];
+      rHx[n] = TS(-Ezy  + LHx[i]/two);
+      rHy[n] = TS( Ezx  + LHy[i]/two);
+      rEz[n] = TS( CuHz + LEz[i]/two);
+    }
+  }
+}
+
+#endif  // NDG__Maxwell2D_fused_H__INCLUDED
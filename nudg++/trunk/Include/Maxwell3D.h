@@ -21,6 +21,8 @@ protected:
 
   virtual void Run();
   virtual void RHS();
+  virtual void RHS_fused();
+  void InitFusedRHS();
 
   virtual void Resize();
   virtual void SetIC();
@@ -45,7 +47,6 @@ protected:
 
   // local spatial derivatives
   DMat curlHx, curlHy, curlHz, curlEx, curlEy, curlEz;
-  DMat ndotdH, ndotdE;
 
   DMat Ezinit;    // store initial conditions
   DMat EzAnal;    // analytic solution
@@ -56,6 +57,18 @@ protected:
 
   DVec sampleEz;      // Ez(t) at sample point 
   DVec sampleT;       // time for each Ez(t)
+
+  // element-local, threaded RHS (NDG_RHS=fused): face node
+  // boundary flags, stacked [Dr;Ds;Dt], per-thread tiles of
+  // derivatives, fluxes and lifts (aligned columns), and
+  // work per call for the GFLOP/s, GB/s report
+  bool   m_bFusedRHS;
+  IVec   m_bdry;
+  DMat   Drst;
+  int    m_tileK, m_nthreads;
+  DMat   m_tileD, m_tileF, m_tileL;
+  double m_flopsRHS, m_bytesRHS, time_fused;
+  int    Ncalls_fused;
 };
 
 #endif  // NDG__Maxwell_333D_H__INCLUDED
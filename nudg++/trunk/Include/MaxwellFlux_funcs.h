@@ -0,0 +1,62 @@
+// MaxwellFlux_funcs.h
+// pointwise upwind fluxes for the Maxwell equations
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__MaxwellFlux_funcs_H__INCLUDED
+#define NDG__MaxwellFlux_funcs_H__INCLUDED
+
+//---------------------------------------------------------
+// The flux at one face node, from the normal n, the field
+// jumps dH, dE and the face scaling fs, for upwinding
+// alpha (1: upwind, 0: central).  Every Maxwell RHS calls
+// these: the whole-array RHS() of Maxwell2D and Maxwell3D
+// (nodal or compressed face data), the fused kernels of
+// Maxwell2D_fused.h and Maxwell3D_RHS_fused.cpp, and the
+// float steppers of Maxwell2D_P.h.  The operations are those
+// of the MATLAB codes (MaxwellRHS2D, MaxwellRHS3D), in the
+// same order, so every path gives the same fluxes.
+//
+//   2D (TM):  dH = H(vmapM)-H(vmapP),  flux scaled by fs
+//   3D:       dH = H(vmapP)-H(vmapM),  flux scaled by fs/2
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+template <typename T> inline
+void umMaxwell2D_Flux
+(
+  T nx, T ny, T fs, T alpha,
+  T dHx, T dHy, T dEz,
+  T& fHx, T& fHy, T& fEz
+)
+//---------------------------------------------------------
+{
+  const T ndotdH = nx*dHx + ny*dHy;
+  fHx = fs * ( ny*dEz + alpha*(ndotdH*nx - dHx));
+  fHy = fs * (-nx*dEz + alpha*(ndotdH*ny - dHy));
+  fEz = fs * (-nx*dHy + ny*dHx - alpha*dEz);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+void umMaxwell3D_Flux
+(
+  T nx, T ny, T nz, T fs, T alpha,
+  const T dH[3], const T dE[3],
+  T fH[3], T fE[3]
+)
+//---------------------------------------------------------
+{
+  const T ndotdH = nx*dH[0] + ny*dH[1] + nz*dH[2];
+  const T ndotdE = nx*dE[0] + ny*dE[1] + nz*dE[2];
+  const T two = T(2);
+  fH[0] = fs*(-ny*dE[2] + nz*dE[1] + alpha*(dH[0] - ndotdH*nx)) / two;
+  fH[1] = fs*(-nz*dE[0] + nx*dE[2] + alpha*(dH[1] - ndotdH*ny)) / two;
+  fH[2] = fs*(-nx*dE[1] + ny*dE[0] + alpha*(dH[2] - ndotdH*nz)) / two;
+  fE[0] = fs*( ny*dH[2] - nz*dH[1] + alpha*(dE[0] - ndotdE*nx)) / two;
+  fE[1] = fs*( nz*dH[0] - nx*dH[2] + alpha*(dE[1] - ndotdE*ny)) / two;
+  fE[2] = fs*( nx*dH[1] - ny*dH[0] + alpha*(dE[2] - ndotdE*nz)) / two;
+}
+
+#endif  // NDG__MaxwellFlux_funcs_H__INCLUDED
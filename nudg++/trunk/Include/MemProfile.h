@@ -0,0 +1,121 @@
+// MemProfile.h
+// per-name, per-phase accounting of array memory
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__MemProfile_H__INCLUDED
+#define NDG__MemProfile_H__INCLUDED
+
+#include <cstdio>
+
+//---------------------------------------------------------
+// Every registry allocation made by a Vector (or Mat_COL)
+// is charged to the array's name, and to the solver phase
+// that is current when the allocation is made.  For each
+// name the profiler keeps:
+//
+//   allocs      registry and frame allocations
+//   temps       allocations made by OBJ_temp objects
+//   alloc_bytes bytes allocated (registry and frame)
+//   live_bytes  bytes currently held (registry only)
+//   peak_bytes  high-water mark of live_bytes
+//   at_peak     live_bytes when the total peaked
+//
+// and the same counters per phase (live_bytes of a phase
+// are the bytes allocated in that phase still held).
+// When an array takes over the data of a temporary, the
+// live bytes pass to the new owner's name; the counts of
+// allocations stay with the name that made them.
+//
+// Profiling is switched on at run time either by calling
+// umMemProfile::enable(true), or by setting NDG_MEMPROF=1
+// in the environment; until then each hook only tests
+// on().  Builds with -DTRACK_ARRAY_MEMORY=0 (see 
+// ArrayMacros.h) have no hooks: there enable(true) and
+// NDG_MEMPROF warn that profiling is not available, and
+// report() writes nothing.  NDG_MEMPROF_LIMIT=<MB> warns once,
+// naming the largest arrays, when live bytes pass <MB>.
+//
+// Solvers mark phases with a scoped guard:
+//
+//   void Maxwell2D::RHS() {
+//     umMemPhaseScope mp(umMEM_RHS);
+//     ...
+//   }
+//
+// and write the report from FinalReport():
+//
+//   umMemProfile::report(GetClassName());  // -> <name>_memory.csv
+//---------------------------------------------------------
+
+enum umMemPhase {
+  umMEM_SETUP = 0,  // mesh, operators, matrices
+  umMEM_STEP,       // time-step loop, outside the phases below
+  umMEM_RHS,        // evaluation of right-hand sides
+  umMEM_SOLVE,      // linear solves
+  umMEM_OUTPUT,     // rendering and file output
+  umMEM_NPHASE
+};
+
+
+//---------------------------------------------------------
+class umMemProfile
+//---------------------------------------------------------
+{
+public:
+
+  static bool on() { return s_on; }
+  static void enable(bool b);
+  static void reset();
+
+  static const char*  phase_name(umMemPhase p);
+  static umMemPhase   phase();
+  static umMemPhase   set_phase(umMemPhase p);  // returns previous phase
+
+  // hooks called by Vector<T> (see umMEM_ALLOC, etc. below)
+  static void add   (const void* p, long nbytes, const char* name, bool bTemp);
+  static void count (long nbytes, const char* name, bool bTemp);
+  static void remove(const void* p);
+  static void move  (const void* pold, const void* p, long nbytes);
+  static void owner (const void* p, const char* name);
+
+  // totals
+  static long live_bytes();
+  static long peak_bytes();
+
+  // write <tag>_memory.csv, and log a summary
+  static bool report(const char* tag);
+  static void write (FILE* fp, const char* tag);
+
+protected:
+  static bool s_on;
+};
+
+
+//---------------------------------------------------------
+class umMemPhaseScope
+//---------------------------------------------------------
+{
+  // set phase for the life of this object
+public:
+  explicit umMemPhaseScope(umMemPhase p) : m_prev(umMemProfile::set_phase(p)) {}
+  ~umMemPhaseScope() { umMemProfile::set_phase(m_prev); }
+protected:
+  umMemPhase m_prev;
+};
+
+
+#if (TRACK_ARRAY_MEMORY)
+#define umMEM_ALLOC(p,nb,name,tmp) do { if (umMemProfile::on()) { umMemProfile::add((p),(nb),(name),(tmp)); } } while(0)
+#define umMEM_FRAME(nb,name,tmp)   do { if (umMemProfile::on()) { umMemProfile::count((nb),(name),(tmp)); } } while(0)
+#define umMEM_FREE(p)              do { if (umMemProfile::on()) { umMemProfile::remove(p); } } while(0)
+#define umMEM_MOVE(pold,p,nb)      do { if (umMemProfile::on()) { umMemProfile::move((pold),(p),(nb)); } } while(0)
+#define umMEM_OWNER(p,name)        do { if (umMemProfile::on()) { umMemProfile::owner((p),(name)); } } while(0)
+#else
+#define umMEM_ALLOC(p,nb,name,tmp)
+#define umMEM_FRAME(nb,name,tmp)
+#define umMEM_FREE(p)
+#define umMEM_MOVE(pold,p,nb)
+#define umMEM_OWNER(p,name)
+#endif
+
+#endif  // NDG__MemProfile_H__INCLUDED
@@ -10,6 +10,7 @@
 
 // sparse matrix
 #include "CS_Type.h"
+#include "BS_Type.h"
 
 // MatObj<FaceData> neighbors
 // #include "MatObj_Type.h"
@@ -49,6 +50,7 @@ protected:
   void    BuildMaps2D();
   void    BuildBCMaps2D();
   void    BuildPeriodicMaps2D(double xperiod, double yperiod);
+  void    BuildFaceList2D();
   void    MakeCylinder2D(const IMat& faces, double ra, double xo, double yo);
   void    CalcElemCentroids(DMat& centroid);
 
@@ -61,6 +63,8 @@ protected:
 
   void    GeometricFactors2D();
   void    GeometricFactors2D(Cub2D& cub); // high-order cubature
+  void    CompressGeo2D();                // per-element affine factors
+  void    CompressFace2D(const DMat& Fs); // per-face normals, sJ, Fscale
 
   void    dtscale2D(DVec& dtscale);
 
@@ -136,6 +140,20 @@ protected:
     CSd&      spOP,   // [out] sparse
     CSd&      spMM);  // [out] sparse
 
+  void CurvedPoissonIPDG2D(
+    Gauss2D&  gauss,  // [in]
+    Cub2D&    cub,    // [in]
+    BSd&      bsOP,   // [out] block sparse, tril(OP)
+    BSd&      bsMM);  // [out] block sparse
+
+  void CurvedPoissonIPDG2D(
+    Gauss2D&  gauss,  // [in]
+    Cub2D&    cub,    // [in]
+    CSd*      spOP,   // [out] sparse,       or NULL
+    CSd*      spMM,   // [out] sparse,       or NULL
+    BSd*      bsOP,   // [out] block sparse, or NULL
+    BSd*      bsMM);  // [out] block sparse, or NULL
+
   void CurvedPoissonIPDGbc2D(
     Gauss2D&  gauss,  // [in]
     CSd&      spOP);  // [out] sparse
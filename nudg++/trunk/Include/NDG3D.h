@@ -10,6 +10,7 @@
 
 // sparse matrix
 #include "CS_Type.h"
+#include "BS_Type.h"
 
 
 //---------------------------------------------------------
@@ -42,6 +43,7 @@ protected:
   void    Normals3D();
   void    BuildMaps3D();
   void    BuildBCMaps3D();
+  void    BuildFaceList3D();
 //void    MakeSphere3D(const IMat& faces, double ra, double xo, double yo, double zo);
   void    CalcElemCentroids(DMat& centroid);
 
@@ -53,6 +55,8 @@ protected:
 
   void    GeometricFactors3D();
   void    GeometricFactors3D(Cub3D& cub);   // high-order cubature
+  void    CompressGeo3D();                  // per-element affine factors
+  void    CompressFace3D(const DMat& Fs);   // per-face normals, sJ, Fscale
 
   double  dtscale3D() const;
 
@@ -94,6 +98,8 @@ protected:
 
 
   void    PoissonIPDG3D  (CSd& spOP, CSd& spMM);
+  void    PoissonIPDG3D  (BSd& bsOP, BSd& bsMM);
+  void    PoissonIPDG3D  (CSd* spOP, CSd* spMM, BSd* bsOP, BSd* bsMM);
   DMat&   PoissonIPDGbc3D(DVec& ubc);
 
   void Sample3D(double  xout,           // [in]
@@ -7,6 +7,20 @@
 
 
 #include <typeinfo>
+#include <cstdlib>
+#include <cstring>
+#include "ArrayMacros.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#if (USE_THREAD_REGISTRY)
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
 
 #ifdef _DEBUG
 #define SHOW_Reg_ALLOC    1
@@ -34,6 +48,24 @@ typedef enum {
 } umREG_size;
 
 
+//---------------------------------------------------------
+// Allocation policy shared by all registries.  Adjust
+// before creating any arrays, e.g. to disable huge pages:
+//
+//   umAllocPolicy::get().huge_bytes = 0;
+//---------------------------------------------------------
+typedef struct umAllocPolicy_ {
+  size_t align;       // byte alignment of every array (power of 2)
+  size_t huge_bytes;  // arrays this large use huge pages (0: never)
+  size_t huge_page;   // huge page size
+
+  static umAllocPolicy_& get() {
+    static umAllocPolicy_ s_policy = { NDG_ARRAY_ALIGN, NDG_HUGEPAGE_BYTES, 2<<20 };
+    return s_policy;
+  }
+} umAllocPolicy;
+
+
 //---------------------------------------------------------
 template <typename T> 
 class umRegistry
@@ -53,6 +85,20 @@ protected:
   int   m_iRegSize;
   bool  m_bFixedSize;
 
+#if (USE_THREAD_REGISTRY)
+  // Each thread allocates from its own registries (see
+  // umRegistrySet), and only the owning thread touches the
+  // slot tables, without locks.  Another thread releasing
+  // an array posts its slot to m_pending, a lock-free list
+  // (many producers, one consumer), and the owner reclaims
+  // the slot on its next allocation (drain).  Vector<T>
+  // moves an array to the caller's own registry to resize
+  // it (see Vector<T>::extend).
+  struct Pending { Pending* next; int id; bool bRelease; };
+  std::atomic<std::thread::id>  m_owner;
+  std::atomic<Pending*>         m_pending;
+#endif
+
 public:
   umRegistry (
     int   N     = 200,    // initial number of slots
@@ -62,6 +108,10 @@ public:
   virtual ~umRegistry();
 
   int   size() const { return num_alloc; }
+  umREG_size reg_type() const { 
+    return (iReg_small==m_iRegSize) ? umREG_SMALL : 
+          ((iReg_med  ==m_iRegSize) ? umREG_MEDIUM : umREG_GENERAL); 
+  }
   std::string get_reg_name() const;
   void  release_all();  // release all allocations
   int   compact();      // release unused allocations
@@ -76,6 +126,19 @@ public:
   void  free_alloc  (T *& ptr, int user_id);  // mark as available
   void  free_alloc_2(T *& ptr, int user_id);  // free allocation
   void  show_alloc() const;
+
+  // is the calling thread the owner of this registry?
+  bool  is_owner() const;
+  void  set_owner();    // the calling thread takes ownership
+  void  clear_owner();  // no owner (its thread has exited)
+
+protected:
+  void  defer(int user_id, bool bRelease);  // post a release
+  void  drain();                            // reclaim posted slots
+
+  // aligned storage (see umAllocPolicy): release with free()
+  static T* new_block(size_t N, bool bZero);
+  static T* resize_block(T* p, size_t Nold, size_t N, size_t Nkeep);
 };
 
 
@@ -104,6 +167,10 @@ umRegistry<T>::umRegistry
 #endif
 
   assert(NULL==dbase);  // TODO: singleton object
+#if (USE_THREAD_REGISTRY)
+  m_owner.store(std::this_thread::get_id());
+  m_pending.store(NULL);
+#endif
   MAX_alloc = N;
   num_alloc = 0;
   dbase  = (T ** ) calloc((size_t)N, sizeof(T* ));   assert(dbase);
@@ -129,7 +196,7 @@ umRegistry<T>::umRegistry
 
     m_bFixedSize = true;
     for (int i=0; i<MAX_alloc; ++i) {
-      dbase [i] = (T*) calloc((size_t)Nlen, sizeof(T));   assert(dbase[i]);
+      dbase [i] = new_block((size_t)Nlen, true);   assert(dbase[i]);
       curlen[i] = 0;
       maxlen[i] = Nlen;
       inuse [i] = false;
@@ -156,6 +223,8 @@ umRegistry<T>::~umRegistry()
   }
 #endif
 
+  drain();
+
   // free all allocations
   int i=0;
   for (i=0; i<num_alloc; ++i) 
@@ -221,8 +290,8 @@ template <typename T>
 std::string umRegistry<T>::get_reg_name() const
 //---------------------------------------------------------
 {
-  static char buf[50] = {""}; 
-  static std::string sz1;          sz1 = "GENERAL";
+  static umTHREAD_LOCAL char buf[50] = {""}; 
+  std::string sz1 = "GENERAL";
   if      (iReg_small==m_iRegSize) sz1 = "SMALL  ";
   else if (iReg_med  ==m_iRegSize) sz1 = "MEDIUM ";
   sprintf(buf, "umRegistry<%s> %s", typeid(T).name(), sz1.c_str());
@@ -246,6 +315,8 @@ template <typename T>
 int umRegistry<T>::compact()
 //---------------------------------------------------------
 {
+  assert(is_owner());
+  drain();
   // release unused allocations
 
   if (m_bFixedSize) 
@@ -284,6 +355,7 @@ template <typename T>
 void umRegistry<T>::expand()
 //---------------------------------------------------------
 {
+  assert(is_owner());
   int Nold = MAX_alloc;
   
   // Select amount by which to expand this registry:
@@ -318,7 +390,7 @@ void umRegistry<T>::expand()
   {
     // pre-allocate each slot in fixed-size registries
     for (int i=Nold; i<N; ++i) {
-      dbase [i] = (T*) calloc((size_t)m_iRegSize, sizeof(T));
+      dbase [i] = new_block((size_t)m_iRegSize, true);
       curlen[i] = 0;          // current length of array in use
       maxlen[i] = m_iRegSize;  // actual length of allocation
       inuse [i] = false;
@@ -366,6 +438,11 @@ template <typename T>
 T* umRegistry<T>::get_alloc(int N, int& user_id)
 //---------------------------------------------------------
 {
+  assert(is_owner());
+#if (USE_THREAD_REGISTRY)
+  // reclaim slots released by other threads
+  if (m_pending.load(std::memory_order_relaxed)) { drain(); }
+#endif
 
 #if (CHECK_Reg_ALLOC)
   if (m_bFixedSize) {
@@ -409,7 +486,7 @@ T* umRegistry<T>::get_alloc(int N, int& user_id)
 
           if (MAXRLEN < maxlen[i]) {
             // reduce size of allocation [i]
-            dbase[i]  = (T*) realloc(dbase[i], MAXRLEN*sizeof(T));
+            dbase[i]  = resize_block(dbase[i], maxlen[i], MAXRLEN, 0);
             maxlen[i] = MAXRLEN;   // actual length of allocation
           }
         }
@@ -428,8 +505,8 @@ T* umRegistry<T>::get_alloc(int N, int& user_id)
         //RLEN = select_length(N);
           RLEN = N;  // NBN: 2006/12/25
         }
-        // expand this allocation with realloc()
-        dbase[i]  = (T*) realloc(dbase[i],  RLEN*sizeof(T));
+        // expand this allocation (old data not needed)
+        dbase[i]  = resize_block(dbase[i], maxlen[i], RLEN, 0);
         if (! dbase[i]) { 
           umERROR("umRegistry<T>::get_alloc", 
             "Failed to realloc block (%0.3lf million elements)", 
@@ -463,7 +540,7 @@ T* umRegistry<T>::get_alloc(int N, int& user_id)
       RLEN = N;  // NBN: 2006/12/25
     }
 
-    dbase [user_id] = (T*) calloc((size_t)RLEN, sizeof(T));
+    dbase [user_id] = new_block((size_t)RLEN, true);
     curlen[user_id] = N;      // current length of array in use
     maxlen[user_id] = RLEN;   // actual length of allocation
     inuse [user_id] = true;
@@ -531,6 +608,7 @@ template <typename T>
 T* umRegistry<T>::resize_alloc(const T* ptr, const int N, int& user_id)
 //---------------------------------------------------------
 {
+  assert(is_owner());
   // Adjust the size of an existing allocation.  If the 
   // pointer is NULL, call get_alloc() and update user_id
   assert(dbase);
@@ -593,7 +671,8 @@ T* umRegistry<T>::resize_alloc(const T* ptr, const int N, int& user_id)
     //int RLEN = select_length(N);
       int RLEN = N;  // NBN: 2007/01/07
 
-      dbase[i] = (T*) realloc(dbase[i],  RLEN*sizeof(T));
+      int Nkeep = std::min(curlen[i], RLEN);
+      dbase[i] = resize_block(dbase[i], maxlen[i], RLEN, Nkeep);
       if (! dbase[i]) {umERROR("umRegistry<T>::resize_alloc", "Failed to realloc block (%0.3lf million elements)", double(RLEN)/1e6);}
       curlen[i] = N;      // length of array actually in use.
       maxlen[i] = RLEN;   // actual length of allocation
@@ -616,6 +695,7 @@ template <typename T>
 int umRegistry<T>::add_alloc(T *ptr, int N)
 //---------------------------------------------------------
 {
+  assert(is_owner());
   // Insert a "raw" allocation with length N
   // into first free slot in the database.
   // Return the id of this slot to caller.
@@ -675,6 +755,8 @@ bool umRegistry<T>::check_alloc(const T* ptr, const int user_id, const int N)
   // check for invalid ptr/id pairs
   if (user_id < 0) { 
     return false; 
+  } else if (!is_owner()) {
+    return true;    // the slot tables belong to another thread
   } else if (m_bFixedSize && (user_id >= MAX_alloc)) {
     return false;
   } else if (!m_bFixedSize && (user_id >= num_alloc)) {
@@ -707,6 +789,12 @@ void umRegistry<T>::free_alloc(T *& ptr, int user_id)
   // Mark allocation as available
   //
 
+  if (user_id >= 0 && !is_owner()) {
+    defer(user_id, false);    // the owner reclaims the slot
+    ptr = NULL;
+    return;
+  }
+
 #if (CHECK_Reg_ALLOC)
   if (m_bFixedSize) { assert(user_id < MAX_alloc); }
   else              { assert(user_id < num_alloc); }
@@ -747,6 +835,12 @@ void umRegistry<T>::free_alloc_2(T *& ptr, int user_id)
   // Allow user to flush large arrays immediately.
   // free the allocation and mark as available
 
+  if (user_id >= 0 && !is_owner()) {
+    defer(user_id, true);     // the owner frees the block
+    ptr = NULL;
+    return;
+  }
+
   if (m_bFixedSize || (user_id < 0)) 
   { 
     // pass to basic version
@@ -786,6 +880,11 @@ void umRegistry<T>::show_alloc() const
   if (!g_TRCFile)
     return;
 
+  if (!is_owner()) {
+    umTRC(1, "%s: held by another thread\n", get_reg_name().c_str());
+    return;
+  }
+
   assert(dbase);
   bool bExist=false;
   int i=0,N=0,M=0,iUse=0;
@@ -815,6 +914,255 @@ void umRegistry<T>::show_alloc() const
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+bool umRegistry<T>::is_owner() const
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  return (m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id());
+#else
+  return true;
+#endif
+}
+
+
+//---------------------------------------------------------
+template <typename T>
+void umRegistry<T>::set_owner()
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  m_owner.store(std::this_thread::get_id());
+  drain();    // releases posted while the set was pooled
+#endif
+}
+
+
+//---------------------------------------------------------
+template <typename T>
+void umRegistry<T>::clear_owner()
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  drain();
+  m_owner.store(std::thread::id());
+#endif
+}
+
+
+//---------------------------------------------------------
+template <typename T>
+void umRegistry<T>::defer(int user_id, bool bRelease)
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  // push onto m_pending; only the owner pops, and it takes
+  // the whole list at once (drain), so there is no ABA
+  Pending* q = new Pending;
+  q->id = user_id;  q->bRelease = bRelease;
+  q->next = m_pending.load(std::memory_order_relaxed);
+  while (!m_pending.compare_exchange_weak(q->next, q,
+          std::memory_order_release, std::memory_order_relaxed)) {}
+#endif
+}
+
+
+//---------------------------------------------------------
+template <typename T>
+void umRegistry<T>::drain()
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  // reclaim the slots posted by other threads
+  Pending* q = m_pending.exchange(NULL, std::memory_order_acquire);
+  while (q) {
+    int i = q->id;
+    if (q->bRelease && !m_bFixedSize) {
+      free(dbase[i]);         // free allocation
+      dbase [i] = NULL;       // invalidate pointer
+      maxlen[i] = 0;          // book-keeping
+    }
+    inuse [i] = false;        // this slot is available
+    curlen[i] = 0;            // update current length
+    m_iNextSlot = std::min(m_iNextSlot, i);
+
+    Pending* n = q->next;  delete q;  q = n;
+  }
+#endif
+}
+
+
+//---------------------------------------------------------
+template <typename T>
+T* umRegistry<T>::new_block(size_t N, bool bZero)
+//---------------------------------------------------------
+{
+  // Allocate N elements, aligned as umAllocPolicy asks.
+  // Large blocks are aligned to, and padded out to, whole
+  // huge pages, then marked as candidates for huge pages.
+
+  const umAllocPolicy& P = umAllocPolicy::get();
+  size_t nbytes = std::max(N,(size_t)1)*sizeof(T);
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+  // no aligned allocation that is released by free()
+  void* p = bZero ? calloc(nbytes, 1) : malloc(nbytes);
+  return (T*) p;
+#else
+  size_t align = P.align;
+  bool   bHuge = (P.huge_bytes>0 && nbytes>=P.huge_bytes);
+  if (bHuge) {
+    align  = P.huge_page;
+    nbytes = ((nbytes+align-1)/align)*align;
+  }
+
+  void* p = NULL;
+  if (posix_memalign(&p, align, nbytes) || !p) { 
+    return NULL; 
+  }
+#if defined(MADV_HUGEPAGE)
+  if (bHuge) { madvise(p, nbytes, MADV_HUGEPAGE); }
+#endif
+  if (bZero) { memset(p, 0, nbytes); }
+  return (T*) p;
+#endif
+}
+
+
+//---------------------------------------------------------
+template <typename T>
+T* umRegistry<T>::resize_block(T* p, size_t Nold, size_t N, size_t Nkeep)
+//---------------------------------------------------------
+{
+  // Resize block p (Nold elements) to hold N elements,
+  // preserving the first Nkeep.  Shrink in place when 
+  // realloc() keeps the alignment, otherwise move.
+
+  const umAllocPolicy& P = umAllocPolicy::get();
+  bool bHugeOld = (P.huge_bytes>0 && Nold*sizeof(T)>=P.huge_bytes);
+  bool bHuge    = (P.huge_bytes>0 && N   *sizeof(T)>=P.huge_bytes);
+  size_t align  = bHuge ? P.huge_page : P.align;
+
+  if (p && (N<=Nold) && (bHuge==bHugeOld)) {
+    T* q = (T*) realloc(p, std::max(N,(size_t)1)*sizeof(T));
+    if (!q) { return NULL; }
+    if (0 == ((size_t)q % align)) {
+      return q;             // shrunk in place
+    }
+    p = q;                  // moved: copy to aligned block
+  }
+
+  T* q = new_block(N, false);
+  if (q && p) {
+    if (Nkeep>0) { memcpy(q, p, std::min(Nkeep,N)*sizeof(T)); }
+    free(p);
+  }
+  return q;
+}
+
+
+
+
+///////////////////////////////////////////////////////////
+//
+// umRegistrySet: the (small, medium, general) registries 
+// used by Vector<T>, one set per thread
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+template <typename T> 
+class umRegistrySet
+//---------------------------------------------------------
+{
+  // Each thread that creates arrays is given its own set
+  // of registries, so threaded element loops never share
+  // a slot table.  An array remembers its registry, so 
+  // it may be released by any thread (see m_pending above).
+  //
+  // Arrays can outlive the thread that allocated them, 
+  // so sets are never deleted: when a thread exits, its 
+  // set is returned to a pool and reused by the next 
+  // new thread.
+
+public:
+  umRegistry<T> reg1;   // small arrays   (preallocated)
+  umRegistry<T> reg2;   // medium arrays  (preallocated)
+  umRegistry<T> reg3;   // general allocations
+
+  umRegistrySet() 
+  : reg1(500, true, iReg_small),  //  16 =  4* 4
+    reg2(500, true, iReg_med),    // iReg_med, see above
+    reg3(500, false, 0)           // arbitrary length
+  {
+#if (USE_THREAD_REGISTRY)
+    ++s_nsets();
+#endif
+  }
+
+  // registries belonging to the calling thread
+  static umRegistrySet<T>& local();
+
+  // number of sets created (one per thread alive at once)
+#if (USE_THREAD_REGISTRY)
+  static int num_sets() { return s_nsets(); }
+#else
+  static int num_sets() { return 1; }
+#endif
+
+#if (USE_THREAD_REGISTRY)
+protected:
+  struct Handle {
+    umRegistrySet<T>* p;
+    Handle()  : p(acquire()) {}
+    ~Handle() { release(p); }
+  };
+
+  static std::atomic<int>& s_nsets() { static std::atomic<int> n(0); return n; }
+  static std::mutex& pool_lock() { static std::mutex m; return m; }
+  static std::vector<umRegistrySet<T>*>& pool() { 
+    static std::vector<umRegistrySet<T>*> v; return v; 
+  }
+
+  // a new set is owned by the thread that constructs it;
+  // a pooled set changes owner
+  static umRegistrySet<T>* acquire() {
+    umRegistrySet<T>* p = NULL;
+    {
+      std::lock_guard<std::mutex> lock(pool_lock());
+      if (!pool().empty()) { p = pool().back(); pool().pop_back(); }
+    }
+    if (!p) { return new umRegistrySet<T>; }
+    p->reg1.set_owner();  p->reg2.set_owner();  p->reg3.set_owner();
+    return p;
+  }
+
+  static void release(umRegistrySet<T>* p) {
+    p->reg1.clear_owner();  p->reg2.clear_owner();  p->reg3.clear_owner();
+    std::lock_guard<std::mutex> lock(pool_lock());
+    pool().push_back(p);
+  }
+#endif
+};
+
+
+//---------------------------------------------------------
+template <typename T> inline
+umRegistrySet<T>& umRegistrySet<T>::local()
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  static thread_local Handle h;
+  return *(h.p);
+#else
+  static umRegistrySet<T> s_set;
+  return s_set;
+#endif
+}
+
+
 #undef SHOW_Reg_ALLOC
 #undef CHECK_Reg_ALLOC
 
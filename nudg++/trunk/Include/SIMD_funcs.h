@@ -0,0 +1,90 @@
+// SIMD_funcs.h
+// element-wise kernels for double arrays, with runtime
+// selection of SSE2/AVX2/AVX-512 implementations
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__SIMD_funcs_H__INCLUDED
+#define NDG__SIMD_funcs_H__INCLUDED
+
+#include "ArrayMacros.h"
+
+//---------------------------------------------------------
+// The element-wise operators of Vector<double> (and so
+// of DMat) call the kernels below.  Each kernel has a
+// scalar version, and (on x86-64, with USE_SIMD_KERNELS)
+// SSE2, AVX2 and AVX-512 versions.  The best version the
+// cpu supports is selected at startup; the environment
+// variable NDG_SIMD (scalar|sse2|avx2|avx512) or
+// umSIMD_set_level() may select a lower one.
+//
+// Kernels do not use fused multiply-add, so all levels
+// give results identical to the scalar loops and to the
+// reference BLAS they replace.
+//
+// All arrays have length N, and may be unaligned.
+//---------------------------------------------------------
+
+enum umSIMD_Level {
+  umSIMD_SCALAR = 0,
+  umSIMD_SSE2   = 1,
+  umSIMD_AVX2   = 2,
+  umSIMD_AVX512 = 3
+};
+
+
+//---------------------------------------------------------
+struct umSIMD_ops
+//---------------------------------------------------------
+{
+  void (*add) (int N, double* y, const double* x);  // y += x
+  void (*sub) (int N, double* y, const double* x);  // y -= x
+  void (*mul) (int N, double* y, const double* x);  // y .*= x
+  void (*div) (int N, double* y, const double* x);  // y ./= x
+  void (*axpy)(int N, double a, const double* x, double* y); // y += a*x
+  void (*scal)(int N, double a, double* y);         // y *= a
+  void (*sqr) (int N, double* y);                   // y = y.^2
+  void (*sqrt)(int N, double* y);                   // y = (y>0) ? sqrt(y) : 0
+  void (*abs) (int N, double* y);                   // y = |y|
+  void (*max) (int N, double* y, const double* x);  // y = max(y,x)
+  void (*min) (int N, double* y, const double* x);  // y = min(y,x)
+  void (*maxs)(int N, double* y, double x);         // y = max(y,x)
+  void (*mins)(int N, double* y, double x);         // y = min(y,x)
+
+  umSIMD_Level  level;
+  const char*   name;
+};
+
+
+// kernels currently selected
+extern const umSIMD_ops* umSIMD_cur;
+
+umSIMD_Level  umSIMD_best_level();          // best level supported by this cpu
+umSIMD_Level  umSIMD_set_level(umSIMD_Level lev);  // select (at most best); returns level used
+const umSIMD_ops& umSIMD_get_ops(umSIMD_Level lev);  // kernels for a given level
+inline umSIMD_Level umSIMD_level()      { return umSIMD_cur->level; }
+inline const char*  umSIMD_name()       { return umSIMD_cur->name; }
+
+// bytes of L2 cache of one core (NDG_L2=<KB> overrides;
+// 1 MB if the system does not report it), for sizing the
+// tiles of the element-local kernels
+int umCache_L2();
+
+
+//---------------------------------------------------------
+// kernels, via the current selection
+//---------------------------------------------------------
+inline void umV_add (int N, double* y, const double* x)   { umSIMD_cur->add (N, y, x); }
+inline void umV_sub (int N, double* y, const double* x)   { umSIMD_cur->sub (N, y, x); }
+inline void umV_mul (int N, double* y, const double* x)   { umSIMD_cur->mul (N, y, x); }
+inline void umV_div (int N, double* y, const double* x)   { umSIMD_cur->div (N, y, x); }
+inline void umV_axpy(int N, double a, const double* x, double* y) { umSIMD_cur->axpy(N, a, x, y); }
+inline void umV_scal(int N, double a, double* y)          { umSIMD_cur->scal(N, a, y); }
+inline void umV_sqr (int N, double* y)                    { umSIMD_cur->sqr (N, y); }
+inline void umV_sqrt(int N, double* y)                    { umSIMD_cur->sqrt(N, y); }
+inline void umV_abs (int N, double* y)                    { umSIMD_cur->abs (N, y); }
+inline void umV_max (int N, double* y, const double* x)   { umSIMD_cur->max (N, y, x); }
+inline void umV_min (int N, double* y, const double* x)   { umSIMD_cur->min (N, y, x); }
+inline void umV_max (int N, double* y, double x)          { umSIMD_cur->maxs(N, y, x); }
+inline void umV_min (int N, double* y, double x)          { umSIMD_cur->mins(N, y, x); }
+
+#endif  // NDG__SIMD_funcs_H__INCLUDED
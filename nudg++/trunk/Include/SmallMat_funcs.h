@@ -0,0 +1,81 @@
+// SmallMat_funcs.h
+// order-specialized products of small operators (Dr, LIFT)
+// with many element columns
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__SmallMat_funcs_H__INCLUDED
+#define NDG__SmallMat_funcs_H__INCLUDED
+
+#include "SIMD_funcs.h"
+
+//---------------------------------------------------------
+// Products such as Dr*u and LIFT*flux multiply a small
+// (Np,Np) or (Np,Nfaces*Nfp) operator, or the stacked
+// derivatives [Dr;Ds;Dt] (Dim*Np,Np), into K columns.
+// Reference GEMM sees only runtime sizes, so for Np=3..56
+// its call and loop overhead dominate.  The kernels here
+// are instantiated for each order N=1..10, in 2D and 3D,
+// with the operator shape fixed at compile time: the sums
+// of each column are held in registers (or L1), and the
+// operator is streamed from L1 for every column.
+//
+// StartUp2D/StartUp3D call umSmallMat_select(Dim,N), which
+// registers the kernels for the shapes of that order; umAxB
+// then uses a registered kernel whenever A has one of those
+// shapes, and GEMM otherwise.  Sums are formed in the same
+// order as the reference GEMM, without fused multiply-add,
+// so results are unchanged.  The SIMD level follows that
+// of the element-wise kernels (see SIMD_funcs.h), and
+// NDG_SMALLMAT=0 in the environment disables the kernels.
+//
+//   C = alpha*A*B + beta*C,  A is (M,Kc), B is (Kc,N)
+//
+// For the float steppers of Maxwell2D_P.h the 2D shapes
+// also have kernels in float (umSmallMat_fnf), and kernels
+// that read float B into double sums (umSmallMat_fnm).
+//---------------------------------------------------------
+
+typedef void (*umSmallMat_fn)
+(
+  int N, double alpha, const double* A,
+  const double* B, int ldb,
+  double beta, double* C, int ldc
+);
+
+typedef void (*umSmallMat_fnf)
+(
+  int N, float alpha, const float* A,
+  const float* B, int ldb,
+  float beta, float* C, int ldc
+);
+
+typedef void (*umSmallMat_fnm)
+(
+  int N, double alpha, const double* A,
+  const float* B, int ldb,
+  double beta, double* C, int ldc
+);
+
+enum {
+  umSM_MAXORDER = 10,   // kernels exist for N=1..umSM_MAXORDER
+  umSM_VOL      = 0,    // (Np,Np)         e.g. Dr, Ds, Dt
+  umSM_LIFT     = 1,    // (Np,Nfaces*Nfp) LIFT
+  umSM_GRAD     = 2,    // (Dim*Np,Np)     stacked [Dr;Ds;Dt]
+  umSM_NSHAPE   = 3
+};
+
+// register kernels for order N in Dim=2|3; false if none
+bool          umSmallMat_select(int Dim, int N);
+void          umSmallMat_clear();
+
+// registered kernel for A of shape (M,Kc), or NULL
+umSmallMat_fn  umSmallMat_find  (int M, int Kc);
+umSmallMat_fnf umSmallMat_find_f(int M, int Kc);  // float
+umSmallMat_fnm umSmallMat_find_m(int M, int Kc);  // float B, double sums
+
+// kernel for a given level, order and shape (for tests)
+umSmallMat_fn  umSmallMat_get  (umSIMD_Level lev, int Dim, int N, int shape);
+umSmallMat_fnf umSmallMat_get_f(umSIMD_Level lev, int N, int shape);  // 2D
+umSmallMat_fnm umSmallMat_get_m(umSIMD_Level lev, int N, int shape);  // 2D
+
+#endif  // NDG__SmallMat_funcs_H__INCLUDED
@@ -0,0 +1,737 @@
+// VecExpr_Type.h
+// fused element-wise expressions for Vector<T>, Mat_COL<T>
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__VecExpr_Type_H__INCLUDED
+#define NDG__VecExpr_Type_H__INCLUDED
+
+//---------------------------------------------------------
+// The element-wise operators of Vector<T> and Mat_COL<T>
+// return expressions rather than new arrays:
+//
+//   A+B, A-B, -A       vectors, matrices and scalars
+//   A*x, x*A, A/x, x/A with a scalar x
+//   U*V, U/V           element-by-element, for vectors
+//   A.dm(B), A.dd(B)   element-by-element
+//
+// so that a flux line such as
+//
+//   fluxHx = ny.dm(dEz) + alpha*(ndotdH.dm(nx) - dHx);
+//
+// builds a small tree.  Nothing is evaluated until the tree
+// is assigned to a Vector or Mat_COL, when the whole line
+// is computed in one loop, with no temporaries.  Each value
+// is computed as by the former eager operators (e.g. for
+// double, A/x multiplies by 1/x, as div_val).
+//
+// A matrix operand of * or / means a matrix product or a
+// solve: these stay eager, return a new array by value
+// (see Mat_COL.h), and an expression operand is evaluated
+// first (umExprMul, umExprDiv).  Where an array is expected
+// (a const DVec& argument, a function template of Vector<T>,
+// a reference) an expression converts to a new OBJ_temp
+// array, as returned by e.g. trans(), and is released by
+// the same rules.
+//
+// An expression with a Mat_COL operand has a Mat_COL result
+// which takes the shape of that operand.
+//
+// The tree reads its operands in place, so it must be used
+// in the statement that builds it; an array returned by
+// value (e.g. LIFT*u) lives until the end of the statement.
+// OBJ_temp operands (e.g. trans(A)) are deleted after
+// evaluation, or by the tree if it is never evaluated.  An array may appear on both sides
+// of an assignment; if it has to be resized, the expression
+// is first evaluated into a new array.
+//
+// A matrix with padded columns (Mat_COL::resize_padded)
+// enters as its whole padded array, so it combines only
+// with matrices of the same layout.
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+// element-wise operations
+//---------------------------------------------------------
+struct umOpAdd  { template <typename T> static T apply(const T& a, const T& b) { return a+b; } };
+struct umOpSub  { template <typename T> static T apply(const T& a, const T& b) { return a-b; } };
+struct umOpMul  { template <typename T> static T apply(const T& a, const T& b) { return a*b; } };
+struct umOpDiv  { template <typename T> static T apply(const T& a, const T& b) { return a/b; } };
+
+// A/x, given r = umExprDivisor(x)
+struct umOpDivS {
+  template <typename T> static T apply(const T& a, const T& r) { return a/r; }
+  static double apply(const double& a, const double& r) { return a*r; }
+};
+template <typename T> inline T umExprDivisor(const T& x) { return x; }
+inline double umExprDivisor(const double& x) {
+  if (0.0==x) throw "division by zero";
+  return 1.0/x;     // as div_val: multiply by 1/x
+}
+
+struct umOpNeg  { template <typename T> static T apply(const T& a) { return -a; } };
+struct umOpSqr  { template <typename T> static T apply(const T& a) { return a*a; } };
+struct umOpSqrt { template <typename T> static T apply(const T& a) { return (a>0) ? (T) sqrt(double(a)) : T(0); } };  // as SQRT()
+struct umOpAbs  { template <typename T> static T apply(const T& a) { return std::abs(a); } };
+
+
+// operand traits and element-wise operations, see below
+template <typename T, class X> struct umExprNode;
+template <typename T, class X, class Y, class Op> struct umExprBinary;
+
+// result of an expression: a Mat_COL if it reads one
+template <typename T, int M> struct umExprResult      { typedef Vector<T>  type; };
+template <typename T>        struct umExprResult<T,1> { typedef Mat_COL<T> type; };
+
+
+//---------------------------------------------------------
+template <typename T, int M>
+class VecExprLeaf
+//---------------------------------------------------------
+{
+  // reads the data of an existing array (M=1: a Mat_COL)
+public:
+  enum { MAT = M };
+
+  VecExprLeaf(const Vector<T>* pA, int Mr, int N, int ld)
+    : p_(pA->data()), m_M(Mr), m_N(N), m_ld(ld), m_pObj(pA) {}
+
+  T   operator[](int i) const { return p_[i]; }
+  int size()     const { return m_ld*m_N; }
+  int num_rows() const { return m_M; }
+  int num_cols() const { return m_N; }
+  int ld()       const { return m_ld; }
+  bool padded()  const { return (m_ld != m_M); }
+
+  // does this read any of the n values at p?
+  bool reads(const T* p, int n) const { return (p_ < p+n) && (p < p_+size()); }
+
+  // called once, after evaluation: delete OBJ_temp's
+  void release() const {
+    if (OBJ_temp == m_pObj->get_mode()) { delete m_pObj; }
+  }
+
+protected:
+  const T*  p_;       // 0-based data of the wrapped array
+  int       m_M, m_N; // shape of the wrapped array
+  int       m_ld;     // its column stride
+  const Vector<T>* m_pObj;
+};
+
+
+//---------------------------------------------------------
+template <typename T>
+class VecExprScalar
+//---------------------------------------------------------
+{
+  // broadcast a scalar to every element.
+  // size()==0: shape is taken from the other operand
+public:
+  enum { MAT = 0 };
+
+  VecExprScalar(const T& x) : x_(x) {}
+
+  T   operator[](int i) const { return x_; }
+  int size()     const { return 0; }
+  int num_rows() const { return 0; }
+  int num_cols() const { return 0; }
+  int ld()       const { return 0; }
+  bool padded()  const { return false; }
+  bool reads(const T* p, int n) const { return false; }
+  void release() const {}
+
+protected:
+  T x_;
+};
+
+
+//---------------------------------------------------------
+template <typename T, class A, class B, class Op>
+class VecExprBin
+//---------------------------------------------------------
+{
+public:
+  enum { MAT = (A::MAT || B::MAT) };
+
+  VecExprBin(const A& a, const B& b) : a_(a), b_(b) {
+    if (a_.size() && b_.size() && (a_.size() != b_.size()) && (a_.padded() || b_.padded())) {
+      umERROR("VecExprBin", "padded and unpadded operands (%d, %d)", a_.size(), b_.size());
+    }
+    // as the eager operators: operands may be longer
+    assert((0==a_.size() || a_.size()>=size()) && (0==b_.size() || b_.size()>=size()));
+  }
+
+  T   operator[](int i) const { return Op::apply(a_[i], b_[i]); }
+
+  // the shape of a matrix operand, else of the first array
+  int size()     const { return shape_a() ? a_.size()     : b_.size();     }
+  int num_rows() const { return shape_a() ? a_.num_rows() : b_.num_rows(); }
+  int num_cols() const { return shape_a() ? a_.num_cols() : b_.num_cols(); }
+  int ld()       const { return shape_a() ? a_.ld()       : b_.ld();       }
+  bool padded()  const { return shape_a() ? a_.padded()   : b_.padded();   }
+
+  bool reads(const T* p, int n) const { return a_.reads(p,n) || b_.reads(p,n); }
+  void release() const { a_.release(); b_.release(); }
+
+protected:
+  bool shape_a() const { return (a_.size()>0) && (A::MAT || !B::MAT || 0==b_.size()); }
+
+  A a_;   // nodes are small, so store copies
+  B b_;
+};
+
+
+//---------------------------------------------------------
+template <typename T, class A, class Op>
+class VecExprUn
+//---------------------------------------------------------
+{
+public:
+  enum { MAT = A::MAT };
+
+  VecExprUn(const A& a) : a_(a) {}
+
+  T   operator[](int i) const { return Op::apply(a_[i]); }
+  int size()     const { return a_.size(); }
+  int num_rows() const { return a_.num_rows(); }
+  int num_cols() const { return a_.num_cols(); }
+  int ld()       const { return a_.ld(); }
+  bool padded()  const { return a_.padded(); }
+  bool reads(const T* p, int n) const { return a_.reads(p,n); }
+  void release() const { a_.release(); }
+
+protected:
+  A a_;
+};
+
+
+//---------------------------------------------------------
+template <typename T, class E>
+class VecExpr
+//---------------------------------------------------------
+{
+  // Wrapper for all expression nodes: the root of a tree
+  // owns its OBJ_temp operands, and hands them on when it
+  // is combined into a larger tree (take).
+public:
+  enum { MAT = E::MAT };
+  typedef typename umExprResult<T,MAT>::type R;   // Vector<T> or Mat_COL<T>
+
+  explicit VecExpr(const E& e) : e_(e), m_owner(true) {}
+#if (__cplusplus >= 201103L)
+  // moved, never copied: only one holder owns the operands
+  VecExpr(VecExpr&& X) : e_(X.e_), m_owner(X.m_owner) { X.m_owner = false; }
+  VecExpr(const VecExpr&) = delete;
+  VecExpr& operator=(const VecExpr&) = delete;
+#else
+  // C++98: the (elided) copy of a return value takes over
+  // the operands, as std::auto_ptr
+  VecExpr(const VecExpr& X) : e_(X.e_), m_owner(X.m_owner) { X.m_owner = false; }
+#endif
+  ~VecExpr() { release(); }
+
+  T   operator[](int i) const { return e_[i]; }
+  int size()     const { return e_.size(); }
+  int num_rows() const { return e_.num_rows(); }
+  int num_cols() const { return e_.num_cols(); }
+  int ld()       const { return e_.ld(); }
+  bool reads(const T* p, int n) const { return e_.reads(p,n); }
+
+  // delete OBJ_temp operands (once, by the owner)
+  void release() const { if (m_owner) { m_owner = false; e_.release(); } }
+
+  // the tree, handed on to a larger expression
+  const E& take() const { m_owner = false; return e_; }
+
+  // evaluate into a new OBJ_temp array; used where an
+  // array is expected
+  R&  eval() const;
+  operator R&() const { return eval(); }
+
+  // element-by-element operations, as in Vector<T>
+  template <class X> typename umExprBinary<T,VecExpr,X,umOpMul>::type dm(const X& B) const;
+  template <class X> typename umExprBinary<T,VecExpr,X,umOpDiv>::type dd(const X& B) const;
+
+  // "Boolean" results, as in Vector<T>
+  Vector<T>& eq    (T val) const { return eval().eq(val); }
+  Vector<T>& le    (T val) const { return eval().le(val); }
+  Vector<T>& lt    (T val) const { return eval().lt(val); }
+  Vector<T>& lt_abs(T val) const { return eval().lt_abs(val); }
+  Vector<T>& ge    (T val) const { return eval().ge(val); }
+  Vector<T>& gt    (T val) const { return eval().gt(val); }
+  Vector<T>& gt_abs(T val) const { return eval().gt_abs(val); }
+
+protected:
+  E e_;
+  mutable bool m_owner;   // release() operands on destruction?
+};
+
+
+
+///////////////////////////////////////////////////////////
+//
+// operands
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+// umExprNode<T,X>: the node that reads an operand of type X
+//---------------------------------------------------------
+template <typename T> struct umExprNode< T, Vector<T> > {
+  typedef VecExprLeaf<T,0> type;
+  static type get(const Vector<T>& A) { return type(&A, A.size(), 1, A.size()); }
+};
+
+template <typename T> struct umExprNode< T, Mat_COL<T> > {
+  typedef VecExprLeaf<T,1> type;
+  static type get(const Mat_COL<T>& A) { return type(&A, A.num_rows(), A.num_cols(), A.ld()); }
+};
+
+template <typename T, class E> struct umExprNode< T, VecExpr<T,E> > {
+  typedef E type;
+  static const E& get(const VecExpr<T,E>& X) { return X.take(); }
+};
+
+template <typename T> struct umExprNode< T, T > {
+  typedef VecExprScalar<T> type;
+  static type get(const T& x) { return type(x); }
+};
+
+
+//---------------------------------------------------------
+// umExprArray<T,X>: an operand as an array, for the eager
+// operators: expressions are evaluated
+//---------------------------------------------------------
+template <typename T, class X> struct umExprArray {
+  static const X& get(const X& A) { return A; }
+};
+
+template <typename T, class E> struct umExprArray< T, VecExpr<T,E> > {
+  static typename VecExpr<T,E>::R& get(const VecExpr<T,E>& X) { return X.eval(); }
+};
+
+
+//---------------------------------------------------------
+// x op y, element-by-element
+//---------------------------------------------------------
+template <typename T, class X, class Y, class Op>
+struct umExprBinary
+{
+  typedef typename umExprNode<T,X>::type A;
+  typedef typename umExprNode<T,Y>::type B;
+  typedef VecExpr< T, VecExprBin<T,A,B,Op> > type;
+
+  static type apply(const X& x, const Y& y) {
+    return type(VecExprBin<T,A,B,Op>(umExprNode<T,X>::get(x), umExprNode<T,Y>::get(y)));
+  }
+};
+
+template <typename T, class X, class Y> struct umExprAdd : public umExprBinary<T,X,Y,umOpAdd> {};
+template <typename T, class X, class Y> struct umExprSub : public umExprBinary<T,X,Y,umOpSub> {};
+
+
+//---------------------------------------------------------
+// x * y: element-by-element, unless a matrix is involved
+//---------------------------------------------------------
+template <typename T, class X, class Y,
+          bool bMat = (umExprNode<T,X>::type::MAT || umExprNode<T,Y>::type::MAT)>
+struct umExprMul : public umExprBinary<T,X,Y,umOpMul> {};
+
+template <typename T, class X, class Y>
+struct umExprMul<T,X,Y,true>
+{
+  // matrix*matrix, matrix*vector or vector*matrix, on
+  // evaluated operands (eager, see Mat_COL.h)
+  typedef typename umExprResult<T, (umExprNode<T,X>::type::MAT &&
+                                    umExprNode<T,Y>::type::MAT)>::type type;
+
+  static type apply(const X& x, const Y& y) {
+    return umExprArray<T,X>::get(x) * umExprArray<T,Y>::get(y);
+  }
+};
+
+
+//---------------------------------------------------------
+// x / y: element-by-element, unless y is a matrix
+//---------------------------------------------------------
+template <typename T, class X, class Y, bool bMat = (umExprNode<T,Y>::type::MAT != 0)>
+struct umExprDiv : public umExprBinary<T,X,Y,umOpDiv> {};
+
+template <typename T, class X, class Y>
+struct umExprDiv<T,X,Y,true>
+{
+  // right division: x/A => x*inv(A) (eager, see Mat_COL.h)
+  typedef typename umExprResult<T, umExprNode<T,X>::type::MAT>::type type;
+
+  static type apply(const X& x, const Y& y) {
+    return umExprArray<T,X>::get(x) / umExprArray<T,Y>::get(y);
+  }
+};
+
+
+
+///////////////////////////////////////////////////////////
+//
+// Globals: element-wise operator overloads
+//
+///////////////////////////////////////////////////////////
+
+// For each operator F, define
+//
+//   expr op expr
+//   expr op vector,  vector op expr
+//   expr op matrix,  matrix op expr
+
+#define umEXPR_WITH_EXPR(OP, F)                                             \
+                                                                            \
+template <typename T, class A, class B> inline                              \
+typename F< T, VecExpr<T,A>, VecExpr<T,B> >::type                           \
+OP(const VecExpr<T,A>& a, const VecExpr<T,B>& b)                            \
+{ return F< T, VecExpr<T,A>, VecExpr<T,B> >::apply(a, b); }                 \
+                                                                            \
+template <typename T, class A> inline                                       \
+typename F< T, VecExpr<T,A>, Vector<T> >::type                              \
+OP(const VecExpr<T,A>& a, const Vector<T>& b)                               \
+{ return F< T, VecExpr<T,A>, Vector<T> >::apply(a, b); }                    \
+                                                                            \
+template <typename T, class B> inline                                       \
+typename F< T, Vector<T>, VecExpr<T,B> >::type                              \
+OP(const Vector<T>& a, const VecExpr<T,B>& b)                               \
+{ return F< T, Vector<T>, VecExpr<T,B> >::apply(a, b); }                    \
+                                                                            \
+template <typename T, class A> inline                                       \
+typename F< T, VecExpr<T,A>, Mat_COL<T> >::type                             \
+OP(const VecExpr<T,A>& a, const Mat_COL<T>& b)                              \
+{ return F< T, VecExpr<T,A>, Mat_COL<T> >::apply(a, b); }                   \
+                                                                            \
+template <typename T, class B> inline                                       \
+typename F< T, Mat_COL<T>, VecExpr<T,B> >::type                             \
+OP(const Mat_COL<T>& a, const VecExpr<T,B>& b)                              \
+{ return F< T, Mat_COL<T>, VecExpr<T,B> >::apply(a, b); }
+
+// ... and for + and -, every pair of arrays
+
+#define umEXPR_ARRAYS(OP, F)                                                \
+                                                                            \
+template <typename T> inline                                                \
+typename F< T, Vector<T>, Vector<T> >::type                                 \
+OP(const Vector<T>& a, const Vector<T>& b)                                  \
+{ return F< T, Vector<T>, Vector<T> >::apply(a, b); }                       \
+                                                                            \
+template <typename T> inline                                                \
+typename F< T, Mat_COL<T>, Mat_COL<T> >::type                               \
+OP(const Mat_COL<T>& a, const Mat_COL<T>& b)                                \
+{ return F< T, Mat_COL<T>, Mat_COL<T> >::apply(a, b); }                     \
+                                                                            \
+template <typename T> inline                                                \
+typename F< T, Mat_COL<T>, Vector<T> >::type                                \
+OP(const Mat_COL<T>& a, const Vector<T>& b)                                 \
+{ return F< T, Mat_COL<T>, Vector<T> >::apply(a, b); }                      \
+                                                                            \
+template <typename T> inline                                                \
+typename F< T, Vector<T>, Mat_COL<T> >::type                                \
+OP(const Vector<T>& a, const Mat_COL<T>& b)                                 \
+{ return F< T, Vector<T>, Mat_COL<T> >::apply(a, b); }
+
+// ... and a scalar on either side (except A/x, below)
+
+#define umEXPR_SCALAR_R(OP, OPTYPE)                                         \
+                                                                            \
+template <typename T, class A> inline                                       \
+typename umExprBinary< T, VecExpr<T,A>, T, OPTYPE >::type                   \
+OP(const VecExpr<T,A>& a, const T& x)                                       \
+{ return umExprBinary< T, VecExpr<T,A>, T, OPTYPE >::apply(a, x); }         \
+                                                                            \
+template <typename T> inline                                                \
+typename umExprBinary< T, Vector<T>, T, OPTYPE >::type                      \
+OP(const Vector<T>& a, const T& x)                                          \
+{ return umExprBinary< T, Vector<T>, T, OPTYPE >::apply(a, x); }            \
+                                                                            \
+template <typename T> inline                                                \
+typename umExprBinary< T, Mat_COL<T>, T, OPTYPE >::type                     \
+OP(const Mat_COL<T>& a, const T& x)                                         \
+{ return umExprBinary< T, Mat_COL<T>, T, OPTYPE >::apply(a, x); }
+
+#define umEXPR_SCALAR_L(OP, OPTYPE)                                         \
+                                                                            \
+template <typename T, class B> inline                                       \
+typename umExprBinary< T, T, VecExpr<T,B>, OPTYPE >::type                   \
+OP(const T& x, const VecExpr<T,B>& b)                                       \
+{ return umExprBinary< T, T, VecExpr<T,B>, OPTYPE >::apply(x, b); }         \
+                                                                            \
+template <typename T> inline                                                \
+typename umExprBinary< T, T, Vector<T>, OPTYPE >::type                      \
+OP(const T& x, const Vector<T>& b)                                          \
+{ return umExprBinary< T, T, Vector<T>, OPTYPE >::apply(x, b); }            \
+                                                                            \
+template <typename T> inline                                                \
+typename umExprBinary< T, T, Mat_COL<T>, OPTYPE >::type                     \
+OP(const T& x, const Mat_COL<T>& b)                                         \
+{ return umExprBinary< T, T, Mat_COL<T>, OPTYPE >::apply(x, b); }
+
+
+// C = A + B,  C = A - B
+umEXPR_WITH_EXPR(operator+, umExprAdd)
+umEXPR_WITH_EXPR(operator-, umExprSub)
+umEXPR_ARRAYS   (operator+, umExprAdd)
+umEXPR_ARRAYS   (operator-, umExprSub)
+umEXPR_SCALAR_R (operator+, umOpAdd)
+umEXPR_SCALAR_L (operator+, umOpAdd)
+umEXPR_SCALAR_R (operator-, umOpSub)
+umEXPR_SCALAR_L (operator-, umOpSub)
+
+// C = A * B  (matrix product if A or B is a matrix)
+// C = A / B  (right division if B is a matrix)
+umEXPR_WITH_EXPR(operator*, umExprMul)
+umEXPR_WITH_EXPR(operator/, umExprDiv)
+umEXPR_SCALAR_R (operator*, umOpMul)
+umEXPR_SCALAR_L (operator*, umOpMul)
+umEXPR_SCALAR_L (operator/, umOpDiv)
+
+#undef umEXPR_WITH_EXPR
+#undef umEXPR_ARRAYS
+#undef umEXPR_SCALAR_R
+#undef umEXPR_SCALAR_L
+
+
+// C = U .* V,  C = U ./ V  for vectors (see Mat_COL.h
+// for matrix products and division)
+
+template <typename T> inline
+typename umExprBinary< T, Vector<T>, Vector<T>, umOpMul >::type
+operator*(const Vector<T>& a, const Vector<T>& b)
+{ return umExprBinary< T, Vector<T>, Vector<T>, umOpMul >::apply(a, b); }
+
+template <typename T> inline
+typename umExprBinary< T, Vector<T>, Vector<T>, umOpDiv >::type
+operator/(const Vector<T>& a, const Vector<T>& b)
+{ return umExprBinary< T, Vector<T>, Vector<T>, umOpDiv >::apply(a, b); }
+
+
+// C = A / x
+
+template <typename T, class A> inline
+typename umExprBinary< T, VecExpr<T,A>, T, umOpDivS >::type
+operator/(const VecExpr<T,A>& a, const T& x)
+{ return umExprBinary< T, VecExpr<T,A>, T, umOpDivS >::apply(a, umExprDivisor(x)); }
+
+template <typename T> inline
+typename umExprBinary< T, Vector<T>, T, umOpDivS >::type
+operator/(const Vector<T>& a, const T& x)
+{ return umExprBinary< T, Vector<T>, T, umOpDivS >::apply(a, umExprDivisor(x)); }
+
+template <typename T> inline
+typename umExprBinary< T, Mat_COL<T>, T, umOpDivS >::type
+operator/(const Mat_COL<T>& a, const T& x)
+{ return umExprBinary< T, Mat_COL<T>, T, umOpDivS >::apply(a, umExprDivisor(x)); }
+
+
+// unary operations:  -A, and for expressions,
+// sqr(expr), sqrt(expr), abs(expr)
+
+template <typename T> inline
+VecExpr< T, VecExprUn<T,VecExprLeaf<T,0>,umOpNeg> > operator-(const Vector<T>& a)
+{ return VecExpr< T, VecExprUn<T,VecExprLeaf<T,0>,umOpNeg> >(umExprNode< T,Vector<T> >::get(a)); }
+
+template <typename T> inline
+VecExpr< T, VecExprUn<T,VecExprLeaf<T,1>,umOpNeg> > operator-(const Mat_COL<T>& a)
+{ return VecExpr< T, VecExprUn<T,VecExprLeaf<T,1>,umOpNeg> >(umExprNode< T,Mat_COL<T> >::get(a)); }
+
+#define umEXPR_UNARY_OP(OP, OPTYPE)                                         \
+template <typename T, class A> inline                                       \
+VecExpr< T, VecExprUn<T,A,OPTYPE> > OP(const VecExpr<T,A>& a)               \
+{ return VecExpr< T, VecExprUn<T,A,OPTYPE> >(VecExprUn<T,A,OPTYPE>(a.take())); }
+
+umEXPR_UNARY_OP(operator-, umOpNeg)
+umEXPR_UNARY_OP(sqr,       umOpSqr)
+umEXPR_UNARY_OP(sqrt,      umOpSqrt)
+umEXPR_UNARY_OP(abs,       umOpAbs)
+
+#undef umEXPR_UNARY_OP
+
+
+
+///////////////////////////////////////////////////////////
+//
+// member dm(), dd()
+//
+///////////////////////////////////////////////////////////
+
+
+template <typename T> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,VecExprLeaf<T,0>,umOpMul> >
+Vector<T>::dm(const Vector<T>& B) const
+{ return umExprBinary< T, Vector<T>, Vector<T>, umOpMul >::apply(*this, B); }
+
+template <typename T> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,VecExprLeaf<T,0>,umOpDiv> >
+Vector<T>::dd(const Vector<T>& B) const
+{ return umExprBinary< T, Vector<T>, Vector<T>, umOpDiv >::apply(*this, B); }
+
+template <typename T> template <class E> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,E,umOpMul> >
+Vector<T>::dm(const VecExpr<T,E>& B) const
+{ return umExprBinary< T, Vector<T>, VecExpr<T,E>, umOpMul >::apply(*this, B); }
+
+template <typename T> template <class E> inline
+VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,E,umOpDiv> >
+Vector<T>::dd(const VecExpr<T,E>& B) const
+{ return umExprBinary< T, Vector<T>, VecExpr<T,E>, umOpDiv >::apply(*this, B); }
+
+template <typename T, class E> template <class X> inline
+typename umExprBinary<T,VecExpr<T,E>,X,umOpMul>::type VecExpr<T,E>::dm(const X& B) const
+{ return umExprBinary< T, VecExpr<T,E>, X, umOpMul >::apply(*this, B); }
+
+template <typename T, class E> template <class X> inline
+typename umExprBinary<T,VecExpr<T,E>,X,umOpDiv>::type VecExpr<T,E>::dd(const X& B) const
+{ return umExprBinary< T, VecExpr<T,E>, X, umOpDiv >::apply(*this, B); }
+
+
+
+///////////////////////////////////////////////////////////
+//
+// evaluation: single loop over the result
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+template <typename T, class E> inline
+typename VecExpr<T,E>::R& VecExpr<T,E>::eval() const
+//---------------------------------------------------------
+{
+  R* tmp = new R("expr", OBJ_temp);
+  (*tmp) = (*this);   // releases the operands
+  return (*tmp);
+}
+
+
+//---------------------------------------------------------
+template <typename T> template <class E> inline
+Vector<T>& Vector<T>::operator=(const VecExpr<T,E>& X)
+//---------------------------------------------------------
+{
+  int N = X.size();
+  if (N != m_Len) {
+    // (*this) appears in X: evaluate into a new array
+    if (X.reads(v_, m_Len)) { return operator=(X.eval()); }
+    this->resize(N, false);
+  }
+  T* p = v_;
+  for (int i=0; i<N; ++i) { p[i] = X[i]; }
+  X.release();    // delete any OBJ_temp operands
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> template <class E> inline
+Vector<T>& Vector<T>::operator+=(const VecExpr<T,E>& X)
+//---------------------------------------------------------
+{
+  assert(X.size() >= m_Len);
+  T* p = v_;
+  for (int i=0; i<m_Len; ++i) { p[i] += X[i]; }
+  X.release();
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> template <class E> inline
+Vector<T>& Vector<T>::operator-=(const VecExpr<T,E>& X)
+//---------------------------------------------------------
+{
+  assert(X.size() >= m_Len);
+  T* p = v_;
+  for (int i=0; i<m_Len; ++i) { p[i] -= X[i]; }
+  X.release();
+  return (*this);
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// expressions as arguments of array functions
+//
+///////////////////////////////////////////////////////////
+
+// Template arguments are not deduced through conversions,
+// so function templates of Vector<T> (and operators with
+// regions) do not accept an expression.  These evaluate
+// it into an OBJ_temp array first.
+
+template <typename T, class E> inline
+IVec& find(const VecExpr<T,E>& X, char op, T val)
+{ return find(X.eval(), op, val); }
+
+template <typename T, class E> inline
+IVec& find(const VecExpr<T,E>& X, char op, const Vector<T>& B)
+{ return find(X.eval(), op, B); }
+
+template <typename T, class E> inline
+Vector<T>& floor(const VecExpr<T,E>& X)
+{ return floor(X.eval()); }
+
+template <typename T, class E> inline
+Vector<T>& apply(FuncPtr fptr, const VecExpr<T,E>& X)
+{ return apply(fptr, X.eval()); }
+
+template <typename T, class A, class B> inline
+Mat_COL<T>& outer(const VecExpr<T,A>& a, const VecExpr<T,B>& b)
+{ return outer(a.eval(), b.eval()); }
+
+template <typename T, class A> inline
+Mat_COL<T>& outer(const VecExpr<T,A>& a, const Vector<T>& b)
+{ return outer(a.eval(), b); }
+
+template <typename T, class B> inline
+Mat_COL<T>& outer(const Vector<T>& a, const VecExpr<T,B>& b)
+{ return outer(a, b.eval()); }
+
+
+// expression op region:  1D regions give vectors, 2D
+// regions the result of the expression.  But a vector
+// times a mapped 1D region is their outer product, and a
+// matrix times a 1D region is a matrix*vector product.
+
+template <class Array2D> class Region2D;
+
+template <typename T, int M, class Y> struct umExprRegion {};
+template <typename T, int M> struct umExprRegion< T, M, Region1D< Vector<T> > >        { typedef Vector<T>& type; };
+template <typename T, int M> struct umExprRegion< T, M, MappedRegion1D< Vector<T> > >  { typedef Vector<T>& type; };
+template <typename T, int M> struct umExprRegion< T, M, Region2D< Mat_COL<T> > >       { typedef typename umExprResult<T,M>::type& type; };
+template <typename T, int M> struct umExprRegion< T, M, MappedRegion2D< Mat_COL<T> > > { typedef typename umExprResult<T,M>::type& type; };
+
+template <typename T, int M, class Y> struct umExprRegionMul : public umExprRegion<T,M,Y> {};
+template <typename T> struct umExprRegionMul< T, 0, MappedRegion1D< Vector<T> > > { typedef Mat_COL<T>& type; };
+template <typename T> struct umExprRegionMul< T, 1, Region1D< Vector<T> > >       { typedef Vector<T>   type; };
+template <typename T> struct umExprRegionMul< T, 1, MappedRegion1D< Vector<T> > > { typedef Vector<T>   type; };
+
+#define umEXPR_REGION_OP(OP, REG, F)                                        \
+                                                                            \
+template <typename T, class A> inline                                       \
+typename F< T, VecExpr<T,A>::MAT, REG >::type                               \
+OP(const VecExpr<T,A>& a, const REG& b)  { return OP(a.eval(), b); }       \
+                                                                            \
+template <typename T, class B> inline                                       \
+typename F< T, VecExpr<T,B>::MAT, REG >::type                               \
+OP(const REG& a, const VecExpr<T,B>& b)  { return OP(a, b.eval()); }
+
+#define umEXPR_REGION(REG)                                                  \
+umEXPR_REGION_OP(operator+, REG, umExprRegion)                              \
+umEXPR_REGION_OP(operator-, REG, umExprRegion)                              \
+umEXPR_REGION_OP(operator*, REG, umExprRegionMul)                           \
+umEXPR_REGION_OP(operator/, REG, umExprRegion)
+
+umEXPR_REGION(Region1D< Vector<T> >)
+umEXPR_REGION(MappedRegion1D< Vector<T> >)
+umEXPR_REGION(Region2D< Mat_COL<T> >)
+umEXPR_REGION(MappedRegion2D< Mat_COL<T> >)
+
+#undef umEXPR_REGION
+#undef umEXPR_REGION_OP
+
+
+#endif  // NDG__VecExpr_Type_H__INCLUDED
@@ -19,6 +19,9 @@
 #include "BlasLapack.h"
 #include "RAND.h"
 #include "Registry_Type.h"
+#include "SIMD_funcs.h"
+#include "Frame_Type.h"
+#include "MemProfile.h"
 #include <complex>
 
 #include "Region1D.h"
@@ -35,8 +38,15 @@ typedef std::complex<double>  dcmplx;
 
 // typedef versions for common data types
 template <typename T> class Vector;
+template <typename T> class Mat_COL;
+template <typename T, class E> class VecExpr;
+template <typename T, int M>  class VecExprLeaf;
+template <typename T, class A, class B, class Op> class VecExprBin;
+struct umOpMul;
+struct umOpDiv;
 
 typedef Vector<double>  DVec;
+typedef Vector<float>   FVec;
 typedef Vector<dcmplx>  ZVec;
 typedef Vector<int>     IVec;
 typedef Vector<long>    LVec;
@@ -69,11 +79,17 @@ protected:
   int       m_id;       // identifier number
   OBJ_mode  m_mode;     // real or temporary
 
+#if (USE_THREAD_REGISTRY)
+  static std::atomic<int> s_count;  // track number of objects
+#else
   static int            s_count;  // track number of objects
-  static umRegistry<T>  s_Reg1;   // manage small arrays (preallocated)
-  static umRegistry<T>  s_Reg2;   // manage medium arrays (preallocated)
-  static umRegistry<T>  s_Reg3;   // manage general allocations
+#endif
+  static umTHREAD_LOCAL umArrayStats s_stats; // allocs, copies, moves
          umRegistry<T>* m_pReg;   // pointer to registry storing this data
+                                  // (small/medium/general registries 
+                                  //  are per-thread: see umRegistrySet)
+         int            m_frame;  // depth of umFrame this object was born in
+         int            m_arena;  // depth of umFrame holding data (0: registry)
   static bool           s_trace;  // toggle tracing of allocations
 
 public:
@@ -91,10 +107,23 @@ public:
   // toggle _DEBUG trace
   static void set_trace(bool b) { s_trace = b; }
 
+  // allocation/copy/move counters (all zero unless 
+  // built with TRACK_ARRAY_STATS)
+  static const umArrayStats& stats() { return s_stats; }
+  static void reset_stats()          { s_stats.reset(); }
+
 
   // constructors
   explicit Vector(const char* sz="vec",  OBJ_mode md=OBJ_real);
            Vector(const Vector<T> &B,    OBJ_mode md=OBJ_real, const char* sz="vec");
+#if (__cplusplus >= 201103L)
+  // C++11 move: O(1) transfer.  Note: the global operators
+  // still return OBJ_temp references, which operator= and
+  // the copy constructor already take over without a copy
+  // (see steal).  The rvalue forms serve code that returns
+  // or stores arrays by value (e.g. in std::vector).
+           Vector(Vector<T> &&B);
+#endif
   explicit Vector(int N, const char* sz, OBJ_mode md=OBJ_real);
   explicit Vector(int N, const T x=T(0), OBJ_mode md=OBJ_real, const char* sz="vec");
   explicit Vector(int N, const T* vdata, OBJ_mode md=OBJ_real, const char* sz="vec");
@@ -112,6 +141,7 @@ public:
   Vector<T>& borrow(const Vector<T>& CV);
   Vector<T>& own  (Vector<T>& B);   // allow lazy deallocation
   Vector<T>& own_2(Vector<T>& B);   // force immediate dealloc
+  Vector<T>& steal(Vector<T>& B);   // O(1) transfer, leaves B empty
 
   void initialize(int N, bool bInit=true, T x=T(0));
   bool resize(int N, bool bInit=true, T x=T(0));
@@ -137,10 +167,17 @@ public:
   // assignment
   Vector<T>& operator=(const T &x);
   Vector<T>& operator=(const Vector<T> &B);
+#if (__cplusplus >= 201103L)
+  Vector<T>& operator=(Vector<T> &&B);
+#endif
   // allow assignment of 
   Vector<T>& assign(const IVec &B); // enable IVec -> DVec
   Vector<T>& assign(const DVec &B); // enable DVec -> IVec
 
+  // evaluate element-wise expression (see VecExpr_Type.h)
+  template <class E> Vector<T>& operator= (const VecExpr<T,E>& X);
+  template <class E> Vector<T>& operator+=(const VecExpr<T,E>& X);
+  template <class E> Vector<T>& operator-=(const VecExpr<T,E>& X);
 
   Vector<T>& append(const T&  x);
   Vector<T>& append(const Vector<T>& B);
@@ -255,8 +292,11 @@ public:
   Vector<T>& operator*=(const Vector<T>& B);
   Vector<T>& operator/=(const Vector<T>& B);
 
-  Vector<T>& dd(const Vector<T> &B) const;    // C = A ./ B
-  Vector<T>& dm(const Vector<T> &B) const;    // C = A .* B
+  // C = A ./ B,  C = A .* B  (see VecExpr_Type.h)
+  VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,VecExprLeaf<T,0>,umOpDiv> > dd(const Vector<T> &B) const;
+  VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,VecExprLeaf<T,0>,umOpMul> > dm(const Vector<T> &B) const;
+  template <class E> VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,E,umOpDiv> > dd(const VecExpr<T,E> &B) const;
+  template <class E> VecExpr< T, VecExprBin<T,VecExprLeaf<T,0>,E,umOpMul> > dm(const VecExpr<T,E> &B) const;
 
   // this += alpha*X
   void axp_y (const T& alpha, const Vector<T>& X);
@@ -450,26 +490,16 @@ public:
 
 // allow toggling of allocation tracing in debug mode
 template <typename T> bool  Vector<T>::s_trace=false;
+#if (USE_THREAD_REGISTRY)
+template <typename T> std::atomic<int> Vector<T>::s_count(0);
+#else
 template <typename T> int   Vector<T>::s_count=0;
+#endif
+template <typename T> umTHREAD_LOCAL umArrayStats Vector<T>::s_stats={0,0,0,0,0,0};
 
 
-///////////////////////////////////////////////////////////
-//
-// Set initial sizes of the 3 registries here here
-//
-///////////////////////////////////////////////////////////
-
-// Both the smaller registries involve less memory 
-// than one large matrix, so we preallocate them:
-#if (1)
-template <typename T> umRegistry<T> Vector<T>::s_Reg1(500, true, iReg_small); //  16 =  4* 4
-template <typename T> umRegistry<T> Vector<T>::s_Reg2(500, true, iReg_med);   // 256 = 16*16
-template <typename T> umRegistry<T> Vector<T>::s_Reg3(500, false, 0);    // arbitrary length
-#else
-template <typename T> umRegistry<T> Vector<T>::s_Reg1(10, true, iReg_small); //  16 =  4* 4
-template <typename T> umRegistry<T> Vector<T>::s_Reg2(10, true, iReg_med);   // 256 = 16*16
-template <typename T> umRegistry<T> Vector<T>::s_Reg3(10, false, 0);    // arbitrary length
-#endif
+// Initial sizes of the 3 registries are set in the 
+// constructor of umRegistrySet (Registry_Type.h).
 
 
 
@@ -486,7 +516,8 @@ Vector<T>::Vector(const char* sz, OBJ_mode md)
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
 }
@@ -499,20 +530,41 @@ Vector<T>::Vector(const Vector<T> &B, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
   operator=(B);   // manage copy of real/temp objects
 }
 
 
+#if (__cplusplus >= 201103L)
+//---------------------------------------------------------
+template <typename T> inline
+Vector<T>::Vector(Vector<T> &&B)
+//---------------------------------------------------------
+: v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
+  m_name(B.m_name), m_EqTol(B.m_EqTol), m_borrowed(false),
+  m_id(-1), m_mode(OBJ_real), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, false)), m_arena(0)
+{
+  ++s_count;
+
+  // "borrowed" data stays with its owner: copy it
+  if (B.m_borrowed) { operator=((const Vector<T>&)B); }
+  else if (B.ok())  { steal(B); }
+}
+#endif
+
+
 //---------------------------------------------------------
 template <typename T> inline
 Vector<T>::Vector(int N, const char* sz, OBJ_mode md)
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 { 
   ++s_count;
   initialize(N, true, ZERO);
@@ -525,7 +577,8 @@ Vector<T>::Vector(int N, const T x, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 { 
   ++s_count;
   initialize(N, true, x); 
@@ -538,7 +591,8 @@ Vector<T>::Vector(int N, const T* vdata, OBJ_mode md, const char* sz)
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
   initialize(N, false); 
@@ -552,7 +606,8 @@ Vector<T>::Vector(const ArrayData& rAD, int N, const char *sdata, OBJ_mode md, c
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
   initialize(N, false); 
@@ -572,7 +627,8 @@ Vector<T>::Vector(const T x1, const T x2, const T x3)
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name("vec"), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(OBJ_real), m_pReg(NULL)
+  m_id(-1), m_mode(OBJ_real), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, false)), m_arena(0)
 {
   ++s_count;
   initialize(3, false); 
@@ -595,6 +651,7 @@ Vector<T>::~Vector()
 //---------------------------------------------------------
 {
   --s_count;
+  if (OBJ_temp == m_mode) { umSTAT_INC(s_stats.temp); }
 
   if (v_) {
     destroy();
@@ -607,8 +664,9 @@ template <typename T> inline
 void Vector<T>::destroy()
 //---------------------------------------------------------
 {
-  if (v_ && (!m_borrowed)) {
+  if (v_ && (!m_borrowed) && (!m_arena)) {
     assert(reg_ok());
+    umMEM_FREE(v_);
     m_pReg->free_alloc(v_, m_id);   // mark allocation as "available"
   }
 
@@ -616,6 +674,7 @@ void Vector<T>::destroy()
   vm1_  = NULL;   // so set both to NULL.
   m_Len = 0;      // no data left
   m_id  = -1;     // no slot in registry
+  m_arena = 0;    // (frame data is released by its umFrame)
 }
 
 
@@ -624,8 +683,9 @@ template <typename T> inline
 void Vector<T>::destroy_2()
 //---------------------------------------------------------
 {
-  if (v_ && (!m_borrowed)) {
+  if (v_ && (!m_borrowed) && (!m_arena)) {
     assert(reg_ok());
+    umMEM_FREE(v_);
     m_pReg->free_alloc_2(v_, m_id); // ***RELEASE*** allocation
   }
 
@@ -633,6 +693,7 @@ void Vector<T>::destroy_2()
   vm1_  = NULL;   // so set both to NULL.
   m_Len = 0;      // no data left
   m_id  = -1;     // no slot in registry
+  m_arena = 0;    // (frame data is released by its umFrame)
 }
 
 
@@ -716,23 +777,34 @@ Vector<T>& Vector<T>::own(Vector<T>& B)
     return (*this);       // both arrays are empty
   }
 
-  // Take ownership of B's allocation:
-  m_pReg= B.m_pReg;       // point to B's registry
-  m_id  = B.m_id;         // take B's slot in registry
-  v_    = B.v_;           // point to B's array
-  vm1_  = v_ - 1;         // adjust 1-offset pointer
-  m_Len = B.m_Len;        // update length
+  if (B.m_arena && (m_frame < B.m_arena)) {
+    // B's data will be released by its umFrame, 
+    // which this object outlives: copy the data.
+    initialize(B.m_Len, false);
+    copy(B.v_);
+    umSTAT_INC(s_stats.copy);
+  } else {
+    // Take ownership of B's allocation:
+    m_pReg= B.m_pReg;     // point to B's registry
+    m_id  = B.m_id;       // take B's slot in registry
+    m_arena=B.m_arena;    // take B's frame (if any)
+    v_    = B.v_;         // point to B's array
+    vm1_  = v_ - 1;       // adjust 1-offset pointer
+    m_Len = B.m_Len;      // update length
+  }
 
   m_name    = B.m_name;     // copy B's name
   m_EqTol   = B.m_EqTol;    // copy B's equality tolerance
   m_borrowed= B.m_borrowed; // copy B's borrowed status
   m_mode    = B.m_mode;     // copy B's mode
+  umMEM_OWNER(v_, m_name.c_str());
 
   // invalidate B:
   B.m_id  = -1;     // invalidate B's slot
   B.v_    = NULL;   // invalidate B's array
   B.vm1_  = NULL;   // invalidate B's array
   B.m_Len = 0;      // invalidate B's length
+  B.m_arena = 0;    // invalidate B's frame
 
   return (*this);
 }
@@ -753,6 +825,66 @@ Vector<T>& Vector<T>::own_2(Vector<T>& B)
 }
 
 
+//---------------------------------------------------------
+template <typename T> inline
+Vector<T>& Vector<T>::steal(Vector<T>& B)
+//---------------------------------------------------------
+{
+  // Transfer B's allocation to this object in O(1),
+  // without copying any data.  Unlike own(), keeps 
+  // this object's name and mode, and leaves B empty 
+  // (but still alive).  Used for OBJ_temp results 
+  // and for C++11 rvalues.
+
+  if (B.m_arena && (m_frame < B.m_arena))
+  {
+    // B's data will be released by its umFrame, which
+    // this object outlives (e.g. a member assigned a
+    // frame temporary): copy the data instead.
+    if (m_Len != B.m_Len) {
+      Vector<T>::destroy();
+      initialize(B.m_Len, false);
+    }
+    copy(B.v_);
+    umSTAT_INC(s_stats.copy);
+    B.Vector<T>::destroy();
+    return (*this);
+  }
+
+  if (reg_ok()) 
+  {
+    // free current allocation
+    assert(m_pReg->check_alloc(v_, m_id, m_Len));
+    umMEM_FREE(v_);
+    m_pReg->free_alloc(v_, m_id);
+  }
+
+  m_Len  = B.m_Len;       // copy length
+  m_id   = B.m_id;        // take B's slot in the registry
+  m_arena= B.m_arena;     // take B's frame (if any)
+  v_     = B.v_;          // take B's array
+  vm1_   = v_ ? (v_-1) : NULL;  // adjust 1-based pointer
+
+  if (B.m_borrowed) {
+    umWARNING("Vector<T>::steal(B)", "check transfer of borrowed allocation");
+    this->m_borrowed = true;
+  } else {
+    m_pReg = B.m_pReg;    // copy address of B's registry
+    assert(m_arena || m_pReg->check_alloc(v_, m_id, m_Len));
+  }
+
+  B.v_    = NULL;         // detach B from its array
+  B.vm1_  = NULL;
+  B.m_id  = -1;           // mark as unregistered
+  B.m_Len = 0;            // mark as empty (for debug trace)
+  B.m_arena = 0;
+
+  umMEM_OWNER(v_, m_name.c_str());
+  umSTAT_INC(s_stats.move);
+  return (*this);
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 void Vector<T>::initialize(int N, bool bInit, T x)
@@ -769,15 +901,30 @@ void Vector<T>::initialize(int N, bool bInit, T x)
     // About to allocate, expect v_ to be NULL
     assert( NULL == v_ );
 
-    // Select storage location:
-    if      (N <= iReg_small) { m_pReg = &s_Reg1; }
-    else if (N <= iReg_med)   { m_pReg = &s_Reg2; }
-    else                      { m_pReg = &s_Reg3; }
+    if (m_frame > 0 && m_frame == umFrameArena::local().depth())
+    {
+      // born in the innermost open umFrame: bump-allocate 
+      // from the frame arena, released when frame closes
+      v_ = (T*) umFrameArena::local().alloc(N*sizeof(T));
+      m_pReg = NULL;  m_id = -1;  m_arena = m_frame;
+      umSTAT_INC(s_stats.frame);
+      umMEM_FRAME(long(N)*(long)sizeof(T), m_name.c_str(), OBJ_temp==m_mode);
+    }
+    else
+    {
+      // Select storage location (this thread's registries):
+      umRegistrySet<T>& R = umRegistrySet<T>::local();
+      if      (N <= iReg_small) { m_pReg = &R.reg1; }
+      else if (N <= iReg_med)   { m_pReg = &R.reg2; }
+      else                      { m_pReg = &R.reg3; }
     
-    v_ = m_pReg->get_alloc(N, m_id);
+      v_ = m_pReg->get_alloc(N, m_id);
+      umSTAT_INC(s_stats.alloc);
     
-    assert(m_pReg->check_alloc(v_, m_id, N));
-    if (!v_) { umERROR("Vector<T>::initialize(%d)", "alloc failed (%0.2lf MB)", N, double(N*(int)sizeof(T))/(1024.*1024.)); }
+      assert(m_pReg->check_alloc(v_, m_id, N));
+      if (!v_) { umERROR("Vector<T>::initialize(%d)", "alloc failed (%0.2lf MB)", N, double(N*(int)sizeof(T))/(1024.*1024.)); }
+      umMEM_ALLOC(v_, long(N)*(long)sizeof(T), m_name.c_str(), OBJ_temp==m_mode);
+    }
     
     vm1_  = v_ - 1;   // make 1-offset
   }
@@ -894,20 +1041,31 @@ bool Vector<T>::extend(int N, bool bInit, T x)
     // a. If new size "fits"    in current registry, just resize
     // b. If new size "belongs" in current registry, just resize
 
-    if      (                    (N <= iReg_small) && (&s_Reg1==m_pReg)) {v_ = s_Reg1.resize_alloc(v_, N, m_id);}
-    else if ((N > iReg_small) && (N <= iReg_med  ) && (&s_Reg2==m_pReg)) {v_ = s_Reg2.resize_alloc(v_, N, m_id);}
-    else if ((N > iReg_med)                        && (&s_Reg3==m_pReg)) {v_ = s_Reg3.resize_alloc(v_, N, m_id);}
+    // Note: resize in the registry that holds the array.
+    // Arrays held in a umFrame arena, or in a registry of
+    // another thread, are moved to the calling thread's 
+    // registries (see switch_Registry, umRegistry<T>).
+    umREG_size rt = m_arena ? umREG_GENERAL : m_pReg->reg_type();
+    T* vold = v_;
+
+    if      (m_arena)               { switch_Registry(N, bInit, x); }
+    else if (!m_pReg->is_owner())   { switch_Registry(N, bInit, x); }
+    else if (                    (N <= iReg_small) && (umREG_SMALL  ==rt)) {v_ = m_pReg->resize_alloc(v_, N, m_id);}
+    else if ((N > iReg_small) && (N <= iReg_med  ) && (umREG_MEDIUM ==rt)) {v_ = m_pReg->resize_alloc(v_, N, m_id);}
+    else if ((N > iReg_med)                        && (umREG_GENERAL==rt)) {v_ = m_pReg->resize_alloc(v_, N, m_id);}
     else {
       switch_Registry(N, bInit, x);
     }
 
     if (!v_) {
-      umWARNING("Vector::extend()", "Call to s_Reg.resize_alloc(%d) failed", N);
+      umWARNING("Vector::extend()", "Call to m_pReg->resize_alloc(%d) failed", N);
+      umMEM_MOVE(vold, NULL, 0);
       destroy();
       return false;
     } 
     else 
     {
+      umMEM_MOVE(vold, v_, long(N)*(long)sizeof(T));
       vm1_ = v_ - 1;    // update 1-offset pointer
       m_Len=N;
       if (N>0 && bInit) 
@@ -940,9 +1098,13 @@ bool Vector<T>::switch_Registry(int N, bool bInit, T x)
 #if defined(_DEBUG) || defined(DEBUG)
   //#####################################################
   bool bSwitched = false;
-  if (&s_Reg1 == m_pReg)
+  if (m_arena)
+  {
+    umTRC(1, "switch_Registry: frame    --> (new allocation)\n");
+  }
+  else if (umREG_SMALL == m_pReg->reg_type())
   { 
-    // currently in s_Reg1: fixed (small)
+    // currently in small registry: fixed
     if (N <= iReg_small) {
       umTRC(1, "switch_Registry: small    (no change)\n");
     } else if (N <= iReg_med) {
@@ -953,9 +1115,9 @@ bool Vector<T>::switch_Registry(int N, bool bInit, T x)
       bSwitched = true;
     }
   }
-  else if (&s_Reg2 == m_pReg)
+  else if (umREG_MEDIUM == m_pReg->reg_type())
   {
-    // currently in s_Reg2: fixed (medium)
+    // currently in medium registry: fixed
     if (N <= iReg_small) {
       umTRC(1, "switch_Registry: medium   --> small\n");
       bSwitched = true;
@@ -968,7 +1130,7 @@ bool Vector<T>::switch_Registry(int N, bool bInit, T x)
   }
   else
   {
-    // currently in s_Reg2: dynamic
+    // currently in general registry: dynamic
     if (N <= iReg_small) {
       umTRC(1, "switch_Registry: dynamic  --> small\n");
       bSwitched = true;
@@ -983,13 +1145,13 @@ bool Vector<T>::switch_Registry(int N, bool bInit, T x)
 #endif
 
   // constructor selects correct registry
-  Vector<T> *tmp = new Vector<T>(N, ZERO, OBJ_temp, "switching");
+  Vector<T> *tmp = new Vector<T>(N, ZERO, OBJ_temp, m_name.c_str());
 
   int L=std::min(size(), N);  // how much data to copy?
   tmp->copy(L, data());       // copy existing data
   (*this) = (*tmp);           // switch ownership, delete tmp
 
-  assert(reg_ok());
+  assert(m_arena || reg_ok());
   return (pRegOld == m_pReg) ? false : true;
 }
 
@@ -1003,10 +1165,6 @@ bool Vector<T>::reg_ok() const
   if (!m_pReg) { return false; }
   if (!v_    ) { return false; }
 
-  if ((m_pReg != &s_Reg1) && 
-      (m_pReg != &s_Reg2) && 
-      (m_pReg != &s_Reg3)) { return false; }
-
   bool bOK = m_pReg->check_alloc(v_, m_id, m_Len);
   return bOK;
 }
@@ -1019,9 +1177,11 @@ template <typename T> inline
 void Vector<T>::compact() const
 //---------------------------------------------------------
 {
-//s_Reg1.compact();  // no change to fixed-size registry
-//s_Reg2.compact();  // no change to fixed-size registry
-  s_Reg3.compact();  // release all unused allocations
+  // compact the calling thread's registries
+  umRegistrySet<T>& R = umRegistrySet<T>::local();
+//R.reg1.compact();  // no change to fixed-size registry
+//R.reg2.compact();  // no change to fixed-size registry
+  R.reg3.compact();  // release all unused allocations
 }
 
 
@@ -1261,6 +1421,7 @@ Vector<T>& Vector<T>::operator=(const Vector<T> &B)
     // match, deep copy the data to the external array:
     if (m_Len == B.m_Len) {
       copy(B.v_);   // deep copy into external array
+      umSTAT_INC(s_stats.copy);
     } else {
       umERROR("Vector::operator=(Vector&)", 
         "When assigning an array to a borrowed  \n"
@@ -1283,41 +1444,42 @@ Vector<T>& Vector<T>::operator=(const Vector<T> &B)
       initialize(B.m_Len, false); // re-use, with housekeeping 
       copy(B.v_);
     }
+    umSTAT_INC(s_stats.copy);
   }
   else
   {
     // B is a "temporary" object: transfer ownership
+    steal(const_cast<Vector<T>& >(B));
+    delete &B;            // delete temporary object
+  }
 
-    Vector<T> &Bref = const_cast<Vector<T>& >(B);
+  return (*this);
+}
 
-    if (reg_ok()) 
-    {
-      // free current allocation
-      assert(m_pReg->check_alloc(v_, m_id, m_Len));
-      m_pReg->free_alloc(v_, m_id); // free current allocation
-    }
 
-    m_Len  = Bref.size();   // copy length
-    m_id   = Bref.get_id(); // take B's slot in the registry
-    v_     = Bref.get_v();  // take B's array
-    vm1_   = v_ - 1;        // adjust 1-based pointer
+#if (__cplusplus >= 201103L)
+//---------------------------------------------------------
+template <typename T> inline
+Vector<T>& Vector<T>::operator=(Vector<T> &&B)
+//---------------------------------------------------------
+{
+  // C++11 move assignment: take B's allocation in O(1).
+  // Borrowed arrays (on either side) need a deep copy.
 
-    if (B.is_borrowed()) {
-      umWARNING("Vector<T>::operator=(B)", "check transfer of borrowed allocation");
-      this->m_borrowed = true;
-    } else {
-      m_pReg = Bref.get_reg();  // copy address of B's registry
-      assert(m_pReg->check_alloc(v_, m_id, m_Len));
-    }
+  if (this == &B) { return (*this); }
 
-    Bref.set_v(NULL);     // detach B from its array
-    Bref.set_id(-1);      // mark as unregistered
-    Bref.m_Len = 0;       // mark as empty (for debug trace)
-    delete &B;            // delete temporary object
+  if (m_borrowed || B.m_borrowed) {
+    return operator=((const Vector<T>&)B);
   }
 
+  if (m_name=="vec" || m_name=="mat" || m_name.empty()) 
+    m_name=B.name();
+
+  if (B.ok()) { steal(B);  }
+  else        { destroy(); }
   return (*this);
 }
+#endif
 
 
 //---------------------------------------------------------
@@ -1456,6 +1618,16 @@ Vector<T>& Vector<T>::set_abs()
 }
 
 
+//---------------------------------------------------------
+template <> inline  // specialization for T=double
+Vector<double>& Vector<double>::set_abs()
+//---------------------------------------------------------
+{
+  umV_abs(m_Len, v_);
+  return (*this);
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 Vector<T>& Vector<T>::set_min_val(double dtol)
@@ -1509,6 +1681,26 @@ Vector<T>& Vector<T>::SQR()
 }
 
 
+//---------------------------------------------------------
+template <> inline  // specialization for T=double
+Vector<double>& Vector<double>::SQRT()
+//---------------------------------------------------------
+{
+  umV_sqrt(m_Len, v_);    // (v>0) ? sqrt(v) : 0
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <> inline  // specialization for T=double
+Vector<double>& Vector<double>::SQR()
+//---------------------------------------------------------
+{
+  umV_sqr(m_Len, v_);
+  return (*this);
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 T Vector<T>::max_val() const
@@ -2059,8 +2251,8 @@ void Vector<double>::mult_val(const double &x)
   if (ZERO==x) {fill(ZERO); return;}
   if (ONE ==x) { return; }
 
-  // call BLAS dscal()
-  SCAL(m_Len, x, v_, 1);
+  // SIMD version of BLAS dscal()
+  umV_scal(m_Len, x, v_);
 }
 
 
@@ -2168,8 +2360,8 @@ Vector<double>& Vector<double>::operator+=(const Vector<double>& B)
 {
   assert(B.size() >= m_Len);    // B may be longer than A
   const double* p = B.data();   // operate on the base array
-  // call BLAS daxpy()
-  AXPY(m_Len, 1.0, (double*)p, 1, v_, 1);
+  // SIMD version of BLAS daxpy()
+  umV_add(m_Len, v_, p);
 
   // if B is temporary, delete it.
   if (B.get_mode() == OBJ_temp) {delete (&B);}
@@ -2213,8 +2405,8 @@ Vector<double>& Vector<double>::operator-=(const Vector<double>& B)
 {
   assert(B.size() >= m_Len);    // B may be longer than A
   const double *p = B.data();   // operate on the base array
-  // call BLAS daxpy()
-  AXPY(m_Len, -1.0, (double*)p, 1, v_, 1);
+  // SIMD version of BLAS daxpy()
+  umV_sub(m_Len, v_, p);
 
   // if B is temporary, delete it.
   if (B.get_mode() == OBJ_temp) {delete (&B);}
@@ -2277,6 +2469,17 @@ Vector<T>& Vector<T>::operator*=(const T* p)
 }
 
 
+//---------------------------------------------------------
+template <> inline  // specialization for T=double
+Vector<double>& Vector<double>::operator*=(const double* p)
+//---------------------------------------------------------
+{
+  // element-by-element --> A .* data
+  umV_mul(m_Len, v_, p);
+  return (*this);
+}
+
+
 //---------------------------------------------------------
 template <typename T> inline
 Vector<T>& Vector<T>::operator*=(const Vector<T>& B)
@@ -2330,40 +2533,22 @@ Vector<T>& Vector<T>::operator/=(const Vector<T>& B)
 
 
 //---------------------------------------------------------
-template <typename T> inline
-Vector<T>& Vector<T>::dd(const Vector<T> &B) const
-//---------------------------------------------------------
-{
-  // (*this) is not changed: C = A ./ B
-
-#ifndef NDEBUG
-  // FIXME: tmp ctor may delete (*this)
-  // if (OBJ_temp == m_mode) {umWARNING("Vector<T>::dd(B)", "check for side-effects");}
-#endif
-
-  std::string sz; tmp_op_name(name(), "./", B.name(), sz);
-  Vector<T> *tmp=new Vector<T>((*this), OBJ_temp, sz.c_str());
-  (*tmp)/=(B);
-  return (*tmp);
-}
-  
-
-//---------------------------------------------------------
-template <typename T> inline
-Vector<T>& Vector<T>::dm(const Vector<T> &B) const
+template <> inline  // specialization for T=double
+Vector<double>& Vector<double>::operator/=(const Vector<double>& B)
 //---------------------------------------------------------
 {
-  // (*this) is not changed: C = A .* B
+  // element-by-element --> A ./ B
 
-#ifndef NDEBUG
-  // FIXME: tmp ctor may delete (*this)
-  //if (OBJ_temp == m_mode) {umWARNING("Vector<T>::dm(B)", "check for side-effects");}
-#endif
+  if (m_Len>0) 
+  {
+    assert(B.size() >= m_Len);      // B may be longer than A
+    assert(B.min_val_abs()>0.0);    // DEBUG check for zero divisor
+    umV_div(m_Len, v_, B.data());
+  }
 
-  std::string sz; tmp_op_name(name(), ".*", B.name(), sz);
-  Vector<T> *tmp=new Vector<T>((*this), OBJ_temp, sz.c_str());
-  (*tmp)*=(B);
-  return (*tmp);
+  // if B is temporary, delete it.
+  if (B.get_mode() == OBJ_temp) {delete (&B);}
+  return (*this);
 }
 
 
@@ -2374,7 +2559,7 @@ void Vector<double>::axp_y(const double& alpha, const Vector<double>& X)
 {
   // BLAS example:  this += alpha*X
   assert(this->size() == X.size());
-  AXPY(m_Len, alpha, (double*)X.data(), 1, this->v_, 1);
+  umV_axpy(m_Len, alpha, X.data(), this->v_);
 
   // if X is temporary, delete it.
   if (X.get_mode() == OBJ_temp) {delete (&X);}
@@ -2405,7 +2590,7 @@ void Vector<double>::axp_y
   assert(Y.size() == X.size());
 
   (*this) = Y;    // copy Y, then add alpha*X,
-  AXPY(m_Len, alpha, (double*)X.data(), 1, this->v_, 1);
+  umV_axpy(m_Len, alpha, X.data(), this->v_);
 
   // operator=() above deletes temporary Y
   // if X is temporary, delete it here.
@@ -2476,7 +2661,7 @@ void Vector<T>::print
 ) const
 //---------------------------------------------------------
 {
-  static char buf[20] = {""};
+  static umTHREAD_LOCAL char buf[20] = {""};
 
   // write min(nv,len) vals
   int len = this->size();
@@ -2753,179 +2938,8 @@ void Vector<T>::m_load_v(FILE *fp, char **name)
 ///////////////////////////////////////////////////////////
 
 
-// C = A + B
-// C = A - B
-
-template <typename T> inline 
-Vector<T>& operator+(const Vector<T> &A, const Vector<T> &B) 
-{
-  std::string sz; tmp_op_name(A.name(),"+",B.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += B;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator-(const Vector<T> &A, const Vector<T> &B) 
-{
-  std::string sz; tmp_op_name(A.name(),"-",B.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) -= B;
-  return (*tmp);
-}
-
-
-// C = A + x
-// C = x + A
-// C = A - x
-// C = x - A  (make vector X from scalar x)
-
-template <typename T> inline 
-Vector<T>& operator+(const Vector<T> &A, const T &x) 
-{
-  std::string sz; tmp_op_name(A.name(),"+","x", sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += x;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator+(const T &x, const Vector<T> &A) 
-{
-  std::string sz; tmp_op_name("x","+",A.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) += x;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator-(const Vector<T> &A, const T &x) 
-{
-  std::string sz; tmp_op_name(A.name(),"-","x", sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) -= x;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator-(const T &x, const Vector<T> &A)
-{ 
-  // Create vec X filled with scalar x, then call X - A
-
-  std::string sz; tmp_op_name("x","-",A.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A.size(), x, OBJ_temp, sz.c_str());
-  (*tmp) -= A;
-  return (*tmp);
-}
-
-
-
-// C = A * x
-// C = x * A
-// C = A .* B   Note: element-by-element
-// C = A ./ B   Note: element-by-element
-// C = A / x
-// C = x / A
-
-template <typename T> inline 
-Vector<T>& operator*(const Vector<T> &A, const T &x) 
-{
-  std::string sz; tmp_op_name(A.name(),"*","x", sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= x;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator*(const T &x, const Vector<T> &A) 
-{
-  std::string sz; tmp_op_name("x","*",A.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= x;
-  return (*tmp);
-}
-
-
-/*
-//---------------------------------------------------------
-// specialization for T=double
-inline DVec& operator*(const DVec& A, const DVec& B) 
-//---------------------------------------------------------
-{
-  int n = A.size();
-  assert(A.size() == n);
-  // element-by-element --> A .* B
-  // using BLAS2 symmetric banded mat*vec
-  std::string sz; tmp_op_name(A.name(),"*",B.name(), sz);
-//DVec *tmp=new DVec(A, OBJ_temp, sz.c_str());
-  DVec *tmp=new DVec(n, sz.c_str(), OBJ_temp);
-//dsbmv(uplo, n, kd, alpha, double *a,  lda, double *x, int incx, double beta, double *y, int incy);
-  SBMV ('U',  n, 0,   1.0,  A.data(),     1,  B.data(),    1,        0.0,   tmp->data(),     1);
-  if (A.get_mode() == OBJ_temp) { delete (&A); }
-  if (B.get_mode() == OBJ_temp) { delete (&B); }
-  return (*tmp);
-}
-*/
-
-template <typename T> inline 
-Vector<T>& operator*(const Vector<T> &A, const Vector<T> &B) 
-{
-  // element-by-element --> A .* B
-  std::string sz; tmp_op_name(A.name(),"*",B.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= B;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator/(const Vector<T> &A, const Vector<T> &B) 
-{ 
-  // element-by-element --> A ./ B
-  std::string sz; tmp_op_name(A.name(),"/",B.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) /= B;
-  return (*tmp);
-}
-
-
-template <typename T> inline 
-Vector<T>& operator/(const Vector<T> &A, const T &x) 
-{
-  std::string sz; tmp_op_name(A.name(),"/","x", sz);
-  assert(std::abs(x) > (T)0);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) /= x;
-  return (*tmp);
-}
-
-
-template <typename T> inline
-Vector<T>& operator/(const T &x, const Vector<T> &A) 
-{ 
-  // create a vector filled with scalar x;  tmp = tmp./A
-  std::string sz; tmp_op_name("x","/",A.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A.size(), x, OBJ_temp, sz.c_str());
-  (*tmp) /= A;
-  return (*tmp);
-}
+// C = A + B, A - B, A * B, A / B, -A  (element-wise):
+// see VecExpr_Type.h
 
 
 
@@ -2972,7 +2986,6 @@ inline double norm(const DVec& V)
 ///////////////////////////////////////////////////////////
 
 
-// C = -A     : unary negation
 // C = !A     : boolean not
 // x = A.B    : inner product
 // Z = aX+Y   : [*]axpy
@@ -2980,18 +2993,6 @@ inline double norm(const DVec& V)
 // Y = apply(f, X);
 
 
-// negation (unary operator)
-template <typename T> inline 
-Vector<T>& operator- (const Vector<T> &A) 
-{
-  std::string sz; tmp_op_name(" ","-",A.name(), sz);
-
-  Vector<T> *tmp=new Vector<T>(A, OBJ_temp, sz.c_str());
-  (*tmp) *= T(-1);
-  return (*tmp);
-}
-
-
 // boolean (unary operator)
 template <typename T> inline 
 Vector<T>& operator! (const Vector<T> &A)
@@ -3693,7 +3694,7 @@ Vector<T>& Vector<T>::get_map(const IVec& iM) const
   //
   //  v = q.map(um->vmapR) - q.map(um->vmapL);
 
-  static char buf[100]={""};
+  static umTHREAD_LOCAL char buf[100]={""};
   snprintf(buf, (size_t)90, "vmap(%s)", this->name());
   int idx=0, len=iM.size();
   Vector<T> *tmp=new Vector<T>(len, ZERO, OBJ_temp, buf);
@@ -3767,7 +3768,8 @@ template <typename T> inline
 Vector<T>::Vector(const Region1D< Vector<T> > &R, OBJ_mode md, const char *sz)
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
   (*this)=R;  // vector = region
@@ -3779,7 +3781,8 @@ template <typename T> inline
 Vector<T>::Vector(const_Region1D< Vector<T> > &R, OBJ_mode md, const char *sz)
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
   (*this)=R;  // vector = region
@@ -4082,7 +4085,8 @@ Vector<T>::Vector(const MappedRegion1D< Vector<T> > &R, OBJ_mode md, const char
 //---------------------------------------------------------
 : v_(0), vm1_(0), m_Len(0), ZERO(0), ONE(1),
   m_name(sz), m_EqTol(0.0), m_borrowed(false),
-  m_id(-1), m_mode(md), m_pReg(NULL)
+  m_id(-1), m_mode(md), m_pReg(NULL),
+  m_frame(umFrameArena::birth(this, OBJ_temp==md)), m_arena(0)
 {
   ++s_count;
   (*this)=R;  // vector = mapped region
@@ -4406,5 +4410,11 @@ Vector<T>& operator-(T x, const MappedRegion1D< Vector<T> > &A)
   return (*tmp);
 }
 
+
+//---------------------------------------------------------
+// element-wise expressions
+//---------------------------------------------------------
+#include "VecExpr_Type.h"
+
 #endif  // NDG__Vector_Type_H__INCLUDED
 
@@ -0,0 +1,367 @@
+// View2D.h
+// non-owning strided views of matrix/vector data
+// 2026/10/17
+//---------------------------------------------------------
+#ifndef NDG__View2D_H__INCLUDED
+#define NDG__View2D_H__INCLUDED
+
+//---------------------------------------------------------
+// A View2D<T> refers to an (M,N) block of column-major
+// data with leading dimension ld, i.e. element (i,j) is
+// p[(i-1) + (j-1)*ld].  It owns nothing, so it is cheap
+// to create and pass by value.  Columns, rows and blocks
+// of a Mat_COL, contiguous regions, and columns reshaped
+// as (M,N) matrices are all views:
+//
+//   DView2D c = col_view(rhsQ, n);        // rhsQ(All,n)
+//   DView2D r = row_view(A, i);           // A(i,All): 1xN, ld=M
+//   DView2D b = block_view(A, I, J);      // A(I,J)
+//   DView2D q = col_view(cQ, n, Nc, K);   // cQ(All,n) as (Nc,K)
+//   DView2D s = stack_view(cQ, Nc);       // cQ as (Nc,4*K)
+//   DView2D v = view(rhsQ(II,n));         // from a Region1D
+//
+// Writes through a view go straight into the viewed
+// array, and BLAS/LAPACK calls read and write the view's
+// data in place (see umAxB and chol_solve in Mat_COL.cpp):
+//
+//   umAxB(cub.V, qn, col_view(cQ,n,Nc,K));  // cQ(All,n) = cub.V*qn
+//   chol_solve(mmCHOL, view(rhsQ(II,n)));   // in-place solve
+//
+// so that, unlike assignments to a Region1D/Region2D, no
+// temporary is created and copied back.  Index-mapped
+// regions (MappedRegion1D/2D) are not strided, and have
+// no views.
+//
+// Assigning to a view copies data into it (as for Region2D);
+// copy-constructing a view makes another view of the same
+// data.  A view is invalidated if its array is resized.
+//---------------------------------------------------------
+
+
+//---------------------------------------------------------
+// element-wise helpers: SIMD kernels for double
+//---------------------------------------------------------
+template <typename T> inline void umView_add(int n, T* y, const T* x) { for (int i=0;i<n;++i) {y[i] += x[i];} }
+template <typename T> inline void umView_sub(int n, T* y, const T* x) { for (int i=0;i<n;++i) {y[i] -= x[i];} }
+template <typename T> inline void umView_mul(int n, T* y, const T* x) { for (int i=0;i<n;++i) {y[i] *= x[i];} }
+template <typename T> inline void umView_div(int n, T* y, const T* x) { for (int i=0;i<n;++i) {y[i] /= x[i];} }
+template <typename T> inline void umView_scal(int n, T a, T* y)       { for (int i=0;i<n;++i) {y[i] *= a;} }
+
+inline void umView_add(int n, double* y, const double* x) { umV_add(n, y, x); }
+inline void umView_sub(int n, double* y, const double* x) { umV_sub(n, y, x); }
+inline void umView_mul(int n, double* y, const double* x) { umV_mul(n, y, x); }
+inline void umView_div(int n, double* y, const double* x) { umV_div(n, y, x); }
+inline void umView_scal(int n, double a, double* y)       { umV_scal(n, a, y); }
+
+
+//---------------------------------------------------------
+template <typename T>
+class View2D
+//---------------------------------------------------------
+{
+protected:
+  T*    p_;       // (1,1) element
+  int   m_M;      // rows
+  int   m_N;      // cols
+  int   m_ld;     // distance between columns
+
+public:
+
+  View2D() : p_(NULL), m_M(0), m_N(0), m_ld(0) {}
+  View2D(T* p, int M, int N, int ld) : p_(p), m_M(M), m_N(N), m_ld(ld)
+  { assert(M>=0 && N>=0 && ld>=M); }
+  View2D(T* p, int M, int N=1) : p_(p), m_M(M), m_N(N), m_ld(M)
+  { assert(M>=0 && N>=0); }
+
+  // "view" of a whole array
+  explicit View2D(Vector<T>& V) : p_(V.data()), m_M(V.size()), m_N(1), m_ld(V.size()) {}
+  explicit View2D(Mat_COL<T>& A) : p_(A.data()), m_M(A.num_rows()), m_N(A.num_cols()), m_ld(A.ld()) {}
+
+  // another view of the same data (operator= below copies
+  // the data instead, so the copy constructor is declared)
+#if (__cplusplus >= 201103L)
+  View2D(const View2D<T>& B) = default;
+#endif
+
+        T* data()             { return p_; }
+  const T* data()       const { return p_; }
+        T* pCol(int j)        { return p_ + (j-1)*m_ld; }
+  const T* pCol(int j)  const { return p_ + (j-1)*m_ld; }
+
+  int   num_rows()      const { return m_M; }
+  int   num_cols()      const { return m_N; }
+  int   ld()            const { return m_ld; }
+  int   size()          const { return m_M*m_N; }
+  bool  is_contiguous() const { return (m_ld==m_M || m_N<=1); }
+
+  T& operator()(int i, int j=1) {
+    CheckIdx(i,j); return p_[(i-1) + (j-1)*m_ld];
+  }
+  const T& operator()(int i, int j=1) const {
+    CheckIdx(i,j); return p_[(i-1) + (j-1)*m_ld];
+  }
+
+  // assignment writes into the viewed data
+  View2D<T>& operator=(const View2D<T>& B);
+  View2D<T>& operator=(const Vector<T>& B);   // B: (M*N) values, column-major
+  View2D<T>& operator=(const T& x);
+
+  View2D<T>& operator+=(const Vector<T>& B);
+  View2D<T>& operator-=(const Vector<T>& B);
+  View2D<T>& operator*=(const T& x);
+  View2D<T>& operator/=(const T& x) { assert(T(0)!=x); return (*this) *= (T(1)/x); }
+
+  View2D<T>& mult_element(const Vector<T>& B);  // .*
+  View2D<T>& mult_element(const View2D<T>& B);
+  View2D<T>& div_element (const Vector<T>& B);  // ./
+  View2D<T>& div_element (const View2D<T>& B);
+
+protected:
+  void CheckIdx(int i, int j) const {
+#if (CHECK_ARRAY_INDEX)
+    assert(i>=1 && i<=m_M && j>=1 && j<=m_N);
+#endif
+  }
+  void CheckDims(const View2D<T>& B) const {
+    assert(B.num_rows()==m_M && B.num_cols()==m_N);
+  }
+};
+
+typedef View2D<double>  DView2D;
+typedef View2D<int>     IView2D;
+
+
+///////////////////////////////////////////////////////////
+//
+// creating views
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> col_view(Mat_COL<T>& A, int j)
+//---------------------------------------------------------
+{
+  // A(All,j)
+  return View2D<T>(A.pCol(j), A.num_rows(), 1);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> col_view(Mat_COL<T>& A, int j, int M, int N)
+//---------------------------------------------------------
+{
+  // A(All,j), as an (M,N) matrix
+  assert(M*N == A.num_rows());
+  return View2D<T>(A.pCol(j), M, N);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> stack_view(Mat_COL<T>& A, int M)
+//---------------------------------------------------------
+{
+  // all columns of A, each reshaped as (M,N/M) and stacked
+  // side by side: an (M, N*ncols/M) matrix, so one product
+  // acts on every field, e.g. Q(Np*K,4) -> (Np,4*K)
+  assert(M>0 && 0 == A.num_rows()%M);
+  return View2D<T>(A.data(), M, (A.num_rows()/M)*A.num_cols());
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> row_view(Mat_COL<T>& A, int i)
+//---------------------------------------------------------
+{
+  // A(i,All): a (1,N) view with stride num_rows
+  assert(i>=1 && i<=A.num_rows());
+  return View2D<T>(A.data()+(i-1), 1, A.num_cols(), A.num_rows());
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> block_view(Mat_COL<T>& A, const Index1D& I, const Index1D& J)
+//---------------------------------------------------------
+{
+  // A(I,J)
+  assert(I.lo()>=1 && I.hi()<=A.num_rows() && I.lo()<=I.hi());
+  assert(J.lo()>=1 && J.hi()<=A.num_cols() && J.lo()<=J.hi());
+  return View2D<T>(A.data() + (I.lo()-1) + (J.lo()-1)*A.num_rows(),
+                   I.N(), J.N(), A.num_rows());
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> view(const Region1D< Vector<T> >& R)
+//---------------------------------------------------------
+{
+  // contiguous region, e.g. rhsQ(II,n)
+  T* p = const_cast<Vector<T>&>(R.array()).data() + R.offset();
+  return View2D<T>(p, R.size(), 1);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T> view(const Region2D< Mat_COL<T> >& R)
+//---------------------------------------------------------
+{
+  // block region, e.g. A(I,J)
+  Mat_COL<T>& A = const_cast<Mat_COL<T>&>(R.array());
+  T* p = A.data() + R.offset(1) + R.offset(2)*A.num_rows();
+  return View2D<T>(p, R.num_rows(), R.num_cols(), A.num_rows());
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// element-wise operations: one kernel call per column
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::operator=(const View2D<T>& B)
+//---------------------------------------------------------
+{
+  CheckDims(B);
+  for (int j=1; j<=m_N; ++j) {
+    memmove(pCol(j), B.pCol(j), m_M*sizeof(T));
+  }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::operator=(const Vector<T>& B)
+//---------------------------------------------------------
+{
+  assert(B.size() == size());
+  const T* b = B.data();
+  for (int j=1; j<=m_N; ++j, b+=m_M) {
+    memcpy(pCol(j), b, m_M*sizeof(T));
+  }
+  if (B.get_mode() == OBJ_temp) { delete (&B); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::operator=(const T& x)
+//---------------------------------------------------------
+{
+  for (int j=1; j<=m_N; ++j) {
+    T* c = pCol(j);
+    for (int i=0; i<m_M; ++i) { c[i] = x; }
+  }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::operator+=(const Vector<T>& B)
+//---------------------------------------------------------
+{
+  assert(B.size() == size());
+  const T* b = B.data();
+  for (int j=1; j<=m_N; ++j, b+=m_M) { umView_add(m_M, pCol(j), b); }
+  if (B.get_mode() == OBJ_temp) { delete (&B); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::operator-=(const Vector<T>& B)
+//---------------------------------------------------------
+{
+  assert(B.size() == size());
+  const T* b = B.data();
+  for (int j=1; j<=m_N; ++j, b+=m_M) { umView_sub(m_M, pCol(j), b); }
+  if (B.get_mode() == OBJ_temp) { delete (&B); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::operator*=(const T& x)
+//---------------------------------------------------------
+{
+  for (int j=1; j<=m_N; ++j) { umView_scal(m_M, x, pCol(j)); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::mult_element(const Vector<T>& B)
+//---------------------------------------------------------
+{
+  assert(B.size() == size());
+  const T* b = B.data();
+  for (int j=1; j<=m_N; ++j, b+=m_M) { umView_mul(m_M, pCol(j), b); }
+  if (B.get_mode() == OBJ_temp) { delete (&B); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::mult_element(const View2D<T>& B)
+//---------------------------------------------------------
+{
+  CheckDims(B);
+  for (int j=1; j<=m_N; ++j) { umView_mul(m_M, pCol(j), B.pCol(j)); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::div_element(const Vector<T>& B)
+//---------------------------------------------------------
+{
+  assert(B.size() == size());
+  const T* b = B.data();
+  for (int j=1; j<=m_N; ++j, b+=m_M) { umView_div(m_M, pCol(j), b); }
+  if (B.get_mode() == OBJ_temp) { delete (&B); }
+  return (*this);
+}
+
+
+//---------------------------------------------------------
+template <typename T> inline
+View2D<T>& View2D<T>::div_element(const View2D<T>& B)
+//---------------------------------------------------------
+{
+  CheckDims(B);
+  for (int j=1; j<=m_N; ++j) { umView_div(m_M, pCol(j), B.pCol(j)); }
+  return (*this);
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// BLAS/LAPACK on views (see Mat_COL.cpp)
+//
+///////////////////////////////////////////////////////////
+
+// C = alpha*A*B + beta*C, written into the view C
+void umAxB(const DMat&    A, const DMat&    B, DView2D C, double alpha=1.0, double beta=0.0);
+void umAxB(const DMat&    A, const DView2D& B, DView2D C, double alpha=1.0, double beta=0.0);
+
+// solve in place: X = inv(A)*X, A Cholesky-factored
+void chol_solve(const DMat& ch, DView2D X);
+
+#endif  // NDG__View2D_H__INCLUDED
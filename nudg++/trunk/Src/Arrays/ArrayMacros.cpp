@@ -15,3 +15,10 @@ MatColData   gColData;
 // Object to help Region2D return a matrix column/row
 MatDimension   All;
 
+// number of umFrames open on all threads (see Frame_Type.h)
+#if (USE_THREAD_REGISTRY)
+std::atomic<int> g_umFrames_open(0);
+#else
+int              g_umFrames_open = 0;
+#endif
+
@@ -0,0 +1,165 @@
+// BatchChol.cpp
+// batched solves with the Cholesky-factored mass matrices
+// of curved elements
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+
+#include "BatchChol.h"
+#include "SIMD_funcs.h"
+
+#include <vector>
+
+#if (USE_SIMD_KERNELS) && defined(__GNUC__) && defined(__x86_64__)
+#define umBC_X86  1
+#else
+#define umBC_X86  0
+#endif
+
+
+//---------------------------------------------------------
+// baseline kernels (SSE2 on x86-64)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umBC_base
+#include "BatchChol_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+
+#if (umBC_X86)
+
+//---------------------------------------------------------
+// AVX2 kernels (no FMA: see BatchChol.h)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx2")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umBC_avx2
+#include "BatchChol_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+
+//---------------------------------------------------------
+// AVX-512 kernels
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx512f")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umBC_avx512
+#include "BatchChol_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+#endif  // umBC_X86
+
+
+typedef void (*umBC_fn)(int Np, int nf, const double* U, double* X);
+
+//---------------------------------------------------------
+static umBC_fn umBC_select()
+//---------------------------------------------------------
+{
+#if (umBC_X86)
+  switch (umSIMD_level()) {
+  case umSIMD_AVX512: return umBC_avx512::potrs;
+  case umSIMD_AVX2:   return umBC_avx2  ::potrs;
+  default:            break;
+  }
+#endif
+  return umBC_base::potrs;
+}
+
+
+//---------------------------------------------------------
+void umBatchChol::reset(const DMat& CHOL, const IVec& elmts, int Np)
+//---------------------------------------------------------
+{
+  const int L = umBC_LANES;
+  m_Np = Np;  m_Nelmt = elmts.size();
+  m_Nbatch = (m_Nelmt + L-1) / L;
+  if (m_Nelmt < 1 || Np < 1) {
+    m_Nelmt = m_Nbatch = 0;
+    m_elmt.destroy();  m_U.destroy();
+    return;
+  }
+  assert(CHOL.num_rows() == Np*Np);
+
+  // pack the upper triangles by column, interleaved by
+  // lane; unused lanes of the last batch hold U = I
+  int Ntri = Np*(Np+1)/2;
+  m_elmt = elmts;
+  m_U.resize(m_Nbatch*Ntri*L);
+  double* pu = m_U.data();
+  for (int b=0; b<m_Nbatch; ++b, pu+=Ntri*L) {
+    for (int l=0; l<L; ++l) {
+      int m = b*L + l + 1;
+      const double* u = (m<=m_Nelmt) ? CHOL.pCol(elmts(m)) : NULL;
+      for (int j=0; j<Np; ++j) {
+        for (int i=0; i<=j; ++i) {
+          double uij = u ? u[i + j*Np] : ((i==j) ? 1.0 : 0.0);
+          pu[((j*(j+1))/2 + i)*L + l] = uij;
+        }
+      }
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+void umBatchChol::solve(DMat& X, int nf) const
+//---------------------------------------------------------
+{
+  if (m_Nelmt < 1) { return; }
+  int ldf = (nf>0) ? X.size()/nf : 0;
+  if (nf<1 || nf*ldf != X.size()) {
+    umERROR("umBatchChol::solve", "(%d,%d) array does not hold %d fields", 
+            X.num_rows(), X.num_cols(), nf);
+  }
+  solve(X.data(), nf, ldf);
+}
+
+
+//---------------------------------------------------------
+void umBatchChol::solve(double* X, int nf, int ldf) const
+//---------------------------------------------------------
+{
+  // field f of element k is X[f*ldf + (k-1)*Np + (0:Np-1)]
+  if (m_Nelmt < 1) { return; }
+
+  const int L = umBC_LANES, Np = m_Np, Ntri = Np*(Np+1)/2;
+  umBC_fn potrs = umBC_select();
+
+  // interleaved rhs of one batch: one per thread
+  static umTHREAD_LOCAL std::vector<double> s_W;
+  if ((int)s_W.size() < Np*nf*L) { s_W.resize(Np*nf*L); }
+  double* w = &s_W[0];
+
+  for (int b=0; b<m_Nbatch; ++b) {
+    int nl = std::min(L, m_Nelmt - b*L);
+
+    // gather: w[(i*nf+f)*L+l]
+    for (int l=0; l<L; ++l) {
+      for (int f=0; f<nf; ++f) {
+        if (l<nl) {
+          const double* x = X + f*ldf + (m_elmt(b*L+l+1)-1)*Np;
+          for (int i=0; i<Np; ++i) { w[(i*nf+f)*L+l] = x[i]; }
+        } else {
+          for (int i=0; i<Np; ++i) { w[(i*nf+f)*L+l] = 0.0; }
+        }
+      }
+    }
+
+    potrs(Np, nf, m_U.data() + b*Ntri*L, w);
+
+    // scatter
+    for (int l=0; l<nl; ++l) {
+      for (int f=0; f<nf; ++f) {
+        double* x = X + f*ldf + (m_elmt(b*L+l+1)-1)*Np;
+        for (int i=0; i<Np; ++i) { x[i] = w[(i*nf+f)*L+l]; }
+      }
+    }
+  }
+}
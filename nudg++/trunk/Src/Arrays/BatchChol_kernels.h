@@ -0,0 +1,65 @@
+// BatchChol_kernels.h
+// kernel bodies for BatchChol.cpp
+// 2026/10/17
+//---------------------------------------------------------
+// No include guard: BatchChol.cpp includes this file once
+// per instruction set, after defining
+//
+//   umK_NS           namespace for this set of kernels
+//
+// The loops over the L lanes (elements) are vectorized for
+// the target selected around the include.
+//---------------------------------------------------------
+
+namespace umK_NS {
+
+//---------------------------------------------------------
+static void potrs(int Np, int nf, const double* U, double* X)
+//---------------------------------------------------------
+{
+  // Solve U^T*U*x = b for L=umBC_LANES elements and nf
+  // fields.  U(i,j), i<=j, of lane l is U[(j*(j+1)/2+i)*L+l]
+  // and x(i) of field f, lane l is X[(i*nf+f)*L+l].
+  //
+  // As in the reference dtrsm calls of dpotrs: the forward
+  // solve forms each sum in order and divides by U(i,i);
+  // the back solve skips the updates of a zero x(k).
+  const int L = umBC_LANES;
+
+  // U^T*y = b
+  for (int i=0; i<Np; ++i) {
+    const double* ui = U + (i*(i+1)/2)*L;     // column i of U
+    for (int f=0; f<nf; ++f) {
+      double t[L];
+      double* xi = X + (i*nf+f)*L;
+      for (int l=0; l<L; ++l) { t[l] = xi[l]; }
+      for (int k=0; k<i; ++k) {
+        const double* uk = ui + k*L;
+        const double* xk = X + (k*nf+f)*L;
+        for (int l=0; l<L; ++l) { t[l] = t[l] - uk[l]*xk[l]; }
+      }
+      for (int l=0; l<L; ++l) { xi[l] = t[l] / ui[i*L+l]; }
+    }
+  }
+
+  // U*x = y
+  for (int k=Np-1; k>=0; --k) {
+    const double* uk = U + (k*(k+1)/2)*L;     // column k of U
+    for (int f=0; f<nf; ++f) {
+      double t[L];  bool nz[L];
+      double* xk = X + (k*nf+f)*L;
+      for (int l=0; l<L; ++l) {
+        nz[l] = (xk[l] != 0.0);
+        t[l]  = nz[l] ? xk[l]/uk[k*L+l] : xk[l];
+        xk[l] = t[l];
+      }
+      for (int i=0; i<k; ++i) {
+        const double* ui = uk + i*L;
+        double* xi = X + (i*nf+f)*L;
+        for (int l=0; l<L; ++l) { xi[l] = nz[l] ? xi[l] - t[l]*ui[l] : xi[l]; }
+      }
+    }
+  }
+}
+
+} // namespace umK_NS
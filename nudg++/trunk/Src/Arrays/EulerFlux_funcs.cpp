@@ -0,0 +1,162 @@
+// EulerFlux_funcs.cpp
+// pointwise numerical fluxes for the Euler equations
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+
+#include "EulerFlux_funcs.h"
+
+// Built with -fno-math-errno -fno-trapping-math (Makefile):
+// the kernels take sqrt of v >= 0 only, but the errno branch
+// of ::sqrt, and the SSE2 selects of max2/min2 under trapping
+// math, would keep the node loops scalar.  Neither option
+// changes results.
+
+#if (USE_SIMD_KERNELS) && defined(__GNUC__) && defined(__x86_64__)
+#define umEF_X86  1
+#else
+#define umEF_X86  0
+#endif
+
+// the node loops vectorize only if the functors are inlined
+#if defined(__GNUC__)
+#define umEF_INLINE  inline __attribute__((always_inline))
+#else
+#define umEF_INLINE  inline
+#endif
+
+
+//---------------------------------------------------------
+// baseline kernels (SSE2 on x86-64)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umEF_base
+#include "EulerFlux_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+
+#if (umEF_X86)
+
+//---------------------------------------------------------
+// AVX2 kernels (no FMA: see EulerFlux_funcs.h)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx2")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umEF_avx2
+#include "EulerFlux_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+
+//---------------------------------------------------------
+// AVX-512 kernels
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx512f")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umEF_avx512
+#include "EulerFlux_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+#endif  // umEF_X86
+
+
+// dispatch on the SIMD level and dimension (_NR: and
+// carry on after the call)
+#if (umEF_X86)
+#define umEF_CALL_NR(fn, args)                                \
+  switch (umSIMD_level()) {                                   \
+  case umSIMD_AVX512: umEF_avx512::fn args; break;            \
+  case umSIMD_AVX2:   umEF_avx2  ::fn args; break;            \
+  default:            umEF_base  ::fn args; break;            \
+  }
+#else
+#define umEF_CALL_NR(fn, args)   umEF_base::fn args;
+#endif
+#define umEF_CALL(fn, args)   { umEF_CALL_NR(fn, args) return; }
+
+
+//---------------------------------------------------------
+void umEulerFlux
+(
+  int ftype, int Dim, double gamma, int Nr,
+  const double* nx, const double* ny, const double* nz, int ninc,
+  const double* QM, const double* QP, int ldq,
+  const double* lam,
+  double* F, int ldf
+)
+//---------------------------------------------------------
+{
+  if (Nr < 1) { return; }
+  if (FT_LaxF == ftype && !lam) {
+    umERROR("umEulerFlux", "LF needs the face wave speeds (umEulerSpeed)");
+    return;
+  }
+
+  if (2 == Dim) {
+    umEF_CALL(flux<2>, (ftype, gamma, Nr, nx,ny,nz, ninc, QM,QP,ldq, lam, F,ldf));
+  } else if (3 == Dim) {
+    umEF_CALL(flux<3>, (ftype, gamma, Nr, nx,ny,nz, ninc, QM,QP,ldq, lam, F,ldf));
+  }
+  umERROR("umEulerFlux", "expected Dim = 2 or 3, got %d", Dim);
+}
+
+
+//---------------------------------------------------------
+void umEulerSpeed
+(
+  int Dim, double gamma, int Nr, int Nfp,
+  const double* QM, const double* QP, int ldq,
+  double* lam
+)
+//---------------------------------------------------------
+{
+  if (Nr < 1) { return; }
+  assert(Nfp > 0 && 0 == Nr % Nfp);
+
+  if (2 == Dim) {
+    umEF_CALL(speed<2>, (gamma, Nr, Nfp, NULL, QM, QP, ldq, lam));
+  } else if (3 == Dim) {
+    umEF_CALL(speed<3>, (gamma, Nr, Nfp, NULL, QM, QP, ldq, lam));
+  }
+  umERROR("umEulerSpeed", "expected Dim = 2 or 3, got %d", Dim);
+}
+
+
+//---------------------------------------------------------
+void umEulerFluxUnique
+(
+  int ftype, int Dim, double gamma, int Nu, int NuI, int Nfp,
+  const int* u, const int* p,
+  const double* nx, const double* ny, const double* nz,
+  const double* QM, const double* QP, int ldq,
+  double* lam,
+  double* F, int ldf
+)
+//---------------------------------------------------------
+{
+  if (Nu < 1) { return; }
+  if (FT_LaxF == ftype) {
+    if (!lam) {
+      umERROR("umEulerFluxUnique", "LF needs scratch for the face wave speeds");
+      return;
+    }
+    assert(Nfp > 0 && 0 == Nu % Nfp);
+    if (2 == Dim) {
+      umEF_CALL_NR(speed<2>, (gamma, Nu, Nfp, u, QM, QP, ldq, lam));
+    } else if (3 == Dim) {
+      umEF_CALL_NR(speed<3>, (gamma, Nu, Nfp, u, QM, QP, ldq, lam));
+    }
+  }
+
+  if (2 == Dim) {
+    umEF_CALL(flux_unique<2>, (ftype, gamma, Nu, NuI, u, p, nx,ny,nz, QM,QP,ldq, lam, F,ldf));
+  } else if (3 == Dim) {
+    umEF_CALL(flux_unique<3>, (ftype, gamma, Nu, NuI, u, p, nx,ny,nz, QM,QP,ldq, lam, F,ldf));
+  }
+  umERROR("umEulerFluxUnique", "expected Dim = 2 or 3, got %d", Dim);
+}
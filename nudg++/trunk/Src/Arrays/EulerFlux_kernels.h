@@ -0,0 +1,433 @@
+// EulerFlux_kernels.h
+// flux functors and node loops for EulerFlux_funcs.cpp
+// 2026/10/17
+//---------------------------------------------------------
+// No include guard: EulerFlux_funcs.cpp includes this file
+// once per instruction set, after defining
+//
+//   umK_NS           namespace for this set of kernels
+//
+// The loops over face nodes are vectorized for the target
+// selected around the include: each functor is inlined
+// (umEF_INLINE), and its fields live in registers.
+//---------------------------------------------------------
+
+namespace umK_NS {
+
+// as the element-wise kernels: max, min, sqrt(max(v,0))
+inline double max2 (double a, double b) { return (a>b) ? a : b; }
+inline double min2 (double a, double b) { return (a<b) ? a : b; }
+inline double sqrt0(double v)           { return ::sqrt(max2(v, 0.0)); }
+
+
+//---------------------------------------------------------
+template <int D> struct Frame;
+//---------------------------------------------------------
+// rotate momentum to and from the face normal frame:
+// r = {rho, m.n, m.t[D-1], Ener}
+
+template <> struct Frame<2>
+{
+  double nx, ny;
+  umEF_INLINE Frame(const double* n) : nx(n[0]), ny(n[1]) {}
+
+  umEF_INLINE void to(const double* q, double* r) const {
+    r[0] = q[0];  r[3] = q[3];
+    r[1] =  nx*q[1] + ny*q[2];
+    r[2] = -(ny*q[1]) + nx*q[2];
+  }
+  umEF_INLINE void from(const double* g, double* f) const {
+    f[0] = g[0];  f[3] = g[3];
+    f[1] = nx*g[1] - ny*g[2];
+    f[2] = ny*g[1] + nx*g[2];
+  }
+};
+
+template <> struct Frame<3>
+{
+  double n[3], t1[3], t2[3];
+  umEF_INLINE Frame(const double* nn) {
+    n[0] = nn[0];  n[1] = nn[1];  n[2] = nn[2];
+    // t1 is normal to n and to e_z (or e_x, near n = +-e_z)
+    bool bz = (::fabs(n[2]) < 0.9);
+    double a0 = bz ? -n[1] : 0.0, a1 = bz ? n[0] : -n[2], a2 = bz ? 0.0 : n[1];
+    double s = 1.0 / ::sqrt(a0*a0 + a1*a1 + a2*a2);
+    t1[0] = a0*s;  t1[1] = a1*s;  t1[2] = a2*s;
+    t2[0] = n[1]*t1[2] - n[2]*t1[1];
+    t2[1] = n[2]*t1[0] - n[0]*t1[2];
+    t2[2] = n[0]*t1[1] - n[1]*t1[0];
+  }
+
+  umEF_INLINE void to(const double* q, double* r) const {
+    r[0] = q[0];  r[4] = q[4];
+    r[1] =  n[0]*q[1] +  n[1]*q[2] +  n[2]*q[3];
+    r[2] = t1[0]*q[1] + t1[1]*q[2] + t1[2]*q[3];
+    r[3] = t2[0]*q[1] + t2[1]*q[2] + t2[2]*q[3];
+  }
+  umEF_INLINE void from(const double* g, double* f) const {
+    f[0] = g[0];  f[4] = g[4];
+    for (int d=0; d<3; ++d) { f[1+d] = n[d]*g[1] + t1[d]*g[2] + t2[d]*g[3]; }
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D> struct NormalState
+//---------------------------------------------------------
+{
+  // primitive variables and x-flux of a rotated state r,
+  // in the operation order of CurvedEuler2D::Fluxes
+  double rho, u, v[D-1], p, fx[D+2];
+
+  umEF_INLINE NormalState(const double* r, double gm1) {
+    rho = r[0];  u = r[1]/rho;
+    double m2 = r[1]*u;
+    for (int k=0; k<D-1; ++k) { v[k] = r[2+k]/rho;  m2 = m2 + r[2+k]*v[k]; }
+    p = gm1*(r[D+1] - 0.5*m2);
+
+    fx[0] = r[1];
+    fx[1] = r[1]*u + p;
+    for (int k=0; k<D-1; ++k) { fx[2+k] = r[2+k]*u; }
+    fx[D+1] = u*(r[D+1]+p);
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D> struct RoeAverage
+//---------------------------------------------------------
+{
+  // Roe averages of two rotated states
+  double rho, u, v[D-1], H, q2, c2, c;
+
+  umEF_INLINE RoeAverage(const NormalState<D>& M, const NormalState<D>& P,
+             double HM, double HP, double gm1)
+  {
+    double rhoMs = sqrt0(M.rho), rhoPs = sqrt0(P.rho);
+    double rhoMsPs = rhoMs + rhoPs;
+
+    rho = rhoMs*rhoPs;
+    u   = (rhoMs*M.u + rhoPs*P.u) / rhoMsPs;
+    for (int k=0; k<D-1; ++k) { v[k] = (rhoMs*M.v[k] + rhoPs*P.v[k]) / rhoMsPs; }
+    H   = (rhoMs*HM + rhoPs*HP) / rhoMsPs;
+
+    q2 = u*u;
+    for (int k=0; k<D-1; ++k) { q2 = q2 + v[k]*v[k]; }
+    c2 = gm1*(H - 0.5*q2);  c = sqrt0(c2);
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D> struct LF
+//---------------------------------------------------------
+{
+  // local Lax-Friedrichs (Rusanov), as EulerLF2D:
+  // F* = (n.(F(qM)+F(qP)) + lam*(qM-qP))/2
+  enum { LAM = 1 };   // uses the face wave speed
+  double gamma, gm1;
+  LF(double g) : gamma(g), gm1(g-1.0) {}
+
+  umEF_INLINE double speed(const double* q) const {
+    double rho = q[0], u[D], m2 = 0.0, u2 = 0.0;
+    for (int d=0; d<D; ++d) {
+      u[d] = q[1+d]/rho;
+      m2 = d ? m2 + q[1+d]*u[d] : q[1+d]*u[d];
+      u2 = d ? u2 + u[d]*u[d]   : u[d]*u[d];
+    }
+    double p = gm1*(q[D+1] - 0.5*m2);
+    return sqrt0(u2) + sqrt0(::fabs(gamma*(p/rho)));
+  }
+
+  umEF_INLINE void operator()(const double* n, const double* qM, const double* qP,
+                  double lam, double* f) const
+  {
+    double uM[D], uP[D], sM = 0.0, sP = 0.0;
+    for (int d=0; d<D; ++d) {
+      uM[d] = qM[1+d]/qM[0];  uP[d] = qP[1+d]/qP[0];
+      sM = d ? sM + qM[1+d]*uM[d] : qM[1+d]*uM[d];
+      sP = d ? sP + qP[1+d]*uP[d] : qP[1+d]*uP[d];
+    }
+    double pM = gm1*(qM[D+1] - 0.5*sM), pP = gm1*(qP[D+1] - 0.5*sP);
+
+    // field c of the flux in direction d:
+    //   {m[d], m[c-1]*u[d] (+p if c-1==d), u[d]*(Ener+p)}
+#pragma GCC unroll 8
+    for (int c=0; c<D+2; ++c) {
+      double s = 0.0;
+      for (int d=0; d<D; ++d) {
+        double fM, fP;
+        if      (0 == c)   { fM = qM[1+d];  fP = qP[1+d]; }
+        else if (D+1 == c) { fM = uM[d]*(qM[D+1]+pM);  fP = uP[d]*(qP[D+1]+pP); }
+        else if (c-1 == d) { fM = qM[c]*uM[d] + pM;    fP = qP[c]*uP[d] + pP; }
+        else               { fM = qM[c]*uM[d];         fP = qP[c]*uP[d]; }
+        s = d ? s + n[d]*(fP+fM) : n[d]*(fP+fM);
+      }
+      f[c] = 0.5*(s + lam*(qM[c]-qP[c]));
+    }
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D> struct Roe
+//---------------------------------------------------------
+{
+  // Roe's approximate Riemann solver, as EulerRoe2D
+  enum { LAM = 0 };
+  double gamma, gm1;
+  Roe(double g) : gamma(g), gm1(g-1.0) {}
+
+  umEF_INLINE void operator()(const double* n, const double* qM, const double* qP,
+                  double, double* f) const
+  {
+    Frame<D> fr(n);  double rM[D+2], rP[D+2], g[D+2];
+    fr.to(qM, rM);  fr.to(qP, rP);
+    NormalState<D> M(rM, gm1), P(rP, gm1);
+
+    double HM = (rM[D+1]+M.p)/M.rho, HP = (rP[D+1]+P.p)/P.rho;
+    RoeAverage<D> A(M, P, HM, HP, gm1);
+
+    // wave strengths, scaled by |wave speed|
+    double dW1 = -0.5*((A.rho*(P.u-M.u))/A.c) + 0.5*((P.p-M.p)/A.c2);
+    double dW2 = (P.rho-M.rho) - (P.p-M.p)/A.c2;
+    double dW4 =  0.5*((A.rho*(P.u-M.u))/A.c) + 0.5*((P.p-M.p)/A.c2);
+    double dW3[D-1];
+    for (int k=0; k<D-1; ++k) { dW3[k] = ::fabs(A.u)*(A.rho*(P.v[k]-M.v[k])); }
+    dW1 = ::fabs(A.u-A.c)*dW1;
+    dW2 = ::fabs(A.u    )*dW2;
+    dW4 = ::fabs(A.u+A.c)*dW4;
+
+    for (int c=0; c<D+2; ++c) { g[c] = (P.fx[c]+M.fx[c])/2.0; }
+    g[0] -= (dW1 + dW2 + dW4)/2.0;
+    g[1] -= (dW1*(A.u-A.c) + dW2*A.u + dW4*(A.u+A.c))/2.0;
+    for (int k=0; k<D-1; ++k) {
+      g[2+k] -= (dW1*A.v[k] + dW2*A.v[k] + dW3[k] + dW4*A.v[k])/2.0;
+    }
+    double e = dW1*(A.H-A.u*A.c) + (dW2*A.q2)/2.0;
+    for (int k=0; k<D-1; ++k) { e = e + dW3[k]*A.v[k]; }
+    g[D+1] -= (e + dW4*(A.H+A.u*A.c))/2.0;
+
+    fr.from(g, f);
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D> struct HLL
+//---------------------------------------------------------
+{
+  // Harten-Lax-van Leer, with Roe-averaged wave speed
+  // estimates, as EulerHLL2D
+  enum { LAM = 0 };
+  double gamma, gm1;
+  HLL(double g) : gamma(g), gm1(g-1.0) {}
+
+  umEF_INLINE void operator()(const double* n, const double* qM, const double* qP,
+                  double, double* f) const
+  {
+    Frame<D> fr(n);  double rM[D+2], rP[D+2], g[D+2];
+    fr.to(qM, rM);  fr.to(qP, rP);
+    NormalState<D> M(rM, gm1), P(rP, gm1);
+
+    double HM = (rM[D+1]+M.p)/M.rho, cM = sqrt0(gamma*(M.p/M.rho));
+    double HP = (rP[D+1]+P.p)/P.rho, cP = sqrt0(gamma*(P.p/P.rho));
+    RoeAverage<D> A(M, P, HM, HP, gm1);
+
+    double SL = min2(M.u-cM, A.u-A.c);
+    double SR = max2(P.u+cP, A.u+A.c);
+
+    double t1 = (min2(SR,0.0) - min2(0.0,SL)) / (SR-SL);
+    double t2 = 1.0 - t1;
+    double t3 = (SR*::fabs(SL) - SL*::fabs(SR)) / (2.0*(SR-SL));
+
+    for (int c=0; c<D+2; ++c) {
+      g[c] = t1*P.fx[c] + t2*M.fx[c] - t3*(rP[c]-rM[c]);
+    }
+    fr.from(g, f);
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D> struct HLLC
+//---------------------------------------------------------
+{
+  // HLL with the contact wave restored (Toro), using the
+  // wave speed estimates of HLL
+  enum { LAM = 0 };
+  double gamma, gm1;
+  HLLC(double g) : gamma(g), gm1(g-1.0) {}
+
+  umEF_INLINE void operator()(const double* n, const double* qM, const double* qP,
+                  double, double* f) const
+  {
+    Frame<D> fr(n);  double rM[D+2], rP[D+2], g[D+2];
+    fr.to(qM, rM);  fr.to(qP, rP);
+    NormalState<D> M(rM, gm1), P(rP, gm1);
+
+    double HM = (rM[D+1]+M.p)/M.rho, cM = sqrt0(gamma*(M.p/M.rho));
+    double HP = (rP[D+1]+P.p)/P.rho, cP = sqrt0(gamma*(P.p/P.rho));
+    RoeAverage<D> A(M, P, HM, HP, gm1);
+
+    double SL = min2(M.u-cM, A.u-A.c);
+    double SR = max2(P.u+cP, A.u+A.c);
+
+    // contact speed, and the star state on each side
+    double aM = M.rho*(SL-M.u), aP = P.rho*(SR-P.u);
+    double SM = (P.p - M.p + aM*M.u - aP*P.u) / (aM - aP);
+    double sM = aM/(SL-SM), sP = aP/(SR-SM);
+    double eM = rM[D+1]/M.rho + (SM-M.u)*(SM + M.p/aM);
+    double eP = rP[D+1]/P.rho + (SM-P.u)*(SM + P.p/aP);
+
+    // select F(M), F*(M), F*(P) or F(P) by the sign of the
+    // wave speeds; every branch is computed, so the loop
+    // vectorizes with blends
+    for (int c=0; c<D+2; ++c) {
+      double uM, uP;
+      if      (0 == c)   { uM = sM;        uP = sP; }
+      else if (1 == c)   { uM = sM*SM;     uP = sP*SM; }
+      else if (D+1 == c) { uM = sM*eM;     uP = sP*eP; }
+      else               { uM = sM*M.v[c-2];  uP = sP*P.v[c-2]; }
+
+      double fsM = M.fx[c] + SL*(uM - rM[c]);
+      double fsP = P.fx[c] + SR*(uP - rP[c]);
+      g[c] = (SL >= 0.0) ? M.fx[c] : (SM >= 0.0) ? fsM : (SR >= 0.0) ? fsP : P.fx[c];
+    }
+    fr.from(g, f);
+  }
+};
+
+
+//---------------------------------------------------------
+template <int D, int NINC, int G, class FLUX> static void
+face_nodes(const FLUX& F, int Nr, const int* u, const int* p,
+           const double* nx, const double* ny, const double* nz,
+           const double* QM, const double* QP, int ldq,
+           const double* lam, double* Fo, int ldf)
+//---------------------------------------------------------
+{
+  // NINC=0: one normal for all Nr nodes.  G=0: node i of
+  // the traces and fluxes; G>0: node u[i]-1 (unique faces),
+  // G=2: and -F* at the partner node p[i]-1.  The normals
+  // and wave speeds are indexed by i.  The traces and
+  // fluxes are distinct arrays (ivdep): "omp simd" would
+  // keep the per-node arrays in memory.
+#pragma GCC ivdep
+  for (int i=0; i<Nr; ++i) {
+    double ni[3], a[D+2], b[D+2], fi[D+2];
+    const int k = G ? u[i]-1 : i;
+    ni[0] = nx[i*NINC];  ni[1] = ny[i*NINC];  ni[2] = (3==D) ? nz[i*NINC] : 0.0;
+    for (int c=0; c<D+2; ++c) { a[c] = QM[c*ldq+k];  b[c] = QP[c*ldq+k]; }
+    F(ni, a, b, FLUX::LAM ? lam[i] : 0.0, fi);
+    for (int c=0; c<D+2; ++c) { Fo[c*ldf+k] = fi[c]; }
+    if (2 == G) {
+      const int m = p[i]-1;
+      for (int c=0; c<D+2; ++c) { Fo[c*ldf+m] = -fi[c]; }
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+template <int D, class FLUX> static void
+face_flux(const FLUX& F, int Nr,
+          const double* nx, const double* ny, const double* nz, int ninc,
+          const double* QM, const double* QP, int ldq,
+          const double* lam, double* Fo, int ldf)
+//---------------------------------------------------------
+{
+  if (ninc) { face_nodes<D,1,0>(F, Nr, NULL,NULL, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf); }
+  else      { face_nodes<D,0,0>(F, Nr, NULL,NULL, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf); }
+}
+
+
+//---------------------------------------------------------
+template <int D, class FLUX> static void
+unique_flux(const FLUX& F, int Nu, int NuI, const int* u, const int* p,
+            const double* nx, const double* ny, const double* nz,
+            const double* QM, const double* QP, int ldq,
+            const double* lam, double* Fo, int ldf)
+//---------------------------------------------------------
+{
+  // interior faces (both sides), then boundary faces
+  const int o = NuI;
+  face_nodes<D,1,2>(F, NuI, u, p, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf);
+  face_nodes<D,1,1>(F, Nu-NuI, u+o, NULL, nx+o, ny+o, (3==D) ? nz+o : nz,
+                    QM,QP,ldq, lam ? lam+o : lam, Fo,ldf);
+}
+
+
+//---------------------------------------------------------
+template <int D> static void
+flux(int ftype, double gamma, int Nr,
+     const double* nx, const double* ny, const double* nz, int ninc,
+     const double* QM, const double* QP, int ldq,
+     const double* lam, double* Fo, int ldf)
+//---------------------------------------------------------
+{
+  switch (ftype) {
+  case FT_LaxF: face_flux<D>(LF  <D>(gamma), Nr, nx,ny,nz,ninc, QM,QP,ldq, lam, Fo,ldf); break;
+  case FT_Roe:  face_flux<D>(Roe <D>(gamma), Nr, nx,ny,nz,ninc, QM,QP,ldq, lam, Fo,ldf); break;
+  case FT_HLL:  face_flux<D>(HLL <D>(gamma), Nr, nx,ny,nz,ninc, QM,QP,ldq, lam, Fo,ldf); break;
+  case FT_HLLC: face_flux<D>(HLLC<D>(gamma), Nr, nx,ny,nz,ninc, QM,QP,ldq, lam, Fo,ldf); break;
+  default: umERROR("umEulerFlux", "unknown flux type: %d", ftype); break;
+  }
+}
+
+
+//---------------------------------------------------------
+template <int D> static void
+flux_unique(int ftype, double gamma, int Nu, int NuI, const int* u, const int* p,
+            const double* nx, const double* ny, const double* nz,
+            const double* QM, const double* QP, int ldq,
+            const double* lam, double* Fo, int ldf)
+//---------------------------------------------------------
+{
+  switch (ftype) {
+  case FT_LaxF: unique_flux<D>(LF  <D>(gamma), Nu,NuI,u,p, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf); break;
+  case FT_Roe:  unique_flux<D>(Roe <D>(gamma), Nu,NuI,u,p, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf); break;
+  case FT_HLL:  unique_flux<D>(HLL <D>(gamma), Nu,NuI,u,p, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf); break;
+  case FT_HLLC: unique_flux<D>(HLLC<D>(gamma), Nu,NuI,u,p, nx,ny,nz, QM,QP,ldq, lam, Fo,ldf); break;
+  default: umERROR("umEulerFluxUnique", "unknown flux type: %d", ftype); break;
+  }
+}
+
+
+//---------------------------------------------------------
+template <int D, int G> static void
+speed_nodes(double gamma, int Nr, int Nfp, const int* u,
+            const double* QM, const double* QP, int ldq, double* lam)
+//---------------------------------------------------------
+{
+  // G=0: node i of the traces; G=1: node u[i]-1
+  LF<D> F(gamma);
+
+#pragma GCC ivdep
+  for (int i=0; i<Nr; ++i) {
+    double a[D+2], b[D+2];
+    const int k = G ? u[i]-1 : i;
+    for (int c=0; c<D+2; ++c) { a[c] = QM[c*ldq+k];  b[c] = QP[c*ldq+k]; }
+    lam[i] = max2(F.speed(a), F.speed(b));
+  }
+
+  // largest speed on each face
+  for (int o=0; o<Nr; o+=Nfp) {
+    double m = lam[o];
+    for (int j=1; j<Nfp; ++j) { m = max2(m, lam[o+j]); }
+    for (int j=0; j<Nfp; ++j) { lam[o+j] = m; }
+  }
+}
+
+
+//---------------------------------------------------------
+template <int D> static void
+speed(double gamma, int Nr, int Nfp, const int* u,
+      const double* QM, const double* QP, int ldq, double* lam)
+//---------------------------------------------------------
+{
+  if (u) { speed_nodes<D,1>(gamma, Nr, Nfp, u, QM, QP, ldq, lam); }
+  else   { speed_nodes<D,0>(gamma, Nr, Nfp, u, QM, QP, ldq, lam); }
+}
+
+} // namespace umK_NS
@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "Mat_COL.h"
+#include "SmallMat_funcs.h"
 
 //---------------------------------------------------------
 void umAxB(const DMat& A, const DMat& B, DMat& C)
@@ -17,10 +18,14 @@ void umAxB(const DMat& A, const DMat& B, DMat& C)
   //        C  is (M,N)
   //-------------------------
   int M=A.num_rows(), K=A.num_cols(), N=B.num_cols();
-  int LDA=M, LDB=K, LDC=M;
   double one=1.0, zero=0.0;
   if (B.num_rows() != K) { umERROR("umAxB(A,B,C)", "wrong dimensions"); }
-  C.resize(M,N);
+  C.resize(M,N);    // keeps the layout of C if (M,N)
+  int LDA=A.ld(), LDB=B.ld(), LDC=C.ld();
+
+  // order-specialized kernel for operators such as Dr, LIFT
+  umSmallMat_fn fn = (LDA==M) ? umSmallMat_find(M,K) : NULL;
+  if (fn) { fn(N, one,A.data(), B.data(),LDB, zero,C.data(),LDC); return; }
 
   GEMM ('N','N',M,N,K, one,A.data(),LDA, 
                            B.data(),LDB, 
@@ -28,6 +33,49 @@ void umAxB(const DMat& A, const DMat& B, DMat& C)
 }
 
 
+//---------------------------------------------------------
+void umAxB(const DMat& A, const DMat& B, DView2D C, double alpha, double beta)
+//---------------------------------------------------------
+{
+  //-------------------------
+  // C = alpha*A*B + beta*C, 
+  // written into view C
+  //-------------------------
+  int M=A.num_rows(), K=A.num_cols(), N=B.num_cols();
+  if (B.num_rows() != K) { umERROR("umAxB(A,B,view)", "wrong dimensions"); }
+  if (C.num_rows() != M || C.num_cols() != N) { umERROR("umAxB(A,B,view)", "view is not (%d,%d)", M,N); }
+
+  umSmallMat_fn fn = A.is_padded() ? NULL : umSmallMat_find(M,K);
+  if (fn) { fn(N, alpha,A.data(), B.data(),B.ld(), beta,C.data(),C.ld()); return; }
+
+  GEMM ('N','N',M,N,K, alpha,A.data(),A.ld(), 
+                             B.data(),B.ld(), 
+                        beta,C.data(),C.ld());
+}
+
+
+//---------------------------------------------------------
+void umAxB(const DMat& A, const DView2D& B, DView2D C, double alpha, double beta)
+//---------------------------------------------------------
+{
+  //-------------------------
+  // C = alpha*A*B + beta*C, 
+  // B and C are views
+  //-------------------------
+  int M=A.num_rows(), K=A.num_cols(), N=B.num_cols();
+  if (B.num_rows() != K) { umERROR("umAxB(A,view,view)", "wrong dimensions"); }
+  if (C.num_rows() != M || C.num_cols() != N) { umERROR("umAxB(A,view,view)", "view is not (%d,%d)", M,N); }
+  assert(B.data() != C.data());   // GEMM may not overwrite B
+
+  umSmallMat_fn fn = A.is_padded() ? NULL : umSmallMat_find(M,K);
+  if (fn) { fn(N, alpha,A.data(), B.data(),B.ld(), beta,C.data(),C.ld()); return; }
+
+  GEMM ('N','N',M,N,K, alpha,A.data(),A.ld(), 
+                             B.data(),B.ld(), 
+                        beta,C.data(),C.ld());
+}
+
+
 //---------------------------------------------------------
 void umAxB(const ZMat& A, const ZMat& B, ZMat& C)
 //---------------------------------------------------------
@@ -40,10 +88,10 @@ void umAxB(const ZMat& A, const ZMat& B, ZMat& C)
   //        C  is (M,N)
   //-------------------------
   int M=A.num_rows(), K=A.num_cols(), N=B.num_cols();
-  int LDA=M, LDB=K, LDC=M;
   std::complex<double> one=1.0, zero=0.0;
   if (B.num_rows() != K) { umERROR("umAxB(A,B,C)", "wrong dimensions"); }
   C.resize(M,N);
+  int LDA=A.ld(), LDB=B.ld(), LDC=C.ld();
 
   ZGEMM ('N','N',M,N,K, one,A.data(),LDA, 
                            B.data(),LDB, 
@@ -63,10 +111,10 @@ void umAtransxB(const DMat& A, const DMat& B, DMat& C)
   //          C  is (M,N)
   //-------------------------
   int M=A.num_cols(), K=A.num_rows(), N=B.num_cols();
-  int LDA=K, LDB=K, LDC=M;
   double one=1.0, zero=0.0;
   if (B.num_rows() != K) { umERROR("umAtransxB(A,B,C)", "wrong dimensions"); }
   C.resize(M,N);
+  int LDA=A.ld(), LDB=B.ld(), LDC=C.ld();
 
   GEMM ('T','N',M,N,K, one,A.data(),LDA, 
                            B.data(),LDB, 
@@ -86,10 +134,10 @@ void umAxBtrans(const DMat& A, const DMat& B, DMat& C)
   //          C  is (M,N)
   //-------------------------
   int M=A.num_rows(), K=A.num_cols(), N=B.num_rows();
-  int LDA=M, LDB=N, LDC=M;
   double one=1.0, zero=0.0;
   if (B.num_cols() != K) { umERROR("umAxBtrans(A,B,C)", "wrong dimensions"); }
   C.resize(M,N);
+  int LDA=A.ld(), LDB=B.ld(), LDC=C.ld();
 
   GEMM ('N','T',M,N,K, one,A.data(),LDA, 
                            B.data(),LDB, 
@@ -120,7 +168,7 @@ void umSOLVE(const DMat& mat, const DVec& b, DVec& x)
 //---------------------------------------------------------
 {
   // Work with copies of input arrays.
-  DMat A(mat);
+  DMat A(mat);  A.unpad();
   x = b;
 
   int NRHS = 1;
@@ -179,6 +227,7 @@ void umSOLVE(const DMat& mat, const DMat& B, DMat& X)
 
   DMat A(mat);    // work with copy of input
   X = B;          // initialize result with RHS
+  A.unpad();  X.unpad();
 
   int rows=A.num_rows(), LDA=A.num_rows(), cols=A.num_cols();
   int LDB=B.num_rows(), NRHS=B.num_cols(), info=0;
@@ -218,6 +267,7 @@ void umSOLVE_CH(const DMat& mat, const DVec& b, DVec& x)
   
   DMat A(mat);    // work with copy of input
   x = b;          // allocate solution vector
+  A.unpad();
 
   int rows=A.num_rows(), LDA=A.num_rows(), cols=A.num_cols();
   int  LDB=b.size(), NRHS=1, info=0;
@@ -261,6 +311,7 @@ void umSOLVE_CH(const DMat& mat, const DMat& B, DMat& X)
   
   DMat A(mat);    // Work with a copy of input array.
   X = B;          // initialize solution with rhs
+  A.unpad();  X.unpad();
 
   int rows=A.num_rows(), LDA=A.num_rows(), cols=A.num_cols();
   int LDB=X.num_rows(), NRHS=X.num_cols(), info=0;
@@ -295,6 +346,7 @@ void umSOLVE_LS(const DMat& mat, const DMat& B, DMat& X)
   if (!mat.ok()) {umWARNING("umSOLVE_LS()", "system is empty"); return;}
 
   DMat A(mat);    // work with copy of input.
+  A.unpad();
 
   int rows=A.num_rows(), cols=A.num_cols(), mmn=A.min_mn();
   int LDB=A.max_mn(), NRHS=B.num_cols();
@@ -307,6 +359,7 @@ void umSOLVE_LS(const DMat& mat, const DMat& B, DMat& X)
   // then load the set of right hand sides.
 
   X.resize(LDB,NRHS, true, 0.0);
+  X.unpad();
 
   for (int j=1; j<=NRHS; ++j)     // loop across colums
     for (int i=1; i<=rows; ++i)   // loop down rows
@@ -380,14 +433,15 @@ DVec& svd
 {
   // Work with a copy of the input matrix.
   DMat A(mat, OBJ_temp, "svd.TMP");
+  A.unpad();
 
   // A(MxN)
   int m=A.num_rows(), n=A.num_cols();
   int mmn=A.min_mn(), xmn=A.max_mn();
 
   // resize parameters
-  U.resize (m,m, true, 0.0);
-  VT.resize(n,n, true, 0.0);
+  U.resize (m,m, true, 0.0);  U.unpad();
+  VT.resize(n,n, true, 0.0);  VT.unpad();
   DVec* s = new DVec(mmn, 0.0, OBJ_temp, "s.TMP");
   char jobu  = ju;
   char jobvt = jvt;
@@ -465,7 +519,7 @@ double cond(ZMat& mat)
 
   int info;
 
-  ZMat matcopy(mat);
+  ZMat matcopy(mat);  matcopy.unpad();
   IVec ipiv(mat.num_rows(), "ipiv");
 
   ZGETRF(mat.num_rows(),
@@ -535,11 +589,12 @@ void eig(const DMat& A, DVec& Re, DMat& VL, DMat& VR, bool bL, bool bR)
   Re.resize(N);     // store REAL components of eigenvalues in Re
   VL.resize(N,N);   // storage for LEFT eigenvectors
   VR.resize(N,N);   // storage for RIGHT eigenvectors
+  VL.unpad();  VR.unpad();
   DVec Im(N);     // NOT returning imaginary components
   DVec work(ldwork, 0.0);
 
   // Work on a copy of A
-  B = A;
+  B = A;  B.unpad();
 
   char jobL = bL ? 'V' : 'N';   // calc LEFT eigenvectors?
   char jobR = bR ? 'V' : 'N';   // calc RIGHT eigenvectors?
@@ -589,6 +644,7 @@ void eig_sym(const DMat& A, DVec& ev, DMat& Q, bool bDoEVecs)
   DVec work(ldwork, 0.0, OBJ_temp, "work_TMP");
 
   Q = A;          // Calculate eigenvectors in Q (optional)
+  Q.unpad();
   ev.resize(N);   // Calculate eigenvalues in ev
 
   char jobV = bDoEVecs ? 'V' : 'N';
@@ -614,7 +670,7 @@ DMat& lu(DMat& A, bool in_place)
   // for use later in solving (multiple) linear systems.
 
   if (!A.is_square()) { umERROR("lu(A)", "matrix is not square."); }
-  int rows=A.num_rows(); int N=rows, LDA=rows, info=0;
+  int rows=A.num_rows(); int N=rows, LDA=A.ld(), info=0;
   int* ipiv = umIVector(rows);
 
   if (in_place) 
@@ -683,7 +739,7 @@ DMat& chol(DMat& A, bool in_place)
   // return its Cholesky-factorization for use
   // later in solving (multiple) linear systems.
 
-  int M=A.num_rows(), LDA=A.num_rows(), info=0;
+  int M=A.num_rows(), LDA=A.ld(), info=0;
   char uplo = 'U';
 
   if (in_place) 
@@ -720,12 +776,13 @@ bool chol_solve(const DMat& ch, const DMat& B, DMat& X)
   // symmetric positive-definite matrix, A = U^T U.
 
   if (FACT_CHOL != ch.get_factmode()) {umERROR("chol_solve(ch,B,X)", "matrix is not factored.");}
-  int M =ch.num_rows(), lda=ch.num_rows(); 
-  int ldb=B.num_rows(), nrhs=B.num_cols(); assert(ldb == M);
+  int M =ch.num_rows(), lda=ch.ld(); 
+  int ldb=0, nrhs=B.num_cols(); assert(B.num_rows() == M);
   char uplo = 'U';  int info=0; 
   double* ch_data = const_cast<double*>(ch.data());
 
   X = B;  // overwrite X with RHS's, then solutions
+  ldb = X.ld();
   POTRS (uplo, M, nrhs, ch_data, lda, X.data(), ldb, info);
 
   if (info) { umERROR("chol_solve(ch,B,X)", "dpotrs reports: info = %d", info); }
@@ -741,7 +798,7 @@ DVec& chol_solve(const DMat& ch, const DVec& b)
   // symmetric positive-definite matrix, A = U^T U.
 
   if (FACT_CHOL != ch.get_factmode()) {umERROR("chol_solve(ch,b)", "matrix is not factored.");}
-  int M=ch.num_rows(), lda=ch.num_rows(); 
+  int M=ch.num_rows(), lda=ch.ld(); 
   int nrhs=1, ldb=b.size();   assert(ldb == M);
   char uplo = 'U';  int info=0; 
   double* ch_data = const_cast<double*>(ch.data());
@@ -764,6 +821,26 @@ DVec& chol_solve(const DMat& ch, Region1D<DVec> R)
 }
 
 
+// overload to solve in place, in a view
+//---------------------------------------------------------
+void chol_solve(const DMat& ch, DView2D X)
+//---------------------------------------------------------
+{
+  // Solve (in place) the linear systems with rhs in the
+  // columns of view X, using Cholesky-factored symmetric 
+  // positive-definite matrix, A = U^T U.
+
+  if (FACT_CHOL != ch.get_factmode()) {umERROR("chol_solve(ch,view)", "matrix is not factored.");}
+  int M=ch.num_rows(), lda=ch.ld();
+  int nrhs=X.num_cols(), ldb=X.ld(); assert(X.num_rows() == M);
+  char uplo = 'U';  int info=0; 
+  double* ch_data = const_cast<double*>(ch.data());
+
+  POTRS (uplo, M, nrhs, ch_data, lda, X.data(), ldb, info);
+  if (info) { umERROR("chol_solve(ch,view)", "dpotrs reports: info = %d", info); }
+}
+
+
 //---------------------------------------------------------
 DMat& qr(DMat& A, bool in_place)
 //---------------------------------------------------------
@@ -772,7 +849,7 @@ DMat& qr(DMat& A, bool in_place)
   // The result Q is represented as a product of 
   // min(m, n) elementary reflectors. 
 
-  int M=A.num_rows(), N=A.num_cols(), LDA=A.num_rows();
+  int M=A.num_rows(), N=A.num_cols(), LDA=A.ld();
   int min_mn = A.min_mn(), info=0; DVec tau(min_mn);
 
   if (in_place) 
@@ -0,0 +1,473 @@
+// MemProfile.cpp
+// per-name, per-phase accounting of array memory
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+
+#include "MemProfile.h"
+
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#if (USE_THREAD_REGISTRY)
+#include <atomic>
+#include <mutex>
+#define umMEM_LOCK()  std::lock_guard<std::mutex> mem_lock_(S.lock)
+#else
+#define umMEM_LOCK()
+#endif
+
+
+//---------------------------------------------------------
+struct umMemRecord
+//---------------------------------------------------------
+{
+  std::string name;
+  long allocs, temps, alloc_bytes, live, peak;
+  long at_peak;         // live when the total last peaked...
+  long version;         // ...valid if version == peak_version
+  long ph_allocs[umMEM_NPHASE], ph_temps[umMEM_NPHASE];
+  long ph_bytes [umMEM_NPHASE], ph_live [umMEM_NPHASE], ph_peak[umMEM_NPHASE];
+
+  explicit umMemRecord(const std::string& s) : name(s) { clear(); }
+
+  void clear() {
+    allocs = temps = alloc_bytes = live = peak = at_peak = 0;  version = 0;
+    for (int i=0; i<umMEM_NPHASE; ++i) {
+      ph_allocs[i] = ph_temps[i] = ph_bytes[i] = ph_live[i] = ph_peak[i] = 0;
+    }
+  }
+};
+
+// a live registry allocation
+struct umMemBlock { int rec; long nbytes; int phase; };
+
+// all profiler state (see state() below)
+struct umMemState
+{
+  std::vector<umMemRecord>                   recs;   // [0]: totals
+  std::map<std::string,int>                  index;  // name -> record
+  std::unordered_map<const void*,umMemBlock> blocks; // data -> owner
+  long   peak_version;
+  int    peak_phase;
+  long   limit;         // warn above (bytes); 0: never
+  bool   warned;
+#if (USE_THREAD_REGISTRY)
+  std::mutex lock;
+#endif
+
+  umMemState() : peak_version(0), peak_phase(umMEM_SETUP), limit(0), warned(false) {}
+};
+
+#if (USE_THREAD_REGISTRY)
+static std::atomic<int> s_phase(umMEM_SETUP);
+#else
+static int              s_phase = umMEM_SETUP;
+#endif
+
+bool umMemProfile::s_on = false;
+
+// NDG_MEMPROF was set in a build without the array hooks
+static bool s_unavailable = false;
+
+
+//---------------------------------------------------------
+static umMemState& state()
+//---------------------------------------------------------
+{
+  // Built on first use, i.e. no later than the first 
+  // tracked array (which may itself be a global), so it 
+  // is destroyed after every array charged to it.
+  static umMemState s;
+  return s;
+}
+
+
+//---------------------------------------------------------
+static int find_record(const char* name)
+//---------------------------------------------------------
+{
+  // caller holds the lock
+  umMemState& S = state();
+  if (S.recs.empty()) { S.recs.push_back(umMemRecord("*total*")); }
+  std::string key = (name && name[0]) ? name : "(unnamed)";
+  std::map<std::string,int>::iterator it = S.index.find(key);
+  if (it != S.index.end()) { return it->second; }
+  int i = (int)S.recs.size();
+  S.recs.push_back(umMemRecord(key));
+  S.index[key] = i;
+  return i;
+}
+
+
+//---------------------------------------------------------
+static void change_live(umMemRecord& R, long nb)
+//---------------------------------------------------------
+{
+  // save this record's share of the last peak before
+  // its first change since that peak
+  umMemState& S = state();
+  if (R.version != S.peak_version) {
+    R.at_peak = R.live;  R.version = S.peak_version;
+  }
+  R.live += nb;
+}
+
+
+//---------------------------------------------------------
+static void warn_limit()
+//---------------------------------------------------------
+{
+  // name the largest holders of memory
+  umMemState& S = state();
+  std::vector<std::pair<long,int> > top;
+  for (int i=1; i<(int)S.recs.size(); ++i) {
+    top.push_back(std::make_pair(-S.recs[i].live, i));
+  }
+  std::sort(top.begin(), top.end());
+  std::string msg;
+  char buf[200];
+  for (int j=0; j<(int)top.size() && j<5; ++j) {
+    const umMemRecord& R = S.recs[top[j].second];
+    snprintf(buf, sizeof(buf), "\n  %-24s %10.2lf MB", R.name.c_str(), R.live/1048576.0);
+    msg += buf;
+  }
+  umWARNING("umMemProfile", "live arrays exceed %0.1lf MB (%0.1lf MB, phase %s); largest:%s",
+            S.limit/1048576.0, S.recs[0].live/1048576.0,
+            umMemProfile::phase_name(umMemProfile::phase()), msg.c_str());
+}
+
+
+//---------------------------------------------------------
+static void grow(int ir, long nb, int ph, int ph_owner)
+//---------------------------------------------------------
+{
+  // caller holds the lock: add nb live bytes to record ir
+  // (and the totals), allocated in phase ph_owner
+  umMemState& S = state();
+  long old_peak = S.recs[0].peak;
+  int irs[2] = {0, ir};
+  for (int k=0; k<2; ++k) {
+    umMemRecord& R = S.recs[irs[k]];
+    change_live(R, nb);  R.ph_live[ph_owner] += nb;
+    R.peak        = std::max(R.peak, R.live);
+    R.ph_peak[ph] = std::max(R.ph_peak[ph], R.live);
+  }
+
+  if (S.recs[0].live > old_peak) {
+    // new high-water mark: shares of other records
+    // are saved lazily, by change_live()
+    ++S.peak_version;
+    S.recs[0].at_peak  = S.recs[0].live;  S.recs[0].version  = S.peak_version;
+    S.recs[ir].at_peak = S.recs[ir].live; S.recs[ir].version = S.peak_version;
+    S.peak_phase = ph;
+  }
+
+  if (S.limit>0 && !S.warned && S.recs[0].live > S.limit) {
+    S.warned = true;  warn_limit();
+  }
+}
+
+
+//---------------------------------------------------------
+static void charge(int ir, long nb, bool bTemp, int ph, bool bLive)
+//---------------------------------------------------------
+{
+  // caller holds the lock: count an allocation
+  umMemState& S = state();
+  int irs[2] = {0, ir};
+  for (int k=0; k<2; ++k) {
+    umMemRecord& R = S.recs[irs[k]];
+    ++R.allocs;  R.alloc_bytes += nb;
+    ++R.ph_allocs[ph];  R.ph_bytes[ph] += nb;
+    if (bTemp) { ++R.temps;  ++R.ph_temps[ph]; }
+  }
+  if (bLive) { grow(ir, nb, ph, ph); }
+}
+
+
+//---------------------------------------------------------
+static void release(const umMemBlock& B)
+//---------------------------------------------------------
+{
+  // caller holds the lock
+  umMemState& S = state();
+  int irs[2] = {0, B.rec};
+  for (int k=0; k<2; ++k) {
+    umMemRecord& R = S.recs[irs[k]];
+    change_live(R, -B.nbytes);  R.ph_live[B.phase] -= B.nbytes;
+  }
+}
+
+
+///////////////////////////////////////////////////////////
+//
+// umMemProfile
+//
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+void umMemProfile::enable(bool b)
+//---------------------------------------------------------
+{
+  // without TRACK_ARRAY_MEMORY, arrays are never charged
+#if (TRACK_ARRAY_MEMORY)
+  s_on = b;
+#else
+  s_on = false;
+  if (b) {
+    umWARNING("umMemProfile::enable", 
+              "built with TRACK_ARRAY_MEMORY=0: array memory is not profiled");
+  }
+#endif
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::reset()
+//---------------------------------------------------------
+{
+  // forget all counters (allocations already made
+  // are no longer tracked)
+  umMemState& S = state();
+  umMEM_LOCK();
+  S.recs.clear();  S.index.clear();  S.blocks.clear();
+  S.peak_version = 0;  S.peak_phase = umMEM_SETUP;  S.warned = false;
+}
+
+
+//---------------------------------------------------------
+const char* umMemProfile::phase_name(umMemPhase p)
+//---------------------------------------------------------
+{
+  static const char* names[umMEM_NPHASE] = { "setup", "step", "rhs", "solve", "output" };
+  return (p>=0 && p<umMEM_NPHASE) ? names[p] : "?";
+}
+
+
+//---------------------------------------------------------
+umMemPhase umMemProfile::phase()
+//---------------------------------------------------------
+{
+  return (umMemPhase) (int) s_phase;
+}
+
+
+//---------------------------------------------------------
+umMemPhase umMemProfile::set_phase(umMemPhase p)
+//---------------------------------------------------------
+{
+#if (USE_THREAD_REGISTRY)
+  return (umMemPhase) s_phase.exchange(p);
+#else
+  umMemPhase old = (umMemPhase) s_phase;  s_phase = p;
+  return old;
+#endif
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::add(const void* p, long nbytes, const char* name, bool bTemp)
+//---------------------------------------------------------
+{
+  umMemState& S = state();
+  if (!p) { return; }
+  int ph = (int) s_phase;
+  umMEM_LOCK();
+  int ir = find_record(name);
+  umMemBlock B = { ir, nbytes, ph };
+  std::pair<std::unordered_map<const void*,umMemBlock>::iterator,bool> res = S.blocks.insert(std::make_pair(p, B));
+  if (!res.second) {
+    // not seen released (e.g. profiler enabled late)
+    release(res.first->second);  res.first->second = B;
+  }
+  charge(ir, nbytes, bTemp, ph, true);
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::count(long nbytes, const char* name, bool bTemp)
+//---------------------------------------------------------
+{
+  // allocation from a umFrame arena: counted, not held
+  umMemState& S = state();
+  int ph = (int) s_phase;
+  umMEM_LOCK();
+  charge(find_record(name), nbytes, bTemp, ph, false);
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::remove(const void* p)
+//---------------------------------------------------------
+{
+  umMemState& S = state();
+  if (!p) { return; }
+  umMEM_LOCK();
+  std::unordered_map<const void*,umMemBlock>::iterator it = S.blocks.find(p);
+  if (it == S.blocks.end()) { return; }   // allocated before profiling
+  release(it->second);
+  S.blocks.erase(it);
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::move(const void* pold, const void* p, long nbytes)
+//---------------------------------------------------------
+{
+  // registry resized an allocation in place, or moved it
+  umMemState& S = state();
+  umMEM_LOCK();
+  std::unordered_map<const void*,umMemBlock>::iterator it = S.blocks.find(pold);
+  if (it == S.blocks.end()) { return; }
+  umMemBlock B = it->second;
+  S.blocks.erase(it);
+  if (!p) { release(B); return; }
+
+  long d = nbytes - B.nbytes;
+  if (d>0) {
+    int ph = (int) s_phase;
+    S.recs[0].alloc_bytes += d;  S.recs[0].ph_bytes[ph] += d;
+    S.recs[B.rec].alloc_bytes += d;  S.recs[B.rec].ph_bytes[ph] += d;
+    grow(B.rec, d, ph, B.phase);
+  } else if (d<0) {
+    umMemBlock R = { B.rec, -d, B.phase };  release(R);
+  }
+  B.nbytes = nbytes;
+  S.blocks[p] = B;
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::owner(const void* p, const char* name)
+//---------------------------------------------------------
+{
+  // an array took over allocation p: charge its live 
+  // bytes to the new owner's name (totals unchanged)
+  umMemState& S = state();
+  if (!p) { return; }
+  umMEM_LOCK();
+  std::unordered_map<const void*,umMemBlock>::iterator it = S.blocks.find(p);
+  if (it == S.blocks.end()) { return; }
+  umMemBlock& B = it->second;
+  int ir = find_record(name);
+  if (ir == B.rec) { return; }
+
+  umMemRecord& R0 = S.recs[B.rec];
+  change_live(R0, -B.nbytes);  R0.ph_live[B.phase] -= B.nbytes;
+
+  int ph = (int) s_phase;
+  umMemRecord& R1 = S.recs[ir];
+  change_live(R1,  B.nbytes);  R1.ph_live[B.phase] += B.nbytes;
+  R1.peak        = std::max(R1.peak, R1.live);
+  R1.ph_peak[ph] = std::max(R1.ph_peak[ph], R1.live);
+  B.rec = ir;
+}
+
+
+//---------------------------------------------------------
+long umMemProfile::live_bytes()
+//---------------------------------------------------------
+{
+  umMemState& S = state();
+  umMEM_LOCK();
+  return S.recs.empty() ? 0 : S.recs[0].live;
+}
+
+
+//---------------------------------------------------------
+long umMemProfile::peak_bytes()
+//---------------------------------------------------------
+{
+  umMemState& S = state();
+  umMEM_LOCK();
+  return S.recs.empty() ? 0 : S.recs[0].peak;
+}
+
+
+//---------------------------------------------------------
+void umMemProfile::write(FILE* fp, const char* tag)
+//---------------------------------------------------------
+{
+  // CSV: one row per (name, phase), plus a row per name
+  // for all phases ("all"), sorted by peak bytes.  Lines
+  // starting with '#' are comments.
+  umMemState& S = state();
+
+  umMEM_LOCK();
+  if (S.recs.empty()) { S.recs.push_back(umMemRecord("*total*")); }
+
+  std::vector<std::pair<long,int> > order;
+  for (int i=1; i<(int)S.recs.size(); ++i) {
+    order.push_back(std::make_pair(-S.recs[i].peak, i));
+  }
+  std::sort(order.begin(), order.end());
+  order.insert(order.begin(), std::make_pair(0L, 0));
+
+  const umMemRecord& T = S.recs[0];
+  fprintf(fp, "# memory profile: %s\n", tag ? tag : "");
+  fprintf(fp, "# peak_bytes %ld  phase %s\n", T.peak, phase_name((umMemPhase)S.peak_phase));
+  fprintf(fp, "# live_bytes %ld  names %d\n", T.live, (int)S.recs.size()-1);
+  fprintf(fp, "name,phase,allocs,temps,alloc_bytes,live_bytes,peak_bytes,at_peak_bytes\n");
+
+  for (int j=0; j<(int)order.size(); ++j) {
+    const umMemRecord& R = S.recs[order[j].second];
+    long at_peak = (R.version == S.peak_version) ? R.at_peak : R.live;
+    fprintf(fp, "\"%s\",all,%ld,%ld,%ld,%ld,%ld,%ld\n", R.name.c_str(),
+            R.allocs, R.temps, R.alloc_bytes, R.live, R.peak, at_peak);
+    for (int p=0; p<umMEM_NPHASE; ++p) {
+      if (R.ph_allocs[p]<1 && R.ph_live[p]==0) { continue; }
+      fprintf(fp, "\"%s\",%s,%ld,%ld,%ld,%ld,%ld,\n", R.name.c_str(), phase_name((umMemPhase)p),
+              R.ph_allocs[p], R.ph_temps[p], R.ph_bytes[p], R.ph_live[p], R.ph_peak[p]);
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+bool umMemProfile::report(const char* tag)
+//---------------------------------------------------------
+{
+  if (s_unavailable) {
+    umWARNING("umMemProfile::report", 
+              "NDG_MEMPROF is set, but this build has no array hooks\n"
+              "(TRACK_ARRAY_MEMORY=0): no memory profile written");
+    s_unavailable = false;
+  }
+  if (!s_on) { return false; }
+
+  std::string fname = std::string(tag ? tag : "NDG") + "_memory.csv";
+  FILE* fp = fopen(fname.c_str(), "w");
+  if (!fp) {
+    umWARNING("umMemProfile::report", "could not open %s", fname.c_str());
+    return false;
+  }
+  write(fp, tag);
+  fclose(fp);
+
+  umLOG(1, " array memory: peak %0.2lf MB, live %0.2lf MB (see %s)\n\n",
+        peak_bytes()/1048576.0, live_bytes()/1048576.0, fname.c_str());
+  return true;
+}
+
+
+//---------------------------------------------------------
+// switch on from the environment
+//---------------------------------------------------------
+static struct umMemProfileInit {
+  umMemProfileInit() {
+    const char* s = getenv("NDG_MEMPROF");
+    // (too early to log: a build without the hooks
+    // warns from report() instead)
+#if (TRACK_ARRAY_MEMORY)
+    if (s && atoi(s)>0) { umMemProfile::enable(true); }
+#else
+    if (s && atoi(s)>0) { s_unavailable = true; }
+#endif
+    s = getenv("NDG_MEMPROF_LIMIT");
+    if (s && atof(s)>0.0) { state().limit = (long)(atof(s)*1048576.0); }
+  }
+} s_memprof_init;
@@ -0,0 +1,277 @@
+// SIMD_funcs.cpp
+// element-wise kernels for double arrays
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+
+#include "SIMD_funcs.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#if (USE_SIMD_KERNELS) && defined(__GNUC__) && defined(__x86_64__)
+#define umSIMD_X86  1
+#include <immintrin.h>
+#else
+#define umSIMD_X86  0
+#endif
+
+
+//---------------------------------------------------------
+// scalar kernels
+//---------------------------------------------------------
+#define umK_NS      umSIMD_scalar
+#define VD          double
+#define VW          1
+#define VLD(p)      (*(p))
+#define VST(p,v)    (*(p) = (v))
+#define VSET1(a)    (a)
+#define VADD(a,b)   ((a)+(b))
+#define VSUB(a,b)   ((a)-(b))
+#define VMUL(a,b)   ((a)*(b))
+#define VDIV(a,b)   ((a)/(b))
+#define VMAX(a,b)   (((a)>(b)) ? (a) : (b))
+#define VMIN(a,b)   (((a)<(b)) ? (a) : (b))
+#define VSQRT(v)    (((v)>0.0) ? ::sqrt(v) : 0.0)
+#define VABS(v)     ::fabs(v)
+#include "SIMD_kernels.h"
+#undef umK_NS
+#undef VD
+#undef VW
+#undef VLD
+#undef VST
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VMAX
+#undef VMIN
+#undef VSQRT
+#undef VABS
+
+
+#if (umSIMD_X86)
+
+//---------------------------------------------------------
+// SSE2 kernels
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("sse2")
+#define umK_NS      umSIMD_sse2
+#define VD          __m128d
+#define VW          2
+#define VLD(p)      _mm_loadu_pd(p)
+#define VST(p,v)    _mm_storeu_pd((p),(v))
+#define VSET1(a)    _mm_set1_pd(a)
+#define VADD(a,b)   _mm_add_pd((a),(b))
+#define VSUB(a,b)   _mm_sub_pd((a),(b))
+#define VMUL(a,b)   _mm_mul_pd((a),(b))
+#define VDIV(a,b)   _mm_div_pd((a),(b))
+#define VMAX(a,b)   _mm_max_pd((a),(b))
+#define VMIN(a,b)   _mm_min_pd((a),(b))
+#define VSQRT(v)    _mm_sqrt_pd(_mm_max_pd((v), _mm_setzero_pd()))
+#define VABS(v)     _mm_andnot_pd(_mm_set1_pd(-0.0), (v))
+#include "SIMD_kernels.h"
+#undef umK_NS
+#undef VD
+#undef VW
+#undef VLD
+#undef VST
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VMAX
+#undef VMIN
+#undef VSQRT
+#undef VABS
+#pragma GCC pop_options
+
+
+//---------------------------------------------------------
+// AVX2 kernels (no FMA: see SIMD_funcs.h)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx2")
+#define umK_NS      umSIMD_avx2
+#define VD          __m256d
+#define VW          4
+#define VLD(p)      _mm256_loadu_pd(p)
+#define VST(p,v)    _mm256_storeu_pd((p),(v))
+#define VSET1(a)    _mm256_set1_pd(a)
+#define VADD(a,b)   _mm256_add_pd((a),(b))
+#define VSUB(a,b)   _mm256_sub_pd((a),(b))
+#define VMUL(a,b)   _mm256_mul_pd((a),(b))
+#define VDIV(a,b)   _mm256_div_pd((a),(b))
+#define VMAX(a,b)   _mm256_max_pd((a),(b))
+#define VMIN(a,b)   _mm256_min_pd((a),(b))
+#define VSQRT(v)    _mm256_sqrt_pd(_mm256_max_pd((v), _mm256_setzero_pd()))
+#define VABS(v)     _mm256_andnot_pd(_mm256_set1_pd(-0.0), (v))
+#include "SIMD_kernels.h"
+#undef umK_NS
+#undef VD
+#undef VW
+#undef VLD
+#undef VST
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VMAX
+#undef VMIN
+#undef VSQRT
+#undef VABS
+#pragma GCC pop_options
+
+
+//---------------------------------------------------------
+// AVX-512 kernels (avx512f implies fma: keep a*x+y as a
+// separate multiply and add)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx512f")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umSIMD_avx512
+#define VD          __m512d
+#define VW          8
+#define VLD(p)      _mm512_loadu_pd(p)
+#define VST(p,v)    _mm512_storeu_pd((p),(v))
+#define VSET1(a)    _mm512_set1_pd(a)
+#define VADD(a,b)   _mm512_add_pd((a),(b))
+#define VSUB(a,b)   _mm512_sub_pd((a),(b))
+#define VMUL(a,b)   _mm512_mul_pd((a),(b))
+#define VDIV(a,b)   _mm512_div_pd((a),(b))
+#define VMAX(a,b)   _mm512_max_pd((a),(b))
+#define VMIN(a,b)   _mm512_min_pd((a),(b))
+#define VSQRT(v)    _mm512_sqrt_pd(_mm512_max_pd((v), _mm512_setzero_pd()))
+#define VABS(v)     _mm512_abs_pd(v)
+#include "SIMD_kernels.h"
+#undef umK_NS
+#undef VD
+#undef VW
+#undef VLD
+#undef VST
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VMAX
+#undef VMIN
+#undef VSQRT
+#undef VABS
+#pragma GCC pop_options
+
+#endif  // umSIMD_X86
+
+
+//---------------------------------------------------------
+// kernel tables
+//---------------------------------------------------------
+#define umSIMD_TABLE(ns, lev, nm) \
+  { ns::add, ns::sub, ns::mul, ns::div, ns::axpy, ns::scal,   \
+    ns::sqr, ns::sqrt_, ns::abs_, ns::max, ns::min,           \
+    ns::maxs, ns::mins, lev, nm }
+
+static const umSIMD_ops s_ops_scalar = umSIMD_TABLE(umSIMD_scalar, umSIMD_SCALAR, "scalar");
+#if (umSIMD_X86)
+static const umSIMD_ops s_ops_sse2   = umSIMD_TABLE(umSIMD_sse2,   umSIMD_SSE2,   "sse2");
+static const umSIMD_ops s_ops_avx2   = umSIMD_TABLE(umSIMD_avx2,   umSIMD_AVX2,   "avx2");
+static const umSIMD_ops s_ops_avx512 = umSIMD_TABLE(umSIMD_avx512, umSIMD_AVX512, "avx512");
+#endif
+
+// scalar kernels until the selection below is made, so
+// arrays used during static initialization are safe
+const umSIMD_ops* umSIMD_cur = &s_ops_scalar;
+
+
+//---------------------------------------------------------
+umSIMD_Level umSIMD_best_level()
+//---------------------------------------------------------
+{
+#if (umSIMD_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) { return umSIMD_AVX512; }
+  if (__builtin_cpu_supports("avx2"))    { return umSIMD_AVX2; }
+  if (__builtin_cpu_supports("sse2"))    { return umSIMD_SSE2; }
+#endif
+  return umSIMD_SCALAR;
+}
+
+
+//---------------------------------------------------------
+const umSIMD_ops& umSIMD_get_ops(umSIMD_Level lev)
+//---------------------------------------------------------
+{
+  // Note: caller checks that the cpu supports lev
+#if (umSIMD_X86)
+  switch (lev) {
+  case umSIMD_AVX512: return s_ops_avx512;
+  case umSIMD_AVX2:   return s_ops_avx2;
+  case umSIMD_SSE2:   return s_ops_sse2;
+  default:            break;
+  }
+#endif
+  return s_ops_scalar;
+}
+
+
+//---------------------------------------------------------
+umSIMD_Level umSIMD_set_level(umSIMD_Level lev)
+//---------------------------------------------------------
+{
+  // Select kernels for level lev, or the best level the
+  // cpu supports if that is lower.  Call this before any
+  // threads that use arrays are started.
+  umSIMD_Level best = umSIMD_best_level();
+  if (lev > best) { lev = best; }
+  umSIMD_cur = &umSIMD_get_ops(lev);
+  return lev;
+}
+
+
+//---------------------------------------------------------
+static umSIMD_Level umSIMD_init()
+//---------------------------------------------------------
+{
+  // default: best available, unless set by NDG_SIMD
+  umSIMD_Level lev = umSIMD_AVX512;
+  const char* env = getenv("NDG_SIMD");
+  if (env) {
+    if      (!strcmp(env, "scalar")) { lev = umSIMD_SCALAR; }
+    else if (!strcmp(env, "sse2"))   { lev = umSIMD_SSE2; }
+    else if (!strcmp(env, "avx2"))   { lev = umSIMD_AVX2; }
+    else if (!strcmp(env, "avx512")) { lev = umSIMD_AVX512; }
+    else { umWARNING("umSIMD_init", "NDG_SIMD=%s not recognized", env); }
+  }
+  return umSIMD_set_level(lev);
+}
+
+static umSIMD_Level s_simd_init = umSIMD_init();
+
+
+//---------------------------------------------------------
+int umCache_L2()
+//---------------------------------------------------------
+{
+  static int s_L2 = 0;
+  if (s_L2 > 0) { return s_L2; }
+
+  long L2 = 0;
+  const char* env = getenv("NDG_L2");
+  if (env) {
+    L2 = 1024L*atol(env);
+    if (L2 <= 0) { umWARNING("umCache_L2", "NDG_L2=%s not recognized", env); }
+  }
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  if (L2 <= 0) { L2 = sysconf(_SC_LEVEL2_CACHE_SIZE); }
+#endif
+  if (L2 <= 0) { L2 = 1L<<20; }
+  s_L2 = (int)L2;
+  return s_L2;
+}
@@ -0,0 +1,100 @@
+// SIMD_kernels.h
+// kernel bodies for SIMD_funcs.cpp
+// 2026/10/17
+//---------------------------------------------------------
+// No include guard: SIMD_funcs.cpp includes this file once
+// per instruction set, after defining
+//
+//   umK_NS           namespace for this set of kernels
+//   VD, VW           vector type, and its width (doubles)
+//   VLD, VST         unaligned load/store
+//   VSET1            broadcast a scalar
+//   VADD,VSUB,VMUL,VDIV, VMAX,VMIN, VSQRT,VABS
+//
+// where VMAX(a,b) is (a>b ? a : b), VMIN(a,b) is (a<b ? a : b)
+// (as for maxpd/minpd), and VSQRT(v) is sqrt(max(v,0)).
+// The scalar cleanup loops follow the same conventions.
+//---------------------------------------------------------
+
+namespace umK_NS {
+
+// y = OP(y, x), 2 vectors per pass
+#define umK_BINARY(fname, OP, sop)                      \
+static void fname(int N, double* y, const double* x)    \
+{                                                       \
+  int i=0;                                              \
+  for (; i+2*VW<=N; i+=2*VW) {                          \
+    VST(y+i,    OP(VLD(y+i),    VLD(x+i)));             \
+    VST(y+i+VW, OP(VLD(y+i+VW), VLD(x+i+VW)));          \
+  }                                                     \
+  for (; i<N; ++i) { sop; }                             \
+}
+
+// y = OP(y, a), for scalar a
+#define umK_SCALAR(fname, OP, sop)                      \
+static void fname(int N, double* y, double a)           \
+{                                                       \
+  const VD va = VSET1(a);                               \
+  int i=0;                                              \
+  for (; i+2*VW<=N; i+=2*VW) {                          \
+    VST(y+i,    OP(VLD(y+i),    va));                   \
+    VST(y+i+VW, OP(VLD(y+i+VW), va));                   \
+  }                                                     \
+  for (; i<N; ++i) { sop; }                             \
+}
+
+// y = OP(y)
+#define umK_UNARY(fname, OP, sop)                       \
+static void fname(int N, double* y)                     \
+{                                                       \
+  int i=0;                                              \
+  for (; i+2*VW<=N; i+=2*VW) {                          \
+    VST(y+i,    OP(VLD(y+i)));                          \
+    VST(y+i+VW, OP(VLD(y+i+VW)));                       \
+  }                                                     \
+  for (; i<N; ++i) { sop; }                             \
+}
+
+#define umK_SQR(v)      VMUL((v),(v))
+#define umK_MAXR(v,x)   VMAX((x),(v))
+#define umK_MINR(v,x)   VMIN((x),(v))
+
+umK_BINARY(add,  VADD,     y[i] += x[i])
+umK_BINARY(sub,  VSUB,     y[i] -= x[i])
+umK_BINARY(mul,  VMUL,     y[i] *= x[i])
+umK_BINARY(div,  VDIV,     y[i] /= x[i])
+umK_BINARY(max,  umK_MAXR, y[i] = (x[i]>y[i]) ? x[i] : y[i])
+umK_BINARY(min,  umK_MINR, y[i] = (x[i]<y[i]) ? x[i] : y[i])
+
+umK_SCALAR(scal_, VMUL,     y[i] *= a)
+umK_SCALAR(maxs,  umK_MAXR, y[i] = (a>y[i]) ? a : y[i])
+umK_SCALAR(mins,  umK_MINR, y[i] = (a<y[i]) ? a : y[i])
+
+umK_UNARY(sqr,   umK_SQR,  y[i] *= y[i])
+umK_UNARY(sqrt_, VSQRT,    y[i] = (y[i]>0.0) ? ::sqrt(y[i]) : 0.0)
+umK_UNARY(abs_,  VABS,     y[i] = ::fabs(y[i]))
+
+static void scal(int N, double a, double* y) { scal_(N, y, a); }
+
+//---------------------------------------------------------
+static void axpy(int N, double a, const double* x, double* y)
+//---------------------------------------------------------
+{
+  // y += a*x  (separate multiply and add, as in daxpy)
+  const VD va = VSET1(a);
+  int i=0;
+  for (; i+2*VW<=N; i+=2*VW) {
+    VST(y+i,    VADD(VLD(y+i),    VMUL(va, VLD(x+i))));
+    VST(y+i+VW, VADD(VLD(y+i+VW), VMUL(va, VLD(x+i+VW))));
+  }
+  for (; i<N; ++i) { y[i] += a*x[i]; }
+}
+
+#undef umK_BINARY
+#undef umK_SCALAR
+#undef umK_UNARY
+#undef umK_SQR
+#undef umK_MAXR
+#undef umK_MINR
+
+} // namespace umK_NS
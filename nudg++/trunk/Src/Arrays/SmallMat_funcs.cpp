@@ -0,0 +1,216 @@
+// SmallMat_funcs.cpp
+// order-specialized products of small operators
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+
+#include "SmallMat_funcs.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if (USE_SMALLMAT_KERNELS) && (USE_SIMD_KERNELS) && defined(__GNUC__) && defined(__x86_64__)
+#define umSM_X86  1
+#else
+#define umSM_X86  0
+#endif
+
+
+//---------------------------------------------------------
+// baseline kernels (SSE2 on x86-64)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umSM_base
+#include "SmallMat_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+
+#if (umSM_X86)
+
+//---------------------------------------------------------
+// AVX2 kernels (no FMA: see SmallMat_funcs.h)
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx2")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umSM_avx2
+#include "SmallMat_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+
+//---------------------------------------------------------
+// AVX-512 kernels
+//---------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target ("avx512f")
+#pragma GCC optimize ("fp-contract=off")
+#define umK_NS      umSM_avx512
+#include "SmallMat_kernels.h"
+#undef umK_NS
+#pragma GCC pop_options
+
+#endif  // umSM_X86
+
+
+//---------------------------------------------------------
+// registered shapes
+//---------------------------------------------------------
+#define umSM_MAXREG  8
+
+typedef struct {
+  int M, Kc;
+  umSmallMat_fn  fn;
+  umSmallMat_fnf fnf;   // 2D only, else NULL
+  umSmallMat_fnm fnm;
+} umSM_entry;
+
+static umSM_entry s_reg[umSM_MAXREG];
+static int        s_nreg = 0;
+
+
+//---------------------------------------------------------
+umSmallMat_fn umSmallMat_get(umSIMD_Level lev, int Dim, int N, int shape)
+//---------------------------------------------------------
+{
+  if (N<1 || N>umSM_MAXORDER || Dim<2 || Dim>3) { return NULL; }
+  if (shape<0 || shape>=umSM_NSHAPE)             { return NULL; }
+#if (umSM_X86)
+  switch (lev) {
+  case umSIMD_AVX512: return umSM_avx512::table[N][Dim-2][shape];
+  case umSIMD_AVX2:   return umSM_avx2  ::table[N][Dim-2][shape];
+  default:            break;
+  }
+#endif
+  return umSM_base::table[N][Dim-2][shape];
+}
+
+
+//---------------------------------------------------------
+umSmallMat_fnf umSmallMat_get_f(umSIMD_Level lev, int N, int shape)
+//---------------------------------------------------------
+{
+  if (N<1 || N>umSM_MAXORDER || shape<0 || shape>=umSM_NSHAPE) { return NULL; }
+#if (umSM_X86)
+  switch (lev) {
+  case umSIMD_AVX512: return umSM_avx512::table_f[N][shape];
+  case umSIMD_AVX2:   return umSM_avx2  ::table_f[N][shape];
+  default:            break;
+  }
+#endif
+  return umSM_base::table_f[N][shape];
+}
+
+
+//---------------------------------------------------------
+umSmallMat_fnm umSmallMat_get_m(umSIMD_Level lev, int N, int shape)
+//---------------------------------------------------------
+{
+  if (N<1 || N>umSM_MAXORDER || shape<0 || shape>=umSM_NSHAPE) { return NULL; }
+#if (umSM_X86)
+  switch (lev) {
+  case umSIMD_AVX512: return umSM_avx512::table_m[N][shape];
+  case umSIMD_AVX2:   return umSM_avx2  ::table_m[N][shape];
+  default:            break;
+  }
+#endif
+  return umSM_base::table_m[N][shape];
+}
+
+
+//---------------------------------------------------------
+static void umSM_add(int M, int Kc, umSmallMat_fn fn,
+                     umSmallMat_fnf fnf, umSmallMat_fnm fnm)
+//---------------------------------------------------------
+{
+  for (int i=0; i<s_nreg; ++i) {
+    if (s_reg[i].M==M && s_reg[i].Kc==Kc) {
+      s_reg[i].fn = fn;  s_reg[i].fnf = fnf;  s_reg[i].fnm = fnm;
+      return;
+    }
+  }
+  if (s_nreg == umSM_MAXREG) {
+    // drop the oldest shape
+    memmove(s_reg, s_reg+1, (umSM_MAXREG-1)*sizeof(umSM_entry));
+    --s_nreg;
+  }
+  s_reg[s_nreg].M = M;  s_reg[s_nreg].Kc = Kc;  s_reg[s_nreg].fn = fn;
+  s_reg[s_nreg].fnf = fnf;  s_reg[s_nreg].fnm = fnm;
+  ++s_nreg;
+}
+
+
+//---------------------------------------------------------
+bool umSmallMat_select(int Dim, int N)
+//---------------------------------------------------------
+{
+  // Register the kernels for the operators of order N.
+  // Call from setup, before any threads use umAxB.
+#if (USE_SMALLMAT_KERNELS)
+  const char* env = getenv("NDG_SMALLMAT");
+  if (env && !strcmp(env, "0")) { return false; }
+
+  umSIMD_Level lev = umSIMD_level();
+  umSmallMat_fn fv = umSmallMat_get(lev, Dim, N, umSM_VOL);
+  umSmallMat_fn fl = umSmallMat_get(lev, Dim, N, umSM_LIFT);
+  umSmallMat_fn fg = umSmallMat_get(lev, Dim, N, umSM_GRAD);
+  if (!fv || !fl || !fg) { return false; }
+
+  // float and mixed kernels exist for 2D shapes only
+  bool b2 = (2==Dim);
+  int Np  = b2 ? (N+1)*(N+2)/2 : (N+1)*(N+2)*(N+3)/6;
+  int Nfq = b2 ? 3*(N+1)       : 2*(N+1)*(N+2);
+  umSM_add(Np, Np,  fv, b2 ? umSmallMat_get_f(lev,N,umSM_VOL)  : NULL,
+                        b2 ? umSmallMat_get_m(lev,N,umSM_VOL)  : NULL);
+  umSM_add(Np, Nfq, fl, b2 ? umSmallMat_get_f(lev,N,umSM_LIFT) : NULL,
+                        b2 ? umSmallMat_get_m(lev,N,umSM_LIFT) : NULL);
+  umSM_add(Dim*Np, Np, fg, b2 ? umSmallMat_get_f(lev,N,umSM_GRAD) : NULL,
+                           b2 ? umSmallMat_get_m(lev,N,umSM_GRAD) : NULL);
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+//---------------------------------------------------------
+void umSmallMat_clear()
+//---------------------------------------------------------
+{
+  s_nreg = 0;
+}
+
+
+//---------------------------------------------------------
+umSmallMat_fn umSmallMat_find(int M, int Kc)
+//---------------------------------------------------------
+{
+  for (int i=0; i<s_nreg; ++i) {
+    if (s_reg[i].M==M && s_reg[i].Kc==Kc) { return s_reg[i].fn; }
+  }
+  return NULL;
+}
+
+
+//---------------------------------------------------------
+umSmallMat_fnf umSmallMat_find_f(int M, int Kc)
+//---------------------------------------------------------
+{
+  for (int i=0; i<s_nreg; ++i) {
+    if (s_reg[i].M==M && s_reg[i].Kc==Kc) { return s_reg[i].fnf; }
+  }
+  return NULL;
+}
+
+
+//---------------------------------------------------------
+umSmallMat_fnm umSmallMat_find_m(int M, int Kc)
+//---------------------------------------------------------
+{
+  for (int i=0; i<s_nreg; ++i) {
+    if (s_reg[i].M==M && s_reg[i].Kc==Kc) { return s_reg[i].fnm; }
+  }
+  return NULL;
+}
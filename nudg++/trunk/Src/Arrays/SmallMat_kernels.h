@@ -0,0 +1,116 @@
+// SmallMat_kernels.h
+// kernel bodies for SmallMat_funcs.cpp
+// 2026/10/17
+//---------------------------------------------------------
+// No include guard: SmallMat_funcs.cpp includes this file
+// once per instruction set, after defining
+//
+//   umK_NS           namespace for this set of kernels
+//
+// The compiler vectorizes the inner loops for the target
+// selected around the include; with M and Kc fixed, the
+// loops over rows are fully unrolled for small orders.
+// The kernels are templated on the type T of A, C and the
+// sums, and the type TB of B (float fields with double
+// sums: T=double, TB=float).
+//---------------------------------------------------------
+
+namespace umK_NS {
+
+//---------------------------------------------------------
+template <typename T, typename TB, int M, int Kc>
+static void axb
+(
+  int N, T alpha, const T* A,
+  const TB* B, int ldb,
+  T beta, T* C, int ldc
+)
+//---------------------------------------------------------
+{
+  // C = alpha*A*B + beta*C.  As in the reference dgemm,
+  // C(:,j) is scaled by beta, then the columns of A are
+  // added in order, each times alpha*B(l,j).  Operators
+  // too large for L1 are applied to NB columns at a time,
+  // so each column of A is loaded once per block.  The
+  // factors alpha*B(l,j) are formed (in T) before the sums.
+  enum { NB = (M*Kc > 2048) ? 4 : 1 };
+  T t[NB][M], s[NB][Kc];
+  int j=0;
+  for (; j+NB<=N; j+=NB) {
+    for (int q=0; q<NB; ++q) {
+      const T*  c = C + (j+q)*ldc;
+      const TB* b = B + (j+q)*ldb;
+      if      (T(0)==beta) { for (int i=0; i<M; ++i) { t[q][i] = T(0); } }
+      else if (T(1)==beta) { for (int i=0; i<M; ++i) { t[q][i] = c[i]; } }
+      else                 { for (int i=0; i<M; ++i) { t[q][i] = beta*c[i]; } }
+      for (int l=0; l<Kc; ++l) { s[q][l] = alpha*T(b[l]); }
+    }
+    const T* a = A;
+    for (int l=0; l<Kc; ++l, a+=M) {
+      for (int q=0; q<NB; ++q) {
+        const T bl = s[q][l];
+        for (int i=0; i<M; ++i) { t[q][i] += bl*a[i]; }
+      }
+    }
+    for (int q=0; q<NB; ++q) {
+      T* c = C + (j+q)*ldc;
+      for (int i=0; i<M; ++i) { c[i] = t[q][i]; }
+    }
+  }
+
+  // remaining columns, one at a time
+  for (; j<N; ++j) {
+    const TB* b = B + j*ldb;
+    T*        c = C + j*ldc;
+
+    if      (T(0)==beta) { for (int i=0; i<M; ++i) { t[0][i] = T(0); } }
+    else if (T(1)==beta) { for (int i=0; i<M; ++i) { t[0][i] = c[i]; } }
+    else                 { for (int i=0; i<M; ++i) { t[0][i] = beta*c[i]; } }
+    for (int l=0; l<Kc; ++l) { s[0][l] = alpha*T(b[l]); }
+
+    const T* a = A;
+    for (int l=0; l<Kc; ++l, a+=M) {
+      const T bl = s[0][l];
+      for (int i=0; i<M; ++i) { t[0][i] += bl*a[i]; }
+    }
+    for (int i=0; i<M; ++i) { c[i] = t[0][i]; }
+  }
+}
+
+// operator shapes for order N
+template <int N> struct shape2D { enum { Np=(N+1)*(N+2)/2,        Nfq=3*(N+1) }; };
+template <int N> struct shape3D { enum { Np=(N+1)*(N+2)*(N+3)/6,  Nfq=2*(N+1)*(N+2) }; };
+
+#define umK_SHAPES(T, TB, S, dim)                                       \
+  { axb<T,TB, S::Np, S::Np>, axb<T,TB, S::Np, S::Nfq>, axb<T,TB, dim*S::Np, S::Np> }
+
+#define umK_ORDER(n)    { umK_SHAPES(double,double, shape2D<n>, 2),   \
+                          umK_SHAPES(double,double, shape3D<n>, 3) }
+#define umK_ORDER_F(n)    umK_SHAPES(float, float,  shape2D<n>, 2)
+#define umK_ORDER_M(n)    umK_SHAPES(double,float,  shape2D<n>, 2)
+
+// table[N][Dim-2][shape]
+static const umSmallMat_fn table[umSM_MAXORDER+1][2][umSM_NSHAPE] = {
+  { { NULL, NULL, NULL }, { NULL, NULL, NULL } },
+  umK_ORDER(1), umK_ORDER(2), umK_ORDER(3), umK_ORDER(4), umK_ORDER(5),
+  umK_ORDER(6), umK_ORDER(7), umK_ORDER(8), umK_ORDER(9), umK_ORDER(10)
+};
+
+// float and mixed kernels, 2D only: table_f[N][shape]
+static const umSmallMat_fnf table_f[umSM_MAXORDER+1][umSM_NSHAPE] = {
+  { NULL, NULL, NULL },
+  umK_ORDER_F(1), umK_ORDER_F(2), umK_ORDER_F(3), umK_ORDER_F(4), umK_ORDER_F(5),
+  umK_ORDER_F(6), umK_ORDER_F(7), umK_ORDER_F(8), umK_ORDER_F(9), umK_ORDER_F(10)
+};
+static const umSmallMat_fnm table_m[umSM_MAXORDER+1][umSM_NSHAPE] = {
+  { NULL, NULL, NULL },
+  umK_ORDER_M(1), umK_ORDER_M(2), umK_ORDER_M(3), umK_ORDER_M(4), umK_ORDER_M(5),
+  umK_ORDER_M(6), umK_ORDER_M(7), umK_ORDER_M(8), umK_ORDER_M(9), umK_ORDER_M(10)
+};
+
+#undef umK_ORDER_M
+#undef umK_ORDER_F
+#undef umK_ORDER
+#undef umK_SHAPES
+
+} // namespace umK_NS
@@ -0,0 +1,133 @@
+// FluxCheck2D_main.cpp: entry point for the FluxCheck2D
+// check program (console version).  Validates and times 
+// the CurvedEuler2D surface fluxes, from both sides of each
+// face and once per face (see CurvedEuler2D::SurfaceFlux)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "CurvedEuler2D.h"
+#include "CheckHarness.h"
+
+// Usage:  FluxCheck2D [N] [reps]
+//
+// For each test mesh, sets up the isentropic vortex (or
+// channel flow) at order N, forms the Gauss face traces
+// with one RHS evaluation, then evaluates the LF, Roe, HLL
+// and HLLC fluxes at every face node pair from both sides, and
+// once per face (NDG_FLUX=unique).  Reports seconds per
+// call of each path and the largest difference relative
+// to max|flux| (round-off: the two sides' normals agree
+// to round-off only).
+
+
+//---------------------------------------------------------
+class FluxCheck2D : public umCheckFixture<CurvedEuler2D>
+//---------------------------------------------------------
+{
+public:
+  FluxCheck2D(int sim) { sim_type = sim; }
+
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    flux_type = FT_Roe;  ExactSolution = NULL;
+    switch (sim_type) {
+    case eIsentropicVortex:
+      InitialSolution = &FluxCheck2D::IsentropicVortexIC2D;
+      BCSolution      = &FluxCheck2D::IsentropicVortexBC2D;  break;
+    default:
+      InitialSolution = &FluxCheck2D::ChannelIC2D;
+      BCSolution      = &FluxCheck2D::ChannelBC2D;  break;
+    }
+    if (!Load(mesh, Nord)) { return false; }
+
+    InitRun();
+    CubatureOrder = (int)floor(2.0*(N+1)*3.0/2.0);
+    NGauss        = (int)floor(2.0*(N+1));
+    CubatureVolumeMesh2D(CubatureOrder);
+    GaussFaceMesh2D(NGauss);
+    Resize_cub();
+    MapGaussFaceData();
+    PreCalcBdryData();
+
+    // scale Q element by element to open up jumps at the
+    // faces, so that the fluxes differ
+    for (int i=1; i<=Q.num_rows(); ++i) {
+      double s = 1.0 + 0.02*((i-1)/Np % 3);
+      for (int n=1; n<=4; ++n) { Q(i,n) *= s; }
+    }
+
+    // one RHS evaluation forms the face traces (gQM,gQP)
+    flux_type = FT_LaxF;  m_bUniqueFlux = false;
+    this->RHS(Q, 0.0, BCSolution);
+    return true;
+  }
+
+  //-------------------------------------
+  double TimeFlux(int ftype, bool bUnique, int reps, DMat& F)
+  //-------------------------------------
+  {
+    flux_type = ftype;  m_bUniqueFlux = bUnique;
+    F.resize(gQM.num_rows(), 4);
+    SurfaceFlux(gQM, gQP, F);             // warm up
+    double t = 0.0;
+    for (int r=0; r<reps; ++r) {
+      double t0 = timer.read();
+      SurfaceFlux(gQM, gQP, F);
+      t += timer.read()-t0;
+    }
+    return t/double(reps);
+  }
+
+  int num_faces() const { return uFaceM.size(); }
+};
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("FluxCheck2D");
+
+  int Nord = (argc>1) ? atoi(argv[1]) : 6;
+  int reps = (argc>2) ? atoi(argv[2]) : 20;
+
+  struct { const char* mesh; int sim; } tests[] = {
+    { "Grid/Euler2D/vortexA04.neu",    0 },   // eIsentropicVortex
+    { "Grid/Euler2D/Euler01.neu",      1 },   // eChannelFlow
+    { "Grid/Euler2D/Euler005.neu",     1 }
+  };
+  static const char* fnames[4] = { "LF", "Roe", "HLL", "HLLC" };
+  int ftypes[4] = { FT_LaxF, FT_Roe, FT_HLL, FT_HLLC };
+
+  umCheckTable tab;
+
+  for (int t=0; t<3; ++t) {
+    FluxCheck2D* p = umCheckLoad("FluxCheck2D", new FluxCheck2D(tests[t].sim), tests[t].mesh, Nord);
+    if (!p) { continue; }
+
+    for (int f=0; f<4; ++f) {
+      DMat Fref, F;
+      double tb = p->TimeFlux(ftypes[f], false, reps, Fref);
+      double tu = p->TimeFlux(ftypes[f], true,  reps, F);
+      umCheckDiff d;  d.add(F, Fref);
+
+      tab.row("%-28s %-4s %5d %6d  %10.3e %10.3e %7.2f  %9.2e\n",
+              tests[t].mesh, fnames[f], p->num_elmts(), p->num_faces(),
+              tb, tu, (tu>0.0) ? tb/tu : 0.0, d.rel());
+    }
+    delete p;
+  }
+
+  printf("\nCurvedEuler2D surface flux (N=%d)\n\n", Nord);
+  printf("%-28s %-4s %5s %6s  %10s %10s %7s  %9s\n",
+         "mesh", "flux", "K", "faces", "both sides", "per face", "speedup", "rel.diff");
+  tab.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
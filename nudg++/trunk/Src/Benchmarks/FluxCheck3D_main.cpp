@@ -0,0 +1,107 @@
+// FluxCheck3D_main.cpp: entry point for the FluxCheck3D
+// check program (console version).  Validates and times 
+// the Euler3D right-hand side with the LF flux evaluated 
+// from both sides of each face and once per face
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "Euler3D.h"
+#include "CheckHarness.h"
+
+// Usage:  FluxCheck3D [N] [reps]
+//
+// For each test mesh, sets up the isentropic vortex at 
+// order N and evaluates Euler3D::RHS with the surface flux
+// from both sides of each face, then once per face 
+// (NDG_FLUX=unique).  The volume terms are the same, so
+// the difference of the two results is that of the face
+// fluxes.  Reports seconds per call of each path and the
+// largest difference relative to max|rhsQ| (round-off:
+// the two sides' normals agree to round-off only).
+
+
+//---------------------------------------------------------
+class FluxCheck3D : public umCheckFixture<Euler3D>
+//---------------------------------------------------------
+{
+public:
+
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    sim_type        = eIsentropicVortex;
+    InitialSolution = &FluxCheck3D::IsentropicVortexIC3D;
+    ExactSolution   = &FluxCheck3D::IsentropicVortexIC3D;
+    BCSolution      = &FluxCheck3D::IsentropicVortexBC3D;
+    if (!Load(mesh, Nord)) { return false; }
+    InitRun();
+
+    // scale Q element by element to open up jumps at the
+    // faces, so that the fluxes differ
+    for (int i=1; i<=Q.num_rows(); ++i) {
+      double s = 1.0 + 0.02*((i-1)/Np % 3);
+      for (int n=1; n<=5; ++n) { Q(i,n) *= s; }
+    }
+    return true;
+  }
+
+  //-------------------------------------
+  double TimeRHS(bool bUnique, int reps, DMat& R)
+  //-------------------------------------
+  {
+    m_bUniqueFlux = bUnique;
+    this->RHS(Q, 0.0, BCSolution);        // warm up
+    double t = 0.0;
+    for (int r=0; r<reps; ++r) {
+      double t0 = timer.read();
+      this->RHS(Q, 0.0, BCSolution);
+      t += timer.read()-t0;
+    }
+    R = rhsQ;
+    return t/double(reps);
+  }
+
+  int num_faces() const { return uFaceM.size(); }
+};
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("FluxCheck3D");
+
+  int Nord = (argc>1) ? atoi(argv[1]) : 4;
+  int reps = (argc>2) ? atoi(argv[2]) : 10;
+
+  const char* meshes[] = { "Grid/3D/cubeK86.neu", "Grid/3D/cubeK268.neu" };
+
+  umCheckTable tab;
+
+  for (int t=0; t<2; ++t) {
+    FluxCheck3D* p = umCheckLoad("FluxCheck3D", new FluxCheck3D, meshes[t], Nord);
+    if (!p) { continue; }
+
+    DMat Rref, R;
+    double tb = p->TimeRHS(false, reps, Rref);
+    double tu = p->TimeRHS(true,  reps, R);
+    umCheckDiff d;  d.add(R, Rref);
+
+    tab.row("%-22s %5d %6d  %10.3e %10.3e %7.2f  %9.2e\n",
+            meshes[t], p->num_elmts(), p->num_faces(),
+            tb, tu, (tu>0.0) ? tb/tu : 0.0, d.rel());
+    delete p;
+  }
+
+  printf("\nEuler3D RHS, LF flux (N=%d)\n\n", Nord);
+  printf("%-22s %5s %6s  %10s %10s %7s  %9s\n",
+         "mesh", "K", "faces", "both sides", "per face", "speedup", "rel.diff");
+  tab.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
@@ -0,0 +1,158 @@
+// GeomCheck_main.cpp: entry point for the GeomCheck check
+// program (console version).  Validates and times Grad, 
+// Div and Curl with compressed geometric factors 
+// (NDG_GEOM=affine, see CompressGeo2D/3D)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "MaxwellCurved2D.h"
+#include "Maxwell3D.h"
+#include "CheckHarness.h"
+
+// Usage:  GeomCheck [mesh2D] [mesh3D] [N2D] [N3D] [reps]
+//
+// Loads the 2D mesh (pushed to the unit cylinder, so it
+// mixes affine and curved elements) and the 3D mesh, then
+// evaluates Grad, Div and Curl with the nodal factors and
+// with the compressed ones.  Reports the number of affine
+// elements, seconds per call of each path, and the largest
+// difference relative to max|nodal result| (round-off).
+
+
+//---------------------------------------------------------
+class GeomCheck2D : public umCheckFixture<MaxwellCurved2D>
+//---------------------------------------------------------
+{
+public:
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    if (!Load(mesh, Nord)) { return false; }
+    InitRun();
+    u.resize(Np,K); v.resize(Np,K); w.resize(Np,K);
+    u = apply(sin, 2.0*x);  v = apply(cos, x+3.0*y);  w = apply(sin, x-y);
+    return true;
+  }
+
+  //-------------------------------------
+  double Time(int op, bool bAffine, int reps, DMat* R)
+  //-------------------------------------
+  {
+    m_bAffineGeo = bAffine;
+    double t0 = timer.read();
+    for (int r=0; r<reps; ++r) {
+      switch (op) {
+      case 0: Grad2D(u, R[0], R[1]);              break;
+      case 1: Div2D (u, v, R[0]);                 break;
+      case 2: Curl2D(u, v, w, R[0], R[1], R[2]);  break;
+      }
+    }
+    return (timer.read()-t0)/double(reps);
+  }
+
+  int num_affine() const { return Naffine; }
+
+protected:
+  DMat u, v, w;
+};
+
+
+//---------------------------------------------------------
+class GeomCheck3D : public umCheckFixture<Maxwell3D>
+//---------------------------------------------------------
+{
+public:
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    if (!Load(mesh, Nord)) { return false; }
+    InitRun();
+    u.resize(Np,K); v.resize(Np,K); w.resize(Np,K);
+    u = apply(sin, 2.0*x);  v = apply(cos, y+z);  w = apply(sin, x+y+z);
+    return true;
+  }
+
+  //-------------------------------------
+  double Time(int op, bool bAffine, int reps, DMat* R)
+  //-------------------------------------
+  {
+    m_bAffineGeo = bAffine;
+    double t0 = timer.read();
+    for (int r=0; r<reps; ++r) {
+      switch (op) {
+      case 0: Grad3D(u, R[0], R[1], R[2]);        break;
+      case 1: Div3D (u, v, w, R[0]);              break;
+      case 2: Curl3D(u, v, w, R[0], R[1], R[2]);  break;
+      }
+    }
+    return (timer.read()-t0)/double(reps);
+  }
+
+  int num_affine() const { return Naffine; }
+
+protected:
+  DMat u, v, w;
+};
+
+
+//---------------------------------------------------------
+template <class T> static void
+CheckOps(T* p, const char* dim, int reps, umCheckTable& tab)
+//---------------------------------------------------------
+{
+  static const char* names[3] = { "Grad", "Div", "Curl" };
+  static const int   nout[3]  = { 0, 1, 3 };
+
+  for (int op=0; op<3; ++op) {
+    DMat Rref[3], R[3];
+    double tn = p->Time(op, false, reps, Rref);
+    double ta = p->Time(op, true,  reps, R);
+
+    int nr = nout[op] ? nout[op] : ('2'==dim[0] ? 2 : 3);
+    umCheckDiff d;
+    for (int f=0; f<nr; ++f) { d.add(R[f], Rref[f]); }
+
+    tab.row("%s %-4s %4d %6d %6d  %10.3e %10.3e %7.2f  %9.2e\n",
+            dim, names[op], p->num_nodes(), p->num_elmts(), p->num_affine(),
+            tn, ta, (ta>0.0) ? tn/ta : 0.0, d.rel());
+  }
+}
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("GeomCheck");
+
+  const char* mesh2 = (argc>1) ? argv[1] : "Grid/Other/circA01.neu";
+  const char* mesh3 = (argc>2) ? argv[2] : "Grid/3D/cubeK268.neu";
+  int N2   = (argc>3) ? atoi(argv[3]) : 8;
+  int N3   = (argc>4) ? atoi(argv[4]) : 6;
+  int reps = (argc>5) ? atoi(argv[5]) : 20;
+
+  // build the compressed factors alongside the nodal ones
+  setenv("NDG_GEOM", "affine", 1);
+
+  umCheckTable tab;
+
+  GeomCheck2D* p2 = umCheckLoad("GeomCheck", new GeomCheck2D, mesh2, N2);
+  if (p2) { CheckOps(p2, "2D", reps, tab);  delete p2; }
+
+  GeomCheck3D* p3 = umCheckLoad("GeomCheck", new GeomCheck3D, mesh3, N3);
+  if (p3) { CheckOps(p3, "3D", reps, tab);  delete p3; }
+
+  printf("\nGrad/Div/Curl: nodal vs compressed geometric factors\n");
+  printf("  2D: %s (N=%d)\n  3D: %s (N=%d)\n\n", mesh2, N2, mesh3, N3);
+  printf("%2s %-4s %4s %6s %6s  %10s %10s %7s  %9s\n",
+         "", "op", "Np", "K", "affine", "nodal", "affine", "speedup", "rel.diff");
+  tab.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
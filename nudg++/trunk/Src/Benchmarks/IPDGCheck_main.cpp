@@ -0,0 +1,189 @@
+// IPDGCheck_main.cpp: entry point for the IPDGCheck check
+// program (console version).  Validates and times the 
+// threaded IPDG operator assembly (NDG3D::PoissonIPDG3D),
+// and the block sparse form of the operators (BS_Type.h)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "Maxwell3D.h"
+#include "CheckHarness.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Usage:  IPDGCheck [mesh] [Nmin] [Nmax] [reps]
+//
+// For each order N, loads the mesh and assembles the IPDG
+// Poisson operator and mass matrix with one thread, then
+// with OMP_NUM_THREADS threads.  Reports seconds for each
+// assembly and the number of entries of {OP,MM} that differ
+// in pattern or value (should be 0: bit for bit).
+//
+// Then assembles {OP,MM} as BSd (see BS_Type.h), and
+// counts the entries that differ from the csc form, after
+// BSd::to_CS and after a BSd::load/to_CS round trip of the
+// csc form (should be 0).  Finally times y = OP*x, as csc
+// and as BSd (tril(OP), applied as symmetric), and Y = MM*X
+// with 4 columns, and reports the largest differences:
+// |dOP| is a rounding difference, since the symmetric
+// products sum in different orders, and |dMM| should be 0.
+//
+// Last, solves OP*u = MM*x with CS_PCG (cholinc, drop tol
+// 1e-4, tol 1e-9), with the products of the iterations on
+// the csc form and on (Np,Np) blocks, and reports seconds
+// per solve, iterations and the largest difference of the
+// two solutions relative to max|u|.
+
+
+//---------------------------------------------------------
+class IPDGCheck3D : public umCheckFixture<Maxwell3D>
+//---------------------------------------------------------
+{
+public:
+  //-------------------------------------
+  double Assemble(int nthreads, CSd& OP, CSd& MM)
+  //-------------------------------------
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+#endif
+    double t0 = timer.read();
+    PoissonIPDG3D(OP, MM);
+    return timer.read()-t0;
+  }
+
+  //-------------------------------------
+  double AssembleBS(BSd& OP, BSd& MM)
+  //-------------------------------------
+  {
+    double t0 = timer.read();
+    PoissonIPDG3D(OP, MM);
+    return timer.read()-t0;
+  }
+};
+
+
+//---------------------------------------------------------
+static int count_diff(const CSd& A, const CSd& B)
+//---------------------------------------------------------
+{
+  // number of entries that differ in pattern or value
+  if (A.m != B.m || A.n != B.n || A.nnz() != B.nnz()) {
+    return std::max(A.nnz(), B.nnz());
+  }
+  int nd = 0, nz = A.nnz();
+  const int *Ap=A.P.data(), *Bp=B.P.data();
+  const int *Ai=A.I.data(), *Bi=B.I.data();
+  const double *Ax=A.X.data(), *Bx=B.X.data();
+  for (int j=0; j<=A.n; ++j) { if (Ap[j] != Bp[j]) { ++nd; } }
+  for (int i=0; i<nz; ++i) {
+    if (Ai[i] != Bi[i] || Ax[i] != Bx[i]) { ++nd; }
+  }
+  return nd;
+}
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("IPDGCheck");
+
+  const char* mesh = (argc>1) ? argv[1] : "Grid/3D/cubeK268.neu";
+  int Nmin = (argc>2) ? atoi(argv[2]) : 2;
+  int Nmax = (argc>3) ? atoi(argv[3]) : 6;
+  int reps = (argc>4) ? atoi(argv[4]) : 20;
+
+  int nthreads = 1;
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+
+  umCheckTable tab, tab2, tab3;
+
+  for (int Nord=Nmin; Nord<=Nmax; ++Nord) {
+    IPDGCheck3D* p = umCheckLoad("IPDGCheck", new IPDGCheck3D, mesh, Nord);
+    if (!p) { break; }
+
+    CSd OP1("OP1"), MM1("MM1"), OPn("OPn"), MMn("MMn");
+    double t1 = p->Assemble(1,        OP1, MM1);
+    double tn = p->Assemble(nthreads, OPn, MMn);
+    int nd = count_diff(OP1, OPn) + count_diff(MM1, MMn);
+
+    tab.row("%2d %4d %6d %10d %8d  %10.3e %10.3e %7.2f  %6d\n",
+            Nord, p->num_nodes(), p->num_elmts(), OP1.nnz(), nthreads,
+            t1, tn, (tn>0.0) ? t1/tn : 0.0, nd);
+
+    // block sparse form
+    BSd bOP("bOP"), bMM("bMM"), rOP("rOP");
+    CSd cOP("cOP"), cMM("cMM"), c2("c2");
+    double tb = p->AssembleBS(bOP, bMM);
+    bOP.to_CS(cOP);  bMM.to_CS(cMM);
+    int ndb = count_diff(OP1, cOP) + count_diff(MM1, cMM);
+    rOP.load(OP1, p->num_nodes());  rOP.to_CS(c2);
+    ndb += count_diff(OP1, c2);
+
+    // products: OP1 holds tril(OP)
+    int n = OP1.num_rows(), nrhs = 4, r = 0;
+    OP1.set_shape(sp_LOWER | sp_SYMMETRIC);
+    DVec x(n), y1, y2;  DMat X(n, nrhs), Y1, Y2;
+    for (int i=1; i<=n; ++i) { x(i) = sin(0.37*i); }
+    for (int i=1; i<=n*nrhs; ++i) { X(i) = cos(0.11*i); }
+
+    double t0 = p->now();
+    for (r=0; r<reps; ++r) { y1 = OP1*x; }
+    double tcs = (p->now()-t0)/double(reps);  t0 = p->now();
+    for (r=0; r<reps; ++r) { y2 = bOP*x; }
+    double tbs = (p->now()-t0)/double(reps);  t0 = p->now();
+    for (r=0; r<reps; ++r) { Y1 = MM1*X; }
+    double tcm = (p->now()-t0)/double(reps);  t0 = p->now();
+    for (r=0; r<reps; ++r) { Y2 = bMM*X; }
+    double tbm = (p->now()-t0)/double(reps);
+
+    umCheckDiff dOP, dMM;
+    dOP.add(y2.data(), y1.data(), n);
+    dMM.add(Y2.data(), Y1.data(), n*nrhs);
+
+    tab2.row("%2d %4d %10d %8d  %10.3e %5d  %10.3e %10.3e %9.2e  %10.3e %10.3e %9.2e\n",
+             Nord, p->num_nodes(), OP1.nnz(), bOP.nnzb(), tb, ndb,
+             tcs, tbs, dOP.rel(), tcm, tbm, dMM.abs());
+
+    // PCG with csc and block products (cholinc owns its copy)
+    DVec rhs = MM1*x, u1, u2;
+    CS_PCG pcg1, pcg2;  CSd A1("A1"), A2("A2");
+    OP1.set_shape(sp_LOWER | sp_SYMMETRIC | sp_TRIANGULAR);
+    A1.copy(OP1);  pcg1.cholinc(A1, 1e-4);
+    A2.copy(OP1);  pcg2.cholinc(A2, 1e-4, p->num_nodes());
+    t0 = p->now();  u1 = pcg1.solve(rhs, 1e-9, 30);
+    double tp1 = p->now()-t0;  t0 = p->now();
+    u2 = pcg2.solve(rhs, 1e-9, 30);
+    double tp2 = p->now()-t0;
+
+    umCheckDiff du;  du.add(u2.data(), u1.data(), n);
+    tab3.row("%2d %4d %10d  %10.3e %4d  %10.3e %4d %7.2f  %9.2e\n",
+             Nord, p->num_nodes(), n, tp1, pcg1.get_iter(),
+             tp2, pcg2.get_iter(), (tp2>0.0) ? tp1/tp2 : 0.0, du.rel());
+    delete p;
+  }
+
+  printf("\nPoissonIPDG3D assembly: %s\n\n", mesh);
+  printf("%2s %4s %6s %10s %8s  %10s %10s %7s  %6s\n",
+         "N", "Np", "K", "nnz(OP)", "threads", "1 thread", "threads", "speedup", "ndiff");
+  tab.print();
+  printf("\nblock sparse (BSd), %d threads:\n\n", nthreads);
+  printf("%2s %4s %10s %8s  %10s %5s  %10s %10s %9s  %10s %10s %9s\n",
+         "N", "Np", "nnz(OP)", "blocks", "assemble", "ndiff",
+         "OP*x csc", "OP*x BSd", "|dOP|", "MM*X csc", "MM*X BSd", "|dMM|");
+  tab2.print();
+  printf("\nPCG solve of OP*u = MM*x, products on csc and on blocks:\n\n");
+  printf("%2s %4s %10s  %10s %4s  %10s %4s %7s  %9s\n",
+         "N", "Np", "n", "csc", "its", "BSd", "its", "speedup", "|du|");
+  tab3.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
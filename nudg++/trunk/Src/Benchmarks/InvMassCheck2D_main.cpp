@@ -0,0 +1,159 @@
+// InvMassCheck2D_main.cpp: entry point for the InvMassCheck2D
+// check program (console version).  Validates and times the
+// batched inverse mass product of CurvedEuler2D against the
+// element by element loop (see CurvedEuler2D::InvMass)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "CurvedEuler2D.h"
+#include "CheckHarness.h"
+
+// Usage:  InvMassCheck2D [N] [reps]
+//
+// For each mesh in Grid/Euler2D used by CurvedEuler2D,
+// sets up the simulation at order N (cubature data as in
+// Run()), and applies the inverse mass matrices of all
+// elements to the 4 fields of the initial solution, in
+// the element by element loop and in batched form (see
+// CurvedEuler2D::InvMass).  Reports seconds per call of
+// each (each call includes a copy of the rhs), then the
+// same for the curved elements alone (Cholesky solves
+// with chol_solve, and with umBatchChol), and the largest
+// difference (should be 0: bit for bit).
+
+
+//---------------------------------------------------------
+class InvMassCheck2D : public umCheckFixture<CurvedEuler2D>
+//---------------------------------------------------------
+{
+public:
+  InvMassCheck2D(int sim) { sim_type = sim; }
+
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    flux_type = FT_Roe;  ExactSolution = NULL;
+    switch (sim_type) {
+    case eIsentropicVortex:
+      InitialSolution = &InvMassCheck2D::IsentropicVortexIC2D;
+      BCSolution      = &InvMassCheck2D::IsentropicVortexBC2D;  break;
+    default:
+      // any smooth data will do: the channel flow solution
+      // is also used on the Couette meshes
+      InitialSolution = &InvMassCheck2D::ChannelIC2D;
+      BCSolution      = &InvMassCheck2D::ChannelBC2D;  break;
+    }
+    if (!Load(mesh, Nord)) { return false; }
+
+    InitRun();
+    CubatureOrder = (int)floor(2.0*(N+1)*3.0/2.0);
+    NGauss        = (int)floor(2.0*(N+1));
+    CubatureVolumeMesh2D(CubatureOrder);
+    InitBatchMass();
+    GaussFaceMesh2D(NGauss);
+    Resize_cub();
+    return true;
+  }
+
+  //-------------------------------------
+  double TimeInvMass(bool bBatch, int reps, DMat& R)
+  //-------------------------------------
+  {
+    m_bBatchMass = bBatch;
+    R = Q;  InvMass(R);                   // warm up
+    double t0 = timer.read();
+    for (int r=0; r<reps; ++r) { R = Q;  InvMass(R); }
+    return (timer.read()-t0)/double(reps);
+  }
+
+  //-------------------------------------
+  void CurvedSolve(bool bBatch, DMat& R)
+  //-------------------------------------
+  {
+    // curved elements only: step 3.1.b of InvMass
+    R = Q;
+    if (bBatch) { m_cub.mmBatch.solve(R, 4); return; }
+
+    DMat mmCHOL;  Index1D II;
+    for (int n=1; n<=4; ++n) {
+      for (int m=1; m<=curved.size(); ++m) {
+        int k = curved(m);  II.reset((k-1)*Np+1, k*Np);
+        mmCHOL.borrow(Np,Np, m_cub.mmCHOL.pCol(k));
+        mmCHOL.set_factmode(FACT_CHOL);
+        chol_solve(mmCHOL, view(R(II,n)));
+      }
+    }
+  }
+
+  //-------------------------------------
+  double TimeCurved(bool bBatch, int reps, DMat& R)
+  //-------------------------------------
+  {
+    CurvedSolve(bBatch, R);               // warm up
+    double t0 = timer.read();
+    for (int r=0; r<reps; ++r) { CurvedSolve(bBatch, R); }
+    return (timer.read()-t0)/double(reps);
+  }
+
+  int num_straight() const { return straight.size(); }
+  int num_curved()   const { return curved.size(); }
+};
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("InvMassCheck2D");
+
+  int Nord = (argc>1) ? atoi(argv[1]) : 8;
+  int reps = (argc>2) ? atoi(argv[2]) : 50;
+
+  // the meshes and cases of CurvedEuler2D::Driver
+  struct { const char* mesh; int sim; } cases[] = {
+    { "Grid/Euler2D/vortexA04.neu",   0 },    // eIsentropicVortex
+    { "Grid/Euler2D/Euler01.neu",     1 },    // eChannelFlow
+    { "Grid/Euler2D/Couette_K082.neu", 2 },   // eCouetteFlow
+    { "Grid/Euler2D/Couette_K242.neu", 2 },
+    { "Grid/Euler2D/Couette_K856.neu", 2 }
+  };
+  int Ncases = sizeof(cases)/sizeof(cases[0]);
+
+  umCheckTable tab;
+
+  for (int c=0; c<Ncases; ++c) {
+    InvMassCheck2D* p = umCheckLoad("InvMassCheck2D", new InvMassCheck2D(cases[c].sim), cases[c].mesh, Nord);
+    if (!p) { continue; }
+
+    DMat Rref, R;  umCheckDiff d;
+    double tloop  = p->TimeInvMass(false, reps, Rref);
+    double tbatch = p->TimeInvMass(true,  reps, R);
+    d.add(R, Rref);
+
+    double cloop=0.0, cbatch=0.0;
+    if (p->num_curved() > 0) {
+      cloop  = p->TimeCurved(false, reps, Rref);
+      cbatch = p->TimeCurved(true,  reps, R);
+      d.add(R, Rref);
+    }
+
+    tab.row("%-30s %6d %6d  %10.3e %10.3e %7.2f  %10.3e %10.3e %7.2f  %9.2e\n",
+            cases[c].mesh, p->num_straight(), p->num_curved(),
+            tloop, tbatch, (tbatch>0.0) ? tloop/tbatch : 0.0,
+            cloop, cbatch, (cbatch>0.0) ? cloop/cbatch : 0.0, d.abs());
+    delete p;
+  }
+
+  printf("\nCurvedEuler2D inverse mass, N = %d\n\n", Nord);
+  printf("%-30s %6s %6s  %10s %10s %7s  %10s %10s %7s  %9s\n",
+         "mesh", "K_str", "K_cur", "loop", "batched", "speedup",
+         "chol loop", "batched", "speedup", "max|diff|");
+  tab.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
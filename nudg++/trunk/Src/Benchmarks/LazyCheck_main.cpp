@@ -0,0 +1,242 @@
+// LazyCheck_main.cpp
+// check of the fused element-wise expressions of Vector<T>
+// and Mat_COL<T> (see VecExpr_Type.h)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+// Usage:  LazyCheck [N]
+//
+// Evaluates array expressions written in the plain syntax
+// of the solvers and compares them with element loops
+// doing the same operations in the same order; the values
+// must be identical.  Also checks
+//
+//   - the shape of results: a matrix operand gives its
+//     shape, a vector result keeps the shape of the target
+//   - that a matrix operand of * or / is a product or a
+//     solve, also when the other operand is an expression
+//   - assignments which resize an array read on the right
+//   - that no OBJ_temp array is leaked, whether or not an
+//     expression is evaluated
+//
+// Reports the number of failed checks; it must be zero.
+
+
+static int s_nfail = 0;
+
+
+//---------------------------------------------------------
+static void check(bool ok, const char* what)
+//---------------------------------------------------------
+{
+  if (!ok) { ++s_nfail; umLOG(1, "  FAILED: %s\n", what); }
+}
+
+
+//---------------------------------------------------------
+static void fill(DVec& v, int tag)
+//---------------------------------------------------------
+{
+  // distinct, non-zero values
+  for (int i=1; i<=v.size(); ++i) { v(i) = 0.5 + 0.01*tag + 1.0/(i+tag); }
+}
+
+
+//---------------------------------------------------------
+static bool same(const DVec& A, const DVec& B)
+//---------------------------------------------------------
+{
+  if (A.size() != B.size()) { return false; }
+  for (int i=1; i<=A.size(); ++i) {
+    if (A(i) != B(i)) { return false; }
+  }
+  return true;
+}
+
+
+//---------------------------------------------------------
+static void check_values(int N)
+//---------------------------------------------------------
+{
+  DVec nx(N,"nx"), ny(N,"ny"), dHx(N,"dHx"), dHy(N,"dHy"), dEz(N,"dEz");
+  fill(nx,1); fill(ny,2); fill(dHx,3); fill(dHy,4); fill(dEz,5);
+  double alpha = 0.75, a = 1.5, b = 3.0;
+
+  // a flux line (Maxwell2D::RHS)
+  DVec ndotdH, fluxHx, ref(N);
+  ndotdH =  nx.dm(dHx) + ny.dm(dHy);
+  fluxHx = -nx.dm(dEz) + alpha*(ndotdH.dm(ny) - dHy);
+  for (int i=1; i<=N; ++i) {
+    double nd = nx(i)*dHx(i) + ny(i)*dHy(i);
+    ref(i) = -(nx(i)*dEz(i)) + alpha*(nd*ny(i) - dHy(i));
+  }
+  check(same(fluxHx, ref), "flux line");
+
+  // scalars on both sides; A/x multiplies by 1/x
+  DVec C;
+  C = ((a*nx + b*ny) - 2.0*(dHx - 1.0))/b;
+  for (int i=1; i<=N; ++i) {
+    ref(i) = ((a*nx(i) + b*ny(i)) - 2.0*(dHx(i) - 1.0))*(1.0/b);
+  }
+  check(same(C, ref), "scalar operands, A/x");
+
+  C = 1.0/nx + nx/ny - ny*dEz;
+  for (int i=1; i<=N; ++i) { ref(i) = 1.0/nx(i) + nx(i)/ny(i) - ny(i)*dEz(i); }
+  check(same(C, ref), "x/U, U/V, U*V");
+
+  C = sqr(nx-ny) + sqrt(nx.dd(ny)) - abs(-dHx);
+  for (int i=1; i<=N; ++i) {
+    double d = nx(i)-ny(i);
+    ref(i) = d*d + sqrt(nx(i)/ny(i)) - fabs(-dHx(i));
+  }
+  check(same(C, ref), "sqr, sqrt, abs, dd");
+
+  // C += expr, with C on the right hand side
+  C = nx;  C += C.dm(ny) - 1.0;
+  for (int i=1; i<=N; ++i) { ref(i) = nx(i) + (nx(i)*ny(i) - 1.0); }
+  check(same(C, ref), "C += expr(C)");
+
+  // an expression where an array is expected
+  IVec idx = find(nx - ny, '>', 0.0);
+  DVec pos = (nx - ny).gt(0.0);
+  int npos = 0;
+  for (int i=1; i<=N; ++i) { if (nx(i)-ny(i) > 0.0) { ++npos; } }
+  check(idx.size()==npos && pos.sum()==npos, "find(expr), expr.gt()");
+}
+
+
+//---------------------------------------------------------
+static void check_shapes(int N)
+//---------------------------------------------------------
+{
+  int Nr = 3, Nc = N;
+  DMat A(Nr,Nc,"A"), B(Nr,Nc,"B");  DVec v(Nr*Nc,"v");
+  fill(A,6); fill(B,7); fill(v,8);
+
+  // matrix operands give the shape
+  DMat C;
+  C = A + v;
+  bool ok = (C.num_rows()==Nr && C.num_cols()==Nc);
+  for (int i=1; i<=Nr*Nc; ++i) { ok = ok && (C.data()[i-1] == A.data()[i-1] + v(i)); }
+  check(ok, "matrix + vector: shape, values");
+
+  C = 2.0*v - A.dm(B);
+  check(C.num_rows()==Nr && C.num_cols()==Nc, "vector - matrix: shape");
+
+  // a vector expression keeps the shape of the target ...
+  C = v + v;
+  check(C.num_rows()==Nr && C.num_cols()==Nc, "matrix = vector expression: shape");
+
+  // ... unless the length differs
+  DVec w(2*N,"w");  fill(w,9);
+  C = w - 1.0;
+  check(C.num_rows()==2*N && C.num_cols()==1, "matrix = vector expression: new length");
+
+  // a vector target takes the length
+  DVec u;
+  u = A - B;
+  check(u.size()==Nr*Nc, "vector = matrix expression: length");
+
+  // matrix * expression is a product: Dr*(u+w)
+  DMat Dr(Nc,Nc,"Dr");  fill(Dr,10);
+  for (int i=1; i<=Nc; ++i) { Dr(i,i) += Nc; }   // well conditioned
+  DVec x(Nc,"x"), y(Nc,"y"), s(Nc,"s");  fill(x,11); fill(y,12);
+  s = x + y;
+  DVec P1, P2;
+  P1 = Dr*(x + y);
+  P2 = Dr*s;
+  check(same(P1, P2), "matrix * expression");
+
+  // ... also inside an expression: -x + Dr*(x+y)/2
+  P1 = -x + Dr*(x + y)/2.0;
+  for (int i=1; i<=Nc; ++i) { P2(i) = -x(i) + P2(i)*(1.0/2.0); }
+  check(same(P1, P2), "expression with a matrix product");
+
+  // expression * matrix
+  P1 = (x + y)*Dr;
+  P2 = s*Dr;
+  check(same(P1, P2), "expression * matrix");
+
+  // right division by a matrix is a solve: (x+y)/Dr
+  P1 = (x + y)/Dr;
+  P2 = s/Dr;
+  check(same(P1, P2), "expression / matrix");
+}
+
+
+//---------------------------------------------------------
+static void check_alias(int N)
+//---------------------------------------------------------
+{
+  // resizing (*this) would destroy an operand: the
+  // expression is evaluated into a new array first
+  DVec a(N+3,"a"), b(N,"b"), ref(N);
+  fill(a,13); fill(b,14);
+  for (int i=1; i<=N; ++i) { ref(i) = b(i) + 2.0*a(i); }
+  a = b + 2.0*a;
+  check(same(a, ref), "vector: resize, (*this) on the right");
+
+  DMat A(3,N,"A"), B(N,3,"B");
+  fill(A,15); fill(B,16);
+  DVec r(3*N);
+  for (int i=1; i<=3*N; ++i) { r(i) = B.data()[i-1] - A.data()[i-1]; }
+  A = B - A;
+  check(A.num_rows()==N && A.num_cols()==3 && same(A, r), "matrix: reshape, (*this) on the right");
+}
+
+
+//---------------------------------------------------------
+static void check_temps(int N)
+//---------------------------------------------------------
+{
+  // OBJ_temp operands (products) are deleted after the
+  // evaluation, or with an expression that is not used
+  DMat Dr(N,N,"Dr");  fill(Dr,17);
+  DVec x(N,"x"), y(N,"y"), z;  fill(x,18); fill(y,19);
+
+  int count0 = x.get_s_count();
+  for (int r=0; r<10; ++r) {
+    z  = -x + Dr*x/2.0;
+    z += (Dr*x).dm(Dr*y);
+    z  = (x + Dr*y) - z.dm(Dr*(x-y));
+    (void)(Dr*x + y);                     // never evaluated
+    IVec  n = find(Dr*x - y, '<', 0.0);  // converted to an array
+    DMat M;  M = Dr + trans(Dr);
+  }
+  check(x.get_s_count() == count0, "OBJ_temp operands released");
+}
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+
+  int N = (argc>1) ? atoi(argv[1]) : 10;
+
+#if (__cplusplus >= 201103L)
+  // an expression is moved, never copied
+  DVec p(2), q(2);
+  typedef decltype(p + q) Expr;
+  static_assert(!std::is_copy_constructible<Expr>::value, "VecExpr: copy");
+  static_assert( std::is_move_constructible<Expr>::value, "VecExpr: move");
+#endif
+
+  check_values(N);
+  check_shapes(N);
+  check_alias (N);
+  check_temps (N);
+
+  umLOG(1, "LazyCheck: N = %d, failed checks: %d  ==> %s\n",
+        N, s_nfail, s_nfail ? "FAILED" : "ok");
+
+  FreeGlobalInfo();
+  return s_nfail ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+// Maxwell3DCheck_main.cpp: entry point for the Maxwell3DCheck
+// check program (console version).  Validates and times the
+// fused, threaded Maxwell3D RHS against the library path
+// (see Maxwell3D::RHS_fused)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "Maxwell3D.h"
+#include "CheckHarness.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Usage:  Maxwell3DCheck [mesh] [Nmin] [Nmax] [reps]
+//
+// For each order N, loads the mesh, fills the six fields
+// with smooth non-polynomial data, and evaluates the RHS
+// with the library path and with RHS_fused.  Reports the
+// largest difference (should be 0: bit for bit), seconds
+// per call of each path, and the GFLOP/s and GB/s of the
+// fused RHS.  Set OMP_NUM_THREADS to vary the threads.
+
+
+//---------------------------------------------------------
+class Maxwell3DCheck : public umCheckFixture<Maxwell3D>
+//---------------------------------------------------------
+{
+public:
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    if (!Load(mesh, Nord)) { return false; }
+    InitRun();
+
+    Hx = apply(sin, 2.0*x);  Hy = apply(cos, 3.0*y);  Hz = apply(sin, x+z);
+    Ex = apply(cos, 2.0*z);  Ey = apply(sin, y-x);    Ez = apply(cos, x+y+z);
+    return true;
+  }
+
+  //-------------------------------------
+  double TimeRHS(bool bFused, int reps, DMat* rhs)
+  //-------------------------------------
+  {
+    m_bFusedRHS = bFused;
+    // best of reps calls, after a warm up
+    this->RHS();
+    double ts = 0.0;
+    for (int r=0; r<reps; ++r) {
+      double t0 = timer.read();
+      this->RHS();
+      double t = timer.read()-t0;
+      if (0==r || t<ts) { ts = t; }
+    }
+    rhs[0]=rhsHx; rhs[1]=rhsHy; rhs[2]=rhsHz;
+    rhs[3]=rhsEx; rhs[4]=rhsEy; rhs[5]=rhsEz;
+    return ts;
+  }
+
+  int    num_threads() const { return m_nthreads; }
+  double flops()      const { return m_flopsRHS; }
+  double bytes()      const { return m_bytesRHS; }
+};
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("Maxwell3DCheck");
+
+  const char* mesh = (argc>1) ? argv[1] : "Grid/3D/cubeK268.neu";
+  int Nmin = (argc>2) ? atoi(argv[2]) : 4;
+  int Nmax = (argc>3) ? atoi(argv[3]) : 8;
+  int reps = (argc>4) ? atoi(argv[4]) : 10;
+
+  umCheckTable tab;
+
+  for (int Nord=Nmin; Nord<=Nmax; ++Nord) {
+    Maxwell3DCheck* p = umCheckLoad("Maxwell3DCheck", new Maxwell3DCheck, mesh, Nord);
+    if (!p) { break; }
+
+    DMat Rref[6], R[6];
+    double tlib = p->TimeRHS(false, reps, Rref);
+    double tfus = p->TimeRHS(true,  reps, R);
+
+    umCheckDiff d;
+    for (int f=0; f<6; ++f) { d.add(R[f], Rref[f]); }
+
+    tab.row("%2d %4d %6d %8d  %10.3e %10.3e %7.2f %8.2f %8.2f  %9.2e\n",
+            Nord, p->num_nodes(), p->num_elmts(), p->num_threads(),
+            tlib, tfus, (tfus>0.0) ? tlib/tfus : 0.0,
+            1e-9*p->flops()/tfus, 1e-9*p->bytes()/tfus, d.abs());
+    delete p;
+  }
+
+  printf("\nMaxwell3D RHS: %s\n\n", mesh);
+  printf("%2s %4s %6s %8s  %10s %10s %7s %8s %8s  %9s\n",
+         "N", "Np", "K", "threads", "library", "fused", "speedup", "GFLOP/s", "GB/s", "max|diff|");
+  tab.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
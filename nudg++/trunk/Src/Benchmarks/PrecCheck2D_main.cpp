@@ -0,0 +1,164 @@
+// PrecCheck2D_main.cpp: entry point for the PrecCheck2D
+// check program (console version).  Validates and times
+// Maxwell2D stepping in single and mixed precision, and
+// the fused RHS, against the library path (Maxwell2D_P.h)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "Maxwell2D.h"
+#include "Maxwell2D_P.h"
+#include "CheckHarness.h"
+
+// Usage:  PrecCheck2D [N] [FinalTime] [mesh ...]
+//
+// For each mesh, integrates the Maxwell2D (TM) problem to
+// FinalTime with the library (DMat) path, with the fused
+// RHS (Maxwell2D::RHS_fused), then with the Maxwell2D_P
+// steppers in double, mixed and single, and reports 
+// seconds per step, the difference from the library path
+// (relative to max|Ez|), and the error against the exact
+// solution (a standing mode).  The fused RHS should match
+// the library path bit for bit (rel.diff 0).
+
+
+//---------------------------------------------------------
+class Maxwell2DCheck : public umCheckFixture<Maxwell2D>
+//---------------------------------------------------------
+{
+public:
+  Maxwell2DCheck(double Tfinal) : m_Tfinal(Tfinal) {}
+
+  //-------------------------------------
+  bool Setup(const char* mesh, int Nord)
+  //-------------------------------------
+  {
+    if (!Load(mesh, Nord, m_Tfinal)) { return false; }
+    InitRun();
+    return true;
+  }
+
+  //-------------------------------------
+  double RunDouble(DMat& EzOut, bool bFused=false)
+  //-------------------------------------
+  {
+    // the loop of Maxwell2D::Run, without reports
+    m_bFusedRHS = bFused;
+    SetIC();  resHx=0.0; resHy=0.0; resEz=0.0;
+    double t0 = timer.read();
+    for (int n=1; n<=Nsteps; ++n) {
+      for (int INTRK=1; INTRK<=5; ++INTRK) {
+        this->RHS();
+        resHx *= rk4a(INTRK);   resHx += dt*rhsHx;
+        resHy *= rk4a(INTRK);   resHy += dt*rhsHy;
+        resEz *= rk4a(INTRK);   resEz += dt*rhsEz;
+        Hx += rk4b(INTRK)*resHx;
+        Hy += rk4b(INTRK)*resHy;
+        Ez += rk4b(INTRK)*resEz;
+      }
+    }
+    double ts = (timer.read()-t0)/double(Nsteps);
+    EzOut = Ez;
+    return ts;
+  }
+
+  //-------------------------------------
+  double RunPrec(umPrecision prec, DMat& EzOut)
+  //-------------------------------------
+  {
+    SetIC();
+    Maxwell2D_Pbase* p = NewMaxwell2D_P(prec, *this);
+    p->SetFields(Hx, Hy, Ez);
+    double t0 = timer.read();
+    for (int n=1; n<=Nsteps; ++n) { p->Step(dt); }
+    double ts = (timer.read()-t0)/double(Nsteps);
+    p->GetFields(Hx, Hy, Ez);
+    delete p;
+    EzOut = Ez;
+    return ts;
+  }
+
+  //-------------------------------------
+  double ExactError(const DMat& E)
+  //-------------------------------------
+  {
+    // Ez = sin(pi x) sin(pi y) cos(sqrt(2) pi t)
+    double ct = cos(sqrt(2.0)*pi*FinalTime), err = 0.0;
+    for (int i=1; i<=E.size(); ++i) {
+      err = std::max(err, fabs(E(i) - Ezinit(i)*ct));
+    }
+    return err;
+  }
+
+  int num_steps() const { return Nsteps; }
+
+protected:
+  double m_Tfinal;
+};
+
+
+//---------------------------------------------------------
+static double rel_diff(const DMat& A, const DMat& R)
+//---------------------------------------------------------
+{
+  umCheckDiff d;  d.add(A, R);
+  return d.rel();
+}
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+  umCheckBanner("PrecCheck2D");
+
+  int    Nord   = (argc>1) ? atoi(argv[1]) : 8;
+  double Tfinal = (argc>2) ? atof(argv[2]) : 1.0;
+
+  std::vector<std::string> meshes;
+  for (int i=3; i<argc; ++i) { meshes.push_back(argv[i]); }
+  if (meshes.empty()) {
+    meshes.push_back("Grid/Maxwell2D/Maxwell2.neu");
+    meshes.push_back("Grid/Maxwell2D/Maxwell1.neu");
+    meshes.push_back("Grid/Maxwell2D/Maxwell05.neu");
+    meshes.push_back("Grid/Maxwell2D/Maxwell025.neu");
+  }
+
+  const umPrecision precs[3] = { umPREC_DOUBLE, umPREC_MIXED, umPREC_SINGLE };
+  umCheckTable tab;
+
+  for (size_t m=0; m<meshes.size(); ++m) {
+    const char* mesh = meshes[m].c_str();
+    Maxwell2DCheck* p = umCheckLoad("PrecCheck2D", new Maxwell2DCheck(Tfinal), mesh, Nord);
+    if (!p) { continue; }
+
+    DMat Eref("Eref"), E("E");
+    double tref = p->RunDouble(Eref);
+    tab.row("%-32s %6d %5d  %-8s %10.3e %7.2f  %9s  %9.2e\n",
+            mesh, p->num_elmts(), p->num_steps(), "library",
+            tref, 1.0, "-", p->ExactError(Eref));
+
+    double tf = p->RunDouble(E, true);
+    tab.row("%-32s %6d %5d  %-8s %10.3e %7.2f  %9.2e  %9.2e\n",
+            "", p->num_elmts(), p->num_steps(), "fused",
+            tf, (tf>0.0) ? tref/tf : 0.0, rel_diff(E, Eref), p->ExactError(E));
+
+    for (int k=0; k<3; ++k) {
+      double ts = p->RunPrec(precs[k], E);
+      tab.row("%-32s %6d %5d  %-8s %10.3e %7.2f  %9.2e  %9.2e\n",
+              "", p->num_elmts(), p->num_steps(), umPrecName(precs[k]),
+              ts, (ts>0.0) ? tref/ts : 0.0, rel_diff(E, Eref), p->ExactError(E));
+    }
+    delete p;
+  }
+
+  printf("\nMaxwell2D: N = %d, FinalTime = %g\n\n", Nord, Tfinal);
+  printf("%-32s %6s %5s  %-8s %10s %7s  %9s  %9s\n",
+         "mesh", "K", "steps", "path", "sec/step", "speedup", "rel.diff", "err(Ez)");
+  tab.print();
+  printf("\n");
+
+  FreeGlobalInfo();
+  return 0;
+}
@@ -0,0 +1,173 @@
+// RegistryCheck_main.cpp
+// multi-threaded check of the per-thread array registries
+// (USE_THREAD_REGISTRY, see umRegistrySet in Registry_Type.h)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG_headers.h"
+#include "Stopwatch.h"
+
+#if (USE_THREAD_REGISTRY)
+#include <thread>
+#include <mutex>
+#include <vector>
+#endif
+
+// Usage:  RegistryCheck [Nthreads] [reps]
+//
+// Each thread creates and destroys small, medium and general
+// arrays and expression temporaries, checking their values.
+// Every thread also leaves a share of its arrays in a common
+// pool.  Part of the pool is freed and resized by the other
+// threads while its owners are still running, the rest by
+// the main thread after every owner has exited.  Reports
+// the number of bad values and of leaked arrays; both must
+// be zero.  Build with -fsanitize=thread to check for races.
+//
+// The threads run in two waves: the second must reuse the
+// registry sets the first returned to the pool, so at most
+// Nthreads+1 sets exist (with the main thread's).  Last,
+// times the owner path: nanoseconds to create and destroy
+// one array of each registry on the main thread.
+
+
+#if (USE_THREAD_REGISTRY)
+
+static const int s_len[3] = { 12, 300, 5000 };  // one per registry
+
+static std::mutex          s_pool_lock;
+static std::vector<DVec*>  s_pool;
+static std::mutex          s_bad_lock;
+static int                 s_bad = 0;
+
+
+//---------------------------------------------------------
+static void fill(DVec& v, int tag)
+//---------------------------------------------------------
+{
+  for (int i=1; i<=v.size(); ++i) { v(i) = tag + i; }
+}
+
+
+//---------------------------------------------------------
+static int check(const DVec& v, int tag, double scale)
+//---------------------------------------------------------
+{
+  int nbad = 0;
+  for (int i=1; i<=v.size(); ++i) {
+    if (v(i) != scale*(tag + i)) { ++nbad; }
+  }
+  return nbad;
+}
+
+
+//---------------------------------------------------------
+static void worker(int id, int reps)
+//---------------------------------------------------------
+{
+  int nbad = 0;
+  for (int r=0; r<reps; ++r)
+  {
+    int tag = 1000*id + r;
+    for (int j=0; j<3; ++j)
+    {
+      int n = s_len[j];
+      DVec a(n, "a"), b(n, "b");
+      fill(a, tag);  fill(b, tag);
+      DVec c = a + b;               // registry temporary
+      nbad += check(c, tag, 2.0);
+
+      // leave some arrays for other threads
+      if (0 == (r % 4)) {
+        DVec* p = new DVec(n, "pool");
+        fill(*p, tag);
+        std::lock_guard<std::mutex> lock(s_pool_lock);
+        s_pool.push_back(p);
+      }
+    }
+
+    // free and resize arrays from other threads
+    // while their owners may still be running
+    if (1 == (r % 4)) {
+      DVec* p = NULL;
+      {
+        std::lock_guard<std::mutex> lock(s_pool_lock);
+        if (s_pool.size() > 8) { p = s_pool.back(); s_pool.pop_back(); }
+      }
+      if (p) { p->resize(s_len[r%3]+1); delete p; }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(s_bad_lock);
+  s_bad += nbad;
+}
+
+#endif
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  InitGlobalInfo();
+
+#if (USE_THREAD_REGISTRY)
+
+  int Nthreads = (argc>1) ? atoi(argv[1]) : 8;
+  int reps     = (argc>2) ? atoi(argv[2]) : 2000;
+
+  DVec probe;
+  int count0 = probe.get_s_count();
+
+  for (int w=0; w<2; ++w) {
+    std::vector<std::thread> threads;
+    for (int t=0; t<Nthreads; ++t) {
+      threads.push_back(std::thread(worker, w*Nthreads+t+1, reps));
+    }
+    for (int t=0; t<Nthreads; ++t) {
+      threads[t].join();
+    }
+  }
+  int nsets = umRegistrySet<double>::num_sets();
+
+  // owners have exited: release the rest from here
+  int nleft = (int)s_pool.size();
+  for (int i=0; i<nleft; ++i) {
+    DVec* p = s_pool[i];
+    p->resize(s_len[i%3]);
+    delete p;
+  }
+  s_pool.clear();
+
+  int nleak = probe.get_s_count() - count0;
+  bool bFail = (s_bad || nleak || nsets > Nthreads+1);
+
+  // owner path: create and destroy on the main thread
+  stopwatch timer;  timer.start();
+  double ns[3] = { 0.0, 0.0, 0.0 };
+  int Ntime = 50*reps;
+  for (int j=0; j<3; ++j) {
+    double t0 = timer.read();
+    for (int r=0; r<Ntime; ++r) { DVec a(s_len[j], "a"); }
+    ns[j] = 1e9*(timer.read()-t0)/double(Ntime);
+  }
+
+  umLOG(1, "RegistryCheck: 2 x %d threads, %d reps, %d arrays left to main\n",
+        Nthreads, reps, nleft);
+  umLOG(1, "  registry sets: %d\n", nsets);
+  umLOG(1, "  bad values: %d, leaked arrays: %d  ==> %s\n",
+        s_bad, nleak, bFail ? "FAILED" : "ok");
+  umLOG(1, "  owner create+destroy (ns): small %.1f, medium %.1f, general %.1f\n",
+        ns[0], ns[1], ns[2]);
+
+  FreeGlobalInfo();
+  return bFail ? 1 : 0;
+
+#else
+
+  umLOG(1, "RegistryCheck: built without USE_THREAD_REGISTRY\n");
+  FreeGlobalInfo();
+  return 0;
+
+#endif
+}
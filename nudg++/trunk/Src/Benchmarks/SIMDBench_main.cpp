@@ -0,0 +1,133 @@
+// SIMDBench_main.cpp
+// microbenchmark: element-wise DVec operators at each
+// SIMD level (see SIMD_funcs.h)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+
+#include <chrono>
+#include <cstring>
+
+// Usage:  SIMDBench [Nmax]
+//
+// For each operator and array length N, reports ns per
+// element at each SIMD level the cpu supports, and checks
+// that each level gives results identical to the scalar
+// kernels.  Lengths are typical of Np*K (Np = 10..28).
+
+
+//---------------------------------------------------------
+struct BenchOp
+//---------------------------------------------------------
+{
+  const char* name;
+  void (*run)(DVec& A, const DVec& B);
+};
+
+static void op_mul   (DVec& A, const DVec& B) { A *= B; }
+static void op_div   (DVec& A, const DVec& B) { A /= B; }
+static void op_add   (DVec& A, const DVec& B) { A += B; }
+static void op_sub   (DVec& A, const DVec& B) { A -= B; }
+static void op_axpy  (DVec& A, const DVec& B) { A.axp_y(0.75, B); }
+static void op_scal  (DVec& A, const DVec& B) { A *= 0.75; }
+static void op_sqr   (DVec& A, const DVec& B) { A.SQR(); }
+static void op_sqrt  (DVec& A, const DVec& B) { A.SQRT(); }
+static void op_abs   (DVec& A, const DVec& B) { A.set_abs(); }
+static void op_max   (DVec& A, const DVec& B) { A = max(A, B); }
+static void op_maxs  (DVec& A, const DVec& B) { A = max(0.5, A); }
+static void op_dm    (DVec& A, const DVec& B) { A = A.dm(B); }
+static void op_dd    (DVec& A, const DVec& B) { A = A.dd(B); }
+
+static const BenchOp s_ops[] = {
+  { "A.*=B",      op_mul  },
+  { "A./=B",      op_div  },
+  { "A+=B",       op_add  },
+  { "A-=B",       op_sub  },
+  { "axp_y",      op_axpy },
+  { "A*=x",       op_scal },
+  { "SQR",        op_sqr  },
+  { "SQRT",       op_sqrt },
+  { "abs",        op_abs  },
+  { "max(A,B)",   op_max  },
+  { "max(x,A)",   op_maxs },
+  { "A.dm(B)",    op_dm   },
+  { "A.dd(B)",    op_dd   }
+};
+
+
+//---------------------------------------------------------
+static double now()
+//---------------------------------------------------------
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//---------------------------------------------------------
+static double time_op(const BenchOp& op, DVec& A, const DVec& X, const DVec& B, int reps)
+//---------------------------------------------------------
+{
+  // time (refresh + op) minus time (refresh), so that
+  // each pass starts from the same data
+  int N = X.size();
+  double t0=now();
+  for (int r=0; r<reps; ++r) { memcpy(A.data(), X.data(), N*sizeof(double)); }
+  double t1=now();
+  for (int r=0; r<reps; ++r) { memcpy(A.data(), X.data(), N*sizeof(double)); op.run(A, B); }
+  double t2=now();
+  return std::max(0.0, (t2-t1)-(t1-t0)) / double(reps);
+}
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  int Nmax = (argc>1) ? atoi(argv[1]) : 2000000;
+
+  const int lens[] = { 10*100, 15*500, 21*1000, 28*4000, 21*20000, 28*80000 };
+  const int nlens = sizeof(lens)/sizeof(lens[0]);
+  const int nops  = sizeof(s_ops)/sizeof(s_ops[0]);
+
+  umSIMD_Level best = umSIMD_best_level();
+  printf("\nSIMD kernels: best level %s\n", umSIMD_get_ops(best).name);
+  printf("ns per element (speedup of best level over scalar)\n\n");
+
+  printf("%-10s %9s", "operator", "N");
+  for (int l=umSIMD_SCALAR; l<=best; ++l) { printf(" %8s", umSIMD_get_ops((umSIMD_Level)l).name); }
+  printf("  speedup  check\n");
+
+  for (int k=0; k<nops; ++k) {
+    const BenchOp& op = s_ops[k];
+    for (int n=0; n<nlens; ++n) {
+      int N = lens[n]; if (N>Nmax) { continue; }
+
+      // A in [-1,2), B in [0.5,1.5): nonzero divisor
+      DVec X(N), B(N), A(N), R("R");
+      unsigned int seed = 12345;
+      for (int i=0; i<N; ++i) {
+        seed = 1664525u*seed + 1013904223u; X[i] = -1.0 + 3.0*(seed>>8)/16777216.0;
+        seed = 1664525u*seed + 1013904223u; B[i] =  0.5 + 1.0*(seed>>8)/16777216.0;
+      }
+      int reps = std::max(3, int(2e8 / double(N) / 20.0));
+
+      double ts[umSIMD_AVX512+1] = {0.0};
+      bool bOK = true;
+      for (int l=umSIMD_SCALAR; l<=best; ++l) {
+        umSIMD_set_level((umSIMD_Level)l);
+        A = X; op.run(A, B);    // warm up, and check
+        if (umSIMD_SCALAR==l) { R = A; }
+        else if (memcmp(R.data(), A.data(), N*sizeof(double))) { bOK = false; }
+        ts[l] = time_op(op, A, X, B, reps);
+      }
+      umSIMD_set_level(best);
+
+      printf("%-10s %9d", op.name, N);
+      for (int l=umSIMD_SCALAR; l<=best; ++l) { printf(" %8.3f", 1e9*ts[l]/double(N)); }
+      printf("  %6.2fx  %s\n", (ts[best]>0.0) ? ts[umSIMD_SCALAR]/ts[best] : 0.0, bOK ? "ok" : "DIFFERS");
+    }
+  }
+  printf("\n");
+  return 0;
+}
@@ -0,0 +1,117 @@
+// SmallMatBench_main.cpp
+// microbenchmark: order-specialized operator kernels
+// against GEMM (see SmallMat_funcs.h)
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "SmallMat_funcs.h"
+
+#include <chrono>
+#include <cstring>
+
+// Usage:  SmallMatBench [Nmax] [Ntot]
+//
+// For Dim=2,3 and orders N=1..Nmax, times C = A*B for the
+// volume (Np,Np), lift (Np,Nfaces*Nfp) and stacked
+// derivative (Dim*Np,Np) shapes, with B
+// holding K element columns (K*Np ~ Ntot nodes), using the
+// reference GEMM and the specialized kernel at each SIMD
+// level the cpu supports.  Reports GFLOP/s, the speedup of
+// the best level over GEMM, and checks that every kernel
+// gives results identical to GEMM.
+
+
+static const char* s_shape[umSM_NSHAPE] = { "Dr", "LIFT", "Drst" };
+
+
+//---------------------------------------------------------
+static double now()
+//---------------------------------------------------------
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//---------------------------------------------------------
+static void run_gemm(int M, int Kc, int K, const DMat& A, const DMat& B, DMat& C)
+//---------------------------------------------------------
+{
+  GEMM ('N','N',M,K,Kc, 1.0,A.data(),M, B.data(),Kc, 0.0,C.data(),M);
+}
+
+
+//---------------------------------------------------------
+template <class F>
+static double time_it(F f, int reps)
+//---------------------------------------------------------
+{
+  f();                            // warm up
+  double t0=now();
+  for (int r=0; r<reps; ++r) { f(); }
+  return (now()-t0) / double(reps);
+}
+
+
+//---------------------------------------------------------
+int main(int argc, char* argv[])
+//---------------------------------------------------------
+{
+  int Nmax = (argc>1) ? atoi(argv[1]) : umSM_MAXORDER;
+  int Ntot = (argc>2) ? atoi(argv[2]) : 200000;
+  Nmax = std::min(std::max(Nmax,1), (int)umSM_MAXORDER);
+
+  umSIMD_Level best = umSIMD_best_level();
+  printf("\nsmall-matrix kernels: best level %s, %d nodes\n", umSIMD_get_ops(best).name, Ntot);
+  printf("GFLOP/s (speedup of best level over GEMM)\n\n");
+
+  printf("%3s %2s %-4s %4s %4s %6s %8s", "dim", "N", "op", "M", "Kc", "K", "gemm");
+  for (int l=umSIMD_SCALAR; l<=best; ++l) {
+    if (umSIMD_SSE2==l) { continue; }   // same kernels as scalar
+    printf(" %8s", umSIMD_get_ops((umSIMD_Level)l).name);
+  }
+  printf("  speedup  check\n");
+
+  for (int Dim=2; Dim<=3; ++Dim) {
+    for (int N=1; N<=Nmax; ++N) {
+      int Np  = (2==Dim) ? (N+1)*(N+2)/2 : (N+1)*(N+2)*(N+3)/6;
+      int Nfq = (2==Dim) ? 3*(N+1)       : 2*(N+1)*(N+2);
+      int K   = std::max(1, Ntot/Np);
+
+      for (int shape=umSM_VOL; shape<umSM_NSHAPE; ++shape) {
+        int M  = (umSM_GRAD==shape) ? Dim*Np : Np;
+        int Kc = (umSM_LIFT==shape) ? Nfq    : Np;
+        DMat A(M,Kc), B(Kc,K), C(M,K), R("R");
+
+        unsigned int seed = 12345;
+        for (int i=0; i<M*Kc; ++i) { seed = 1664525u*seed + 1013904223u; A.data()[i] = -1.0 + 2.0*(seed>>8)/16777216.0; }
+        for (int i=0; i<Kc*K; ++i) { seed = 1664525u*seed + 1013904223u; B.data()[i] = -1.0 + 2.0*(seed>>8)/16777216.0; }
+
+        double flops = 2.0*double(M)*double(Kc)*double(K);
+        int reps = std::max(3, int(2e9 / flops));
+
+        run_gemm(M,Kc,K, A,B,C);  R = C;
+        double tg = time_it([&]() { run_gemm(M,Kc,K, A,B,C); }, reps);
+
+        double ts[umSIMD_AVX512+1] = {0.0};
+        bool bOK = true;
+        for (int l=umSIMD_SCALAR; l<=best; ++l) {
+          if (umSIMD_SSE2==l) { continue; }
+          umSmallMat_fn fn = umSmallMat_get((umSIMD_Level)l, Dim, N, shape);
+          C.fill(0.0);  fn(K, 1.0,A.data(), B.data(),Kc, 0.0,C.data(),M);
+          if (memcmp(R.data(), C.data(), M*K*sizeof(double))) { bOK = false; }
+          ts[l] = time_it([&]() { fn(K, 1.0,A.data(), B.data(),Kc, 0.0,C.data(),M); }, reps);
+        }
+
+        printf("%3d %2d %-4s %4d %4d %6d %8.2f", Dim, N, s_shape[shape], M, Kc, K, 1e-9*flops/tg);
+        for (int l=umSIMD_SCALAR; l<=best; ++l) {
+          if (umSIMD_SSE2==l) { continue; }
+          printf(" %8.2f", 1e-9*flops/ts[l]);
+        }
+        printf("  %6.2fx  %s\n", tg/ts[best], bOK ? "ok" : "DIFFERS");
+      }
+    }
+  }
+  printf("\n");
+  return 0;
+}
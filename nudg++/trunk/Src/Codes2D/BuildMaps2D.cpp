@@ -75,4 +75,7 @@ void NDG2D::BuildMaps2D()
 
   // Create list of boundary nodes
   mapB = find(vmapP, '=', vmapM);  vmapB = vmapM(mapB);
+
+  // list each face once, for fluxes (see BuildFaceList2D)
+  BuildFaceList2D();
 }
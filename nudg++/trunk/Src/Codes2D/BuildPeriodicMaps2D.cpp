@@ -117,4 +117,7 @@ void NDG2D::BuildPeriodicMaps2D(double xperiod, double yperiod)
 
   // Create default list of boundary nodes
   mapB = find(vmapP, '=', vmapM);  vmapB = vmapM(mapB);
+
+  // periodic faces are now interior faces
+  BuildFaceList2D();
 }
@@ -0,0 +1,70 @@
+// CompressFace2D.cpp
+// one set of face factors per straight face
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG2D.h"
+
+
+//---------------------------------------------------------
+void NDG2D::CompressFace2D(const DMat& Fs)
+//---------------------------------------------------------
+{
+  // On a straight face of an affine map {nx,ny,sJ,Fscale}
+  // are constant.  With NDG_GEOM=affine (m_bAffineGeo, see
+  // CompressGeo2D), store their face means in faceK(:,f)
+  // for f = (k-1)*Nfaces + face, and nodal data in faceC
+  // only for faces where they vary.  Callers pass Fscale
+  // once they have set it, after Normals2D().
+
+  if (!m_bAffineGeo) {
+    faceIdx.destroy(); faceK.destroy(); faceC.destroy(); Nflat = 0;
+    return;
+  }
+  assert(Fs.size() == nx.size());
+
+  const int NG = 4, NM = 2;  // factors, of which normal components
+  const int Nf = Nfaces*K;
+  const double tol = 1e-10;   // relative, per factor and face
+  const double* g[NG] = { nx.data(), ny.data(), sJ.data(), Fs.data() };
+  double lo[NG], hi[NG], fmax[NG];
+  int fc=0, n=0, i=0, Nc=0;
+
+  // face fc holds entries (fc-1)*Nfp + (0:Nfp-1) of each
+  // (Nfp*Nfaces,K) array
+  faceIdx.resize(Nf); faceK.resize(NG, Nf);
+  for (fc=1; fc<=Nf; ++fc) {
+    int o = (fc-1)*Nfp;  double nmax = 0.0;
+    for (n=0; n<NG; ++n) {
+      double sum = 0.0;  lo[n] = hi[n] = g[n][o];  fmax[n] = 0.0;
+      for (i=0; i<Nfp; ++i) {
+        double gi = g[n][o+i];
+        lo[n] = std::min(lo[n], gi); hi[n] = std::max(hi[n], gi); sum += gi;
+        fmax[n] = std::max(fmax[n], fabs(gi));
+      }
+      if (n<NM) { nmax = std::max(nmax, fmax[n]); }
+      faceK(n+1, fc) = sum / double(Nfp);
+    }
+
+    // straight if each factor f varies by at most tol*max|f|
+    // on the face; a normal component that is round-off
+    // next to the others is taken as zero
+    bool bFlat = true;
+    for (n=0; n<NG && bFlat; ++n) {
+      bool bZero = (n<NM) && (fmax[n] <= tol*nmax);
+      bFlat = bZero || (hi[n]-lo[n] <= tol*fmax[n]);
+    }
+    faceIdx(fc) = bFlat ? 0 : ++Nc;
+  }
+  Nflat = Nf - Nc;
+
+  // nodal factors of the curved faces
+  faceC.resize(NG*Nfp, Nc);
+  for (fc=1; fc<=Nf; ++fc) {
+    if (0 == faceIdx(fc)) { continue; }
+    double* c = faceC.pCol(faceIdx(fc));  int o = (fc-1)*Nfp;
+    for (n=0; n<NG; ++n) {
+      for (i=0; i<Nfp; ++i) { c[n*Nfp+i] = g[n][o+i]; }
+    }
+  }
+}
@@ -39,6 +39,9 @@ Cub2D& NDG2D::CubatureVolumeMesh2D(int Corder)
     m_cub.mmCHOL(All,k) = chol(mmk);  // store Cholesky factorization
   }
 
+  // factors of the curved elements, for batched solves
+  m_cub.mmBatch.reset(m_cub.mmCHOL, curved, Np);
+
   // incorporate weights and Jacobian
   m_cub.W = outer(m_cub.w, ones(K));
   m_cub.W.mult_element(m_cub.J);
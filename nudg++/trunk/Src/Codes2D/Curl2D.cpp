@@ -11,6 +11,28 @@
 //    b:  [vx,vy,vz] = C(ux,uy,uz) 
 
 
+// vz = rx*uyr + sx*uys - ry*uxr - sy*uxs on one element,
+// and if uzr != NULL, vx = ry*uzr + sy*uzs, vy = -rx*uzr - sx*uzs.
+// Factor n at node i is g[n*fs + i*INC] (INC=0 if affine)
+template <int INC> static inline void
+curl_elmt(int Np, const double* g, int fs, 
+          const double* uxr, const double* uxs, const double* uyr, const double* uys,
+          const double* uzr, const double* uzs, double* vx, double* vy, double* vz)
+{
+  const double *grx=g, *gsx=g+fs, *gry=g+2*fs, *gsy=g+3*fs;
+  int i=0;
+  for (i=0; i<Np; ++i) {
+    vz[i] = grx[i*INC]*uyr[i] + gsx[i*INC]*uys[i] - gry[i*INC]*uxr[i] - gsy[i*INC]*uxs[i];
+  }
+  if (uzr) {
+    for (i=0; i<Np; ++i) {
+      vx[i] =  gry[i*INC]*uzr[i] + gsy[i*INC]*uzs[i];
+      vy[i] = -grx[i*INC]*uzr[i] - gsx[i*INC]*uzs[i];
+    }
+  }
+}
+
+
 //---------------------------------------------------------
 void NDG2D::Curl2D
 (
@@ -26,6 +48,18 @@ void NDG2D::Curl2D
   DMat uxr = Dr*ux, uxs = Ds*ux, 
        uyr = Dr*uy, uys = Ds*uy;
 
+  if (m_bAffineGeo)
+  {
+    // compressed geometry (CompressGeo2D)
+    vz.resize(Np, K, false);
+    for (int k=1; k<=K; ++k) {
+      int c = geoIdx(k), o = (k-1)*Np;
+      if (c) { curl_elmt<1>(Np, geoC.pCol(c), Np, uxr.data()+o, uxs.data()+o, uyr.data()+o, uys.data()+o, NULL, NULL, NULL, NULL, vz.data()+o); }
+      else   { curl_elmt<0>(Np, geoK.pCol(k), 1,  uxr.data()+o, uxs.data()+o, uyr.data()+o, uys.data()+o, NULL, NULL, NULL, NULL, vz.data()+o); }
+    }
+    return;
+  }
+
   vz = rx.dm(uyr) + sx.dm(uys) - ry.dm(uxr) - sy.dm(uxs);
 }
 
@@ -49,6 +83,18 @@ void NDG2D::Curl2D
        uyr = Dr*uy, uys = Ds*uy,
        uzr = Dr*uz, uzs = Ds*uz;
 
+  if (m_bAffineGeo)
+  {
+    // compressed geometry (CompressGeo2D)
+    vx.resize(Np, K, false); vy.resize(Np, K, false); vz.resize(Np, K, false);
+    for (int k=1; k<=K; ++k) {
+      int c = geoIdx(k), o = (k-1)*Np;
+      if (c) { curl_elmt<1>(Np, geoC.pCol(c), Np, uxr.data()+o, uxs.data()+o, uyr.data()+o, uys.data()+o, uzr.data()+o, uzs.data()+o, vx.data()+o, vy.data()+o, vz.data()+o); }
+      else   { curl_elmt<0>(Np, geoK.pCol(k), 1,  uxr.data()+o, uxs.data()+o, uyr.data()+o, uys.data()+o, uzr.data()+o, uzs.data()+o, vx.data()+o, vy.data()+o, vz.data()+o); }
+    }
+    return;
+  }
+
   vz =  rx.dm(uyr) + sx.dm(uys) - ry.dm(uxr) - sy.dm(uxs);
   vx =  ry.dm(uzr) + sy.dm(uzs);
   vy = -rx.dm(uzr) - sx.dm(uzs);
@@ -22,7 +22,7 @@ DMat& NDG2D::CurvedDGDiv2D
   // Purpose: compute the divergence of a vectorial function given
   //          at cubature and surface Gauss nodes
 
-  DMat gFxM,gFxP,mmCHOL;  DVec gUM,gUP,gVM,gVP;
+  DMat gFxM,gFxP;  DVec gUM,gUP,gVM,gVP;
   DMat *tmp = new DMat("divU", OBJ_temp);
   DMat &divU(*tmp);
 
@@ -51,13 +51,7 @@ DMat& NDG2D::CurvedDGDiv2D
   divU(All,straight) = VVT * dd(divU(All,straight), J(All,straight));
 
   // Multiply curvilinear faces by custom inverse mass matrix
-  int Ncurved = curved.size(), k=0;
-  for (int m=1; m<=Ncurved; ++m) {
-    k = curved(m);
-    mmCHOL.borrow(Np,Np, cub.mmCHOL.pCol(k));
-    mmCHOL.set_factmode(FACT_CHOL);  // indicate factored state
-    divU(All,k) = chol_solve(mmCHOL, divU(All,k));
-  }
+  cub.mmBatch.solve(divU, 1);
 
   // Correct sign
   divU *= -1.0;
@@ -25,7 +25,7 @@ void NDG2D::CurvedDGGrad2D
   // shorthand references
   Cub2D& cub = this->m_cub; Gauss2D& gauss = this->m_gauss;
 
-  DMat fx,fy,mmCHOL;  DVec gUM,gUP;
+  DMat fx,fy;  DVec gUM,gUP;
 
   // Volume terms: dUdx and dUdy
   dUdx = cub.DrT*(cub.W.dm(cub.rx.dm(cU))) + cub.DsT*(cub.W.dm(cub.sx.dm(cU)));
@@ -51,14 +51,8 @@ void NDG2D::CurvedDGGrad2D
   dUdy(All,straight) = VVT * dd(dUdy(All,straight), J(All,straight));
 
   // Multiply curvilinear faces by custom inverse mass matrix
-  int Ncurved = curved.size(), k=0;
-  for (int m=1; m<=Ncurved; ++m) {
-    k = curved(m);
-    mmCHOL.borrow(Np,Np, cub.mmCHOL.pCol(k));
-    mmCHOL.set_factmode(FACT_CHOL);  // indicate factored state
-    dUdx(All,k) = chol_solve(mmCHOL, dUdx(All,k));
-    dUdy(All,k) = chol_solve(mmCHOL, dUdy(All,k));
-  }
+  cub.mmBatch.solve(dUdx, 1);
+  cub.mmBatch.solve(dUdy, 1);
 
   // Correct sign
   dUdx *= -1.0;
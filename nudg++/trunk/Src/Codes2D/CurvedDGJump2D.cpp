@@ -19,7 +19,7 @@ DMat& NDG2D::CurvedDGJump2D
   // purpose: compute discontinuous Galerkin jump applied
   //          to a field given at cubature and Gauss nodes
 
-  DMat mmCHOL;  DVec gUM,gUP,fx;
+  DVec gUM,gUP,fx;
   DMat *tmp = new DMat("jumpU", OBJ_temp);
   DMat &jumpU(*tmp);
 
@@ -39,13 +39,7 @@ DMat& NDG2D::CurvedDGJump2D
   jumpU(All,straight) = VVT * dd(jumpU(All,straight), J(All,straight));
 
   // multiply by custom inverse mass matrix for each curvilinear triangle
-  int Ncurved = curved.size(), k=0;
-  for (int m=1; m<=Ncurved; ++m) {
-    k = curved(m);
-    mmCHOL.borrow(Np,Np, cub.mmCHOL.pCol(k));
-    mmCHOL.set_factmode(FACT_CHOL);  // indicate factored state
-    jumpU(All,k) = chol_solve(mmCHOL, jumpU(All,k));
-  }
+  cub.mmBatch.solve(jumpU, 1);
 
   // these parameters may be OBJ_temp (allocated on the fly)
   if (OBJ_temp == gU.get_mode())  { delete (&gU); }
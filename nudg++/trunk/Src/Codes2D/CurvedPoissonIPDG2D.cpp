@@ -4,6 +4,11 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "NDG2D.h"
+#include "CS_BlockPattern.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 //---------------------------------------------------------
@@ -15,6 +20,36 @@ void NDG2D::CurvedPoissonIPDG2D
   CSd&      spMM   // [out] sparse
 )
 //---------------------------------------------------------
+{
+  CurvedPoissonIPDG2D(gauss, cub, &spOP, &spMM, NULL, NULL);
+}
+
+
+//---------------------------------------------------------
+void NDG2D::CurvedPoissonIPDG2D
+(
+  Gauss2D&  gauss, // [in]
+  Cub2D&    cub,   // [in]
+  BSd&      bsOP,  // [out] block sparse, tril(OP)
+  BSd&      bsMM   // [out] block sparse
+)
+//---------------------------------------------------------
+{
+  CurvedPoissonIPDG2D(gauss, cub, NULL, NULL, &bsOP, &bsMM);
+}
+
+
+//---------------------------------------------------------
+void NDG2D::CurvedPoissonIPDG2D
+(
+  Gauss2D&  gauss, // [in]
+  Cub2D&    cub,   // [in]
+  CSd*      spOP,  // [out] sparse,       or NULL
+  CSd*      spMM,  // [out] sparse,       or NULL
+  BSd*      bsOP,  // [out] block sparse, or NULL
+  BSd*      bsMM   // [out] block sparse, or NULL
+)
+//---------------------------------------------------------
 {
   // function [OP,MM] = CurvedPoissonIPDG2D(gauss, cub)
   //
@@ -23,130 +58,139 @@ void NDG2D::CurvedPoissonIPDG2D
 
   NGauss = gauss.NGauss;
 
-  // build DG derivative matrices
-  int max_OP = (K*Np*Np*(1+Nfaces));
-  int max_MM = (K*Np*Np);
-
-  // "OP" triplets (i,j,x), extracted to {Ai,Aj,Ax}
-  IVec OPi(max_OP), OPj(max_OP), Ai,Aj; DVec OPx(max_OP), Ax;
-  // "MM" triplets (i,j,x)
-  IVec MMi(max_MM), MMj(max_MM); DVec MMx(max_MM);
-
-  DMat gDxM, gDyM, gDxP, gDyP, gDnM, gDnP, OP11, OP12;
-  IVec idsPR;  IMat rows1, cols1, cols2;  Index1D entries, entriesMM, idsM;
-  DVec xk1, yk1, xk2, yk2, locmm;
-  DMat cDx, cDy, gVM, gVMT, gVP, gVPR;
-  DMat_Diag cw, gnx,gny,gw; double opti1=0.0, opti2=0.0;
-  int k1=0,f1=0, k2=0,f2=0; double hinv=0.0, gtau=0.0;
-
-  // global node numbering
-  entries.reset(1,Np*Np); entriesMM.reset(1,Np*Np);
+  int k1=0, f1=0, bc=0;
+  double opti1=0.0, opti2=0.0;
 
   umMSG(1, "\n ==> {OP,MM} assembly: ");
   opti1 = timer.read(); // time assembly
 
-  for (k1=1; k1<=K; ++k1)
-  {
-    if (! (k1%100)) { umMSG(1, "%4d, ",k1); }
-
-    rows1 = outer( Range((k1-1)*Np+1,k1*Np), Ones(Np) );
-    cols1 = trans(rows1);
-
-    // Build local operators  
-    locmm = cub.mm(All,k1);
-    cw  = cub.W(All,k1);
+  // The csc patterns of OP and MM follow from the coupled
+  // faces: blocks are added in place by their row element,
+  // so elements are independent, and the result does not
+  // depend on the number of threads.  Only tril(OP) is
+  // assembled (see below).
+  IMat nbr(K, Nfaces);
+  for (k1=1; k1<=K; ++k1) {
+    for (f1=1; f1<=Nfaces; ++f1) {
+      bc = BCType(k1,f1);
+      nbr(k1,f1) = (BC_Dirichlet != bc && BC_Neuman != bc) ? EToE(k1,f1) : 0;
+    }
+  }
+  umBlockPattern patOP, patMM;
+  patOP.build(nbr, Np, sp_LT);
+  patMM.build(K,   Np, sp_All);
+  if (spOP) { patOP.alloc(*spOP);  patMM.alloc(*spMM); }
+  else      { patOP.alloc(*bsOP);  patMM.alloc(*bsMM); }
+  int max_OP = patOP.max_nnz(), max_MM = patMM.max_nnz();
+
+  int nthreads = 1;
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+  umMSG(1, "(%d thread%s)", nthreads, (nthreads>1) ? "s" : "");
 
-    xk1 = x(All,k1); yk1 = y(All,k1);
-    PhysDmatrices2D(xk1, yk1, cub.V, cDx, cDy);
-    OP11 = trans(cDx)*cw*cDx + trans(cDy)*cw*cDy;
-    
-    // Build element-to-element parts of operator
-    for (f1=1; f1<=Nfaces; ++f1)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    // per-thread temporaries
+    DMat gDxM, gDyM, gDxP, gDyP, gDnM, gDnP, OP11, OP12;
+    IVec idsPR;  Index1D idsM;
+    DVec xk1, yk1, xk2, yk2, locmm;
+    DMat cDx, cDy, gVM, gVMT, gVP, gVPR;
+    DMat_Diag cw, gnx,gny,gw;
+    int k2=0, f2=0; double hinv=0.0, gtau=0.0;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int k1=1; k1<=K; ++k1)
     {
-      k2 = EToE(k1,f1); f2 = EToF(k1,f1);
-
-      idsM.reset((f1-1)*NGauss+1, f1*NGauss);
-      idsPR.range(NGauss,1);
-
-      gVM = gauss.finterp[f1];
-      gVP = gauss.finterp[f2];  gVP.reverse_rows();
-      gVMT= trans(gVM);   // store transpose
+      // Build local operators  
+      locmm = cub.mm(All,k1);
+      cw  = cub.W(All,k1);
 
       xk1 = x(All,k1); yk1 = y(All,k1);
-      xk2 = x(All,k2); yk2 = y(All,k2);
-      PhysDmatrices2D(xk1,yk1,gVM,  gDxM,gDyM);
-      PhysDmatrices2D(xk2,yk2,gVP,  gDxP,gDyP);
-      gnx = gauss.nx(idsM, k1);
-      gny = gauss.ny(idsM, k1);
-      gw  = gauss.W (idsM, k1);
-
-      gDnM = gnx*gDxM + gny*gDyM;
-      gDnP = gnx*gDxP + gny*gDyP;
-
-      cols2 = outer( Ones(Np), Range((k2-1)*Np+1,k2*Np));
-      hinv = std::max(Fscale(1+(f1-1)*Nfp, k1), Fscale(1+(f2-1)*Nfp, k2));
-    //gtau = 100*2*(N+1)*(N+1)*hinv; // set penalty scaling
-      gtau = ( 5*2*(N+1)*(N+1))*hinv; // set penalty scaling
-
-      switch (BCType(k1,f1)) {
-      case BC_Dirichlet:
-        OP11 += ( gVMT*(gw*gtau)*gVM - gVMT*gw*gDnM - trans(gDnM)*gw*gVM );
-        break;
-      case BC_Neuman:
-        // nada 
-        break;
-      default:
-        // interior face variational terms
-        OP11 +=  0.5*( gVMT*(gw*gtau)*gVM - gVMT*gw*gDnM - trans(gDnM)*gw*gVM );
-        OP12  = -0.5*( gVMT*(gw*gtau)*gVP + gVMT*gw*gDnP - trans(gDnM)*gw*gVP );
-        OPi(entries)=rows1; OPj(entries)=cols2; OPx(entries)=OP12;
-        entries += (Np*Np);
-        break;
+      PhysDmatrices2D(xk1, yk1, cub.V, cDx, cDy);
+      OP11 = trans(cDx)*cw*cDx + trans(cDy)*cw*cDy;
+      
+      // Build element-to-element parts of operator
+      for (int f1=1; f1<=Nfaces; ++f1)
+      {
+        k2 = EToE(k1,f1); f2 = EToF(k1,f1);
+
+        idsM.reset((f1-1)*NGauss+1, f1*NGauss);
+        idsPR.range(NGauss,1);
+
+        gVM = gauss.finterp[f1];
+        gVP = gauss.finterp[f2];  gVP.reverse_rows();
+        gVMT= trans(gVM);   // store transpose
+
+        xk1 = x(All,k1); yk1 = y(All,k1);
+        xk2 = x(All,k2); yk2 = y(All,k2);
+        PhysDmatrices2D(xk1,yk1,gVM,  gDxM,gDyM);
+        PhysDmatrices2D(xk2,yk2,gVP,  gDxP,gDyP);
+        gnx = gauss.nx(idsM, k1);
+        gny = gauss.ny(idsM, k1);
+        gw  = gauss.W (idsM, k1);
+
+        gDnM = gnx*gDxM + gny*gDyM;
+        gDnP = gnx*gDxP + gny*gDyP;
+
+        hinv = std::max(Fscale(1+(f1-1)*Nfp, k1), Fscale(1+(f2-1)*Nfp, k2));
+      //gtau = 100*2*(N+1)*(N+1)*hinv; // set penalty scaling
+        gtau = ( 5*2*(N+1)*(N+1))*hinv; // set penalty scaling
+
+        switch (BCType(k1,f1)) {
+        case BC_Dirichlet:
+          OP11 += ( gVMT*(gw*gtau)*gVM - gVMT*gw*gDnM - trans(gDnM)*gw*gVM );
+          break;
+        case BC_Neuman:
+          // nada 
+          break;
+        default:
+          // interior face variational terms
+          OP11 +=  0.5*( gVMT*(gw*gtau)*gVM - gVMT*gw*gDnM - trans(gDnM)*gw*gVM );
+          if (patOP.stored(k1,f1)) {  // tril(OP): k1 > k2
+            OP12  = -0.5*( gVMT*(gw*gtau)*gVP + gVMT*gw*gDnP - trans(gDnM)*gw*gVP );
+            patOP.add_face(k1, f1, OP12.data());
+          }
+          break;
+        }
       }
-    }
 
-    OPi(entries  )=rows1; OPj(entries  )=cols1; OPx(entries  )=OP11;
-    MMi(entriesMM)=rows1; MMj(entriesMM)=cols1; MMx(entriesMM)=locmm;
-    entries += (Np*Np);  entriesMM += (Np*Np);
+      patOP.add_diag(k1, OP11.data());
+      patMM.add_diag(k1, locmm.data());
+    }
+  }
+  if (!spOP) {
+    // block sparse: tril(OP) is flagged symmetric
+    opti2 = timer.read();
+    umMSG(1, "\n ==> {OP,MM} block sparse.  (%g secs)\n", opti2-opti1);
+    umMSG(1, " ==> blocks_OP: %10d  (%d x %d)\n", patOP.nnzb(), Np, Np);
+    return;
   }
-  umMSG(1, "\n ==> {OP,MM} to sparse\n");
-
-  entries.reset(1, entries.hi()-Np*Np);
 
-  // Extract triplets from the large buffers. Note: this 
-  // requires copying each array, and since these arrays 
-  // can be HUGE(!), we force immediate deallocation:
+  umMSG(1, "\n ==> {OP,MM} to sparse\n");
 
-  Ai=OPi(entries);  OPi.Free();
-  Aj=OPj(entries);  OPj.Free();
-  Ax=OPx(entries);  OPx.Free();
+  // drop the zero entries
+  int nnzOP = patOP.finish(*spOP);
+  patMM.finish(*spMM);
 
-  // return 0-based sparse results
   // Note: create strictly symmetric matrices by loading 
-  // the upper triangle, then adding (transpose-diag)
-  Ai -= 1; Aj -= 1; MMi -= 1; MMj -= 1;  int npk=Np*K;
-
-#ifdef NDG_USE_CHOLMOD
-  // pass only the lower triangle
-  spOP.load(npk,npk, Ai,Aj,Ax, sp_LT,false,1e-15,true);  // {LT, false} -> TriL
-#else 
-  // pass both upper and lower triangles
-  spOP.load(npk,npk, Ai,Aj,Ax, sp_LT, true,1e-15,true);  // LT -> enforce symmetry
-//spOP.load(npk,npk, Ai,Aj,Ax, sp_All,true,1e-15,true);  // All-> includes "noise"
+  // the lower triangle, then adding (transpose-diag)
+#ifndef NDG_USE_CHOLMOD
+  spOP->make_tri_sym();   // mirror tril(OP)
 #endif
 
-  Ai.Free();  Aj.Free();  Ax.Free();
-
   //-------------------------------------------------------
   // The mass matrix operator will NOT be factorised, 
   // only used to build velocity system 
   //
   //  VELsystem += (*mm) * (g0/(dt*nu));
   //
-  // Load ALL elements (both upper and lower triangles):
+  // MM holds ALL elements (both upper and lower triangles)
   //-------------------------------------------------------
-  spMM.load(npk,npk, MMi,MMj,MMx, sp_All,false,1e-15,true);
-  MMi.Free(); MMj.Free(); MMx.Free();
 
 
 #if (0)
@@ -168,7 +212,7 @@ void NDG2D::CurvedPoissonIPDG2D
 #if (1)
   // check on original estimates for nnx
   umMSG(1, " ==> max_OP: %12d\n", max_OP);
-  umMSG(1, " ==> nnz_OP: %12d\n", entries.hi());
+  umMSG(1, " ==> nnz_OP: %12d\n", nnzOP);
   umMSG(1, " ==> max_MM: %12d\n", max_MM);
 #endif
 }
@@ -5,6 +5,20 @@
 #include "NDGLib_headers.h"
 #include "NDG2D.h"
 
+
+// divu = rx*ur + sx*us + ry*vr + sy*vs on one element:
+// factor n at node i is g[n*fs + i*INC] (INC=0 if affine)
+template <int INC> static inline void
+div_elmt(int Np, const double* g, int fs, const double* ur, const double* us,
+         const double* vr, const double* vs, double* divu)
+{
+  const double *grx=g, *gsx=g+fs, *gry=g+2*fs, *gsy=g+3*fs;
+  for (int i=0; i<Np; ++i) {
+    divu[i] = grx[i*INC]*ur[i] + gsx[i*INC]*us[i] + gry[i*INC]*vr[i] + gsy[i*INC]*vs[i];
+  }
+}
+
+
 //---------------------------------------------------------
 void NDG2D::Div2D(const DMat& u, const DMat& v, DMat& divu)
 //---------------------------------------------------------
@@ -13,5 +27,18 @@ void NDG2D::Div2D(const DMat& u, const DMat& v, DMat& divu)
   // Purpose: Compute the 2D divergence of the vectorfield (u,v)
 
   DMat ur=Dr*u, us=Ds*u, vr=Dr*v, vs=Ds*v;
+
+  if (m_bAffineGeo)
+  {
+    // compressed geometry (CompressGeo2D)
+    divu.resize(Np, K, false);
+    for (int k=1; k<=K; ++k) {
+      int c = geoIdx(k), o = (k-1)*Np;
+      if (c) { div_elmt<1>(Np, geoC.pCol(c), Np, ur.data()+o, us.data()+o, vr.data()+o, vs.data()+o, divu.data()+o); }
+      else   { div_elmt<0>(Np, geoK.pCol(k), 1,  ur.data()+o, us.data()+o, vr.data()+o, vs.data()+o, divu.data()+o); }
+    }
+    return;
+  }
+
   divu = rx.dm(ur) + sx.dm(us) + ry.dm(vr) + sy.dm(vs);
 }
@@ -6,6 +6,19 @@
 #include "NDG2D.h"
 
 
+// ux = rx*ur + sx*us, uy = ry*ur + sy*us on one element:
+// factor n at node i is g[n*fs + i*INC] (INC=0 if affine)
+template <int INC> static inline void
+grad_elmt(int Np, const double* g, int fs, const double* ur, const double* us, double* ux, double* uy)
+{
+  const double *grx=g, *gsx=g+fs, *gry=g+2*fs, *gsy=g+3*fs;
+  for (int i=0; i<Np; ++i) {
+    ux[i] = grx[i*INC]*ur[i] + gsx[i*INC]*us[i];
+    uy[i] = gry[i*INC]*ur[i] + gsy[i*INC]*us[i];
+  }
+}
+
+
 //---------------------------------------------------------
 void NDG2D::Grad2D
 (
@@ -18,6 +31,19 @@ void NDG2D::Grad2D
   // function [ux,uy] = Grad2D(u);
   // Purpose: Compute 2D gradient field of scalar u
 
+  if (m_bAffineGeo)
+  {
+    // compressed geometry (CompressGeo2D)
+    DMat ur = Dr*u, us = Ds*u;
+    ux.resize(Np, K, false); uy.resize(Np, K, false);
+    for (int k=1; k<=K; ++k) {
+      int c = geoIdx(k), o = (k-1)*Np;
+      if (c) { grad_elmt<1>(Np, geoC.pCol(c), Np, ur.data()+o, us.data()+o, ux.data()+o, uy.data()+o); }
+      else   { grad_elmt<0>(Np, geoK.pCol(k), 1,  ur.data()+o, us.data()+o, ux.data()+o, uy.data()+o); }
+    }
+    return;
+  }
+
   DVec ur = Dr*u, us = Ds*u;
   ux = rx.dm(ur) + sx.dm(us); uy = ry.dm(ur) + sy.dm(us);
 }
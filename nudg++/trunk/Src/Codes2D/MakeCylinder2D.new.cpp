@@ -117,4 +117,5 @@ void NDG2D::MakeCylinder2D
   Fx = x(Fmask, All); Fy = y(Fmask, All);
   ::GeometricFactors2D(x,y,Dr,Ds,  rx,sx,ry,sy,J);
   Normals2D(); Fscale = sJ.dd(J(Fmask,All));
+  CompressFace2D(Fscale);
 }
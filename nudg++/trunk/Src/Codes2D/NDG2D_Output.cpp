@@ -42,6 +42,8 @@ void OutputSampleNodes2D(int sample_N, DVec &R, DVec &S)
 void NDG2D::OutputVTK(const DMat& FData, int order, int zfield)
 //---------------------------------------------------------
 {
+  umMemPhaseScope mem_phase(umMEM_OUTPUT);
+
   static int count = 0;
   string output_dir = ".";
 
@@ -40,4 +40,8 @@ void NDG2D::Normals2D()  // [nx, ny, sJ]
   // normalise
   sJ = sqrt(sqr(nx)+sqr(ny));  // nx=nx.dd(sJ); ny=ny.dd(sJ);
   nx.div_element(sJ); ny.div_element(sJ);
+
+  // J is final here: (re)build the compressed geometry
+  // (callers compress the face data once Fscale is set)
+  CompressGeo2D();
 }
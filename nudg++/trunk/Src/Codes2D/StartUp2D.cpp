@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "NDG2D.h"
+#include "SmallMat_funcs.h"
 
 
 //---------------------------------------------------------
@@ -16,6 +17,9 @@ bool NDG2D::StartUp2D()
   // Definition of constants
   Nfp = N+1; Np = (N+1)*(N+2)/2; Nfaces=3; NODETOL = 1e-12;
 
+  // select kernels for Dr*u, LIFT*flux at this order
+  umSmallMat_select(2, N);
+
   // Compute nodal set
   DVec x1,y1; Nodes2D(N, x1,y1);  xytors(x1,y1, r,s);
 
@@ -50,6 +54,7 @@ bool NDG2D::StartUp2D()
   // calculate geometric factors
   Normals2D();
   Fscale = sJ.dd(J(Fmask,All));
+  CompressFace2D(Fscale);
 
 
 #if (0)
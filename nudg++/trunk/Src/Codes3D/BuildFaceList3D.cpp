@@ -0,0 +1,41 @@
+// BuildFaceList3D.cpp
+// list each element face once, for flux evaluation
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG3D.h"
+
+
+//---------------------------------------------------------
+void NDG3D::BuildFaceList3D()
+//---------------------------------------------------------
+{
+  // Interior faces appear twice in {vmapM,vmapP}, once from
+  // each side.  List them once, from the side with lower
+  // face id fc = (k-1)*Nfaces+f, followed by the boundary
+  // faces: a flux evaluated on the owner side uFaceM(i)
+  // is scattered with opposite sign to its neighbor
+  // uFaceP(i), through mapP node by node.
+
+  int k1=0,f1=0, k2=0,f2=0, fc1=0,fc2=0, Nb=0;
+  IVec bfaces(Nfaces*K);
+
+  uFaceM.resize(Nfaces*K); uFaceP.resize(Nfaces*K); NufI=0;
+  for (k1=1; k1<=K; ++k1) {
+    for (f1=1; f1<=Nfaces; ++f1) {
+      k2 = EToE(k1,f1); f2 = EToF(k1,f1);
+      fc1 = (k1-1)*Nfaces + f1;  fc2 = (k2-1)*Nfaces + f2;
+      if (fc1 == fc2) {
+        bfaces(++Nb) = fc1;             // boundary face
+      } else if (fc1 < fc2) {
+        ++NufI;  uFaceM(NufI) = fc1;  uFaceP(NufI) = fc2;
+      }
+    }
+  }
+
+  // append boundary faces
+  for (int i=1; i<=Nb; ++i) {
+    uFaceM(NufI+i) = bfaces(i);  uFaceP(NufI+i) = bfaces(i);
+  }
+  uFaceM.realloc(NufI+Nb); uFaceP.realloc(NufI+Nb);
+}
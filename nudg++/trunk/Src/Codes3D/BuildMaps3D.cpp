@@ -75,6 +75,9 @@ void NDG3D::BuildMaps3D()
   // Create list of boundary nodes
   mapB = find(vmapP, '=', vmapM); vmapB = vmapM(mapB);
 
+  // list each face once, for fluxes (see BuildFaceList3D)
+  BuildFaceList3D();
+
 #if (0)
   dumpIVec(vmapM, "vmapM");
   dumpIVec(vmapP, "vmapP");
@@ -0,0 +1,71 @@
+// CompressGeo3D.cpp
+// one set of geometric factors per affine element
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "NDG3D.h"
+
+
+//---------------------------------------------------------
+void NDG3D::CompressGeo3D()
+//---------------------------------------------------------
+{
+  // On a straight-sided tetrahedron the geometric factors
+  // are constant.  With NDG_GEOM=affine, store their
+  // element means in geoK(:,k), and nodal data in geoC
+  // only where the factors vary (see CompressGeo2D).  The
+  // nodal arrays are kept, so this adds 10*(K+Np*Nc)
+  // doubles to the geometry and saves none.
+
+  const char* s = getenv("NDG_GEOM");
+  m_bAffineGeo = (s && !strcmp(s, "affine"));
+  if (!m_bAffineGeo) {
+    geoIdx.destroy(); geoK.destroy(); geoC.destroy(); Naffine = 0;
+    return;
+  }
+
+  const int NG = 10, NM = 9;  // factors, of which metric terms
+  const double tol = 1e-10;   // relative, per factor and element
+  const double* g[NG] = { rx.data(), sx.data(), tx.data(),
+                          ry.data(), sy.data(), ty.data(),
+                          rz.data(), sz.data(), tz.data(), J.data() };
+
+  geoIdx.resize(K); geoK.resize(NG, K);
+  double lo[NG], hi[NG], fmax[NG];
+  int k=0, n=0, i=0, Nc=0;
+  for (k=1; k<=K; ++k) {
+    int o = (k-1)*Np;  double mmax = 0.0;
+    for (n=0; n<NG; ++n) {
+      double sum = 0.0;  lo[n] = hi[n] = g[n][o];  fmax[n] = 0.0;
+      for (i=0; i<Np; ++i) {
+        double gi = g[n][o+i];
+        lo[n] = std::min(lo[n], gi); hi[n] = std::max(hi[n], gi); sum += gi;
+        fmax[n] = std::max(fmax[n], fabs(gi));
+      }
+      if (n<NM) { mmax = std::max(mmax, fmax[n]); }
+      geoK(n+1, k) = sum / double(Np);
+    }
+
+    // affine if each factor f varies by at most tol*max|f|
+    // on the element.  A metric term that is round-off
+    // next to the others (e.g. rx with an edge parallel 
+    // to an axis) is taken as zero.
+    bool bAffine = true;
+    for (n=0; n<NG && bAffine; ++n) {
+      bool bZero = (n<NM) && (fmax[n] <= tol*mmax);
+      bAffine = bZero || (hi[n]-lo[n] <= tol*fmax[n]);
+    }
+    geoIdx(k) = bAffine ? 0 : ++Nc;
+  }
+  Naffine = K - Nc;
+
+  // nodal factors of the non-affine elements
+  geoC.resize(NG*Np, Nc);
+  for (k=1; k<=K; ++k) {
+    if (0 == geoIdx(k)) { continue; }
+    double* c = geoC.pCol(geoIdx(k));  int o = (k-1)*Np;
+    for (n=0; n<NG; ++n) {
+      for (i=0; i<Np; ++i) { c[n*Np+i] = g[n][o+i]; }
+    }
+  }
+}
@@ -5,6 +5,28 @@
 #include "NDGLib_headers.h"
 #include "NDG3D.h"
 
+
+// chain rule at node i: g points at the {r,s,t} factors of
+// one direction (g+3*fs*d, d=0,1,2 for x,y,z), factor n at
+// node i is g[n*fs + i*INC] (INC=0 if affine)
+template <int INC> static inline double
+chain3D(const double* g, int fs, int i, double dr, double ds, double dt)
+{
+  return g[i*INC]*dr + g[fs+i*INC]*ds + g[2*fs+i*INC]*dt;
+}
+
+// divU = dUx/dx + dUy/dy + dUz/dz on one element: d[0:3]
+// hold the (r,s,t) derivatives of Ux, d[3:6] Uy, d[6:9] Uz
+template <int INC> static inline void
+div_elmt(int Np, const double* g, int fs, const double* const* d, double* divU)
+{
+  for (int i=0; i<Np; ++i) {
+    divU[i] =  chain3D<INC>(g,      fs, i, d[0][i], d[1][i], d[2][i])
+             + chain3D<INC>(g+3*fs, fs, i, d[3][i], d[4][i], d[5][i])
+             + chain3D<INC>(g+6*fs, fs, i, d[6][i], d[7][i], d[8][i]);
+  }
+}
+
 //---------------------------------------------------------
 void NDG3D::Div3D
 (
@@ -18,6 +40,21 @@ void NDG3D::Div3D
   // function [divU] = DivH3D(Ux, Uy, Uz)
   // purpose: compute local elemental physical spatial divergence of (Ux,Uy,Uz)
 
+  if (m_bAffineGeo)
+  {
+    // compressed geometry (CompressGeo3D)
+    DMat xr=Dr*Ux, xs=Ds*Ux, xt=Dt*Ux, yr=Dr*Uy, ys=Ds*Uy, yt=Dt*Uy, zr=Dr*Uz, zs=Ds*Uz, zt=Dt*Uz;
+    divU.resize(Np, K, false);
+    for (int k=1; k<=K; ++k) {
+      int c = geoIdx(k), o = (k-1)*Np;
+      const double* d[9] = { xr.data()+o, xs.data()+o, xt.data()+o, yr.data()+o, ys.data()+o, 
+                             yt.data()+o, zr.data()+o, zs.data()+o, zt.data()+o };
+      if (c) { div_elmt<1>(Np, geoC.pCol(c), Np, d, divU.data()+o); }
+      else   { div_elmt<0>(Np, geoK.pCol(k), 1,  d, divU.data()+o); }
+    }
+    return;
+  }
+
   // compute local derivatives of Ux on reference tetrahedron  
   DMat ddr = Dr*Ux,  dds = Ds*Ux,  ddt = Dt*Ux;
 
@@ -27,6 +27,9 @@ Globals3D::Globals3D()
   EToE("EToE"), EToF("EToF"), EToV("EToV"), 
   V("V"), invV("invV"), VVT("VVT"),
   VX("VX"), VY("VY"), VZ("VZ"), x("x"), y("y"), z("z"),
+  m_bAffineGeo(false), geoIdx("geoIdx"), geoK("geoK"), geoC("geoC"), Naffine(0),
+  faceIdx("faceIdx"), faceK("faceK"), faceC("faceC"), Nflat(0),
+  uFaceM("uFaceM"), uFaceP("uFaceP"), NufI(0),
 
   // +NBN: added
   materialVals("materialVals"), epsilon("epsilon"),
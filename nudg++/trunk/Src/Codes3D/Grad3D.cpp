@@ -6,6 +6,27 @@
 #include "NDG3D.h"
 
 
+// chain rule at node i: g points at the {r,s,t} factors of
+// one direction (g+3*fs*d, d=0,1,2 for x,y,z), factor n at
+// node i is g[n*fs + i*INC] (INC=0 if affine)
+template <int INC> static inline double
+chain3D(const double* g, int fs, int i, double dr, double ds, double dt)
+{
+  return g[i*INC]*dr + g[fs+i*INC]*ds + g[2*fs+i*INC]*dt;
+}
+
+template <int INC> static inline void
+grad_elmt(int Np, const double* g, int fs, const double* ur, const double* us, const double* ut,
+          double* ux, double* uy, double* uz)
+{
+  for (int i=0; i<Np; ++i) {
+    ux[i] = chain3D<INC>(g,      fs, i, ur[i], us[i], ut[i]);
+    uy[i] = chain3D<INC>(g+3*fs, fs, i, ur[i], us[i], ut[i]);
+    uz[i] = chain3D<INC>(g+6*fs, fs, i, ur[i], us[i], ut[i]);
+  }
+}
+
+
 //---------------------------------------------------------
 void NDG3D::Grad3D
 (
@@ -22,6 +43,19 @@ void NDG3D::Grad3D
   // compute local derivatives on reference tetrahedron  
   DMat dUdr = Dr*U,  dUds = Ds*U,  dUdt = Dt*U;
 
+  if (m_bAffineGeo)
+  {
+    // compressed geometry (CompressGeo3D)
+    dUdx.resize(Np, K, false); dUdy.resize(Np, K, false); dUdz.resize(Np, K, false);
+    for (int k=1; k<=K; ++k) {
+      int c = geoIdx(k), o = (k-1)*Np;
+      const double *ur=dUdr.data()+o, *us=dUds.data()+o, *ut=dUdt.data()+o;
+      if (c) { grad_elmt<1>(Np, geoC.pCol(c), Np, ur, us, ut, dUdx.data()+o, dUdy.data()+o, dUdz.data()+o); }
+      else   { grad_elmt<0>(Np, geoK.pCol(k), 1,  ur, us, ut, dUdx.data()+o, dUdy.data()+o, dUdz.data()+o); }
+    }
+    return;
+  }
+
   // compute physical spatial derivatives using the chain rule
   dUdx = rx.dm(dUdr) + sx.dm(dUds) + tx.dm(dUdt);
   dUdy = ry.dm(dUdr) + sy.dm(dUds) + ty.dm(dUdt);
@@ -44,6 +44,8 @@ void OutputSampleNodes3D(int sample_N, DVec& R, DVec& S, DVec& T)
 void NDG3D::OutputVTK(const DMat& FData, int order, int zfield)
 //---------------------------------------------------------
 {
+  umMemPhaseScope mem_phase(umMEM_OUTPUT);
+
   static int count = 0;
   string output_dir = ".";
 
@@ -50,4 +50,8 @@ void NDG3D::Normals3D()
   
   nx.div_element(sJ); ny.div_element(sJ); nz.div_element(sJ);
   sJ.mult_element(J(Fmask, All));  //sJ=sJ.*J(Fmask(:),:);
+
+  // (re)build the compressed geometry (StartUp3D 
+  // compresses the face data once Fscale is set)
+  CompressGeo3D();
 }
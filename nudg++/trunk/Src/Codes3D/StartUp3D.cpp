@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "NDG3D.h"
+#include "SmallMat_funcs.h"
 
 
 //---------------------------------------------------------
@@ -16,6 +17,9 @@ bool NDG3D::StartUp3D()
   // Definition of constants
   Np = (N+1)*(N+2)*(N+3)/6; Nfp = (N+1)*(N+2)/2; Nfaces=4; NODETOL = 1e-7;
 
+  // select kernels for Dr*u, LIFT*flux at this order
+  umSmallMat_select(3, N);
+
   // Compute nodal set
   DVec x1,y1,z1;
   Nodes3D(N, x1,y1,z1);
@@ -51,6 +55,7 @@ bool NDG3D::StartUp3D()
   Normals3D();
   
   Fscale = sJ.dd(J(Fmask,All));
+  CompressFace3D(Fscale);
 
   // Build connectivity matrix
   tiConnect3D(EToV, EToE, EToF); 
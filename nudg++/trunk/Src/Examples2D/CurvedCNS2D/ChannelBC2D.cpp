@@ -37,6 +37,12 @@ void CurvedCNS2D::ChannelBC2D
   DVec yB = m_gauss.y(m_gauss.mapB);
   IVec gmapB = m_gauss.mapB;
 
+  // start from the traces, as in CylBC2D
+  brho  = rho;
+  brhou = rhou;
+  brhov = rhov;
+  bEner = Ener;
+
   // Quadratic shear flow, relies on gamma=1.5
   brho (gmapB) = 1.0;
   brhou(gmapB) = sqr(yB);
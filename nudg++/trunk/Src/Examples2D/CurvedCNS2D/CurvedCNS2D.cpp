@@ -50,6 +50,15 @@ void CurvedCNS2D::Resize()
 void CurvedCNS2D::Resize_cub()
 //---------------------------------------------------------
 {
+  // resize cubature arrays
+  int Nc = m_cub.Ncub, NgF = m_gauss.NGauss*Nfaces;
+  // assumes cub and gauss are ready
+  assert(Nc>0 && NgF>0);
+
+  // stacked fields and derivatives of RHS(), kept for
+  // the whole run rather than allocated on every call
+  cQ.resize(Nc*K,4);   gQ.resize(NgF*K,4);
+  dQ.resize(Np*K,6);  cdQ.resize(Nc*K,6);  gdQ.resize(NgF*K,6);
 }
 
 
@@ -319,4 +328,7 @@ void CurvedCNS2D::FinalReport()
   umLOG(1, "\n  time for NDG work:  %0.2lf secs\n",  time_work);
   umLOG(1,   "           rhs work:  %0.2lf\n",       time_rhs);
   umLOG(1,   " time for main loop:  %0.2lf secs\n\n",time_total);
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
@@ -15,6 +15,9 @@ void CurvedCNS2D::RHS(double rkti, fp_BC SolutionBC)
   // Purpose: evaluate right hand side residual of the 
   //          compressible Navier-Stokes equations
 
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
+  umFrame frame;        // locals and temporaries use frame arena
   trhs = timer.read();  // time RHS work
 
   DMat   rho,  rhou,  rhov,  Ener;    // state data
@@ -32,6 +35,12 @@ void CurvedCNS2D::RHS(double rkti, fp_BC SolutionBC)
 
   // shorthand references
   Cub2D& cub = this->m_cub; Gauss2D& gauss = this->m_gauss;
+  int Nc = cub.Ncub, NgF = gauss.NGauss*Nfaces;
+
+  // stacked fields and derivatives {cQ,gQ,dQ,cdQ,gdQ}, 
+  // sized in Resize_cub(): each operator acts on all of 
+  // them in one product (see stack_view in View2D.h)
+  assert(cQ.num_rows() == Nc*K && gdQ.num_rows() == NgF*K);
 
   // Extract fields from two dimensional array of state data
   rho.borrow (Np,K, Q.pCol(1));
@@ -40,10 +49,12 @@ void CurvedCNS2D::RHS(double rkti, fp_BC SolutionBC)
   Ener.borrow(Np,K, Q.pCol(4));
 
   // Interpolate fields to volume cubature nodes & Gauss quadrature surface nodes
-  crho  = cub.V*rho;  grho  = gauss.interp*rho;
-  crhou = cub.V*rhou; grhou = gauss.interp*rhou;
-  crhov = cub.V*rhov; grhov = gauss.interp*rhov;
-  cEner = cub.V*Ener; gEner = gauss.interp*Ener;
+  umAxB(cub.V,        stack_view(Q,Np), stack_view(cQ,Nc));
+  umAxB(gauss.interp, stack_view(Q,Np), stack_view(gQ,NgF));
+  crho.borrow (Nc,K, cQ.pCol(1));  grho.borrow (NgF,K, gQ.pCol(1));
+  crhou.borrow(Nc,K, cQ.pCol(2));  grhou.borrow(NgF,K, gQ.pCol(2));
+  crhov.borrow(Nc,K, cQ.pCol(3));  grhov.borrow(NgF,K, gQ.pCol(3));
+  cEner.borrow(Nc,K, cQ.pCol(4));  gEner.borrow(NgF,K, gQ.pCol(4));
 
   // Compute primitive fields at Gauss quadrature surface nodes
   gu=grhou.dd(grho); gv=grhov.dd(grho);  gu2gv2 = sqr(gu)+sqr(gv);
@@ -79,9 +90,13 @@ void CurvedCNS2D::RHS(double rkti, fp_BC SolutionBC)
   cu = crhou.dd(crho); cv=crhov.dd(crho); cPr = gm1*(cEner - 0.5*crho.dm(sqr(cu)+sqr(cv)));
 
   // Interpolate derivatives of conserved variables to cubature nodes
-  cdrhodx  = cub.V*drhodx;  cdrhody  = cub.V*drhody; 
-  cdrhoudx = cub.V*drhoudx; cdrhoudy = cub.V*drhoudy; 
-  cdrhovdx = cub.V*drhovdx; cdrhovdy = cub.V*drhovdy; 
+  col_view(dQ,1) = drhodx;   col_view(dQ,2) = drhody;
+  col_view(dQ,3) = drhoudx;  col_view(dQ,4) = drhoudy;
+  col_view(dQ,5) = drhovdx;  col_view(dQ,6) = drhovdy;
+  umAxB(cub.V, stack_view(dQ,Np), stack_view(cdQ,Nc));
+  cdrhodx.borrow (Nc,K, cdQ.pCol(1));  cdrhody.borrow (Nc,K, cdQ.pCol(2));
+  cdrhoudx.borrow(Nc,K, cdQ.pCol(3));  cdrhoudy.borrow(Nc,K, cdQ.pCol(4));
+  cdrhovdx.borrow(Nc,K, cdQ.pCol(5));  cdrhovdy.borrow(Nc,K, cdQ.pCol(6));
 
   // Use product-rule to evaluate gradients of velocity components at cubature nodes
   cdudx = (cdrhoudx - cdrhodx.dm(cu)).dd(crho);
@@ -99,9 +114,10 @@ void CurvedCNS2D::RHS(double rkti, fp_BC SolutionBC)
   //-------------------------------------------------------
 
   // Interpolate derivatives of conserved variables to Gauss nodes
-  gdrhodx  = gauss.interp*drhodx;  gdrhody  = gauss.interp*drhody; 
-  gdrhoudx = gauss.interp*drhoudx; gdrhoudy = gauss.interp*drhoudy; 
-  gdrhovdx = gauss.interp*drhovdx; gdrhovdy = gauss.interp*drhovdy; 
+  umAxB(gauss.interp, stack_view(dQ,Np), stack_view(gdQ,NgF));
+  gdrhodx.borrow (NgF,K, gdQ.pCol(1));  gdrhody.borrow (NgF,K, gdQ.pCol(2));
+  gdrhoudx.borrow(NgF,K, gdQ.pCol(3));  gdrhoudy.borrow(NgF,K, gdQ.pCol(4));
+  gdrhovdx.borrow(NgF,K, gdQ.pCol(5));  gdrhovdy.borrow(NgF,K, gdQ.pCol(6));
 
   // Use product-rule to evaluate gradients of velocity components at Gauss nodes
   gdudx = (gdrhoudx - gdrhodx.dm(gu)).dd(grho);
@@ -41,6 +41,8 @@ void CurvedCNS2D::Run()
 #endif
 
 
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   // outer time step loop 
   while (time<FinalTime) 
   {
@@ -15,6 +15,15 @@ CurvedEuler2D::CurvedEuler2D()
   // set simulation parameters
   gamma = 1.4;
   gm1   = gamma - 1.0;
+
+  // NDG_MASS=loop: apply inverse mass element by element
+  const char* s = getenv("NDG_MASS");
+  m_bBatchMass = !(s && !strcmp(s, "loop"));
+  m_sTileK = 0;
+
+  // NDG_FLUX=unique: one flux evaluation per face
+  s = getenv("NDG_FLUX");
+  m_bUniqueFlux = (s && !strcmp(s, "unique"));
 }
 
 
@@ -47,6 +56,11 @@ void CurvedEuler2D::Resize_cub()
   cQ.resize(Nc*K,4); cF.resize(Nc*K,4);  cG.resize(Nc*K,4);
   gQ.resize(Ngf,4);  gQM.resize(Ngf,4);  gQP.resize(Ngf,4); 
   flux.resize(Ngf,4);
+
+  // weighted volume and surface terms, and a second rhs,
+  // for the stacked products in RHS()
+  cWr.resize(Nc*K,4); cWs.resize(Nc*K,4);  gWf.resize(Ngf,4);
+  dQs.resize(Np*K,4);
 }
 
 
@@ -227,6 +241,13 @@ void CurvedEuler2D::Summary()
 {
   // TODO: add details of operators and sparse solvers
   NDG2D::Summary();
+
+  if (!m_bBatchMass) {
+    umLOG(1, "  inv. mass   = per element\n\n");
+  }
+  if (m_bUniqueFlux) {
+    umLOG(1, "  flux        = once per face\n\n");
+  }
 }
 
 
@@ -290,4 +311,7 @@ void CurvedEuler2D::FinalReport()
   umLOG(1, "\n  time for NDG work:  %0.2lf secs\n",  time_work);
   umLOG(1,   "           rhs work:  %0.2lf\n",       time_rhs);
   umLOG(1,   " time for main loop:  %0.2lf secs\n\n",time_total);
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
@@ -32,6 +32,7 @@ void CurvedEuler2D::Driver()
 //flux_type = FT_LaxF;
   flux_type = FT_Roe;
 //flux_type = FT_HLL;
+//flux_type = FT_HLLC;
 
   //--------------------------------------------------
   // select mesh, initial conditions, and BC function
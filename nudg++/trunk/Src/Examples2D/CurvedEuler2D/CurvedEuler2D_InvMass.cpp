@@ -0,0 +1,102 @@
+// CurvedEuler2D_InvMass.cpp
+// apply the elemental inverse mass matrices to the rhs
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "CurvedEuler2D.h"
+
+
+//---------------------------------------------------------
+void CurvedEuler2D::InitBatchMass()
+//---------------------------------------------------------
+{
+  // Split the straight-sided elements into runs of
+  // consecutive element ids, stored as (first,count)
+  // pairs, and size the work array of one tile: R/J for
+  // up to m_sTileK elements, about 32 KB.  Called from
+  // Run() once the curved elements are known.
+  int Nstraight = straight.size(), Nruns = 0;
+  m_sRuns.resize(2*Nstraight);
+  for (int m=1; m<=Nstraight; ++m) {
+    if (Nruns>0 && straight(m) == m_sRuns(2*Nruns-1)+m_sRuns(2*Nruns)) {
+      ++m_sRuns(2*Nruns);
+    } else {
+      ++Nruns;  m_sRuns(2*Nruns-1) = straight(m);  m_sRuns(2*Nruns) = 1;
+    }
+  }
+  m_sRuns.realloc(2*Nruns);
+
+  m_sTileK = std::max(1, 4096/Np);
+  m_sW.resize(Np, m_sTileK);
+}
+
+
+//---------------------------------------------------------
+void CurvedEuler2D::InvMass(DMat& R)
+//---------------------------------------------------------
+{
+  // R(:,n) = inv(M)*R(:,n) for the 4 fields, in place:
+  // M = J*inv(VVT) on straight-sided elements, and the
+  // Cholesky-factored cubature mass matrix on curved ones
+
+  Cub2D& cub = this->m_cub;
+  int Nstraight=straight.size(), Ncurved=curved.size();
+  int n=0, m=0, k=0, i=0;  Index1D II;
+
+  if (m_bBatchMass && Nstraight>0)
+  {
+    // 3.1.a Straight sided elements: consecutive elements
+    // are contiguous in R, so each run is done by tiles:
+    // W = R/J for the tile's elements, then R = VVT*W in
+    // one product written straight back into R
+    if (m_sTileK < 1) { InitBatchMass(); }   // not set up by Run()
+
+    int Nruns = m_sRuns.size()/2;
+    double *w = m_sW.data();
+    for (n=1; n<=4; ++n) {
+      for (m=1; m<=Nruns; ++m) {
+        int k1 = m_sRuns(2*m-1), kend = k1 + m_sRuns(2*m);
+        for (k=k1; k<kend; k+=m_sTileK) {
+          int nt = std::min(m_sTileK, kend-k), o = (k-1)*Np;
+          double *rk = R.pCol(n) + o;  const double *jk = J.data() + o;
+          for (i=0; i<nt*Np; ++i) { w[i] = rk[i] / jk[i]; }
+          umAxB(VVT, DView2D(w, Np, nt), DView2D(rk, Np, nt));
+        }
+      }
+    }
+  }
+  else
+  {
+    // 3.1.a Multiply straight sided elements by inverse mass matrix
+    //       (in place: R(II,n) is accessed through a view)
+    DVec w("w");  w.resize(Np, false);  DView2D wv(w);
+    for (n=1; n<=4; ++n) {
+      for (m=1; m<=Nstraight; ++m) {
+        k = straight(m);  II.reset((k-1)*Np+1, k*Np);
+        DView2D rq = view(R(II,n));
+        wv = rq;  wv.div_element(view(J(II)));
+        umAxB(VVT, wv, rq);
+      }
+    }
+  }
+
+  if (m_bBatchMass && Ncurved>0)
+  {
+    // 3.1.b Curvilinear elements: one batched Cholesky
+    //       solve for all elements and fields (BatchChol.h)
+    cub.mmBatch.solve(R, 4);
+  }
+  else
+  {
+    // 3.1.b Multiply curvilinear elements by custom inverse mass matrices
+    DMat mmCHOL;
+    for (n=1; n<=4; ++n) {
+      for (m=1; m<=Ncurved; ++m) {
+        k = curved(m);  II.reset((k-1)*Np+1, k*Np);
+        mmCHOL.borrow(Np,Np, cub.mmCHOL.pCol(k));
+        mmCHOL.set_factmode(FACT_CHOL);  // indicate factored state
+        chol_solve(mmCHOL, view(R(II,n)));
+      }
+    }
+  }
+}
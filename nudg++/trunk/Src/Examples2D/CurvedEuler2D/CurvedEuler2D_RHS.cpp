@@ -14,20 +14,22 @@ void CurvedEuler2D::RHS(DMat& Qin, double ti, fp_BC SolutionBC)
   // function [rhsQ] = CurvedEulerRHS2D(Qin, time, SolutionBC, fluxtype)
   // purpose: compute right hand side residual for the compressible Euler gas dynamics equations
 
-  DMat qn, ddr, dds, Fn, Gn, mmCHOL, tm1;
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
+  DMat qn, Fn, Gn;
   trhs = timer.read();  // time RHS work
 
   Cub2D&   cub   = this->m_cub;
   Gauss2D& gauss = this->m_gauss;
 
-  int Nc=cub.Ncub, Ng=gauss.NGauss, n=0, i=0, m=0, k=0;
-  int Nstraight=straight.size(), Ncurved=curved.size(); Index1D II;
+  int Nc=cub.Ncub, Ng=gauss.NGauss, NgF=Ng*Nfaces, n=0;
+
+  // The 4 fields are stacked side by side, (Np*K,4) viewed
+  // as (Np,4*K), so that each operator is applied to all
+  // of them in one product (see stack_view in View2D.h)
 
   // 1.1 Interpolate solution to cubature nodes 
-  for (n=1; n<=4; ++n) {
-    qn.borrow(Np,K, Qin.pCol(n));
-    cQ(All,n) = cub.V*qn;
-  }
+  umAxB(cub.V, stack_view(Qin,Np), stack_view(cQ,Nc));   // cQ = cub.V*[Q1..Q4]
 
   // 1.2 Evaluate flux function at cubature nodes
   this->Fluxes(cQ, cF, cG);
@@ -35,20 +37,22 @@ void CurvedEuler2D::RHS(DMat& Qin, double ti, fp_BC SolutionBC)
   // 1.3 Compute volume terms (dphidx, F) + (dphidy, G)
   for (n=1; n<=4; ++n) {
     Fn.borrow(Nc,K, cF.pCol(n)); Gn.borrow(Nc,K, cG.pCol(n));
-    ddr = cub.DrT * (cub.W.dm(cub.rx.dm(Fn) + cub.ry.dm(Gn)));
-    dds = cub.DsT * (cub.W.dm(cub.sx.dm(Fn) + cub.sy.dm(Gn)));
-    rhsQ(All,n) = ddr + dds;
+    col_view(cWr,n) = cub.W.dm(cub.rx.dm(Fn) + cub.ry.dm(Gn));
+    col_view(cWs,n) = cub.W.dm(cub.sx.dm(Fn) + cub.sy.dm(Gn));
   }
+  umAxB(cub.DrT, stack_view(cWr,Nc), stack_view(rhsQ,Np));
+  umAxB(cub.DsT, stack_view(cWs,Nc), stack_view(dQs, Np));
+  rhsQ += dQs;
 
   // 2.1 SURFACE TERMS (using Gauss nodes on element faces)
   // See MapGaussFaceData()
 
   // 2.2 Interpolate solution to Gauss surface nodes
+  umAxB(gauss.interp, stack_view(Qin,Np), stack_view(gQ,NgF));
   for (n=1; n<=4; ++n) {
-    qn.borrow(Np,K, Qin.pCol(n));
-    gQ = gauss.interp*qn;
-    gQM(All,n) = gQ(gauss.mapM);
-    gQP(All,n) = gQ(gauss.mapP);
+    qn.borrow(NgF,K, gQ.pCol(n));
+    gQM(All,n) = qn(gauss.mapM);
+    gQP(All,n) = qn(gauss.mapP);
   }
 
   // 2.3 Apply boundary conditions to '+' traces
@@ -59,39 +63,17 @@ void CurvedEuler2D::RHS(DMat& Qin, double ti, fp_BC SolutionBC)
   }
 
   // 2.4 Evaluate surface flux functions with stabilization
-  switch (flux_type) {
-
-  case FT_LaxF: this->LF2D  (gauss.nx, gauss.ny, gQM, gQP, gamma, flux); break;
-  case FT_Roe:  this->Roe2D (gauss.nx, gauss.ny, gQM, gQP, gamma, flux); break;
-  case FT_HLL:  this->HLL2D (gauss.nx, gauss.ny, gQM, gQP, gamma, flux); break;
-
-  default: umERROR("CurvedEuler2D::RHS", 
-                    "unknown flux_type: %d", flux_type); break;
-  }
+  this->SurfaceFlux(gQM, gQP, flux);
 
   // 2.5 Compute surface integral terms
   for (n=1; n<=4; ++n) {
-    tm1 = gauss.interpT*(gauss.W.dm(flux(All,n)));
-    rhsQ(All,n) -= tm1;
+    col_view(gWf,n) = gauss.W.dm(flux(All,n));
   }
+  umAxB(gauss.interpT, stack_view(gWf,NgF), stack_view(dQs,Np));
+  rhsQ -= dQs;
 
-  // 3.1 Multiply by inverse mass matrix
-  for (n=1; n<=4; ++n)
-  {
-    // 3.1.a Multiply straight sided elements by inverse mass matrix
-    for (m=1; m<=Nstraight; ++m) {
-      k = straight(m);  II.reset((k-1)*Np+1, k*Np);
-      rhsQ(II, n) = VVT * dd(rhsQ(II,n), J(II));
-    }
-
-    // 3.1.b Multiply curvilinear elements by custom inverse mass matrices
-    for (m=1; m<=Ncurved; ++m) {
-      k = curved(m);  II.reset((k-1)*Np+1, k*Np);
-      mmCHOL.borrow(Np,Np, cub.mmCHOL.pCol(k));
-      mmCHOL.set_factmode(FACT_CHOL);  // indicate factored state
-      rhsQ(II, n) = chol_solve(mmCHOL, rhsQ(II, n));
-    }
-  }
+  // 3.1 Multiply by inverse mass matrix 
+  this->InvMass(rhsQ);
 
   time_rhs += (timer.read() - trhs);
 }
@@ -22,6 +22,10 @@ void CurvedEuler2D::Run()
   // build cubature node data for all elements
   CubatureVolumeMesh2D(CubatureOrder);
 
+  // runs of straight elements for the batched InvMass
+  // (redo whenever the curved/straight split changes)
+  InitBatchMass();
+
   // build Gauss node data for all element faces
   GaussFaceMesh2D(NGauss);
 
@@ -30,6 +34,8 @@ void CurvedEuler2D::Run()
   PreCalcBdryData();      // gmapB = concat(mapI, mapO), etc.
   ti0=timer.read();       // time simulation loop
 
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   // outer time step loop 
   while (time<FinalTime) {
 
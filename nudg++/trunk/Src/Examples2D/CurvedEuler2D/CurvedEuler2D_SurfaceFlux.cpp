@@ -0,0 +1,131 @@
+// CurvedEuler2D_SurfaceFlux.cpp
+// numerical flux at the Gauss surface nodes
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "CurvedEuler2D.h"
+#include "EulerFlux_funcs.h"
+
+
+//---------------------------------------------------------
+void CurvedEuler2D::InitUniqueFlux()
+//---------------------------------------------------------
+{
+  // Gauss points on the owner side of each face, in the
+  // order of the face list (BuildFaceList2D), the partner
+  // points of the interior ones, and packed normals
+  Gauss2D& gauss = this->m_gauss;
+  int NG = gauss.NGauss, Nuf = uFaceM.size();
+  int Nu = Nuf*NG, NuI = NufI*NG, i=0, j=0, m=0;
+
+  m_uIdx.resize(Nu);  m_uPart.resize(NuI);
+  for (i=1; i<=Nuf; ++i) {
+    int o = (uFaceM(i)-1)*NG;
+    for (j=1; j<=NG; ++j) {
+      m_uIdx(++m) = o+j;
+      if (i <= NufI) { m_uPart(m) = gauss.mapP(o+j); }
+    }
+  }
+
+  m_unx.resize(Nu);  m_uny.resize(Nu);  m_ulam.resize(Nu);
+  for (m=1; m<=Nu; ++m) {
+    m_unx(m) = gauss.nx(m_uIdx(m));  m_uny(m) = gauss.ny(m_uIdx(m));
+  }
+}
+
+
+//---------------------------------------------------------
+void CurvedEuler2D::SurfaceFlux(DMat& QM, DMat& QP, DMat& flux)
+//---------------------------------------------------------
+{
+  // flux(:,n) at all Gauss surface nodes, from the traces
+  // (QM,QP).  With NDG_FLUX=unique, the flux of a shared
+  // face is evaluated once, from its owner side, and
+  // written to the partner nodes with opposite sign:
+  // F(QP,QM,-n) = -F(QM,QP,n) for LF, Roe, HLL and HLLC.
+
+  Gauss2D& gauss = this->m_gauss;
+
+  if (!m_bUniqueFlux)
+  {
+    switch (flux_type) {
+    case FT_LaxF: this->LF2D  (gauss.nx, gauss.ny, QM, QP, gamma, flux); break;
+    case FT_Roe:  this->Roe2D (gauss.nx, gauss.ny, QM, QP, gamma, flux); break;
+    case FT_HLL:  this->HLL2D (gauss.nx, gauss.ny, QM, QP, gamma, flux); break;
+    case FT_HLLC: this->HLLC2D(gauss.nx, gauss.ny, QM, QP, gamma, flux); break;
+
+    default: umERROR("CurvedEuler2D::SurfaceFlux",
+                      "unknown flux_type: %d", flux_type); break;
+    }
+    return;
+  }
+
+  if (m_uIdx.size() != uFaceM.size()*gauss.NGauss) { InitUniqueFlux(); }
+
+  // one pass over the owner-side points: traces read in
+  // place, both sides of flux written (EulerFlux_funcs.h)
+  int Ngf = QM.num_rows();
+  if (flux.num_rows() != Ngf || flux.num_cols() != 4) { flux.resize(Ngf,4, false); }
+  umEulerFluxUnique(flux_type, 2, gamma, m_uIdx.size(), m_uPart.size(), gauss.NGauss,
+                    m_uIdx.data(), m_uPart.data(), m_unx.data(), m_uny.data(), NULL,
+                    QM.data(), QP.data(), Ngf, m_ulam.data(), flux.data(), Ngf);
+}
+
+
+//---------------------------------------------------------
+void CurvedEuler2D::NodeFlux2D
+(
+        int     ftype,
+  const DMat&   lnx, 
+  const DMat&   lny, 
+  const DMat&   QM, 
+  const DMat&   QP, 
+        double  gamma,
+        DMat&   flux
+)
+//---------------------------------------------------------
+{
+  // flux(:,n) = F*(QM,QP,n).n at each node, evaluated by
+  // the pointwise functors of umEulerFlux; faces are NGauss
+  // consecutive nodes (all faces, or packed unique faces)
+
+  static DVec lam;
+  int Ngf = QM.num_rows(), NG = m_gauss.NGauss;
+  const double *qm=QM.data(), *qp=QP.data(), *pl=NULL;
+  if (flux.num_rows() != Ngf || flux.num_cols() != 4) { flux.resize(Ngf,4, false); }
+  double* fl = flux.data();
+
+  if (FT_LaxF == ftype) {
+    // wave speed: largest |u|+c on each face
+    lam.resize(Ngf, false);  pl = lam.data();
+    umEulerSpeed(2, gamma, Ngf, NG, qm, qp, Ngf, lam.data());
+  }
+
+  if (m_bAffineGeo && Ngf == NG*Nfaces*K)
+  {
+    // compressed face data (CompressFace2D): a straight
+    // face uses its one normal, runs of curved faces keep
+    // the normals (lnx,lny) at their Gauss points
+    int fc=1, fe=0, o=0, n=0;
+    while (fc <= Nfaces*K) {
+      o = (fc-1)*NG;
+      if (0 == faceIdx(fc)) {
+        const double* cn = faceK.pCol(fc);
+        umEulerFlux(ftype, 2, gamma, NG, cn, cn+1, NULL, 0,
+                    qm+o, qp+o, Ngf, pl ? pl+o : NULL, fl+o, Ngf);
+        ++fc;
+      } else {
+        for (fe=fc; fe<=Nfaces*K && 0 != faceIdx(fe); ++fe) {}
+        n = (fe-fc)*NG;
+        umEulerFlux(ftype, 2, gamma, n, lnx.data()+o, lny.data()+o, NULL, 1,
+                    qm+o, qp+o, Ngf, pl ? pl+o : NULL, fl+o, Ngf);
+        fc = fe;
+      }
+    }
+  }
+  else
+  {
+    umEulerFlux(ftype, 2, gamma, Ngf, lnx.data(), lny.data(), NULL, 1,
+                qm, qp, Ngf, pl, fl, Ngf);
+  }
+}
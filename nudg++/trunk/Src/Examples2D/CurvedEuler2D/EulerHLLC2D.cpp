@@ -0,0 +1,29 @@
+// EulerHLLC2D.cpp
+// HLLC surface flux for CurvedEuler2D
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "CurvedEuler2D.h"
+
+
+//---------------------------------------------------------
+void CurvedEuler2D::HLLC2D
+(
+  const DMat&   lnx, 
+  const DMat&   lny, 
+        DMat&   QM, 
+        DMat&   QP, 
+        double  gamma,
+        DMat&   flux
+)
+//---------------------------------------------------------
+{
+  // function flux = EulerHLLC2D(lnx, lny, QM, QP, gamma)
+  // Purpose: compute surface fluxes for Euler's equations using
+  //          the HLLC approximate Riemann solver (HLL with the
+  //          contact wave restored), with the HLL wave speeds
+  //
+  // pointwise functor HLLC<2> (EulerFlux_kernels.h)
+
+  this->NodeFlux2D(FT_HLLC, lnx, lny, QM, QP, gamma, flux);
+}
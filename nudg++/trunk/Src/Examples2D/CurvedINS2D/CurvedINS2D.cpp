@@ -361,4 +361,7 @@ void CurvedINS2D::FinalReport()
   umLOG(1,   "       pressure :  %8.2lf (chol %0.2lf)\n", time_pressure, time_pressure_sol);
   umLOG(1,   " total NDG work :  %8.2lf\n",  time_work);
   umLOG(1,   " total sim time :  %8.2lf\n\n",time_total);
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
@@ -68,6 +68,8 @@ void CurvedINS2D::Run()
 
   // start time stepping
   time = 0.0;
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   for (tstep=1; tstep<=Nsteps; ++tstep)
   {
     tw1=timer.read();   // time NDG work
@@ -76,14 +78,14 @@ void CurvedINS2D::Run()
     // first time step, then recalculate operators
     if (2 == tstep) 
     {
-      // release and recreate Cholesky solvers
-      reset_solvers();
+      umMemPhaseScope mem_phase(umMEM_SETUP);
 
       g0 = 1.5; a0 = 2.0; a1 = -0.5; b0 = 2.0; b1 = -1.0; 
 
-      // Rebuild pressure and viscous matrixes for new g0
-      CurvedINSPressureSetUp2D();
-      CurvedINSViscousSetUp2D();
+      // The pressure system does not depend on g0: keep its
+      // factorization.  Update the values of the viscous 
+      // system for new g0 (pattern unchanged), and refactor
+      CurvedINSViscousUpdate2D();
 
       NDG_garbage_collect();
       umMSG(1, "2nd sparse setup completed\n");
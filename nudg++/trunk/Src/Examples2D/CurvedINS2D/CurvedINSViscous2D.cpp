@@ -10,6 +10,8 @@
 void CurvedINS2D::CurvedINSViscous2D()
 //---------------------------------------------------------
 {
+  umMemPhaseScope mem_phase(umMEM_SOLVE);
+
   double t1 = timer.read(), t2,t3;
 
   // compute right hand side for viscous step solves
@@ -26,7 +26,8 @@ void CurvedINS2D::CurvedINSViscousSetUp2D()
 
   CSd *VELsystemBC = new CSd("VELbc");  // NBN: delete before chol()
   CSd *mm = new CSd("mmV");             // NBN: delete before chol()
-  CSd VELsystem("VEL"); IVec ids;       // NBN: passed to chol()
+  CSd *op = new CSd("opV");             // NBN: delete before chol()
+  IVec ids;
 
   // save original boundary types
   saveBCType = BCType;
@@ -52,11 +53,72 @@ void CurvedINS2D::CurvedINSViscousSetUp2D()
   refrhsbcUy = (*VELsystemBC) * bcUy;
   delete VELsystemBC; VELsystemBC=NULL;
 
-  // Build velocity system 
-  CurvedPoissonIPDG2D(gauss, cub, VELsystem, (*mm));
-  VELsystem += (*mm) * (g0/(dt*nu));
+  // Build velocity operators.  VEL = OP + (g0/(dt*nu))*MM 
+  // has the pattern of OP+MM for any scaling: store OP on 
+  // this pattern, so that VEL can be updated in place.  MM
+  // only fills the diagonal blocks of that pattern: keep 
+  // its nonzeros and their positions, not a second full 
+  // array of values (see CurvedINS2D.h)
+  CurvedPoissonIPDG2D(gauss, cub, (*op), (*mm));
+  VELop.copy(*op);  VELop += (*mm);     // pattern of VEL
+  DVec mmV;
+  VELop.gather(*mm, mmV);               // MM on that pattern
+  VELop.gather(*op, VELop.X);           // OP on that pattern
+  delete op; op=NULL;
   delete mm; mm=NULL;
 
+  int i=0, Nv=mmV.size(), Nm=0;
+  const double* pv = mmV.data();
+  for (i=0; i<Nv; ++i) { if (0.0 != pv[i]) { ++Nm; } }
+  VELmm.resize(Nm); VELmmIdx.resize(Nm); Nm=0;
+  for (i=0; i<Nv; ++i) {
+    if (0.0 != pv[i]) { VELmmIdx.data()[Nm]=i; VELmm.data()[Nm]=pv[i]; ++Nm; }
+  }
+  mmV.destroy();
+
+  BCType = saveBCType;              // Restore original boundary types
+
+  //---------------------------
+  time_setup += timer.read() - t1;
+  //---------------------------
+
+  // VEL and PR are IPDG operators on the same mesh: if 
+  // their patterns match, VEL reuses the symbolic analysis
+  // of PR (see CurvedINSPressureSetUp2D)
+  VELsystemC->share_symbolic(*PRsystemC);
+
+  // form and factor VEL for current {g0,dt,nu}
+  CurvedINSViscousUpdate2D();
+}
+
+
+//---------------------------------------------------------
+void CurvedINS2D::CurvedINSViscousUpdate2D()
+//---------------------------------------------------------
+{
+  // Form VEL = OP + (g0/(dt*nu))*MM on the pattern stored
+  // by CurvedINSViscousSetUp2D, then refactor.  A change of
+  // {g0,dt,nu} costs one pass over the values (no IPDG 
+  // assembly, no sparse add), and VEL matches the matrix
+  // that OP += MM*(g0/(dt*nu)) would give, bit for bit.
+  // Since the pattern is fixed, chol() only repeats the
+  // numeric factorization.
+
+  //---------------------------
+  double t1 = timer.read();
+  //---------------------------
+
+  if (!VELop.ok()) { umERROR("CurvedINSViscousUpdate2D", "call CurvedINSViscousSetUp2D first"); }
+
+  CSd VELsystem("VEL");             // NBN: passed to chol()
+  VELsystem.copy(VELop);
+
+  // zeros of MM on the pattern were not stored: adding
+  // them would leave VEL unchanged
+  double sc = g0/(dt*nu), *pX = VELsystem.X.data();
+  const double* pm = VELmm.data();  const int* im = VELmmIdx.data();
+  for (int i=0; i<VELmm.size(); ++i) { pX[im[i]] += pm[i]*sc; }
+
 #if (0)
   // check against Matlab
   FILE* fp = fopen("nnV.dat", "w");
@@ -69,7 +131,6 @@ void CurvedINS2D::CurvedINSViscousSetUp2D()
   VELsystemC->chol(VELsystem, 4);   // 4=CS_Chol option
 
   VELsystem.reset();                // force deallocation
-  BCType = saveBCType;              // Restore original boundary types
 
   //---------------------------
   time_setup += timer.read() - t1;
@@ -10,6 +10,8 @@ void CurvedINS2D::INSAdvection2D()
 //---------------------------------------------------------
 {
   // reuse 4 static allocations (set size before use!)
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
   static DMat UxM, UxP, UyM, UyP;
   UxM.resize(Nfp*Nfaces, K); UxP.resize(Nfp*Nfaces, K); 
   UyM.resize(Nfp*Nfaces, K); UyP.resize(Nfp*Nfaces, K); 
@@ -19,7 +21,7 @@ void CurvedINS2D::INSAdvection2D()
   double t1 = timer.read();
 
   // evaluate flux vectors
-  fxUx=sqr(Ux);  fyUx=Ux.dm(Uy);  fxUy=Ux.dm(Uy); fyUy=sqr(Uy);
+  fxUx=sqr(Ux);  fyUx=Ux.dm(Uy);  fxUy=fyUx; fyUy=sqr(Uy);
 
   // save old nonlinear terms
   NUxold = NUx; NUyold = NUy; 
@@ -28,8 +30,9 @@ void CurvedINS2D::INSAdvection2D()
   Div2D(fxUx,fyUx, NUx);  Div2D(fxUy,fyUy, NUy);
 
   // interpolate velocity to face nodes on element faces
-  UxM = Ux(vmapM); UyM = Uy(vmapM);
-  UxP = Ux(vmapP); UyP = Uy(vmapP);
+  const DVec* U[2] = {&Ux, &Uy};
+  DVec* UM[2] = {&UxM, &UyM};  DVec* UP[2] = {&UxP, &UyP};
+  trace_gather(2, U, vmapM,vmapP, UM,UP);
 
   // set '+' trace of velocity at boundary face nodes
   UxP(mapI) = bcUx(mapI);   UyP(mapI) = bcUy(mapI);
@@ -37,25 +40,60 @@ void CurvedINS2D::INSAdvection2D()
   UxP(mapC) = bcUx(mapC);   UyP(mapC) = bcUy(mapC);
 
   // evaluate flux vectors at '-' and '+' traces at face nodes
-  fxUxM=sqr(UxM);  fyUxM=UxM.dm(UyM);  fxUyM=UxM.dm(UyM); fyUyM=sqr(UyM);
-  fxUxP=sqr(UxP);  fyUxP=UxP.dm(UyP);  fxUyP=UxP.dm(UyP); fyUyP=sqr(UyP);
+  fxUxM=sqr(UxM);  fyUxM=UxM.dm(UyM);  fxUyM=fyUxM; fyUyM=sqr(UyM);
+  fxUxP=sqr(UxP);  fyUxP=UxP.dm(UyP);  fxUyP=fyUxP; fyUyP=sqr(UyP);
+
+  if (m_bAffineGeo)
+  {
+    // compressed face data (CompressFace2D): one face at a
+    // time, the maximum normal velocity and the local LF
+    // fluxes, already scaled by Fscale
+    fluxUx.resize(Nfp*Nfaces, K, false);  fluxUy.resize(Nfp*Nfaces, K, false);
+    const double *uxm=UxM.data(), *uym=UyM.data(), *uxp=UxP.data(), *uyp=UyP.data();
+    const double *fxxm=fxUxM.data(), *fyxm=fyUxM.data(), *fxym=fxUyM.data(), *fyym=fyUyM.data();
+    const double *fxxp=fxUxP.data(), *fyxp=fyUxP.data(), *fxyp=fxUyP.data(), *fyyp=fyUyP.data();
+    double *fux=fluxUx.data(), *fuy=fluxUy.data();
+    int fs=0, inc=0, i=0, n=0;
+    for (int fc=1; fc<=Nfaces*K; ++fc) {
+      const double *g = face_geo(fc, fs, inc);
+      const double *gnx=g, *gny=g+fs, *gfs=g+3*fs;
+      const int n0 = (fc-1)*Nfp;
+      double mv = 0.0;
+      for (i=0, n=n0; i<Nfp; ++i, ++n) {
+        double unM = uxm[n]*gnx[i*inc] + uym[n]*gny[i*inc];
+        double unP = uxp[n]*gnx[i*inc] + uyp[n]*gny[i*inc];
+        mv = std::max(mv, std::max(fabs(unM), fabs(unP)));
+      }
+      for (i=0, n=n0; i<Nfp; ++i, ++n) {
+        const double nxn=gnx[i*inc], nyn=gny[i*inc], fsc=gfs[i*inc];
+        fux[n] = fsc * 0.5*( -nxn*(fxxm[n]-fxxp[n]) - nyn*(fyxm[n]-fyxp[n]) - mv*(uxp[n]-uxm[n]) );
+        fuy[n] = fsc * 0.5*( -nxn*(fxym[n]-fxyp[n]) - nyn*(fyym[n]-fyyp[n]) - mv*(uyp[n]-uym[n]) );
+      }
+    }
 
-  // evaluate dot product of normal and velocity at face nodes
-  UDotNM = UxM.dm(nx) + UyM.dm(ny);  UDotNP = UxP.dm(nx) + UyP.dm(ny);
-  maxvel = max(abs(UDotNM), abs(UDotNP));
+    // put volume and surface terms together
+    NUx += LIFT*fluxUx;
+    NUy += LIFT*fluxUy;
+  }
+  else
+  {
+    // evaluate dot product of normal and velocity at face nodes
+    UDotNM = UxM.dm(nx) + UyM.dm(ny);  UDotNP = UxP.dm(nx) + UyP.dm(ny);
+    maxvel = max(abs(UDotNM), abs(UDotNP));
 
-  // evaluate maximum normal velocity at face face nodes
-  maxvel.reshape(Nfp, Nfaces*K);
-  maxvel = outer(ones(Nfp), maxvel.max_col_vals());
-  maxvel.reshape(Nfp*Nfaces, K);
+    // evaluate maximum normal velocity at face face nodes
+    maxvel.reshape(Nfp, Nfaces*K);
+    maxvel = outer(ones(Nfp), maxvel.max_col_vals());
+    maxvel.reshape(Nfp*Nfaces, K);
 
-  // form local Lax-Friedrichs/Rusonov fluxes
-  fluxUx = 0.5*( -nx.dm(fxUxM-fxUxP) - ny.dm(fyUxM-fyUxP) - maxvel.dm(UxP-UxM) );
-  fluxUy = 0.5*( -nx.dm(fxUyM-fxUyP) - ny.dm(fyUyM-fyUyP) - maxvel.dm(UyP-UyM) );
+    // form local Lax-Friedrichs/Rusonov fluxes
+    fluxUx = 0.5*( -nx.dm(fxUxM-fxUxP) - ny.dm(fyUxM-fyUxP) - maxvel.dm(UxP-UxM) );
+    fluxUy = 0.5*( -nx.dm(fxUyM-fxUyP) - ny.dm(fyUyM-fyUyP) - maxvel.dm(UyP-UyM) );
 
-  // put volume and surface terms together
-  NUx += LIFT*(Fscale.dm(fluxUx));
-  NUy += LIFT*(Fscale.dm(fluxUy));
+    // put volume and surface terms together
+    NUx += LIFT*(Fscale.dm(fluxUx));
+    NUy += LIFT*(Fscale.dm(fluxUy));
+  }
 
   // compute (U~,V~)
   UxT = ((a0*Ux + a1*Uxold) - dt*(b0*NUx + b1*NUxold))/g0; 
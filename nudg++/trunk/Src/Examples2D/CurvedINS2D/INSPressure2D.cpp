@@ -9,6 +9,8 @@
 void CurvedINS2D::INSPressure2D()
 //---------------------------------------------------------
 {
+  umMemPhaseScope mem_phase(umMEM_SOLVE);
+
   DMat DivUT,CurlU,dCurlUdx,dCurlUdy,res1,res2,dPRdx,dPRdy;
   DVec PRrhs;  double t1 = timer.read(), t2,t3,t4;
 
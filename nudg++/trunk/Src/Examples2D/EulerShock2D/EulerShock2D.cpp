@@ -331,4 +331,7 @@ void EulerShock2D::FinalReport()
 #if (0)
   resid.print(stderr, "resid", "e", 4, 12, false, 3);
 #endif
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
@@ -46,6 +46,8 @@ void EulerShock2D::Run()
   // limit initial condition
   Q = EulerLimiter2D(Q, time);
 
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   // outer time step loop 
   while (time<FinalTime) {
 
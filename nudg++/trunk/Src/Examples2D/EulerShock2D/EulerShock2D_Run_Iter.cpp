@@ -67,6 +67,8 @@ void EulerShock2D::Run_Iter()
     // limit initial condition
     Q = EulerLimiter2D(Q, time);
 
+    umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
     // outer time step loop 
     while (time<FinalTime) {
 
@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "Maxwell2D.h"
+#include "Maxwell2D_P.h"
 
 
 //---------------------------------------------------------
@@ -11,6 +12,16 @@ Maxwell2D::Maxwell2D()
 //---------------------------------------------------------
 {
   class_name = "Maxwell2D-TM";
+
+  stats_rhs.reset();
+  Ncalls_rhs = 0;
+
+  m_precision = umPrecFromEnv("NDG_PRECISION", umPREC_DOUBLE);
+  m_pPrec = NULL;
+
+  const char* s = getenv("NDG_RHS");
+  m_bFusedRHS = (s && !strcmp(s, "fused"));
+  m_tileK = 0;
 }
 
 
@@ -18,6 +29,7 @@ Maxwell2D::Maxwell2D()
 Maxwell2D::~Maxwell2D()
 //---------------------------------------------------------
 {
+  if (m_pPrec) { delete m_pPrec; m_pPrec = NULL; }
 }
 
 
@@ -118,6 +130,13 @@ void Maxwell2D::Summary()
 //---------------------------------------------------------
 {
   NDG2D::Summary();
+
+  if (umPREC_DOUBLE != m_precision) {
+    umLOG(1, "  precision   = %s\n\n", umPrecName(m_precision));
+  }
+  if (m_bFusedRHS) {
+    umLOG(1, "  RHS         = fused\n\n");
+  }
 }
 
 
@@ -162,4 +181,21 @@ void Maxwell2D::FinalReport()
   umLOG(1, "\n time for NDG work  : %12.2lf secs\n", time_work);
   umLOG(1,   " time for RHS       : %12.2lf secs\n", time_rhs);
   umLOG(1,   " time for main loop : %12.2lf secs\n\n", time_total);
+
+#if (TRACK_ARRAY_STATS)
+  // report array traffic per call to RHS()
+  if (Ncalls_rhs > 0) {
+    double nc = (double)Ncalls_rhs;
+    umLOG(1, " array traffic per RHS (%d calls):\n", Ncalls_rhs);
+    umLOG(1, "   allocations  : %8.1lf\n", stats_rhs.alloc/nc);
+    umLOG(1, "   col. indexes : %8.1lf\n", stats_rhs.index/nc);
+    umLOG(1, "   deep copies  : %8.1lf\n", stats_rhs.copy /nc);
+    umLOG(1, "   moves        : %8.1lf\n",   stats_rhs.move /nc);
+    umLOG(1, "   frame allocs : %8.1lf\n",   stats_rhs.frame/nc);
+    umLOG(1, "   OBJ_temp's   : %8.1lf\n\n", stats_rhs.temp /nc);
+  }
+#endif
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
@@ -0,0 +1,18 @@
+// Maxwell2D_P.cpp
+// create Maxwell2D steppers for a given precision
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "Maxwell2D_P.h"
+
+
+//---------------------------------------------------------
+Maxwell2D_Pbase* NewMaxwell2D_P(umPrecision prec, const Globals2D& G)
+//---------------------------------------------------------
+{
+  switch (prec) {
+  case umPREC_SINGLE: return new Maxwell2D_P<float, float >(G);
+  case umPREC_MIXED:  return new Maxwell2D_P<float, double>(G);
+  default:            return new Maxwell2D_P<double,double>(G);
+  }
+}
@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "Maxwell2D.h"
+#include "Maxwell2D_fused.h"
 
 //---------------------------------------------------------
 void Maxwell2D::RHS()
@@ -12,34 +13,54 @@ void Maxwell2D::RHS()
   // function [rhsHx, rhsHy, rhsEz] = MaxwellRHS2D(Hx,Hy,Ez)
   // Purpose  : Evaluate RHS flux in 2D Maxwell TM form 
 
+  if (m_bFusedRHS) { RHS_fused(); return; }
+
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
   //---------------------------
   double t1 = timer.read();
+  umArrayStats s1 = DVec::stats();
   //---------------------------
 
-  // Define field differences at faces
-  dHx = Hx(vmapM)-Hx(vmapP);
-  dHy = Hy(vmapM)-Hy(vmapP); 
-  dEz = Ez(vmapM)-Ez(vmapP);
+  // Define field differences at faces:
+  // dHx = Hx(vmapM)-Hx(vmapP), etc. (one pass for all fields)
+  const DVec* U[3] = { &Hx,  &Hy,  &Ez};
+  DVec*      dU[3] = {&dHx, &dHy, &dEz};
+  trace_jump(3, U, vmapM,vmapP, dU);
 
   // Impose reflective boundary conditions (Ez+ = -Ez-)
   dHx(mapB)=0.0; dHy(mapB)=0.0; dEz(mapB)=2.0*Ez(vmapB);
 
-  // evaluate upwind fluxes
+  // evaluate upwind fluxes, scaled by Fscale, node by node
+  // (MaxwellFlux_funcs.h).  Face data is nodal, or one set
+  // of {nx,ny,Fscale} per straight face if compressed 
+  // (CompressFace2D)
   alpha = 1.0; 
-  ndotdH =  nx.dm(dHx) + ny.dm(dHy);
-  fluxHx =  ny.dm(dEz) + alpha*(ndotdH.dm(nx) - dHx);
-  fluxHy = -nx.dm(dEz) + alpha*(ndotdH.dm(ny) - dHy);
-  fluxEz = -nx.dm(dHy) + ny.dm(dHx) - alpha*dEz;
+  fluxHx.resize(Nfp*Nfaces, K, false);
+  fluxHy.resize(Nfp*Nfaces, K, false);
+  fluxEz.resize(Nfp*Nfaces, K, false);
+  const double *dhx=dHx.data(), *dhy=dHy.data(), *dez=dEz.data();
+  double *fhx=fluxHx.data(), *fhy=fluxHy.data(), *fez=fluxEz.data();
+  for (int fc=1; fc<=Nfaces*K; ++fc) {
+    const int n0=(fc-1)*Nfp;  int inc=1;
+    const double *gnx=nx.data()+n0, *gny=ny.data()+n0, *gfs=Fscale.data()+n0;
+    umFaceGeo2D(this, fc, gnx, gny, gfs, inc);
+    for (int i=0, n=n0; i<Nfp; ++i, ++n) {
+      umMaxwell2D_Flux(gnx[i*inc], gny[i*inc], gfs[i*inc], alpha,
+                       dhx[n], dhy[n], dez[n], fhx[n], fhy[n], fez[n]);
+    }
+  }
 
   // local derivatives of fields
   Grad2D(Ez, Ezx,Ezy);  Curl2D(Hx,Hy, CuHz);
 
   // compute right hand sides of the PDE's
-  rhsHx = -Ezy  + LIFT*(Fscale.dm(fluxHx))/2.0;
-  rhsHy =  Ezx  + LIFT*(Fscale.dm(fluxHy))/2.0;
-  rhsEz =  CuHz + LIFT*(Fscale.dm(fluxEz))/2.0;
+  rhsHx = -Ezy  + LIFT*fluxHx/2.0;
+  rhsHy =  Ezx  + LIFT*fluxHy/2.0;
+  rhsEz =  CuHz + LIFT*fluxEz/2.0;
 
   //---------------------------
   time_rhs += timer.read() - t1;
+  stats_rhs += DVec::stats() - s1;  ++Ncalls_rhs;
   //---------------------------
 }
@@ -0,0 +1,54 @@
+// Maxwell2D_RHS_fused.cpp
+// element-local evaluation of the Maxwell2D (TM) RHS
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "Maxwell2D.h"
+#include "Maxwell2D_fused.h"
+
+
+//---------------------------------------------------------
+void Maxwell2D::InitFusedRHS()
+//---------------------------------------------------------
+{
+  // boundary flags at face nodes, tile size and scratch
+  umMaxwell2D_Bdry(*this, m_bdry);
+  m_tile.resize(umMaxwell2D_Tile(Np, Nfp*Nfaces, K, m_tileK));
+
+  rhsHx.resize(Np,K);  rhsHy.resize(Np,K);  rhsEz.resize(Np,K);
+}
+
+
+//---------------------------------------------------------
+void Maxwell2D::RHS_fused()
+//---------------------------------------------------------
+{
+  // Same result as RHS(), element tile by element tile
+  // (see Maxwell2D_fused.h): the arithmetic follows RHS()
+  // operation by operation, so results are identical.
+
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
+  //---------------------------
+  double t1 = timer.read();
+  umArrayStats s1 = DVec::stats();
+  //---------------------------
+
+  if (m_bdry.size() != Nfp*Nfaces*K) { InitFusedRHS(); }
+  alpha = 1.0;
+
+  umMaxwell2D_Data<double,double> d;
+  d.load(*this, m_bdry);
+  d.Dr = Dr.data();  d.Ds = Ds.data();  d.LIFT = LIFT.data();
+  d.rx = rx.data();  d.ry = ry.data();  d.sx = sx.data();  d.sy = sy.data();
+  d.nx = nx.data();  d.ny = ny.data();  d.Fscale = Fscale.data();
+  d.pFace = this;   // compressed face data, if any
+
+  umMaxwell2D_FusedRHS(d, alpha, Hx.data(), Hy.data(), Ez.data(),
+                       rhsHx.data(), rhsHy.data(), rhsEz.data(), m_tileK, m_tile.data());
+
+  //---------------------------
+  time_rhs += timer.read() - t1;
+  stats_rhs += DVec::stats() - s1;  ++Ncalls_rhs;
+  //---------------------------
+}
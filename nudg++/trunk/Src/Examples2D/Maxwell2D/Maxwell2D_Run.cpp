@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "Maxwell2D.h"
+#include "Maxwell2D_P.h"
 
 //---------------------------------------------------------
 void Maxwell2D::Run()
@@ -16,6 +17,16 @@ void Maxwell2D::Run()
   InitRun();          // prepare simulation
   ti0=timer.read();   // start timing
 
+  if (umPREC_DOUBLE != m_precision) {
+    // float storage: step in Maxwell2D_P, copy fields 
+    // back to (Hx,Hy,Ez) after each step for reports
+    if (m_pPrec) { delete m_pPrec; }
+    m_pPrec = NewMaxwell2D_P(m_precision, *this);
+    m_pPrec->SetFields(Hx, Hy, Ez);
+  }
+
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   // outer time step loop 
   while (time<FinalTime) 
   {
@@ -24,20 +35,27 @@ void Maxwell2D::Run()
     // adjust final step to end exactly at FinalTime
     if (time+dt > FinalTime) { dt = FinalTime-time; }
 
-    for (int INTRK=1; INTRK<=5; ++INTRK) {
+    if (m_pPrec) {
+      double t1 = timer.read();
+      m_pPrec->Step(dt);
+      time_rhs += timer.read() - t1;  // (RHS and RK updates)
+      m_pPrec->GetFields(Hx, Hy, Ez);
+    } else {
+      for (int INTRK=1; INTRK<=5; ++INTRK) {
 
-      // compute rhs of TM-mode Maxwell's equations
-      this->RHS();
+        // compute rhs of TM-mode Maxwell's equations
+        this->RHS();
 
-      // initiate and increment Runge-Kutta residuals
-      resHx *= rk4a(INTRK);   resHx += dt*rhsHx;  
-      resHy *= rk4a(INTRK);   resHy += dt*rhsHy; 
-      resEz *= rk4a(INTRK);   resEz += dt*rhsEz; 
+        // initiate and increment Runge-Kutta residuals
+        resHx *= rk4a(INTRK);   resHx += dt*rhsHx;  
+        resHy *= rk4a(INTRK);   resHy += dt*rhsHy; 
+        resEz *= rk4a(INTRK);   resEz += dt*rhsEz; 
           
-      // update fields
-      Hx += rk4b(INTRK)*resHx;  
-      Hy += rk4b(INTRK)*resHy;  
-      Ez += rk4b(INTRK)*resEz;        
+        // update fields
+        Hx += rk4b(INTRK)*resHx;  
+        Hy += rk4b(INTRK)*resHy;  
+        Ez += rk4b(INTRK)*resEz;        
+      }
     }
 
     time_work += timer.read() - tw1;
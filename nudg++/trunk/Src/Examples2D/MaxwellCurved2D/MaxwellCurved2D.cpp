@@ -11,6 +11,14 @@ MaxwellCurved2D::MaxwellCurved2D()
 //---------------------------------------------------------
 {
   class_name = "MaxwellCurved2D-TM";
+
+  // the float steppers (Maxwell2D_P.h) evaluate the nodal
+  // RHS of Maxwell2D, not the cubature RHS of curved faces
+  if (umPREC_DOUBLE != m_precision) {
+    umWARNING("MaxwellCurved2D", "NDG_PRECISION=%s is not supported, using double", 
+              umPrecName(m_precision));
+    m_precision = umPREC_DOUBLE;
+  }
 }
 
 
@@ -98,7 +106,7 @@ void MaxwellCurved2D::InitRun()
   //---------------------------------------------
   // Adjust reporting and render frequencies
   //---------------------------------------------
-  Nreport =  Nsteps/20;
+  Nreport =  std::max(1, Nsteps/20);  // (Nsteps < 20 for short runs)
 //Nreport =  2;         // set frequency of reporting (param)
 //Nreport = 10;         // set frequency of reporting (param)
 //Nreport = 50;        // set frequency of reporting (param)
@@ -131,6 +139,9 @@ void MaxwellCurved2D::FinalReport()
   umLOG(1,   "            - curve:  %0.2lf\n",       time_rhs_c);
   umLOG(1,   "            - total:  %0.2lf secs\n",  time_rhs+time_rhs_c);
   umLOG(1,   " time for main loop:  %0.2lf secs\n\n",time_total);
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
 
 
@@ -125,6 +125,7 @@ void MaxwellNonCon2D::BuildPNonCon2D
       ::GeometricFactors2D(x,y,Dr,Ds,  rx,sx,ry,sy,J);
       Normals2D();
       Fscale = sJ.dd(J(Fmask,All));
+      CompressFace2D(Fscale);
 
       // Calculate element connections on this mesh
       tiConnect2D(EToV_N, EToE,EToF);
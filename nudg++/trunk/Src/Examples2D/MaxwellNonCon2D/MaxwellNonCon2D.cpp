@@ -322,6 +322,9 @@ void MaxwellNonCon2D::FinalReport()
     umLOG(1,   " time for RHS P-non : %12.2lf secs\n", time_rhs_P);
     umLOG(1,   " time for main loop : %12.2lf secs\n\n", time_total);
   }
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
 
 
@@ -10,6 +10,8 @@
 void MaxwellNonCon2D::RHS()
 //---------------------------------------------------------
 {
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
   if (eModeH == noncon_mode) {
     RHS_H();
   } else {
@@ -30,6 +30,8 @@ void MaxwellNonCon2D::Run()
   // start timing
   ti0=timer.read();
 
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   //-------------------------------------
   // outer time step loop 
   //-------------------------------------
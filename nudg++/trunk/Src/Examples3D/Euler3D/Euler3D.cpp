@@ -18,6 +18,10 @@ Euler3D::Euler3D()
 
   // toggle use of cut-off filter
   m_bApplyFilter = false;
+
+  // NDG_FLUX=unique: one flux evaluation per face
+  const char* s = getenv("NDG_FLUX");
+  m_bUniqueFlux = (s && !strcmp(s, "unique"));
 }
 
 
@@ -47,8 +51,7 @@ void Euler3D::Resize()
   cF.resize(Nr,5); cG.resize(Nr,5); cH.resize(Nr,5);
 
   QM.resize(Nrf,5);  QP.resize(Nrf,5); flux.resize(Nrf,5);
-  fM.resize(Nrf,5);  gM.resize(Nrf,5);  hM.resize(Nrf,5);
-  fP.resize(Nrf,5);  gP.resize(Nrf,5);  hP.resize(Nrf,5);
+  lambda.resize(Nrf);
 }
 
 
@@ -187,6 +190,10 @@ void Euler3D::Summary()
 //---------------------------------------------------------
 {
   NDG3D::Summary();
+
+  if (m_bUniqueFlux) {
+    umLOG(1, "  flux        = once per face\n\n");
+  }
 }
 
 
@@ -266,4 +273,7 @@ void Euler3D::FinalReport()
   umLOG(1, "\n time for NDG work  : %12.2lf secs\n", time_work);
   umLOG(1,   " time for RHS       : %12.2lf secs\n", time_rhs);
   umLOG(1,   " time for main loop : %12.2lf secs\n\n", time_total);
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
@@ -4,6 +4,33 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "Euler3D.h"
+#include "EulerFlux_funcs.h"
+
+
+//---------------------------------------------------------
+void Euler3D::InitUniqueFlux()
+//---------------------------------------------------------
+{
+  // face nodes on the owner side of each face, in the
+  // order of the face list (BuildFaceList3D), the partner
+  // nodes of the interior ones, and packed normals
+  int Nuf = uFaceM.size(), Nu = Nuf*Nfp, NuI = NufI*Nfp, i=0, j=0, m=0;
+
+  m_uIdx.resize(Nu);  m_uPart.resize(NuI);
+  for (i=1; i<=Nuf; ++i) {
+    int o = (uFaceM(i)-1)*Nfp;
+    for (j=1; j<=Nfp; ++j) {
+      m_uIdx(++m) = o+j;
+      if (i <= NufI) { m_uPart(m) = mapP(o+j); }
+    }
+  }
+
+  m_unx.resize(Nu);  m_uny.resize(Nu);  m_unz.resize(Nu);  m_ulam.resize(Nu);
+  for (m=1; m<=Nu; ++m) {
+    i = m_uIdx(m);  m_unx(m) = nx(i);  m_uny(m) = ny(i);  m_unz(m) = nz(i);
+  }
+}
+
 
 //---------------------------------------------------------
 void Euler3D::RHS(DMat& Qin, double ti, fp_BC SolutionBC)
@@ -13,10 +40,12 @@ void Euler3D::RHS(DMat& Qin, double ti, fp_BC SolutionBC)
   // Purpose: Evaluate RHS in 3D Euler equations, discretized 
   //          on weak form with a local Lax-Friedrich flux
 
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
   trhs = timer.read();  // time RHS work
 
   DMat dFdr,dFds,dFdt, dGdr,dGds,dGdt, dHdr,dHds,dHdt; int n=0;
-  DMat Fn,Gn,Hn,lambda,nflux;  DVec rhoM,uM,vM,wM,pM, rhoP,uP,vP,wP,pP;
+  DMat Fn,Gn,Hn,nflux;
 
   // 1. Compute volume contributions (INDEPENDENT OF SURFACE TERMS)
   this->Fluxes(Qin, cF,cG,cH);
@@ -37,39 +66,49 @@ void Euler3D::RHS(DMat& Qin, double ti, fp_BC SolutionBC)
 
   // 2. Compute surface contributions 
   // 2.1 evaluate '-' and '+' traces of conservative variables
-  int Nr = Qin.num_rows(); DVec Qn("Qn");
-  for (n=1; n<=5; ++n) {
-    Qn.borrow (Nr,Qin.pCol(n));
-    QM(All,n) = Qn(vmapM);
-    QP(All,n) = Qn(vmapP);
-  }
+  //     (all 5 columns: QM(All,n) = Qin(vmapM,n), etc.)
+  trace_gather(Qin, vmapM,vmapP, QM,QP);
 
   // 2.2 set boundary conditions by modifying positive traces
   if (SolutionBC) {
     (this->*BCSolution)(Fx,Fy,Fz, nx,ny,nz, mapI,mapO,mapW,mapC, ti, QP);
   }
 
-  // 2.3 evaluate primitive variables & flux functions at '-' and '+' traces
-  this->Fluxes(QM, fM,gM,hM, rhoM,uM,vM,wM,pM);
-  this->Fluxes(QP, fP,gP,hP, rhoP,uP,vP,wP,pP);
+  if (m_bUniqueFlux)
+  {
+    // 2.3-2.5 as below, but from the owner side of each face
+    // only (BuildFaceList3D): one pass reads the traces in
+    // place and writes the flux of a shared face node to
+    // its partner with opposite sign (EulerFlux_funcs.h).
+    // Every face node is an owner or a partner node.
+    if (m_uIdx.size() != uFaceM.size()*Nfp) { InitUniqueFlux(); }
 
-  // 2.4 Compute local Lax-Friedrichs/Rusonov numerical fluxes
-  lambda = max( sqrt(sqr(uM)+sqr(vM)+sqr(wM)) + sqrt(abs(gamma*pM.dd(rhoM))),
-	              sqrt(sqr(uP)+sqr(vP)+sqr(wP)) + sqrt(abs(gamma*pP.dd(rhoP))));
+    int Nrf = QM.num_rows();
+    umEulerFluxUnique(FT_LaxF, 3, gamma, m_uIdx.size(), m_uPart.size(), Nfp,
+                      m_uIdx.data(), m_uPart.data(), m_unx.data(), m_uny.data(), m_unz.data(),
+                      QM.data(), QP.data(), Nrf, m_ulam.data(), flux.data(), Nrf);
 
-  lambda.reshape(Nfp, Nfaces*K);
-  lambda = outer(ones(Nfp), lambda.max_col_vals());
-  lambda.reshape(Nfp*Nfaces, K);
+    for (n=1; n<=5; ++n) {
+      nflux.borrow(Nfp*Nfaces, K, flux.pCol(n));
+      rhsQ(All,n) -= LIFT*(Fscale.dm(nflux));
+    }
 
-  // 2.5 Lift fluxes
-  for (n=1; n<=5; ++n) {
-    nflux = 
-        nx.dm(fP(All,n) + fM(All,n)) + 
-        ny.dm(gP(All,n) + gM(All,n)) + 
-        nz.dm(hP(All,n) + hM(All,n)) + 
-        lambda.dm(QM(All,n) - QP(All,n));
+    time_rhs += (timer.read() - trhs);
+    return;
+  }
 
-    rhsQ(All,n) -= 0.5*LIFT*(Fscale.dm(nflux));
+  // 2.3-2.4 local Lax-Friedrichs/Rusonov numerical fluxes,
+  //         node by node (EulerFlux_funcs.h), with the
+  //         largest |u|+c on each face as wave speed
+  int Nrf = QM.num_rows();
+  umEulerSpeed(3, gamma, Nrf, Nfp, QM.data(), QP.data(), Nrf, lambda.data());
+  umEulerFlux(FT_LaxF, 3, gamma, Nrf, nx.data(), ny.data(), nz.data(), 1,
+              QM.data(), QP.data(), Nrf, lambda.data(), flux.data(), Nrf);
+
+  // 2.5 Lift fluxes (flux includes the factor 1/2)
+  for (n=1; n<=5; ++n) {
+    nflux.borrow(Nfp*Nfaces, K, flux.pCol(n));
+    rhsQ(All,n) -= LIFT*(Fscale.dm(nflux));
   }
 
   time_rhs += (timer.read() - trhs);
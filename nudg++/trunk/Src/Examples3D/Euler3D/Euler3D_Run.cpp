@@ -50,6 +50,8 @@ void Euler3D::Run()
   if (m_bApplyFilter) { for(n=1;n<=5;++n) {Qn.borrow(Np,K, Q.pCol(n)); Q(All,n)=m_Filter*Qn;}}
 
 
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   //--------------------------------------------------
   // outer time step loop 
   //--------------------------------------------------
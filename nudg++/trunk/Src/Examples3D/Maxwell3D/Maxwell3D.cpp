@@ -11,6 +11,12 @@ Maxwell3D::Maxwell3D()
 //---------------------------------------------------------
 {
   class_name = "Maxwell3D-TM";
+
+  const char* s = getenv("NDG_RHS");
+  m_bFusedRHS = (s && !strcmp(s, "fused"));
+  m_tileK = 0;  m_nthreads = 1;
+  m_flopsRHS = m_bytesRHS = time_fused = 0.0;
+  Ncalls_fused = 0;
 }
 
 
@@ -114,6 +120,10 @@ void Maxwell3D::Summary()
 //---------------------------------------------------------
 {
   NDG3D::Summary();
+
+  if (m_bFusedRHS) {
+    umLOG(1, "  RHS         = fused\n\n");
+  }
 }
 
 
@@ -194,4 +204,15 @@ void Maxwell3D::FinalReport()
   umLOG(1, "\n time for NDG work  : %12.2lf secs\n", time_work);
   umLOG(1,   " time for RHS       : %12.2lf secs\n", time_rhs);
   umLOG(1,   " time for main loop : %12.2lf secs\n\n", time_total);
+
+  if (Ncalls_fused > 0 && time_fused > 0.0) {
+    double nc = (double)Ncalls_fused;
+    umLOG(1, " fused RHS (%d calls, %d threads):\n", Ncalls_fused, m_nthreads);
+    umLOG(1, "   sec per call : %12.3e\n", time_fused/nc);
+    umLOG(1, "   GFLOP/s      : %12.2lf\n", 1e-9*m_flopsRHS*nc/time_fused);
+    umLOG(1, "   GB/s         : %12.2lf\n\n", 1e-9*m_bytesRHS*nc/time_fused);
+  }
+
+  // array memory, by name and phase (if NDG_MEMPROF is set)
+  umMemProfile::report(this->GetClassName());
 }
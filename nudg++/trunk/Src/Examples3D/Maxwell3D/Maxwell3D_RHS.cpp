@@ -5,6 +5,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "Maxwell3D.h"
+#include "MaxwellFlux_funcs.h"
 
 //---------------------------------------------------------
 void Maxwell3D::RHS()
@@ -14,14 +15,19 @@ void Maxwell3D::RHS()
   //                          MaxwellRHS3D(Hx,Hy,Hz,Ex,Ey,Ez)
   // Purpose  : Evaluate RHS flux in 3D Maxwell equations
 
+  if (m_bFusedRHS) { RHS_fused(); return; }
+
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
   //---------------------------
   double t1 = timer.read();
   //---------------------------
 
-  // form field differences at faces
-  dHx = Hx(vmapP)-Hx(vmapM);  dEx = Ex(vmapP)-Ex(vmapM);	
-  dHy = Hy(vmapP)-Hy(vmapM); 	dEy = Ey(vmapP)-Ey(vmapM);	
-  dHz = Hz(vmapP)-Hz(vmapM);  dEz = Ez(vmapP)-Ez(vmapM);  
+  // form field differences at faces:
+  // dHx = Hx(vmapP)-Hx(vmapM), etc. (one pass for all fields)
+  const DVec* U[6] = { &Hx,  &Hy,  &Hz,  &Ex,  &Ey,  &Ez};
+  DVec*      dU[6] = {&dHx, &dHy, &dHz, &dEx, &dEy, &dEz};
+  trace_jump(6, U, vmapP,vmapM, dU);
 
   // make boundary conditions all reflective (Ez+ = -Ez-)
   dHx(mapB) = 0.0;  dEx(mapB) = -2.0*Ex(vmapB); 
@@ -30,29 +36,44 @@ void Maxwell3D::RHS()
 
   alpha=1.0; // => full upwinding
 
-  ndotdH = nx.dm(dHx) + ny.dm(dHy) + nz.dm(dHz);
-  ndotdE = nx.dm(dEx) + ny.dm(dEy) + nz.dm(dEz);
-
-  fluxHx = -ny.dm(dEz) + nz.dm(dEy) + alpha*(dHx - ndotdH.dm(nx)); 
-  fluxHy = -nz.dm(dEx) + nx.dm(dEz) + alpha*(dHy - ndotdH.dm(ny)); 
-  fluxHz = -nx.dm(dEy) + ny.dm(dEx) + alpha*(dHz - ndotdH.dm(nz)); 
-
-  fluxEx =  ny.dm(dHz) - nz.dm(dHy) + alpha*(dEx - ndotdE.dm(nx)); 
-  fluxEy =  nz.dm(dHx) - nx.dm(dHz) + alpha*(dEy - ndotdE.dm(ny)); 
-  fluxEz =  nx.dm(dHy) - ny.dm(dHx) + alpha*(dEz - ndotdE.dm(nz)); 
+  // evaluate upwind fluxes, scaled by Fscale/2, node by
+  // node (MaxwellFlux_funcs.h).  Face data is nodal, or one
+  // set of {nx,ny,nz,Fscale} per planar face if compressed
+  // (CompressFace3D)
+  int Nr = Nfp*Nfaces;
+  fluxHx.resize(Nr,K,false); fluxHy.resize(Nr,K,false); fluxHz.resize(Nr,K,false);
+  fluxEx.resize(Nr,K,false); fluxEy.resize(Nr,K,false); fluxEz.resize(Nr,K,false);
+  const double *dQ[6] = {dHx.data(), dHy.data(), dHz.data(), dEx.data(), dEy.data(), dEz.data()};
+  double *fQ[6] = {fluxHx.data(), fluxHy.data(), fluxHz.data(), fluxEx.data(), fluxEy.data(), fluxEz.data()};
+  for (int fc=1; fc<=Nfaces*K; ++fc) {
+    const int n0=(fc-1)*Nfp;  int gs=0, inc=1;
+    const double *gnx=nx.data()+n0, *gny=ny.data()+n0, *gnz=nz.data()+n0, *gfs=Fscale.data()+n0;
+    if (m_bAffineGeo) {
+      const double *g = face_geo(fc, gs, inc);
+      gnx = g;  gny = g+gs;  gnz = g+2*gs;  gfs = g+4*gs;
+    }
+    for (int i=0, n=n0; i<Nfp; ++i, ++n) {
+      const double dH[3] = {dQ[0][n], dQ[1][n], dQ[2][n]};
+      const double dE[3] = {dQ[3][n], dQ[4][n], dQ[5][n]};
+      double fH[3], fE[3];
+      umMaxwell3D_Flux(gnx[i*inc], gny[i*inc], gnz[i*inc], gfs[i*inc], alpha, dH, dE, fH, fE);
+      fQ[0][n] = fH[0];  fQ[1][n] = fH[1];  fQ[2][n] = fH[2];
+      fQ[3][n] = fE[0];  fQ[4][n] = fE[1];  fQ[5][n] = fE[2];
+    }
+  }
 
   // evaluate local spatial derivatives
   Curl3D(Hx,Hy,Hz,  curlHx,curlHy,curlHz);
   Curl3D(Ex,Ey,Ez,  curlEx,curlEy,curlEz);
 
   // calculate Maxwell's right hand side
-  rhsHx = -curlEx + LIFT*(Fscale.dm(fluxHx)/2.0);
-  rhsHy = -curlEy + LIFT*(Fscale.dm(fluxHy)/2.0);
-  rhsHz = -curlEz + LIFT*(Fscale.dm(fluxHz)/2.0);
+  rhsHx = -curlEx + LIFT*fluxHx;
+  rhsHy = -curlEy + LIFT*fluxHy;
+  rhsHz = -curlEz + LIFT*fluxHz;
 
-  rhsEx =  curlHx + LIFT*(Fscale.dm(fluxEx)/2.0);
-  rhsEy =  curlHy + LIFT*(Fscale.dm(fluxEy)/2.0);
-  rhsEz =  curlHz + LIFT*(Fscale.dm(fluxEz)/2.0);
+  rhsEx =  curlHx + LIFT*fluxEx;
+  rhsEy =  curlHy + LIFT*fluxEy;
+  rhsEz =  curlHz + LIFT*fluxEz;
 
   //---------------------------
   time_rhs += timer.read() - t1;
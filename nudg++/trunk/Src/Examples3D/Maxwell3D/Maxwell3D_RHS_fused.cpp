@@ -0,0 +1,210 @@
+// Maxwell3D_RHS_fused.cpp
+// element-local, threaded evaluation of the Maxwell3D RHS
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "Maxwell3D.h"
+#include "SmallMat_funcs.h"
+#include "SIMD_funcs.h"
+#include "MaxwellFlux_funcs.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+//---------------------------------------------------------
+static void tile_AxB(const DMat& A, int nc, const double* B, int ldb, double* C, int ldc)
+//---------------------------------------------------------
+{
+  // C = A*B for nc columns: order-specialized kernel if
+  // one is registered (see SmallMat_funcs.h), else GEMM
+  int M=A.num_rows(), Kc=A.num_cols();
+  umSmallMat_fn fn = umSmallMat_find(M,Kc);
+  if (fn) { fn(nc, 1.0,A.data(), B,ldb, 0.0,C,ldc); }
+  else    { GEMM('N','N',M,nc,Kc, 1.0,A.data(),M, B,ldb, 0.0,C,ldc); }
+}
+
+
+//---------------------------------------------------------
+void Maxwell3D::InitFusedRHS()
+//---------------------------------------------------------
+{
+  int Nfq = Nfp*Nfaces;
+
+  // boundary flags at face nodes
+  m_bdry.resize(Nfq*K, true, 0);
+  for (int i=1; i<=mapB.size(); ++i) { m_bdry(mapB(i)) = 1; }
+
+  // stacked derivative operator [Dr;Ds;Dt], (3*Np,Np)
+  Drst.resize(3*Np, Np);
+  for (int j=1; j<=Np; ++j) {
+    for (int i=1; i<=Np; ++i) {
+      Drst(i,j) = Dr(i,j);  Drst(Np+i,j) = Ds(i,j);  Drst(2*Np+i,j) = Dt(i,j);
+    }
+  }
+
+  // scratch per element and field: 3 derivatives and the
+  // lift (Np each) and the flux (Nfq).  A tile also reads
+  // its fields, metric and neighbor traces and writes its
+  // rhs (21*Np + 6*Nfq doubles).  Tiles are sized so that
+  // this, with Drst and LIFT, fills about a quarter of the
+  // L2 cache of a thread: a few elements at high order.
+  int per_elmt = 8*(6*(4*Np + Nfq) + 21*Np + 6*Nfq);
+  int ops = 8*(3*Np*Np + Np*Nfq);
+  m_tileK = std::max(1, std::min(K, (umCache_L2()/4 - ops)/per_elmt));
+
+#ifdef _OPENMP
+  m_nthreads = omp_get_max_threads();
+#else
+  m_nthreads = 1;
+#endif
+  // one block of 6*tileK columns per thread; columns are
+  // padded so that each starts aligned (resize_padded)
+  int nc = 6*m_tileK*m_nthreads;
+  m_tileD.resize_padded(3*Np, nc);
+  m_tileF.resize_padded(Nfq,  nc);
+  m_tileL.resize_padded(Np,   nc);
+
+  rhsHx.resize(Np,K);  rhsHy.resize(Np,K);  rhsHz.resize(Np,K);
+  rhsEx.resize(Np,K);  rhsEy.resize(Np,K);  rhsEz.resize(Np,K);
+
+  // work per call, for the GFLOP/s and GB/s report:
+  // flops of the two GEMMs, the fluxes (70 per face node)
+  // and the curls (72 per node); bytes of fields, metric
+  // and rhs (21 per node), of neighbor traces (6 per
+  // face node), of face data (4 per face node, or per
+  // face if compressed) and of vmapM/vmapP
+  double Kd = double(K), Nfd = m_bAffineGeo ? double(Nfaces) : double(Nfq);
+  m_flopsRHS = Kd * (2.0*6.0*(3.0*Np*Np + double(Np)*Nfq) + 70.0*Nfq + 72.0*Np);
+  m_bytesRHS = Kd * (8.0*(21.0*Np + 6.0*Nfq + 4.0*Nfd) + 2.0*sizeof(int)*Nfq);
+}
+
+
+//---------------------------------------------------------
+void Maxwell3D::RHS_fused()
+//---------------------------------------------------------
+{
+  // Same result as RHS(), by tiles of elements, with the
+  // tiles shared among OpenMP threads.  For each tile:
+  // the products [Dr;Ds;Dt]*Hx, ..., [Dr;Ds;Dt]*Ez, read
+  // from the field arrays, the fluxes at its face nodes,
+  // one LIFT product of the stacked fluxes, then the curls
+  // and the rhs.  Each step follows the arithmetic of
+  // RHS(), so results are identical.
+
+  umMemPhaseScope mem_phase(umMEM_RHS);
+
+  //---------------------------
+  double t1 = timer.read();
+  //---------------------------
+
+  if (m_bdry.size() != Nfp*Nfaces*K) { InitFusedRHS(); }
+  alpha = 1.0;  // => full upwinding
+
+  const int Nfq=Nfp*Nfaces, nt0=m_tileK, Ntiles=(K+nt0-1)/nt0;
+  const double al = alpha;
+  const int *mM=vmapM.data(), *mP=vmapP.data(), *bc=m_bdry.data();
+  const double *Q[6] = {Hx.data(), Hy.data(), Hz.data(), Ex.data(), Ey.data(), Ez.data()};
+  double       *R[6] = {rhsHx.data(), rhsHy.data(), rhsHz.data(), rhsEx.data(), rhsEy.data(), rhsEz.data()};
+  const double *pnx=nx.data(), *pny=ny.data(), *pnz=nz.data(), *pfs=Fscale.data();
+  const double *prx=rx.data(), *pry=ry.data(), *prz=rz.data();
+  const double *psx=sx.data(), *psy=sy.data(), *psz=sz.data();
+  const double *ptx=tx.data(), *pty=ty.data(), *ptz=tz.data();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int b=0; b<Ntiles; ++b) {
+#ifdef _OPENMP
+    const int c0 = 1 + 6*nt0*omp_get_thread_num();
+#else
+    const int c0 = 1;
+#endif
+    const int k0=b*nt0, nt=std::min(nt0, K-k0);
+    const int o=k0*Np, of=k0*Nfq, nc=6*nt;
+
+    // scratch of this thread, columns ordered (field, element):
+    // D (3*Np,nc), F (Nfq,nc), L (Np,nc), columns ldD.. apart
+    double *D=m_tileD.pCol(c0), *F=m_tileF.pCol(c0), *L=m_tileL.pCol(c0);
+    const int ldD=m_tileD.ld(), ldF=m_tileF.ld(), ldL=m_tileL.ld();
+
+    //-------------------------------------
+    // derivatives of each field, read in place
+    //-------------------------------------
+    for (int f=0; f<6; ++f) { tile_AxB(Drst, nt, Q[f]+o, Np, D+f*nt*ldD, ldD); }
+
+    //-------------------------------------
+    // traces and upwind fluxes, scaled by Fscale/2
+    //-------------------------------------
+    double *fHx=F, *fHy=F+nt*ldF, *fHz=F+2*nt*ldF, *fEx=F+3*nt*ldF, *fEy=F+4*nt*ldF, *fEz=F+5*nt*ldF;
+    for (int fi=0; fi<nt*Nfaces; ++fi) {
+      // face normals and Fscale: nodal, or one value per
+      // planar face if compressed (CompressFace3D)
+      const int n0=of+fi*Nfp;  int gs=0, inc=1;
+      const double *gnx=pnx+n0, *gny=pny+n0, *gnz=pnz+n0, *gfs=pfs+n0;
+      if (m_bAffineGeo) {
+        const double *g = face_geo(n0/Nfp + 1, gs, inc);
+        gnx = g;  gny = g+gs;  gnz = g+2*gs;  gfs = g+4*gs;
+      }
+      const int i0=(fi/Nfaces)*ldF + (fi%Nfaces)*Nfp;
+      for (int j=0; j<Nfp; ++j) {
+        const int i=i0+j, n=n0+j, a=mM[n]-1, p=mP[n]-1;
+        double dH[3], dE[3], fH[3], fE[3];
+        if (bc[n]) {
+          // reflective boundary: E+ = -E-
+          dH[0] = 0.0;  dH[1] = 0.0;  dH[2] = 0.0;
+          dE[0] = -2.0*Q[3][a];  dE[1] = -2.0*Q[4][a];  dE[2] = -2.0*Q[5][a];
+        } else {
+          dH[0] = Q[0][p]-Q[0][a];  dH[1] = Q[1][p]-Q[1][a];  dH[2] = Q[2][p]-Q[2][a];
+          dE[0] = Q[3][p]-Q[3][a];  dE[1] = Q[4][p]-Q[4][a];  dE[2] = Q[5][p]-Q[5][a];
+        }
+        umMaxwell3D_Flux(gnx[j*inc], gny[j*inc], gnz[j*inc], gfs[j*inc], al, dH, dE, fH, fE);
+        fHx[i] = fH[0];  fHy[i] = fH[1];  fHz[i] = fH[2];
+        fEx[i] = fE[0];  fEy[i] = fE[1];  fEz[i] = fE[2];
+      }
+    }
+
+    //-------------------------------------
+    // lift of the 6 stacked fluxes
+    //-------------------------------------
+    tile_AxB(LIFT, nc, F, ldF, L, ldL);
+
+    //-------------------------------------
+    // curls (as in Curl3D) and right hand sides
+    //-------------------------------------
+    for (int e=0; e<nt; ++e) {
+      const double *d[6], *l[6];
+      for (int f=0; f<6; ++f) { d[f] = D + (f*nt+e)*ldD;  l[f] = L + (f*nt+e)*ldL; }
+      const int oe = o + e*Np;
+
+      for (int i=0; i<Np; ++i) {
+        const int n=oe+i;
+        const double rxn=prx[n], ryn=pry[n], rzn=prz[n];
+        const double sxn=psx[n], syn=psy[n], szn=psz[n];
+        const double txn=ptx[n], tyn=pty[n], tzn=ptz[n];
+        double c[6];    // curl H, curl E
+        for (int g=0; g<2; ++g) {
+          const double *dX=d[3*g], *dY=d[3*g+1], *dZ=d[3*g+2];
+          const double rX=dX[i], sX=dX[Np+i], tX=dX[2*Np+i];
+          const double rY=dY[i], sY=dY[Np+i], tY=dY[2*Np+i];
+          const double rZ=dZ[i], sZ=dZ[Np+i], tZ=dZ[2*Np+i];
+          c[3*g  ] = -(rzn*rY + szn*sY + tzn*tY) + (ryn*rZ + syn*sZ + tyn*tZ);
+          c[3*g+1] =  (rzn*rX + szn*sX + tzn*tX) - (rxn*rZ + sxn*sZ + txn*tZ);
+          c[3*g+2] = -(ryn*rX + syn*sX + tyn*tX) + (rxn*rY + sxn*sY + txn*tY);
+        }
+        R[0][n] = -c[3] + l[0][i];
+        R[1][n] = -c[4] + l[1][i];
+        R[2][n] = -c[5] + l[2][i];
+        R[3][n] =  c[0] + l[3][i];
+        R[4][n] =  c[1] + l[4][i];
+        R[5][n] =  c[2] + l[5][i];
+      }
+    }
+  }
+
+  //---------------------------
+  double dt_rhs = timer.read() - t1;
+  time_rhs += dt_rhs;  time_fused += dt_rhs;  ++Ncalls_fused;
+  //---------------------------
+}
@@ -31,6 +31,8 @@ void Maxwell3D::Run()
   Sample3D(1.25, 0.0, 0.25, sampleweights, sampletet);
 
 
+  umMemProfile::set_phase(umMEM_STEP);  // setup done (memory profile)
+
   // outer time step loop 
   while (time<FinalTime)
   {
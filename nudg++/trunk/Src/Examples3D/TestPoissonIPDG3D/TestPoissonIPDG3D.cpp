@@ -109,8 +109,9 @@ void TestPoissonIPDG3D::Run()
     // drop tolerance for cholinc
     double droptol=1e-4;
 
-    // Note: ownership of A is transfered to solver object
-    it_sol.cholinc(A, droptol);
+    // Note: ownership of A is transfered to solver object,
+    // which applies it as dense (Np,Np) blocks (BSd)
+    it_sol.cholinc(A, droptol, Np);
 
   } catch(...) {
     umLOG(1, "\nCaught exception from symbolic chol.\n");
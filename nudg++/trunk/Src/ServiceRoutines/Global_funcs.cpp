@@ -18,6 +18,7 @@ void NDG_garbage_collect()
 {
   DVec dv; dv.compact();  umTRC(2, "*** compacted <double> *** \n");
   IVec iv; iv.compact();  umTRC(2, "*** compacted <int>    *** \n");
+  umFrameArena::local().release();  // (if no umFrame is open)
 }
 
 
@@ -175,7 +175,7 @@ void umTRC(const std::string& msg, int n)
 
 
 //---------------------------------------------------------
-void umWARNING (char* function_name, ...)
+void umWARNING (const char* function_name, ...)
 //---------------------------------------------------------
 {
   // only g_nMax_Warnings warnings are allowed:
@@ -189,9 +189,9 @@ void umWARNING (char* function_name, ...)
     return;
 
   va_list ap;
-  char* fmt;
+  const char* fmt;
   va_start(ap, function_name);
-  fmt = va_arg(ap, char*);
+  fmt = va_arg(ap, const char*);
   vsprintf(buf, fmt, ap);
   va_end(ap);
 
@@ -206,14 +206,14 @@ void umWARNING (char* function_name, ...)
 
 
 //---------------------------------------------------------
-void umERROR (char* function_name, ...)
+void umERROR (const char* function_name, ...)
 //---------------------------------------------------------
 {
   static char buf[2048];
   va_list ap;
-  char* fmt;
+  const char* fmt;
   va_start(ap, function_name);
-  fmt = va_arg(ap, char*);
+  fmt = va_arg(ap, const char*);
   vsprintf(buf, fmt, ap);
   va_end(ap);
 
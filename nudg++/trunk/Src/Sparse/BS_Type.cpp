@@ -0,0 +1,212 @@
+// BS_Type.cpp
+// block sparse matrix of dense (b,b) blocks, for DG
+// operators made of element blocks
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "BS_Type.h"
+#include "SmallMat_funcs.h"
+
+#include <algorithm>
+
+
+//---------------------------------------------------------
+BSd::BSd(const char* sz)
+//---------------------------------------------------------
+  : P("P"), I("I"), X("X"), m_Nb(0), m_b(0), m_shape(sp_NONE), m_name(sz)
+{
+  P.set_name((m_name+".P").c_str());
+  I.set_name((m_name+".I").c_str());
+  X.set_name((m_name+".X").c_str());
+}
+
+
+//---------------------------------------------------------
+void BSd::resize(int Nb, int b, int nnzb)
+//---------------------------------------------------------
+{
+  m_Nb = Nb;  m_b = b;
+  P.resize(Nb+1);  P.fill(0);
+  I.resize(std::max(nnzb,1));
+  X.resize(std::max(nnzb,1)*b*b);  X.fill(0.0);
+}
+
+
+//---------------------------------------------------------
+void BSd::reset()
+//---------------------------------------------------------
+{
+  P.Free();  I.Free();  X.Free();
+  m_Nb = m_b = 0;  m_shape = sp_NONE;
+}
+
+
+//---------------------------------------------------------
+void BSd::load(const CSd& A, int b)
+//---------------------------------------------------------
+{
+  if (!A.ok() || !A.is_csc() || !A.is_square()) {
+    umERROR("BSd::load", "expected a square csc matrix");  return;
+  }
+  if (b<1 || A.n % b) {
+    umERROR("BSd::load", "order %d is not a multiple of %d", A.n, b);  return;
+  }
+
+  int Nb = A.n/b, bb = b*b, kc=0, j=0, p=0, q=0, nb=0;
+  IVec w(Nb), rows(Nb);  w.fill(-1);
+
+  // block rows of each block column: count, then fill
+  IVec cnt(Nb+1);  cnt.fill(0);
+  for (kc=0; kc<Nb; ++kc) {
+    for (j=kc*b; j<(kc+1)*b; ++j) {
+      for (p=A.P[j]; p<A.P[j+1]; ++p) {
+        int kr = A.I[p]/b;
+        if (w[kr] != kc) { w[kr] = kc;  ++cnt[kc+1]; }
+      }
+    }
+  }
+  for (kc=0; kc<Nb; ++kc) { cnt[kc+1] += cnt[kc]; }
+
+  this->resize(Nb, b, cnt[Nb]);
+  m_shape = A.get_shape();
+  for (kc=0; kc<=Nb; ++kc) { P[kc] = cnt[kc]; }
+
+  w.fill(-1);
+  for (kc=0; kc<Nb; ++kc) {
+    nb = 0;
+    for (j=kc*b; j<(kc+1)*b; ++j) {
+      for (p=A.P[j]; p<A.P[j+1]; ++p) {
+        int kr = A.I[p]/b;
+        if (w[kr] < P[kc]) { w[kr] = P[kc];  rows[nb++] = kr; }
+      }
+    }
+    std::sort(rows.data(), rows.data()+nb);
+    for (q=0; q<nb; ++q) { I[P[kc]+q] = rows[q];  w[rows[q]] = P[kc]+q; }
+
+    // copy the entries into their blocks
+    for (j=kc*b; j<(kc+1)*b; ++j) {
+      for (p=A.P[j]; p<A.P[j+1]; ++p) {
+        int i = A.I[p], kr = i/b;
+        X[w[kr]*bb + (i-kr*b) + (j-kc*b)*b] += A.X[p];
+      }
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+void BSd::to_CS(CSd& A) const
+//---------------------------------------------------------
+{
+  // columns keep the block order, rows ascending in each
+  // block; entries that are 0 are dropped
+  int n=num_rows(), b=m_b, bb=b*b, nz=0, kc=0, jj=0, i=0, p=0, q=0;
+  for (p=0; p<nnzb()*bb; ++p) { if (0.0 != X[p]) { ++nz; } }
+
+  A.resize(n, n, nz, 1, 0);
+  A.set_shape(m_shape);
+  for (kc=0; kc<m_Nb; ++kc) {
+    for (jj=0; jj<b; ++jj) {
+      int col = kc*b+jj;  A.P[col] = q;
+      for (p=P[kc]; p<P[kc+1]; ++p) {
+        const double* x = X.data() + p*bb + jj*b;
+        for (i=0; i<b; ++i) {
+          if (0.0 != x[i]) { A.I[q] = I[p]*b+i;  A.X[q++] = x[i]; }
+        }
+      }
+    }
+  }
+  A.P[n] = q;
+}
+
+
+//---------------------------------------------------------
+void BSd::gaxpy(const DVec& x, DVec& y) const
+//---------------------------------------------------------
+{
+  // y += A*x
+
+  assert(ok() && x.ok() && y.ok());
+  assert(num_rows()==y.size() && num_cols()==x.size());
+  this->gaxpy(1, x.data(), x.size(), y.data(), y.size());
+}
+
+
+//---------------------------------------------------------
+void BSd::gaxpy(int nrhs, const double* pX, int ldx, double* pY, int ldy) const
+//---------------------------------------------------------
+{
+  // Y += A*X.  Block p of block column kc adds B*X(kc,:)
+  // to Y(kr,:); if only tril(A) of a symmetric A is
+  // stored, it also adds B'*X(kr,:) to Y(kc,:), with the
+  // diagonal of a diagonal block counted once.
+
+  int b=m_b, bb=b*b, kc=0, kr=0, p=0, i=0, l=0, r=0;
+  bool bSym = is_sym();
+  umSmallMat_fn fn = umSmallMat_find(b, b);
+  const double* pA = X.data();
+
+  for (kc=0; kc<m_Nb; ++kc) {
+    const double* xc = pX + kc*b;
+    double*       yc = pY + kc*b;
+    for (p=P[kc]; p<P[kc+1]; ++p) {
+      kr = I[p];
+      const double* B  = pA + p*bb;
+      const double* xr = pX + kr*b;
+      double*       yr = pY + kr*b;
+
+      if (fn) {
+        fn(nrhs, 1.0, B, xc, ldx, 1.0, yr, ldy);
+      } else {
+        for (r=0; r<nrhs; ++r) {
+          for (l=0; l<b; ++l) {
+            double xl = xc[l+r*ldx];  const double* a = B + l*b;
+            for (i=0; i<b; ++i) { yr[i+r*ldy] += a[i]*xl; }
+          }
+        }
+      }
+
+      if (bSym) {
+        int i0 = 0;
+        for (r=0; r<nrhs; ++r) {
+          for (l=0; l<b; ++l) {
+            const double* a = B + l*b;  double s = 0.0;
+            i0 = (kr==kc) ? l+1 : 0;    // strictly lower part
+            for (i=i0; i<b; ++i) { s += a[i]*xr[i+r*ldx]; }
+            yc[l+r*ldy] += s;
+          }
+        }
+      }
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+DVec& operator*(const BSd& A, const DVec& x)
+//---------------------------------------------------------
+{
+  // y = A*x
+
+  assert(x.size() == A.num_cols());
+  DVec *y = new DVec(A.num_rows(), 0.0, OBJ_temp, "BS*v");
+  A.gaxpy(x, (*y));
+  if (x.get_mode()==OBJ_temp) { delete (&x); }
+  return (*y);
+}
+
+
+//---------------------------------------------------------
+DMat& operator*(const BSd& A, const DMat& X)
+//---------------------------------------------------------
+{
+  // Y = A*X ... block sparse * dense
+
+  assert(X.num_rows() == A.num_cols());
+  int Nr=A.num_rows(), Nc=X.num_cols();
+  DMat *Y = new DMat(Nr, Nc, "BS*X", OBJ_temp);
+  Y->fill(0.0);
+  A.gaxpy(Nc, X.data(), X.num_rows(), Y->data(), Nr);
+  if (X.get_mode()==OBJ_temp) { delete (&X); }
+  return (*Y);
+}
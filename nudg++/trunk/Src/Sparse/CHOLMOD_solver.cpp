@@ -26,10 +26,62 @@ static void CHOLMOD_ehandler(int status, char *file, int line, char *message)
 }
 
 
+//---------------------------------------------------------
+CHOLMOD_symbolic::CHOLMOD_symbolic()
+//---------------------------------------------------------
+  : Ls(NULL), refs(1)
+{
+  cholmod_start(&cm);
+  cm.error_handler = CHOLMOD_ehandler;
+}
+
+
+//---------------------------------------------------------
+CHOLMOD_symbolic::~CHOLMOD_symbolic()
+//---------------------------------------------------------
+{
+  cholmod_free_factor(&Ls, &cm);
+  cholmod_finish(&cm);
+}
+
+
+//---------------------------------------------------------
+bool CHOLMOD_symbolic::analyze(cholmod_sparse* A, const CSd& mat)
+//---------------------------------------------------------
+{
+  // ordering and symbolic factor of A, allocated in cm;
+  // mat is the CSd that A was loaded from
+  double t1 = chol_timer.read(), ta=0.0;
+  cholmod_free_factor(&Ls, &cm);
+  Ls = cholmod_analyze(A, &cm);
+  ta = chol_timer.read() - t1;
+  if (!Ls) { return false; }
+  umMSG(1, "Analyze: flop %g lnz %g time %g\n", cm.fl, cm.lnz, ta);
+
+  P.copy(mat.n+1, mat.P.data());
+  I.copy(mat.P[mat.n], mat.I.data());
+  return true;
+}
+
+
+//---------------------------------------------------------
+bool CHOLMOD_symbolic::matches(const CSd& mat) const
+//---------------------------------------------------------
+{
+  // was Ls built for the pattern of mat?
+  if (!Ls || !mat.is_csc()) { return false; }
+  int n=mat.n;
+  if (P.size() != n+1 || P[n] != mat.P[n]) { return false; }
+  for (int j=0; j<=n; ++j) { if (P[j] != mat.P[j]) { return false; } }
+  for (int p=0; p<P[n]; ++p) { if (I[p] != mat.I[p]) { return false; } }
+  return true;
+}
+
+
 //---------------------------------------------------------
 CHOLMOD_solver::CHOLMOD_solver()
 //---------------------------------------------------------
-  : initialized(false), drop_tol(0.0),
+  : m_sym(NULL), initialized(false), drop_tol(0.0),
     m_status(0), m_NNZ(0), m_M(0), m_N(0),
     A(NULL), L(NULL), x(NULL), b(NULL)
 {
@@ -44,7 +96,7 @@ CHOLMOD_solver::CHOLMOD_solver
   double droptol      // optional droptol
 )
 //---------------------------------------------------------
-  : initialized(false), drop_tol(0.0),
+  : m_sym(NULL), initialized(false), drop_tol(0.0),
     m_status(0), m_NNZ(0), m_M(0), m_N(0),
     A(NULL), L(NULL), x(NULL), b(NULL)
 {
@@ -57,10 +109,42 @@ CHOLMOD_solver::CHOLMOD_solver
 CHOLMOD_solver::~CHOLMOD_solver()
 //---------------------------------------------------------
 {
+  release_symbolic();
   reset();
 }
 
 
+//---------------------------------------------------------
+void CHOLMOD_solver::release_symbolic()
+//---------------------------------------------------------
+{
+  // drop this solver's reference to the analysis
+  // (the last one frees it, in its own Common)
+  if (m_sym && (--m_sym->refs < 1)) {
+    delete m_sym;
+  }
+  m_sym = NULL;
+}
+
+
+//---------------------------------------------------------
+void CHOLMOD_solver::share_symbolic(const CHOLMOD_solver& B)
+//---------------------------------------------------------
+{
+  if (&B == this || !B.m_sym || B.m_sym == m_sym) { return; }
+  release_symbolic();
+  m_sym = B.m_sym;  ++m_sym->refs;
+}
+
+
+//---------------------------------------------------------
+bool CHOLMOD_solver::is_analyzed(const CSd& mat) const
+//---------------------------------------------------------
+{
+  return (m_sym && m_sym->matches(mat));
+}
+
+
 //---------------------------------------------------------
 void CHOLMOD_solver::reset()
 //---------------------------------------------------------
@@ -71,10 +155,7 @@ void CHOLMOD_solver::reset()
   cholmod_free_factor(&L, cm);      // free matrices
   cholmod_free_sparse(&A, cm);
   cholmod_free_dense (&x, cm);
-#if (0)
-  // Note: b points into the allocation for B, so do NOT free!
-  //cholmod_free_dense (&b, cm);
-#endif
+  cholmod_free_dense (&b, cm);      // b only borrows B during solve()
 
   cholmod_finish(cm);               // clear workspace
   L=NULL; A=NULL; x=NULL; b=NULL;   // invalidate pointers
@@ -100,30 +181,76 @@ void CHOLMOD_solver::chol(const CSd& mat, int dummy, double droptol)
 //---------------------------------------------------------
 {
 
+  // check that matrix arg is valid 
+  if (!mat.ok()) { umERROR("CHOLMOD_solver(CSd&)", "matrix arg is empty"); return; }
+
+  // analyze, unless this pattern (or a shared one)
+  // is analyzed already
+  if (!is_analyzed(mat)) {
+    if (!analyze(mat)) { return; }
+  }
+
+  // factorize
+  factorize_numeric(mat);
+}
+
+
+//---------------------------------------------------------
+bool CHOLMOD_solver::analyze(const CSd& mat)
+//---------------------------------------------------------
+{
+  // ordering and symbolic analysis for the pattern of mat.
+  // The analysis has its own Common, so this solver can 
+  // drop its reference (and later reset its own Common)
+  // while other solvers still use it.
+
   if (initialized) {
+    release_symbolic();
     reset();          // clear previous system
     init_common();    // reset common defaults
   }
 
-  // check that matrix arg is valid 
-  if (!mat.ok()) { umERROR("CHOLMOD_solver(CSd&)", "matrix arg is empty"); return; }
+  if (!load(mat)) { return false; }
 
-  // load CSd into CHOLMOD structures
-  load(mat);
+  CHOLMOD_symbolic* S = new CHOLMOD_symbolic;
+  if (!S->analyze(this->A, mat)) {
+    delete S;
+    umERROR("CHOLMOD_solver::analyze", "cholmod_analyze failed"); 
+    return false;
+  }
 
-  // analyze
-  double t1 = chol_timer.read(), ta=0.0, tf=0.0;
-  this->L = cholmod_analyze(this->A, this->cm);
-  ta = chol_timer.read() - t1;
-  umMSG(1, "Analyze: flop %g lnz %g time %g\n", cm->fl, cm->lnz, ta);
+  release_symbolic();
+  m_sym = S;
+  return true;
+}
 
-  // factorize
-  t1 = chol_timer.read();
+
+//---------------------------------------------------------
+bool CHOLMOD_solver::factorize_numeric(const CSd& mat)
+//---------------------------------------------------------
+{
+  // numeric factorization of mat, using the analysis 
+  // of its pattern
+
+  if (!is_analyzed(mat)) {
+    umERROR("CHOLMOD_solver::factorize_numeric", "pattern of mat has not been analyzed"); 
+    return false;
+  }
+
+  // load the values; start from a copy of the symbolic
+  // factor (it may be shared, and L may be supernodal).
+  // The copy is allocated, and later freed, in this->cm.
+  if (!load(mat)) { return false; }
+  cholmod_free_factor(&L, cm);
+  this->L = cholmod_copy_factor(m_sym->Ls, this->cm);
+
+  double t1 = chol_timer.read(), tf=0.0;
   cholmod_factorize(this->A, this->L, this->cm);
   tf = chol_timer.read() - t1;
   umMSG(1, "Factor : flop %g lnz %g time %g\n", cm->fl, cm->lnz, tf);
 
   initialized = true;
+  return true;
 }
 
 
@@ -136,9 +263,13 @@ DVec& CHOLMOD_solver::solve(const DVec &rhs)
 
   // update member data in (struct cholmod_dense) b.
   // Note that b->x borrows raw allocation in DVec B
+  // for this call only: its own 1x1 block is restored
+  // below, so that reset() can free b in this->cm.
 
+  cholmod_dense b0 = *b;
   b->x=B.data(); b->nrow=n; b->ncol=1; b->nzmax=n; b->d=n; b->z=NULL;
   x = cholmod_solve(CHOLMOD_A, this->L, this->b, this->cm);
+  *b = b0;
 
   X.copy(n, (double*)(x->x));   // copy "cholmod_dense" to "DVec"
   cholmod_free_dense (&x, cm);  // release this allocation
@@ -0,0 +1,199 @@
+// CS_BlockPattern.cpp
+// direct csc assembly of DG operators made of (Np,Np)
+// element blocks
+// 2026/10/17
+//---------------------------------------------------------
+#include "NDGLib_headers.h"
+#include "CS_BlockPattern.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+//---------------------------------------------------------
+void umBlockPattern::build(int K, int Np, int part)
+//---------------------------------------------------------
+{
+  // block diagonal: no coupled faces
+  IMat nbr(K, 1);  nbr.fill(0);
+  build(nbr, Np, part);
+}
+
+
+//---------------------------------------------------------
+void umBlockPattern::build(const IMat& nbr, int Np, int part)
+//---------------------------------------------------------
+{
+  if (sp_LT != part && sp_All != part) {
+    umERROR("umBlockPattern::build", "expected part = sp_LT or sp_All");
+    return;
+  }
+
+  m_K = nbr.num_rows();  m_Nfaces = nbr.num_cols();
+  m_Np = Np;  m_part = part;  m_nbr = nbr;
+
+  int K=m_K, Nf=m_Nfaces, k1=0, f1=0, f=0, k2=0;
+  bool bLT = (sp_LT == part);
+
+  // Block row k1 of column kc is stored if k1 couples to
+  // kc (sp_LT: and k1 >= kc).  Visiting k1 in ascending
+  // order, its faces then its diagonal, ranks the blocks
+  // of each column in the order of the serial triplets.
+  // A neighbor met twice by k1 shares one block.
+  m_frank.resize(K*Nf);  m_drank.resize(K);
+  IVec cnt(K);  cnt.fill(0);
+  for (k1=1; k1<=K; ++k1) {
+    for (f1=1; f1<=Nf; ++f1) {
+      int& rk = m_frank[(f1-1)*K+k1-1];
+      k2 = nbr(k1,f1);  rk = -1;
+      if (k2 < 1 || k2 == k1 || (bLT && k1 < k2)) { continue; }
+      for (f=1; f<f1; ++f) {
+        if (nbr(k1,f) == k2) { rk = m_frank[(f-1)*K+k1-1]; break; }
+      }
+      if (rk < 0) { rk = cnt[k2-1]++; }
+    }
+    m_drank[k1-1] = cnt[k1-1]++;
+  }
+
+  // row elements of the blocks of each column
+  m_colB.resize(K+1);  m_colB[0] = 0;
+  for (k1=1; k1<=K; ++k1) { m_colB[k1] = m_colB[k1-1] + cnt[k1-1]; }
+  m_rowB.resize(m_colB[K]);
+  for (k1=1; k1<=K; ++k1) {
+    for (f1=1; f1<=Nf; ++f1) {
+      int rk = m_frank[(f1-1)*K+k1-1];
+      if (rk >= 0) { m_rowB[m_colB[nbr(k1,f1)-1] + rk] = k1; }
+    }
+    m_rowB[m_colB[k1-1] + m_drank[k1-1]] = k1;
+  }
+
+  // entries of the dense blocks (sp_LT: lower half of
+  // the diagonal blocks)
+  m_nnz = m_colB[K]*Np*Np;
+  if (bLT) { m_nnz -= K*(Np*(Np-1))/2; }
+}
+
+
+//---------------------------------------------------------
+void umBlockPattern::alloc(CSd& A)
+//---------------------------------------------------------
+{
+  int K=m_K, Np=m_Np, npk=Np*K;
+  bool bLT = (sp_LT == m_part);
+
+  A.resize(npk, npk, m_nnz, 1, 0);    // csc, with values
+  A.set_shape(bLT ? (sp_LOWER | sp_TRIANGULAR) : sp_NONE);
+
+  int *P=A.P.data(), *I=A.I.data();  double *X=A.X.data();
+
+  // column pointers: column j of block column kc holds
+  // all its blocks, less rows 0:j-1 of the diagonal block
+  P[0] = 0;
+  for (int kc=1; kc<=K; ++kc) {
+    int nb = m_colB[kc]-m_colB[kc-1], col=(kc-1)*Np;
+    for (int j=0; j<Np; ++j, ++col) {
+      P[col+1] = P[col] + nb*Np - (bLT ? j : 0);
+    }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int kc=1; kc<=K; ++kc) {
+    for (int j=0; j<Np; ++j) {
+      int col=(kc-1)*Np+j, p=P[col];
+      for (int b=m_colB[kc-1]; b<m_colB[kc]; ++b) {
+        int kr = m_rowB[b], i0 = (bLT && kr==kc) ? j : 0;
+        for (int i=i0; i<Np; ++i, ++p) { I[p] = (kr-1)*Np+i; X[p] = 0.0; }
+      }
+    }
+  }
+  m_pX = X;  m_pP = P;
+}
+
+
+//---------------------------------------------------------
+void umBlockPattern::alloc(BSd& A)
+//---------------------------------------------------------
+{
+  // the blocks of block column kc, as ranked by build()
+  int K=m_K, nb=nnzb();
+  A.resize(K, m_Np, nb);
+  A.set_shape((sp_LT == m_part) ? (sp_LOWER | sp_SYMMETRIC) : sp_NONE);
+  for (int kc=0; kc<=K; ++kc) { A.P[kc] = m_colB[kc]; }
+  for (int b=0; b<nb; ++b)    { A.I[b]  = m_rowB[b]-1; }
+  m_pX = A.X.data();  m_pP = NULL;
+}
+
+
+//---------------------------------------------------------
+void umBlockPattern::add_block
+(
+  int kr, int kc, int rank, const double* B, double tol
+) const
+//---------------------------------------------------------
+{
+  // csc: within column j of block column kc, the block of
+  // rank r starts at r*Np (sp_LT: r*Np-j, since the diagonal
+  // block has rank 0 and keeps rows j:Np-1 only).
+  // BSd: the block is dense, at m_colB[kc-1]+rank.
+  int Np=m_Np;  bool bLT = (sp_LT == m_part);
+  double x=0.0, *dst=NULL;
+
+  for (int j=0; j<Np; ++j) {
+    if (m_pP) {
+      dst = m_pX + m_pP[(kc-1)*Np+j] + rank*Np - (bLT ? j : 0);
+    } else {
+      dst = m_pX + (m_colB[kc-1]+rank)*Np*Np + j*Np;
+    }
+    const double* src = B + j*Np;
+    for (int i=((bLT && kr==kc) ? j : 0); i<Np; ++i) {
+      x = src[i];  if (fabs(x) > tol) { dst[i] += x; }
+    }
+  }
+}
+
+
+//---------------------------------------------------------
+void umBlockPattern::add_face
+(
+  int k, int f, const double* B, double tol
+) const
+//---------------------------------------------------------
+{
+  int rank = m_frank[(f-1)*m_K+k-1];
+  if (rank >= 0) { add_block(k, m_nbr(k,f), rank, B, tol); }
+}
+
+
+//---------------------------------------------------------
+void umBlockPattern::add_diag
+(
+  int k, const double* B, double tol
+) const
+//---------------------------------------------------------
+{
+  add_block(k, k, m_drank[k-1], B, tol);
+}
+
+
+//---------------------------------------------------------
+int umBlockPattern::finish(CSd& A) const
+//---------------------------------------------------------
+{
+  // remove the entries that received no value > tol,
+  // keeping the order of the others, then trim storage
+  int n=A.n, q=0, p=0, p0=0;
+  int *P=A.P.data(), *I=A.I.data();  double *X=A.X.data();
+
+  for (int j=0; j<n; ++j) {
+    p0 = P[j];  P[j] = q;
+    for (p=p0; p<P[j+1]; ++p) {
+      if (X[p] != 0.0) { I[q] = I[p];  X[q++] = X[p]; }
+    }
+  }
+  P[n] = q;
+  A.realloc(0);
+  return q;
+}
@@ -4,6 +4,7 @@
 //---------------------------------------------------------
 #include "NDGLib_headers.h"
 #include "CS_Type.h"
+#include "BS_Type.h"
 
 #include "Stopwatch.h"
 
@@ -129,10 +130,24 @@ bool CSN::ok() const
 ///////////////////////////////////////////////////////////
 
 
+//---------------------------------------------------------
+bool CS_CholSymbolic::matches(const CSd& A, int ord) const
+//---------------------------------------------------------
+{
+  // was this analysis done for the pattern of A?
+  if (!S || ord != order || !A.is_csc()) { return false; }
+  int n=A.n;
+  if (P.size() != n+1 || P[n] != A.P[n]) { return false; }
+  for (int j=0; j<=n; ++j) { if (P[j] != A.P[j]) { return false; } }
+  for (int p=0; p<P[n]; ++p) { if (I[p] != A.I[p]) { return false; } }
+  return true;
+}
+
+
 //---------------------------------------------------------
 CS_Chol::CS_Chol()
 //---------------------------------------------------------
-  : S(NULL), N(NULL)
+  : m_sym(NULL), S(NULL), N(NULL)
 {
 }
 
@@ -140,56 +155,130 @@ CS_Chol::CS_Chol()
 CS_Chol::~CS_Chol()
 //---------------------------------------------------------
 {
-  if (S) { delete S; S=NULL; }
+  release_symbolic();
   if (N) { delete N; N=NULL; }
 }
 
 
 //---------------------------------------------------------
-int CS_Chol::chol(CSd& A, int order, double dummy)
+void CS_Chol::release_symbolic()
 //---------------------------------------------------------
 {
-  // Perform Cholesky factorization using 
-  // appropriate AMD re-ordering mode:
-  //---------------------------------------
-  // 0: natural: C = A     (no reordering)
-  // 1: Chol   : C = A+A'
-  // 2: LU     : C = A'*A  (drop dense rows)
-  // 3: QR     : C = A'*A
-  // 4: Chol#2 : C = A     (A is symmetric)
-  //---------------------------------------
+  // drop this solver's reference to the analysis
+  if (m_sym && (--m_sym->refs < 1)) { delete m_sym; }
+  m_sym = NULL; S = NULL;
+}
 
-  // clear existing system
-  if (S) { delete S; S = NULL; }
-  if (N) { delete N; N = NULL; }
+
+//---------------------------------------------------------
+void CS_Chol::share_symbolic(const CS_Chol& B)
+//---------------------------------------------------------
+{
+  if (&B == this || !B.m_sym || B.m_sym == m_sym) { return; }
+  release_symbolic();
+  m_sym = B.m_sym;  ++m_sym->refs;  S = m_sym->S;
+}
+
+
+//---------------------------------------------------------
+bool CS_Chol::is_analyzed(const CSd& A, int order) const
+//---------------------------------------------------------
+{
+  return (m_sym && m_sym->matches(A, order));
+}
+
+
+//---------------------------------------------------------
+int CS_Chol::analyze(const CSd& A, int order)
+//---------------------------------------------------------
+{
+  // ordering and symbolic analysis for the pattern of A;
+  // see chol() for the AMD modes
+
+  release_symbolic();
 
   // check matrix input
-  if (!A.ok())        {umERROR("CS_Chol::chol", "empty matrix"); return 0;}
-  if (!A.is_csc())    {umERROR("CS_Chol::chol", "expected csc form"); return 0;}
-  if (!A.is_square()) {umERROR("CS_Chol::chol", "matrix must be square"); return 0;}
+  if (!A.ok())        {umERROR("CS_Chol::analyze", "empty matrix"); return 0;}
+  if (!A.is_csc())    {umERROR("CS_Chol::analyze", "expected csc form"); return 0;}
+  if (!A.is_square()) {umERROR("CS_Chol::analyze", "matrix must be square"); return 0;}
 
   umLOG(1, "\nCS_Chol:chol -- starting symbolic phase\n");
+  CSS* pS = NULL;
   try {
     // ordering and symbolic analysis
-    S = CS_schol(order, A);
-    if (!S) { umERROR("CS_Chol::chol", "error building symbolic info"); return -1;}
+    pS = CS_schol(order, A);
+    if (!pS) { umERROR("CS_Chol::analyze", "error building symbolic info"); return -1;}
   } catch(...) {
-    umERROR("CS_Chol:chol", "exception in symbolic phase"); return -1;
+    umERROR("CS_Chol:analyze", "exception in symbolic phase"); return -1;
   }
   umLOG(1, "CS_Chol:chol -- symbolic phase complete\n");
-  umLOG(1, "CS_Chol:chol -- size of full Cholesky L = %1.0lf\n\n", S->lnz);
+  umLOG(1, "CS_Chol:chol -- size of full Cholesky L = %1.0lf\n\n", pS->lnz);
+
+  // keep the pattern, to check later matrices against
+  m_sym = new CS_CholSymbolic;
+  m_sym->S = pS;  m_sym->order = order;
+  m_sym->P.copy(A.n+1, A.P.data());
+  m_sym->I.copy(A.P[A.n], A.I.data());
+  S = pS;
+  return 1;
+}
+
+
+//---------------------------------------------------------
+int CS_Chol::factorize_numeric(CSd& A)
+//---------------------------------------------------------
+{
+  // numeric factorization of A, using the analysis 
+  // of its pattern.  Takes ownership of A's data.
+
+  if (!m_sym || !m_sym->matches(A, m_sym->order)) {
+    umERROR("CS_Chol::factorize_numeric", "pattern of A has not been analyzed"); 
+    return -1;
+  }
+
+  if (N) { delete N; N = NULL; }
   try {
     // numeric Cholesky factorization
     N = CS_chol(A, S, true);  // take ownership of A's data
-    if (!N) { umERROR("CS_Chol::chol", "error building numeric data"); return -2;}
+    if (!N) { umERROR("CS_Chol::factorize_numeric", "error building numeric data"); return -2;}
   } catch(...) {
-    umERROR("CS_Chol:chol", "exception in numeric phase"); return -2;
+    umERROR("CS_Chol:factorize_numeric", "exception in numeric phase"); return -2;
   }
-
   return 1;
 }
 
 
+//---------------------------------------------------------
+int CS_Chol::chol(CSd& A, int order, double dummy)
+//---------------------------------------------------------
+{
+  // Perform Cholesky factorization using 
+  // appropriate AMD re-ordering mode:
+  //---------------------------------------
+  // 0: natural: C = A     (no reordering)
+  // 1: Chol   : C = A+A'
+  // 2: LU     : C = A'*A  (drop dense rows)
+  // 3: QR     : C = A'*A
+  // 4: Chol#2 : C = A     (A is symmetric)
+  //---------------------------------------
+
+  // clear existing factor
+  if (N) { delete N; N = NULL; }
+
+  // ordering and symbolic analysis, unless this 
+  // pattern (or a shared one) is analyzed already
+  if (is_analyzed(A, order)) {
+    umLOG(1, "\nCS_Chol:chol -- reusing symbolic analysis\n");
+  } else {
+    int info = analyze(A, order);
+    if (info < 1) { return info; }
+  }
+
+  // numeric Cholesky factorization
+  return factorize_numeric(A);
+}
+
+
 //---------------------------------------------------------
 DVec& CS_Chol::solve(const DVec& rhs)
 //---------------------------------------------------------
@@ -220,15 +309,16 @@ DVec& CS_Chol::chol_solve(int order, CSd& A, DVec& rhs)
   int n=A.n; b=rhs; x.resize(n);
   if (!x.ok()||!b.ok()) { umERROR("CS_Chol::chol_solve", "out of memory"); }
 
-  S = CS_schol(order, A);         // ordering and symbolic analysis
-  N = CS_chol(A, S);              // numeric Cholesky factorization
-  if (!S || !N) { umERROR("CS_Chol::chol_solve", "setup failed"); }
+  // local {symbolic, numeric} data: leave this solver as is
+  CSS* pS = CS_schol(order, A);       // ordering and symbolic analysis
+  CSN* pN = pS ? CS_chol(A, pS) : NULL; // numeric Cholesky factorization
+  if (!pS || !pN) { umERROR("CS_Chol::chol_solve", "setup failed"); }
 
-  CS_ipvec  (S->pinv, b, x, n); // x = P*b
-  CS_lsolve (N->L,    x);       // x = L\x
-  CS_ltsolve(N->L,    x);       // x = L'\x
-  CS_pvec   (S->pinv, x, b, n); // b = P'*x
-  delete S; delete N;
+  CS_ipvec  (pS->pinv, b, x, n);  // x = P*b
+  CS_lsolve (pN->L,    x);        // x = L\x
+  CS_ltsolve(pN->L,    x);        // x = L'\x
+  CS_pvec   (pS->pinv, x, b, n);  // b = P'*x
+  delete pS; delete pN;
   return b; 
 }
 
@@ -368,13 +458,39 @@ CSd& CS_Cholinc(CSd& userA, double droptol, int modified);
 #define APPLY_PERM    0
 
 //---------------------------------------------------------
-int CS_PCG::cholinc(CSd &sp, double droptol)
+CS_PCG::~CS_PCG()
+//---------------------------------------------------------
+{
+  delete m_pAb;  m_pAb = NULL;
+}
+
+
+//---------------------------------------------------------
+DVec& CS_PCG::mult_A(const DVec& x) const
+//---------------------------------------------------------
+{
+  // A*x with the block copy of A if cholinc made one
+  if (m_pAb) { return (*m_pAb)*x; }
+  return A*x;
+}
+
+
+//---------------------------------------------------------
+int CS_PCG::cholinc(CSd &sp, double droptol, int b)
 //---------------------------------------------------------
 {
   m_droptol = droptol;
   // take ownership of input matrix
   this->A.own(sp);
 
+  // dense blocks for the products of the iterations (not
+  // for a permuted system: see APPLY_PERM)
+  delete m_pAb;  m_pAb = NULL;
+  if (b>0 && !APPLY_PERM && A.ok() && 0 == A.n % b) {
+    m_pAb = new BSd("PCG.Ab");
+    m_pAb->load(A, b);
+  }
+
 
 #if (OUT_TO_MATLAB)
   {
@@ -588,7 +704,7 @@ DVec& CS_PCG::solve(const DVec& rhs, double tol, int maxit)
   imin = 0;                   // iteration at which xmin was computed
   xmin = px;                  // iterate which has minimal residual so far
   tolb = m_tol * n2b;         // relative tolerance
-  r = pb - A*px;
+  r = pb - mult_A(px);
   normr = r.norm2();          // norm of residual
 
   if (normr <= tolb) {
@@ -640,7 +756,7 @@ DVec& CS_PCG::solve(const DVec& rhs, double tol, int maxit)
       p*=beta;  p+=z;
     }
 
-    q = A*p;
+    q = mult_A(p);
     pq = inner(p,q);
 
     if ((pq <= 0) || isinf(pq)) {
@@ -672,7 +788,7 @@ DVec& CS_PCG::solve(const DVec& rhs, double tol, int maxit)
 
     // form new iterate
     px += alpha * p;
-    b_Ax = pb - A*px;
+    b_Ax = pb - mult_A(px);
     normr = b_Ax.norm2();
     m_resvec(i+1) = normr;
 
@@ -21,6 +21,10 @@ OPTFLAGS = -O3 -DNDEBUG
 # c++ compiler options
 CXXOPTIONS = -DUNDERSCORE -fpermissive
 
+# OpenMP (threaded element loops, e.g. Maxwell3D::RHS_fused);
+# leave empty to build without threads
+OMPFLAGS = -fopenmp
+
 # fortran compiler options
 FCOPTIONS =
 